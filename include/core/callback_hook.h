@@ -27,8 +27,10 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #define CALLBACK_HOOK_INVALID_IDX 0x0
 
@@ -36,6 +38,19 @@ template<class>
 class callback_hook;
 
 /**
+ * A set of callbacks that are executed together.<br>
+ * Registered callbacks are additionally kept in a flat, immutable subscriber array of shared callback objects which
+ * is rebuilt on every registration or removal (copy-on-write, linear in the number of callbacks but without copying
+ * any callback object). Executing the hook only reads the current array and does not allocate, hence callbacks may
+ * safely add or remove callbacks while being executed.<br>
+ * The array is published with std::atomic_load/std::atomic_store on a shared_ptr, so the hook may be executed
+ * concurrently with a registration or removal. Note that these functions are not lock-free in common standard
+ * libraries (libstdc++ guards them with a small pool of mutexes) and are deprecated in C++20 in favor of
+ * std::atomic<std::shared_ptr>. Registrations and removals themselves must not run concurrently with each other.<br>
+ * An execution works on the array it loaded at its start: a callback that is removed from another thread while an
+ * execution is running may still be called by that execution after the removal returned. The callback object is kept
+ * alive until then.
+ *
  * @ingroup core
  */
 template<class R, class... ArgTypes>
@@ -50,17 +65,18 @@ public:
      * @param[in] id - The desired callback id.
      * @returns The id of the callback.
      */
-    u64 add_callback(const std::function<R(ArgTypes...)>& callback, u64 id = CALLBACK_HOOK_INVALID_IDX)
+    u64 add_callback(std::function<R(ArgTypes...)> callback, u64 id = CALLBACK_HOOK_INVALID_IDX)
     {
         if (id == CALLBACK_HOOK_INVALID_IDX)
         {
-            id = 1;
-            while (m_callbacks.find(id) != m_callbacks.end())
+            while (m_callbacks.find(m_next_id) != m_callbacks.end())
             {
-                ++id;
+                ++m_next_id;
             }
+            id = m_next_id++;
         }
-        m_callbacks[id] = callback;
+        m_callbacks[id] = std::make_shared<const std::function<R(ArgTypes...)>>(std::move(callback));
+        update_subscribers();
         return id;
     }
 
@@ -71,14 +87,16 @@ public:
      * @param[in] name - The desired callback identifier.
      * @param[in] callback - The function to add.
      */
-    void add_callback(const std::string& name, const std::function<R(ArgTypes...)>& callback)
+    void add_callback(const std::string& name, std::function<R(ArgTypes...)> callback)
     {
         auto it = m_name_to_id_map.find(name);
         if (it != m_name_to_id_map.end())
         {
             remove_callback(it->second);
         }
-        m_name_to_id_map[name] = add_callback(callback);
+        u64 id                 = add_callback(std::move(callback));
+        m_name_to_id_map[name] = id;
+        m_id_to_name_map[id]   = name;
     }
 
     /**
@@ -92,14 +110,12 @@ public:
         if (it != m_callbacks.end())
         {
             m_callbacks.erase(it);
-            for (auto it2 = m_name_to_id_map.begin(); it2 != m_name_to_id_map.end(); it2++)
+            if (auto it2 = m_id_to_name_map.find(id); it2 != m_id_to_name_map.end())
             {
-                if ((*it2).second == id)
-                {
-                    m_name_to_id_map.erase(it2);
-                    break;
-                }
+                m_name_to_id_map.erase(it2->second);
+                m_id_to_name_map.erase(it2);
             }
+            update_subscribers();
         }
     }
 
@@ -124,16 +140,29 @@ public:
      */
     void inline operator()(ArgTypes... args)
     {
-        if (this->size() == 0)
+        // keep the current array alive, a callback may replace it during execution
+        auto subscribers = std::atomic_load(&m_subscribers);
+        if (subscribers == nullptr)
         {
             return;
         }
-        for (const auto& i : m_callbacks)
+        for (const auto& callback : *subscribers)
         {
-            (i.second)(args...);
+            (*callback)(args...);
         }
     }
 
+    /**
+     * Check whether no callback function is registered.<br>
+     * Allows callers to skip preparing the arguments of an execution altogether.
+     *
+     * @returns True, if no callback function is registered.
+     */
+    bool inline empty() const
+    {
+        return std::atomic_load(&m_subscribers) == nullptr;
+    }
+
     /**
      * Execute a specific callback functions with the provided arguments.<br>
      * If no callback is registered, a default-constructed object is returned.
@@ -149,7 +178,7 @@ public:
         {
             return R();
         }
-        return (it->second)(args...);
+        return (*it->second)(args...);
     }
 
     /**
@@ -225,18 +254,41 @@ public:
      */
     std::string get_name(u64 id)
     {
-        for (const auto& it : m_name_to_id_map)
+        auto it = m_id_to_name_map.find(id);
+        if (it == m_id_to_name_map.end())
         {
-            if (it.second == id)
-            {
-                return it.first;
-            }
+            return "";
         }
-        return "";
+        return it->second;
     }
 
 private:
-    std::map<u64, std::function<R(ArgTypes...)>> m_callbacks;
+    using callback_ptr    = std::shared_ptr<const std::function<R(ArgTypes...)>>;
+    using subscriber_list = std::vector<callback_ptr>;
+
+    void update_subscribers()
+    {
+        if (m_callbacks.empty())
+        {
+            std::atomic_store(&m_subscribers, std::shared_ptr<const subscriber_list>());
+            return;
+        }
+        auto subscribers = std::make_shared<subscriber_list>();
+        subscribers->reserve(m_callbacks.size());
+        for (const auto& it : m_callbacks)
+        {
+            subscribers->push_back(it.second);
+        }
+        std::atomic_store(&m_subscribers, std::shared_ptr<const subscriber_list>(std::move(subscribers)));
+    }
+
+    std::map<u64, callback_ptr> m_callbacks;
 
     std::map<std::string, u64> m_name_to_id_map;
+    std::map<u64, std::string> m_id_to_name_map;
+
+    u64 m_next_id = 1;
+
+    // callbacks in order of their ids, nullptr if none is registered, only accessed through std::atomic_load/std::atomic_store
+    std::shared_ptr<const subscriber_list> m_subscribers;
 };
@@ -0,0 +1,98 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+
+#include <string>
+#include <string_view>
+
+/**
+ * @ingroup core
+ */
+class CORE_API memory_mapped_file
+{
+public:
+    memory_mapped_file() = default;
+
+    ~memory_mapped_file();
+
+    memory_mapped_file(const memory_mapped_file&) = delete;
+    memory_mapped_file& operator=(const memory_mapped_file&) = delete;
+
+    /**
+     * Maps a file read-only into memory.<br>
+     * A previously opened file is closed first.
+     *
+     * @param[in] file_name - Path to the file.
+     * @returns True on success.
+     */
+    bool open(const hal::path& file_name);
+
+    /**
+     * Unmaps the file.<br>
+     * All views obtained from this object become invalid.
+     */
+    void close();
+
+    /**
+     * Checks whether a file is currently mapped.
+     *
+     * @returns True if a file is mapped.
+     */
+    bool is_open() const;
+
+    /**
+     * Gets a pointer to the first byte of the mapped file.
+     *
+     * @returns The pointer or a nullptr if no file is mapped or the file is empty.
+     */
+    const char* data() const;
+
+    /**
+     * Gets the size of the mapped file in bytes.
+     *
+     * @returns The size.
+     */
+    u64 size() const;
+
+    /**
+     * Gets a view of the entire file contents.<br>
+     * The view is valid as long as the file stays mapped.
+     *
+     * @returns The view.
+     */
+    std::string_view view() const;
+
+private:
+    const char* m_data = nullptr;
+    u64 m_size         = 0;
+    bool m_is_open     = false;
+
+#ifdef _WIN32
+    // windows builds read the file into memory instead of mapping it
+    std::string m_buffer;
+#endif
+};
@@ -43,14 +43,14 @@ struct CORE_API token
      * @param[in] s - the string
      * @param[in] cs - if true, string comparisons are case sensitive
      */
-    token(u32 n, const std::string s, bool cs = true);
-
-    // the line number
-    u32 number;
+    token(u32 n, std::string s, bool cs = true);
 
     // the contained string
     std::string string;
 
+    // the line number
+    u32 number;
+
     // if true, string comparisons are case sensitive
     bool case_sensitive;
 
@@ -129,6 +129,16 @@ public:
      */
     token_stream(const std::vector<token>& init, const std::vector<std::string>& increase_level_tokens = {"("}, const std::vector<std::string>& decrease_level_tokens = {")"});
 
+    /**
+     * Initialization constructor that takes over the given tokens without copying them.
+     * The increase-level and decrease-level tokens are used for level-aware iteration.
+     *
+     * @param[in] init - a token vector to initialize with
+     * @param[in] decrease_level_tokens - the tokens that mark the start of a new level, i.e., increase the level.
+     * @param[in] increase_level_tokens - the tokens that mark the end of a level, i.e., decrease the level.
+     */
+    token_stream(std::vector<token>&& init, const std::vector<std::string>& increase_level_tokens = {"("}, const std::vector<std::string>& decrease_level_tokens = {")"});
+
     /**
      * Copy constructor.
      *
@@ -136,6 +146,16 @@ public:
      */
     token_stream(const token_stream& other);
 
+    /**
+     * Move constructor.
+     *
+     * @param[in] other - the token stream to move from
+     */
+    token_stream(token_stream&& other) = default;
+
+    token_stream& operator=(const token_stream& other) = default;
+    token_stream& operator=(token_stream&& other) = default;
+
     /**
      * Consume the next token(s) in the stream.
      * Advances the stream by the given number and returns the last consumed token.
@@ -4,6 +4,7 @@
 #include "def.h"
 
 #include <QObject>
+#include <QSet>
 #include <QStringList>
 #include <QVector>
 
@@ -38,6 +39,7 @@ public:
     void handle_module_submodule_removed(const std::shared_ptr<module> m, const u32 removed_module);
     void handle_module_gate_assigned(const std::shared_ptr<module> m, const u32 inserted_gate) const;
     void handle_module_gate_removed(const std::shared_ptr<module> m, const u32 removed_gate);
+    void handle_module_content_changed(const std::shared_ptr<module> m, const QSet<u32>& added_modules, const QSet<u32>& removed_modules, const QSet<u32>& assigned_gates, const QSet<u32>& removed_gates);
 
     //void handle_gate_created(const std::shared_ptr<gate> g) const;
     //void handle_gate_removed(const std::shared_ptr<gate> g) const;
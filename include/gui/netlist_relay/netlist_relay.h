@@ -24,6 +24,7 @@
 #ifndef NETLIST_RELAY_H
 #define NETLIST_RELAY_H
 
+#include "netlist/event_system/event_controls.h"
 #include "netlist/event_system/gate_event_handler.h"
 #include "netlist/event_system/net_event_handler.h"
 #include "netlist/event_system/netlist_event_handler.h"
@@ -31,6 +32,7 @@
 
 #include <QMap>
 #include <QObject>
+#include <QSet>
 
 class module_item;
 class module_model;
@@ -109,6 +111,17 @@ private:
     void relay_module_event(module_event_handler::event ev, std::shared_ptr<module> object, u32 associated_data);
     void relay_gate_event(gate_event_handler::event ev, std::shared_ptr<gate> object, u32 associated_data);
     void relay_net_event(net_event_handler::event ev, std::shared_ptr<net> object, u32 associated_data);
+    void relay_batch_committed(const event_controls::change_set& changes);
+
+    // content changes of modules while a batch is dispatched, applied to the graph contexts once per module afterwards
+    struct module_content_changes
+    {
+        QSet<u32> added_modules;
+        QSet<u32> removed_modules;
+        QSet<u32> assigned_gates;
+        QSet<u32> removed_gates;
+    };
+    QMap<u32, module_content_changes> m_batch_module_changes;
 
     QMap<u32, QColor> m_module_colors;
 
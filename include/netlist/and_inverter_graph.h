@@ -0,0 +1,291 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/* forward declaration */
+class gate;
+class net;
+class netlist;
+
+/**
+ * And-Inverter-Graph (AIG) for the combined representation of combinational logic.<br>
+ * Functions are referenced by literals: bit 0 of a literal marks a complemented edge, the remaining bits are the node.
+ * Node 0 is the constant ZERO, all other nodes are either inputs or two-input ANDs. AND nodes are structurally hashed,
+ * i.e., each pair of fan-in literals is created only once, and constants as well as trivial cases are propagated on
+ * creation. Since fan-ins are always created before their fan-outs, node order is a topological order.<br>
+ * The combinational logic of a netlist is ingested gate by gate, cutting at sequential gates, global inputs and all
+ * other nets that cannot be translated, which become inputs of the graph.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API and_inverter_graph
+{
+public:
+    /** The literal of the constant ZERO. */
+    static constexpr u32 ZERO = 0;
+    /** The literal of the constant ONE. */
+    static constexpr u32 ONE = 1;
+    /** Returned by operations that failed. */
+    static constexpr u32 INVALID = 0xFFFFFFFF;
+
+    /**
+     * Constructs an empty graph that only contains the constant node.
+     */
+    and_inverter_graph();
+
+    /**
+     * Get the number of nodes including the constant node.
+     *
+     * @returns The number of nodes.
+     */
+    u32 get_num_nodes() const;
+
+    /**
+     * Get the number of AND nodes.
+     *
+     * @returns The number of AND nodes.
+     */
+    u32 get_num_ands() const;
+
+    /**
+     * Creates a new input.
+     *
+     * @param[in] name - The name of the input.
+     * @returns The literal of the input.
+     */
+    u32 create_input(const std::string& name);
+
+    /**
+     * Get the literals of all inputs in order of creation.
+     *
+     * @returns The input literals.
+     */
+    const std::vector<u32>& get_inputs() const;
+
+    /**
+     * Get the name of an input.
+     *
+     * @param[in] literal - The literal of the input.
+     * @returns The name or an empty string if the literal is no input.
+     */
+    std::string get_input_name(u32 literal) const;
+
+    /**
+     * Checks whether a literal refers to an input.
+     *
+     * @param[in] literal - The literal.
+     * @returns True if the literal refers to an input, false otherwise.
+     */
+    bool is_input(u32 literal) const;
+
+    /**
+     * Checks whether a literal refers to an AND node.
+     *
+     * @param[in] literal - The literal.
+     * @returns True if the literal refers to an AND node, false otherwise.
+     */
+    bool is_and(u32 literal) const;
+
+    /**
+     * Get the fan-in literals of the AND node of a literal, ignoring the complement of the literal itself.
+     *
+     * @param[in] literal - The literal of an AND node.
+     * @returns The pair of fan-in literals or (INVALID, INVALID) if the literal is no AND node.
+     */
+    std::pair<u32, u32> get_fan_in(u32 literal) const;
+
+    /**
+     * Get the number of references of the node of a literal by AND nodes and outputs.
+     *
+     * @param[in] literal - The literal.
+     * @returns The number of references.
+     */
+    u32 get_fan_out_count(u32 literal) const;
+
+    /**
+     * Creates the complement of a function.
+     *
+     * @param[in] a - The literal of the function.
+     * @returns The resulting literal.
+     */
+    static u32 create_not(u32 a);
+
+    /**
+     * Creates the conjunction of two functions.
+     *
+     * @param[in] a - The literal of the first function.
+     * @param[in] b - The literal of the second function.
+     * @returns The resulting literal.
+     */
+    u32 create_and(u32 a, u32 b);
+
+    /**
+     * Creates the disjunction of two functions.
+     *
+     * @param[in] a - The literal of the first function.
+     * @param[in] b - The literal of the second function.
+     * @returns The resulting literal.
+     */
+    u32 create_or(u32 a, u32 b);
+
+    /**
+     * Creates the exclusive disjunction of two functions.
+     *
+     * @param[in] a - The literal of the first function.
+     * @param[in] b - The literal of the second function.
+     * @returns The resulting literal.
+     */
+    u32 create_xor(u32 a, u32 b);
+
+    /**
+     * Creates the function "if s then t else e".
+     *
+     * @param[in] s - The literal of the condition.
+     * @param[in] t - The literal of the function if s is ONE.
+     * @param[in] e - The literal of the function if s is ZERO.
+     * @returns The resulting literal.
+     */
+    u32 create_mux(u32 s, u32 t, u32 e);
+
+    /**
+     * Marks a literal as output of the graph, which counts as a reference of its node.
+     *
+     * @param[in] literal - The literal.
+     */
+    void add_output(u32 literal);
+
+    /**
+     * Get the literals of all outputs in order of creation.
+     *
+     * @returns The output literals.
+     */
+    const std::vector<u32>& get_outputs() const;
+
+    /**
+     * Converts a boolean function into the graph.
+     *
+     * @param[in] function - The boolean function.
+     * @param[in] variable_literals - The literals to use for the variables of the function.
+     * @returns The resulting literal or INVALID if the function is empty, contains X or uses an unmapped variable.
+     */
+    u32 from_boolean_function(const boolean_function& function, const std::unordered_map<std::string, u32>& variable_literals);
+
+    /**
+     * Converts the function of a literal back into a boolean function over the input names.
+     *
+     * @param[in] literal - The literal.
+     * @returns The boolean function or an empty function if the literal is invalid.
+     */
+    boolean_function to_boolean_function(u32 literal) const;
+
+    /**
+     * Computes the maximum fanout-free cone of the node of a literal, i.e., the node itself and all AND nodes in its
+     * transitive fan-in that are only referenced from within the cone. Removing the node removes the whole cone.
+     *
+     * @param[in] literal - The literal of an AND node.
+     * @returns The non-complemented literals of the cone in topological order, the node itself last.
+     */
+    std::vector<u32> get_fanout_free_cone(u32 literal) const;
+
+    /**
+     * Adds the combinational gates of a netlist to the graph, cf. add_gates.
+     *
+     * @param[in] nl - The netlist.
+     * @returns True on success, false otherwise.
+     */
+    bool add_netlist(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Adds the given gates to the graph, assigning a literal to each of their output nets.<br>
+     * Combinational and LUT gates are translated using their boolean function of the respective output pin, with
+     * the literals of the nets at their input pins substituted for the pin variables. All other nets in the fan-in,
+     * i.e., nets driven by sequential gates, by gates that are not given, global inputs and nets whose function
+     * cannot be translated, become inputs of the graph named after the net. Combinational loops are cut by turning
+     * one of their nets into an input.<br>
+     * Global output nets and nets that feed gates that are not translated are added as outputs.<br>
+     * Nets keep the literal they are assigned first, also across multiple calls.
+     *
+     * @param[in] gates - The gates.
+     * @returns True on success, false otherwise.
+     */
+    bool add_gates(const std::vector<std::shared_ptr<gate>>& gates);
+
+    /**
+     * Get the literal of a net that was added with add_gates or add_netlist.
+     *
+     * @param[in] n - The net.
+     * @returns The literal of the net or INVALID if the net is unknown.
+     */
+    u32 get_net_literal(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Get the nets that became inputs of the graph in order of creation.
+     *
+     * @returns The input nets.
+     */
+    const std::vector<std::shared_ptr<net>>& get_input_nets() const;
+
+private:
+    struct node
+    {
+        // both INVALID for inputs
+        u32 fan_in_0;
+        u32 fan_in_1;
+    };
+
+    u32 from_boolean_function(const boolean_function& function,
+                              const std::unordered_map<std::string, u32>& variable_literals,
+                              std::unordered_map<const boolean_function::node*, u32>& cache);
+
+    bool is_translated(const std::shared_ptr<gate>& g) const;
+
+    u32 translate_net(const std::shared_ptr<net>& root);
+
+    u32 create_net_input(const std::shared_ptr<net>& n);
+
+    std::vector<node> m_nodes;
+    std::vector<u32> m_fan_out_counts;
+
+    // maps the pair of fan-in literals to the node
+    std::unordered_map<u64, u32> m_structural_hash;
+
+    std::vector<u32> m_inputs;
+    std::unordered_map<u32, std::string> m_input_names;
+    std::vector<u32> m_outputs;
+
+    std::unordered_set<u32> m_gates;
+    std::unordered_map<u32, u32> m_net_literals;
+    std::vector<std::shared_ptr<net>> m_input_nets;
+    std::unordered_set<u32> m_output_nets;
+};
@@ -0,0 +1,221 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Manager of reduced ordered binary decision diagrams (BDDs).<br>
+ * BDDs are referenced by node ids that stay valid for the lifetime of the manager. For a fixed variable order, two
+ * functions are equivalent if and only if they are represented by the same node, which makes the BDD a canonical form.
+ * Nodes are shared through a unique table and operations are memoized in a computed cache.<br>
+ * Only two-valued functions can be represented, functions that contain the constant X cannot be converted.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API bdd_manager
+{
+public:
+    /** The node representing the constant ZERO. */
+    static constexpr u32 ZERO = 0;
+    /** The node representing the constant ONE. */
+    static constexpr u32 ONE = 1;
+    /** Returned by operations that failed. */
+    static constexpr u32 INVALID = 0xFFFFFFFF;
+
+    /**
+     * Constructs a manager.<br>
+     * Variables that are not part of the given order are appended to the order when they are first used.
+     *
+     * @param[in] variable_order - The variables from top to bottom.
+     * @param[in] cache_size_log2 - Logarithm of the number of entries of the computed cache.
+     */
+    bdd_manager(const std::vector<std::string>& variable_order = {}, u32 cache_size_log2 = 16);
+
+    /**
+     * Get the variable order of the manager.
+     *
+     * @returns The variables from top to bottom.
+     */
+    const std::vector<std::string>& get_variable_order() const;
+
+    /**
+     * Get the number of nodes of the manager including both constants.
+     *
+     * @returns The number of nodes.
+     */
+    u32 get_num_nodes() const;
+
+    /**
+     * Get the BDD of a single variable.
+     *
+     * @param[in] name - The variable name.
+     * @returns The node of the variable.
+     */
+    u32 get_variable(const std::string& name);
+
+    /**
+     * Computes the BDD of "if f then g else h".
+     *
+     * @param[in] f - The condition.
+     * @param[in] g - The function if f is ONE.
+     * @param[in] h - The function if f is ZERO.
+     * @returns The resulting node.
+     */
+    u32 ite(u32 f, u32 g, u32 h);
+
+    /**
+     * Computes the BDD of the negation of a function.
+     *
+     * @param[in] f - The function.
+     * @returns The resulting node.
+     */
+    u32 apply_not(u32 f);
+
+    /**
+     * Computes the BDD of the conjunction of two functions.
+     *
+     * @param[in] f - The first function.
+     * @param[in] g - The second function.
+     * @returns The resulting node.
+     */
+    u32 apply_and(u32 f, u32 g);
+
+    /**
+     * Computes the BDD of the disjunction of two functions.
+     *
+     * @param[in] f - The first function.
+     * @param[in] g - The second function.
+     * @returns The resulting node.
+     */
+    u32 apply_or(u32 f, u32 g);
+
+    /**
+     * Computes the BDD of the exclusive disjunction of two functions.
+     *
+     * @param[in] f - The first function.
+     * @param[in] g - The second function.
+     * @returns The resulting node.
+     */
+    u32 apply_xor(u32 f, u32 g);
+
+    /**
+     * Converts a boolean function into a BDD.
+     *
+     * @param[in] function - The boolean function.
+     * @returns The resulting node or INVALID if the function is empty or contains X.
+     */
+    u32 from_boolean_function(const boolean_function& function);
+
+    /**
+     * Converts a BDD into a boolean function.<br>
+     * The function is a nest of multiplexers along the variable order, hence it is a canonical form: the conversions of
+     * equivalent functions compare equal.
+     *
+     * @param[in] f - The node.
+     * @returns The boolean function.
+     */
+    boolean_function to_boolean_function(u32 f);
+
+    /**
+     * Computes a canonical form of a boolean function with respect to the variable order of the manager.
+     *
+     * @param[in] function - The boolean function.
+     * @returns The canonical form or an empty function if the function cannot be converted.
+     */
+    boolean_function get_canonical_form(const boolean_function& function);
+
+    /**
+     * Decides whether two boolean functions are equivalent, i.e., evaluate to the same value for all inputs.
+     *
+     * @param[in] a - The first boolean function.
+     * @param[in] b - The second boolean function.
+     * @returns True if both functions are equivalent, false if not or if a function cannot be converted.
+     */
+    bool are_equivalent(const boolean_function& a, const boolean_function& b);
+
+    /**
+     * Counts the assignments of all variables of the manager for which a function evaluates to ONE.
+     *
+     * @param[in] f - The node.
+     * @returns The number of satisfying assignments.
+     */
+    double count_satisfying_assignments(u32 f) const;
+
+    /**
+     * Computes an irredundant sum-of-products cover of a function using the Minato-Morreale algorithm.<br>
+     * The cover is irredundant but not guaranteed to be minimum.<br>
+     * Each cube is a vector of pairs <variable name, boolean value> in variable order, cf.
+     * boolean_function::get_dnf_clauses. The constant ONE is covered by a single empty cube, ZERO by no cube at all.
+     *
+     * @param[in] f - The node.
+     * @returns The cubes of the cover.
+     */
+    std::vector<std::vector<std::pair<std::string, bool>>> get_isop(u32 f);
+
+private:
+    struct node
+    {
+        u32 level;
+        u32 low;
+        u32 high;
+    };
+
+    struct cache_entry
+    {
+        u32 f = INVALID;
+        u32 g;
+        u32 h;
+        u32 result;
+    };
+
+    u32 make_node(u32 level, u32 low, u32 high);
+
+    u32 get_level(u32 f) const;
+
+    // covers all functions between lower and upper, returns the covered function
+    u32 get_isop(u32 lower, u32 upper, std::vector<std::vector<std::pair<u32, bool>>>& cover);
+
+    u32 from_boolean_function(const boolean_function& function, std::unordered_map<const boolean_function::node*, u32>& cache);
+
+    // the variables from top to bottom and their levels
+    std::vector<std::string> m_variables;
+    std::unordered_map<std::string, u32> m_levels;
+
+    std::vector<node> m_nodes;
+
+    // one table per level, mapping (low, high) to the node
+    std::vector<std::unordered_map<u64, u32>> m_unique_tables;
+
+    // direct-mapped, entries are overwritten on collisions
+    std::vector<cache_entry> m_computed_cache;
+
+    std::unordered_map<u32, boolean_function> m_to_function_cache;
+};
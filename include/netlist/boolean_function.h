@@ -27,12 +27,16 @@
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /**
- * Boolean function class.
+ * Boolean function class.<br>
+ * Functions are immutable graphs of shared nodes, hence copies are cheap and identical subfunctions are stored only once.
  *
  * @ingroup netlist
  */
@@ -158,15 +162,15 @@ public:
      * Operator precedence is ! > & > ^ > |
      *
      * Since, for example, '(' is interpreted as a new term, but might also be an intended part of a variable,
-     * a vector of known variable names can be supplied, which are extracted before parsing.
+     * a vector of known variable names can be supplied, which are matched as a whole wherever an operand starts.
      *
-     * If there is an error during bracket matching, X is returned for that part.
+     * If there is an error during bracket matching, X is returned.
      *
      * @param[in] expression - String containing a boolean function.
      * @param[in] variable_names - Names of variables to help resolve problematic functions
      * @returns The boolean function extracted from the string.
      */
-    static boolean_function from_string(std::string expression, const std::vector<std::string>& variable_names = {});
+    static boolean_function from_string(const std::string& expression, const std::vector<std::string>& variable_names = {});
 
     /**
      * Returns the boolean function as a string.
@@ -175,6 +179,14 @@ public:
      */
     std::string to_string() const;
 
+    /**
+     * Appends the string representation of the boolean function to a buffer.<br>
+     * Allows to reuse the memory of the buffer when converting many functions.
+     *
+     * @param[in,out] out - The buffer to append to.
+     */
+    void to_string(std::string& out) const;
+
     /**
      * ostream operator that forwards to_string of a boolean function.
      *
@@ -285,7 +297,12 @@ public:
     std::vector<std::vector<std::pair<std::string, bool>>> get_dnf_clauses() const;
 
     /**
-     * Optimizes the function by first converting it to DNF and then applying the Quine-McCluskey algorithm.
+     * Optimizes the function into an irredundant sum of products.<br>
+     * Two-valued functions are minimized with the Minato-Morreale algorithm, on packed truth tables for up to 16
+     * variables and on BDDs otherwise. Functions that involve X are converted to DNF and minimized with the
+     * Quine-McCluskey algorithm.<br>
+     * An irredundant cover is not necessarily a minimum one: no cube can be dropped, but the result of two-valued
+     * functions may contain more cubes or literals than an exact Quine-McCluskey cover.
      *
      * @returns The optimized boolean function.
      */
@@ -311,7 +328,23 @@ public:
      */
     std::vector<value> get_truth_table(std::vector<std::string> ordered_variables = {}, bool remove_unknown_variables = false) const;
 
+    /**
+     * Builds the minimized sum of products of a two-valued function from its truth table.
+     * The table is packed bitwise: row i, i.e., the assignment in which the j-th variable takes bit j of i, is bit i % 64 of word i / 64.
+     * For less than six variables, only the lowest 2^n bits of the single word are used.
+     * Rows beyond the end of the table are ZERO. Tables of more than 16 variables are minimized on a BDD.
+     *
+     * @param[in] table - The packed truth table of up to 2^n rows.
+     * @param[in] variables - The n variables of the table, at most 32.
+     * @returns The boolean function, or an empty function if the table does not match the variables.
+     */
+    static boolean_function from_truth_table(const std::vector<u64>& table, const std::vector<std::string>& variables);
+
 private:
+    friend class compiled_boolean_function;
+    friend class bdd_manager;
+    friend class and_inverter_graph;
+
     enum class operation
     {
         AND,
@@ -321,8 +354,6 @@ private:
     static std::string to_string(const operation& op);
     friend std::ostream& operator<<(std::ostream& os, const operation& op);
 
-    static boolean_function from_string_internal(std::string expression, const std::vector<std::string>& variable_names);
-
     /*
      * Constructor for a function of the form "term1 op term2 op term3 op ..."
      * Empty terms behaves like constant X.
@@ -332,7 +363,8 @@ private:
 
     boolean_function combine(operation op, const boolean_function& other) const;
 
-    std::string to_string_internal() const;
+    // appends the string representation to the buffer
+    void write_string(std::string& buffer, bool top_level) const;
 
     // replaces a^b with (a & !b | (!a & b)
     boolean_function replace_xors() const;
@@ -356,19 +388,46 @@ private:
     // merges nested expressions of the same operands
     static std::vector<std::vector<value>> qmc(const std::vector<std::vector<value>>& terms);
 
-    bool m_invert;
-
     enum class content_type
     {
         VARIABLE,
         CONSTANT,
         TERMS
-    } m_content;
+    };
+
+    /*
+     * Immutable node of a function.
+     * Nodes are hash-consed: there is exactly one live node per structure, so identical (sub-)functions share their
+     * node and structural equality is pointer equality. Fields that are irrelevant for the content are left at their
+     * defaults.
+     */
+    struct node
+    {
+        content_type content = content_type::TERMS;
+        bool invert          = false;
+        std::string variable;
+        value constant = value::X;
+        operation op   = operation::AND;
+        std::vector<boolean_function> operands;
+        std::size_t hash = 0;
+    };
+
+    class unique_table;
+
+    // returns the unique node with the given structure
+    static std::shared_ptr<const node> make_node(node&& n);
+
+    explicit boolean_function(std::shared_ptr<const node> n);
+
+    boolean_function substitute(const std::string& variable_name, const boolean_function& function, std::unordered_map<const node*, boolean_function>& cache) const;
+
+    void collect_variables(std::set<std::string>& variables, std::unordered_set<const node*>& visited) const;
 
-    std::string m_variable;
+    // checks whether the function never involves X, i.e., neither contains the constant X nor empty terms
+    bool is_two_valued(std::unordered_set<const node*>& visited) const;
 
-    value m_constant;
+    // builds an OR of ANDs from cubes as returned by get_dnf_clauses
+    static boolean_function from_clauses(const std::vector<std::vector<std::pair<std::string, bool>>>& clauses);
 
-    operation m_op;
-    std::vector<boolean_function> m_operands;
+    std::shared_ptr<const node> m_node;
 };
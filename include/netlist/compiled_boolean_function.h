@@ -0,0 +1,230 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Truth table of a boolean function packed into bitvectors using a two-rail encoding.<br>
+ * Row i of the table is stored in bit (i % 64) of word (i / 64). A row is ONE if its bit is set in ones, ZERO if its
+ * bit is set in zeros and X if it is set in neither. Bits beyond the last row are never set.
+ *
+ * @ingroup netlist
+ */
+struct NETLIST_API packed_truth_table
+{
+    u32 num_variables = 0;
+    std::vector<u64> ones;
+    std::vector<u64> zeros;
+
+    /**
+     * Get the number of rows, i.e., 2^num_variables.
+     *
+     * @returns The number of rows.
+     */
+    u64 size() const;
+
+    /**
+     * Get the value of a row.
+     *
+     * @param[in] row - The row index.
+     * @returns The value of the row.
+     */
+    boolean_function::value get(u64 row) const;
+
+    /**
+     * Unpacks the table into one value per row.
+     *
+     * @returns The vector of output values.
+     */
+    std::vector<boolean_function::value> unpack() const;
+
+    bool operator==(const packed_truth_table& other) const;
+    bool operator!=(const packed_truth_table& other) const;
+};
+
+/**
+ * A boolean function lowered into a flat instruction array over dense variable slots.<br>
+ * Each variable of the function is assigned a slot index and the function is evaluated on an array of values indexed
+ * by slot. Evaluation neither allocates nor compares variable names, making it suitable to evaluate the same function
+ * very often, e.g., for exhaustive testing or random simulation.<br>
+ * Additionally, the function can be evaluated bit-sliced on 64 input patterns at once, with every value represented by
+ * two words (two-rail encoding) to preserve X.<br>
+ * The results are identical to boolean_function::evaluate for the same inputs.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API compiled_boolean_function
+{
+public:
+    /**
+     * Constructor for an empty function.
+     * Evaluates to X (undefined).
+     */
+    compiled_boolean_function();
+
+    /**
+     * Compiles a boolean function.<br>
+     * All variables of the function are assigned a slot in alphabetical order.
+     *
+     * @param[in] function - The boolean function to compile.
+     */
+    compiled_boolean_function(const boolean_function& function);
+
+    /**
+     * Compiles a boolean function.<br>
+     * The slots are assigned in the order of the given variables. Variables of the function that are not assigned a
+     * slot evaluate to X.
+     *
+     * @param[in] function - The boolean function to compile.
+     * @param[in] variables - The variables in slot order.
+     */
+    compiled_boolean_function(const boolean_function& function, const std::vector<std::string>& variables);
+
+    /**
+     * Get the variables in slot order.
+     *
+     * @returns The variable names.
+     */
+    const std::vector<std::string>& get_variables() const;
+
+    /**
+     * Get the number of variable slots, i.e., the size of the input array expected by evaluate.
+     *
+     * @returns The number of slots.
+     */
+    u32 get_num_slots() const;
+
+    /**
+     * Get the slot of a variable.
+     *
+     * @param[in] variable - The variable name.
+     * @returns The slot index or -1 if the variable has no slot.
+     */
+    i32 get_slot(const std::string& variable) const;
+
+    /**
+     * Get the number of instructions the function was lowered to.
+     *
+     * @returns The number of instructions.
+     */
+    u32 get_num_instructions() const;
+
+    /**
+     * Evaluates the function on the given inputs.
+     *
+     * @param[in] inputs - Array of at least get_num_slots() values, indexed by slot.
+     * @returns The value that the function evaluates to.
+     */
+    boolean_function::value evaluate(const boolean_function::value* inputs) const;
+
+    /**
+     * Evaluates the function on the given inputs.
+     *
+     * @param[in] inputs - Vector of get_num_slots() values, indexed by slot.
+     * @returns The value that the function evaluates to or X if too few inputs are given.
+     */
+    boolean_function::value evaluate(const std::vector<boolean_function::value>& inputs) const;
+
+    /**
+     * Evaluates the function on the given inputs.
+     *
+     * @param[in] inputs - Array of at least get_num_slots() values, indexed by slot.
+     * @returns The value that the function evaluates to.
+     */
+    boolean_function::value operator()(const boolean_function::value* inputs) const;
+
+    /**
+     * Two-rail encoding of 64 values, one per bit.<br>
+     * A bit is ONE if set in ones, ZERO if set in zeros and X if set in neither. It must not be set in both.
+     */
+    struct value_slice
+    {
+        u64 ones;
+        u64 zeros;
+    };
+
+    /**
+     * Evaluates the function on 64 input patterns at once.
+     *
+     * @param[in] inputs - Array of at least get_num_slots() slices, indexed by slot.
+     * @returns The 64 values that the function evaluates to.
+     */
+    value_slice evaluate(const value_slice* inputs) const;
+
+    /**
+     * Get the truth table of the function packed into bitvectors.<br>
+     * Row ordering is identical to get_truth_table. Evaluated bit-sliced, i.e., 64 rows per evaluation.
+     * WARNING: Exponential runtime in the number of slots!
+     *
+     * @returns The packed truth table.
+     */
+    packed_truth_table get_packed_truth_table() const;
+
+    /**
+     * Get the truth table outputs of the function.<br>
+     * Ordering is identical to boolean_function::get_truth_table, i.e., the variable in slot 0 changes fastest.
+     * WARNING: Exponential runtime in the number of slots!
+     *
+     * @returns The vector of output values.
+     */
+    std::vector<boolean_function::value> get_truth_table() const;
+
+private:
+    enum class opcode : u8
+    {
+        LOAD_SLOT,     // push inputs[operand]
+        LOAD_CONST,    // push (value)operand
+        AND,           // replace the two topmost values by their combination
+        OR,
+        XOR,
+        NOT    // invert the topmost value
+    };
+
+    struct instruction
+    {
+        opcode op;
+        i32 operand;
+    };
+
+    // operands are evaluated from a fixed-size stack on the native stack if the function is shallow enough
+    static constexpr u32 MAX_INLINE_STACK_SIZE = 64;
+
+    void compile(const boolean_function& function, u32 depth);
+
+    boolean_function::value run(const boolean_function::value* inputs, boolean_function::value* stack) const;
+    value_slice run(const value_slice* inputs, value_slice* stack) const;
+
+    std::vector<std::string> m_variables;
+    std::unordered_map<std::string, u32> m_slots;
+
+    std::vector<instruction> m_instructions;
+    u32 m_stack_size;
+};
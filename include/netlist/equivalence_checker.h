@@ -0,0 +1,124 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/and_inverter_graph.h"
+#include "netlist/boolean_function.h"
+#include "netlist/sat_solver.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+/* forward declaration */
+class net;
+class netlist;
+
+/**
+ * Functional equivalence checking and constant detection for the nets of a netlist.<br>
+ * The combinational logic of the netlist is converted into an and_inverter_graph, so nets are compared as functions
+ * of the global inputs and the outputs of sequential gates. Queries are first filtered by bit-parallel simulation of
+ * random patterns, which refutes most non-equivalent candidates without calling the solver. The remaining
+ * candidates are decided by an incremental SAT solver on the Tseitin encoding of the cones involved. Counterexamples
+ * found by the solver are added to the simulation patterns, and proven equivalences are added as clauses, so later
+ * queries become cheaper.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API equivalence_checker
+{
+public:
+    /**
+     * Constructs a checker for the nets of a netlist.<br>
+     * The netlist must not be modified while the checker is in use.
+     *
+     * @param[in] nl - The netlist.
+     * @param[in] num_simulation_words - The number of 64-bit words of random patterns that are simulated initially.
+     * @param[in] seed - The seed of the random patterns.
+     */
+    equivalence_checker(const std::shared_ptr<netlist>& nl, u32 num_simulation_words = 4, u64 seed = 0x5eed);
+
+    /**
+     * Checks whether two nets are functionally equivalent.
+     *
+     * @param[in] a - The first net.
+     * @param[in] b - The second net.
+     * @returns True if both nets always carry the same value, false otherwise or if a net is not part of the netlist.
+     */
+    bool are_equivalent(const std::shared_ptr<net>& a, const std::shared_ptr<net>& b);
+
+    /**
+     * Checks whether a net is stuck at a constant value.
+     *
+     * @param[in] n - The net.
+     * @returns ZERO or ONE if the net is constant, X otherwise or if the net is not part of the netlist.
+     */
+    boolean_function::value get_constant_value(const std::shared_ptr<net>& n);
+
+    /**
+     * Finds all nets of the netlist that are stuck at a constant value.
+     *
+     * @returns A map from each constant net to its value.
+     */
+    std::map<std::shared_ptr<net>, boolean_function::value> find_constant_nets();
+
+    /**
+     * Get the graph the checks are performed on.
+     *
+     * @returns The and_inverter_graph of the netlist.
+     */
+    const and_inverter_graph& get_and_inverter_graph() const;
+
+    /**
+     * Get the number of queries that could not be decided by simulation and were passed to the SAT solver.
+     *
+     * @returns The number of SAT calls.
+     */
+    u32 get_num_sat_calls() const;
+
+private:
+    std::shared_ptr<netlist> m_netlist;
+    and_inverter_graph m_aig;
+
+    // one vector of node signatures per simulated word
+    std::vector<std::vector<u64>> m_signatures;
+
+    // inputs of the last simulated word, which collects the counterexamples of the solver
+    std::vector<u64> m_counterexample_word;
+    u32 m_num_counterexamples = 0;
+
+    sat_solver m_solver;
+    std::vector<u32> m_sat_variables;
+    u32 m_num_sat_calls = 0;
+
+    std::vector<u64> simulate(const std::vector<u64>& input_word) const;
+    u64 get_signature(u32 literal, u32 word) const;
+    bool have_equal_signatures(u32 a, u32 b) const;
+
+    u32 encode(u32 literal);
+    bool is_unsatisfiable(const std::vector<u32>& assumptions);
+    void add_counterexample();
+};
@@ -25,6 +25,16 @@
 
 #include "def.h"
 
+#include "netlist/event_system/gate_event_handler.h"
+#include "netlist/event_system/module_event_handler.h"
+#include "netlist/event_system/net_event_handler.h"
+#include "netlist/event_system/netlist_event_handler.h"
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+
 /**
  * @ingroup handler
  */
@@ -38,4 +48,120 @@ namespace event_controls
      */
     NETLIST_API void enable_all(bool flag);
 
+    /**
+     * Summary of all changes of a committed batch.<br>
+     * Objects that were created and removed within the batch do not appear at all.
+     * Modified objects are neither created nor removed within the batch.
+     */
+    struct change_set
+    {
+        /* the netlist the batch was started for */
+        std::shared_ptr<netlist> batch_netlist;
+
+        std::set<std::shared_ptr<netlist>> modified_netlists;
+
+        std::set<std::shared_ptr<gate>> created_gates;
+        std::set<std::shared_ptr<gate>> removed_gates;
+        std::set<std::shared_ptr<gate>> modified_gates;
+
+        std::set<std::shared_ptr<net>> created_nets;
+        std::set<std::shared_ptr<net>> removed_nets;
+        std::set<std::shared_ptr<net>> modified_nets;
+
+        std::set<std::shared_ptr<module>> created_modules;
+        std::set<std::shared_ptr<module>> removed_modules;
+        std::set<std::shared_ptr<module>> modified_modules;
+    };
+
+    /**
+     * Starts a batch for a netlist.<br>
+     * Until the batch is committed, the events of all enabled event handlers that concern the netlist or its gates, nets, and modules
+     * are recorded instead of being dispatched. Events of other netlists are not affected.<br>
+     * Batches may be nested, only committing the outermost batch dispatches the recorded events.<br>
+     * Prefer scoped_batch, which also commits the batch if the modifications are aborted by an exception.
+     *
+     * @param[in] nl - The netlist.
+     */
+    NETLIST_API void begin_batch(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Commits the batch of a netlist.<br>
+     * The recorded events are coalesced and dispatched in their original order, afterwards all batch callbacks are executed once with a summary of the changes.<br>
+     * While coalescing, events of objects that were created and removed within the batch are dropped, only the last of repeated state changes (e.g. name changes) is kept,
+     * and each removal cancels the latest preceding matching addition (e.g. of the same destination gate of a net). Additions are never merged with each other.
+     *
+     * @param[in] nl - The netlist.
+     * @returns False if no batch was active for the netlist.
+     */
+    NETLIST_API bool commit_batch(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Checks whether the events of a netlist are currently recorded.
+     *
+     * @param[in] nl - The netlist.
+     * @returns True if a batch is active for the netlist.
+     */
+    NETLIST_API bool is_batch_active(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Checks whether the events of a batch are currently dispatched.<br>
+     * Callbacks can use this to skip expensive bookkeeping per event and perform it once in a batch callback instead.
+     *
+     * @returns True while a batch is committed.
+     */
+    NETLIST_API bool is_committing_batch();
+
+    /**
+     * Registers a callback function that is executed whenever a batch is committed.
+     *
+     * @param[in] name - name of the callback, used for callback removal.
+     * @param[in] function - The callback function.
+     */
+    NETLIST_API void register_batch_callback(const std::string& name, std::function<void(const change_set& changes)> function);
+
+    /**
+     * Removes a batch callback function.
+     *
+     * @param[in] name - name of the callback.
+     */
+    NETLIST_API void unregister_batch_callback(const std::string& name);
+
+    /**
+     * Records an event of the respective event handler if a batch is active for the netlist of the affected object.<br>
+     * Called by the event handlers only.
+     *
+     * @param[in] ev - the event which occured.
+     * @param[in] object - The affected object.
+     * @param[in] associated_data - may have a meaning depending on the event type.
+     * @returns True if the event was recorded, false if it has to be dispatched immediately.
+     */
+    NETLIST_API bool record(netlist_event_handler::event ev, const std::shared_ptr<netlist>& object, u32 associated_data);
+    NETLIST_API bool record(gate_event_handler::event ev, const std::shared_ptr<gate>& object, u32 associated_data);
+    NETLIST_API bool record(net_event_handler::event ev, const std::shared_ptr<net>& object, u32 associated_data);
+    NETLIST_API bool record(module_event_handler::event ev, const std::shared_ptr<module>& object, u32 associated_data);
+
+    /**
+     * Starts a batch for a netlist on construction and commits it on destruction, i.e., also when the scope is left through an exception.
+     */
+    class NETLIST_API scoped_batch
+    {
+    public:
+        /**
+         * Starts a batch, see begin_batch().
+         *
+         * @param[in] nl - The netlist.
+         */
+        explicit scoped_batch(const std::shared_ptr<netlist>& nl);
+
+        /**
+         * Commits the batch, see commit_batch().
+         */
+        ~scoped_batch();
+
+        scoped_batch(const scoped_batch&) = delete;
+        scoped_batch& operator=(const scoped_batch&) = delete;
+
+    private:
+        std::shared_ptr<netlist> m_netlist;
+    };
 }    // namespace event_controls
\ No newline at end of file
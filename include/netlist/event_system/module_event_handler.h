@@ -61,7 +61,7 @@ namespace module_event_handler
     * @param[in] module - The affected object.
     * @param[in] associated_data - may have a meaning depending on the event type.
     */
-    NETLIST_API void notify(event ev, std::shared_ptr<module> module, u32 associated_data = 0xFFFFFFFF);
+    NETLIST_API void notify(event ev, const std::shared_ptr<module>& module, u32 associated_data = 0xFFFFFFFF);
 
     /**
      * Registers a callback function.
@@ -61,7 +61,9 @@ public:
     u32 get_id() const;
 
     /**
-     * Gets the parent netlist of the gate.
+     * Gets the parent netlist of the gate.<br>
+     * The gate only keeps a raw pointer to its netlist, so the netlist must still be alive when this is called.
+     * A gate that is kept beyond the lifetime of its netlist must not access it anymore.
      *
      * @returns The netlist.
      */
@@ -224,14 +226,14 @@ public:
      *
      * @returns A vector of input pin types.
      */
-    std::vector<std::string> get_input_pins() const;
+    const std::vector<std::string>& get_input_pins() const;
 
     /**
      * Get a list of all output pin types of the gate.
      *
      * @returns A vector of output pin types.
      */
-    std::vector<std::string> get_output_pins() const;
+    const std::vector<std::string>& get_output_pins() const;
 
     /**
      * Get a set of all fan-in nets of the gate, i.e. all nets that are connected to one of the input pins.
@@ -248,6 +250,22 @@ public:
      */
     std::shared_ptr<net> get_fan_in_net(const std::string& pin_type) const;
 
+    /**
+     * Get the fan-in net which is connected to a specific input pin.
+     *
+     * @param[in] pin_id - The input pin id as given by gate_type::get_input_pin_id.
+     * @returns The connected input net.
+     */
+    std::shared_ptr<net> get_fan_in_net_by_pin_id(u32 pin_id) const;
+
+    /**
+     * Calls a function for every fan-in net of the gate together with the input pin it is connected to, ordered by pin id.<br>
+     * In contrast to get_fan_in_nets(), no container is built and no reference counts are touched.
+     *
+     * @param[in] visitor - The function to call for each connected input pin.
+     */
+    void for_each_fan_in_net(const std::function<void(const std::string& pin_type, const std::shared_ptr<net>& net)>& visitor) const;
+
     /**
      * Get a set of all fan-out nets of the gate, i.e. all nets that are connected to one of the output pins.
      *
@@ -263,6 +281,22 @@ public:
      */
     std::shared_ptr<net> get_fan_out_net(const std::string& pin_type) const;
 
+    /**
+     * Get the fan-out net which is connected to a specific output pin.
+     *
+     * @param[in] pin_id - The output pin id as given by gate_type::get_output_pin_id.
+     * @returns The connected output net.
+     */
+    std::shared_ptr<net> get_fan_out_net_by_pin_id(u32 pin_id) const;
+
+    /**
+     * Calls a function for every fan-out net of the gate together with the output pin it is connected to, ordered by pin id.<br>
+     * In contrast to get_fan_out_nets(), no container is built and no reference counts are touched.
+     *
+     * @param[in] visitor - The function to call for each connected output pin.
+     */
+    void for_each_fan_out_net(const std::function<void(const std::string& pin_type, const std::shared_ptr<net>& net)>& visitor) const;
+
     /**
      * Get a set of all unique predecessor endpoints of the gate.
      * A filter can be supplied which filters out all potential values that return false.
@@ -308,15 +342,15 @@ public:
     std::vector<endpoint> get_successors(const std::function<bool(const std::string& starting_pin, const endpoint& ep)>& filter = nullptr) const;
 
 private:
-    gate(std::shared_ptr<netlist> const g, u32 id, std::shared_ptr<const gate_type> gt, const std::string& name, float x, float y);
+    gate(netlist* nl, u32 id, std::shared_ptr<const gate_type> gt, const std::string& name, float x, float y);
 
     gate(const gate&) = delete;               //disable copy-constructor
     gate& operator=(const gate&) = delete;    //disable copy-assignment
 
     boolean_function get_lut_function(const std::string& pin) const;
 
-    /* pointer to corresponding netlist parent */
-    std::shared_ptr<netlist> m_netlist;
+    /* pointer to corresponding netlist parent, not owning: the netlist owns the gate and must outlive every access */
+    netlist* m_netlist;
 
     /* id of the gate */
     u32 m_id;
@@ -334,9 +368,9 @@ private:
     /* owning module */
     std::shared_ptr<module> m_module;
 
-    /* connected nets */
-    std::map<std::string, std::shared_ptr<net>> m_in_nets;
-    std::map<std::string, std::shared_ptr<net>> m_out_nets;
+    /* connected nets, indexed by pin id (nullptr if the pin is unconnected) */
+    std::vector<std::shared_ptr<net>> m_in_nets;
+    std::vector<std::shared_ptr<net>> m_out_nets;
 
     /* dedicated functions */
     std::map<std::string, boolean_function> m_functions;
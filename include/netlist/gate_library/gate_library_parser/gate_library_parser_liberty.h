@@ -33,6 +33,7 @@
 #include "netlist/gate_library/gate_type/gate_type_sequential.h"
 
 #include <unordered_map>
+#include <unordered_set>
 
 /**
  * @ingroup netlist
@@ -60,6 +61,14 @@ public:
      * <category> and <identifier> refer to the location where the LUT configuration string is stored, for example "generic" and "init".
      * direction describes whether the least significant bit of the configuration is the output for inputs 000... (ascending) or 111... (descending).
      *
+     * Fracturable LUTs define one lut group per output function. Outputs that only use a part of the configuration additionally specify
+     *
+     *     input_count = <n>;
+     *     first_row = <r>;
+     *
+     * to compute their output from the first n input pins, using the 2^n rows of the full LUT starting at row r.
+     * For example, the O5 output of a 6-input LUT that uses the lower half of its configuration has input_count 5 and first_row 0.
+     *
      * @returns The deserialized gate library.
      */
     std::shared_ptr<gate_library> parse() override;
@@ -75,6 +84,8 @@ private:
         gate_type_sequential::set_reset_behavior special_behavior_var1, special_behavior_var2;
         std::string data_category, data_identifier, data_direction;
         std::string state1, state2;
+        std::unordered_set<std::string> lut_functions;
+        std::unordered_map<std::string, std::pair<u32, u32>> lut_slices;
 
         void clear()
         {
@@ -94,6 +105,8 @@ private:
             data_direction        = "";
             state1                = "";
             state2                = "";
+            lut_functions.clear();
+            lut_slices.clear();
         }
     } m_current_cell;
 
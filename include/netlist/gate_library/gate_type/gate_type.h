@@ -44,6 +44,9 @@ public:
         latch
     };
 
+    /** marks a pin name that is not a pin of the gate type */
+    static constexpr u32 INVALID_PIN_ID = 0xFFFFFFFF;
+
     /**
      * Constructor for a gate type.
      *
@@ -114,11 +117,20 @@ public:
     void add_input_pins(const std::vector<std::string>& input_pins);
 
     /**
-     * Get a vector of input pins of the gate type.
+     * Get a vector of input pins of the gate type.<br>
+     * The position of a pin within this vector is its input pin id.
      *
      * @returns A vector of input pins of the gate type.
      */
-    std::vector<std::string> get_input_pins() const;
+    const std::vector<std::string>& get_input_pins() const;
+
+    /**
+     * Get the id of an input pin, i.e., its position within the input pins of the gate type.
+     *
+     * @param[in] input_pin - The name of the input pin.
+     * @returns The input pin id or INVALID_PIN_ID if there is no such input pin.
+     */
+    u32 get_input_pin_id(const std::string& input_pin) const;
 
     /**
      * Add an output pin to the gate type.
@@ -135,11 +147,20 @@ public:
     void add_output_pins(const std::vector<std::string>& output_pins);
 
     /**
-     * Get a vector of output pins of the gate type.
+     * Get a vector of output pins of the gate type.<br>
+     * The position of a pin within this vector is its output pin id.
      *
      * @returns A vector of output pins of the gate type..
      */
-    std::vector<std::string> get_output_pins() const;
+    const std::vector<std::string>& get_output_pins() const;
+
+    /**
+     * Get the id of an output pin, i.e., its position within the output pins of the gate type.
+     *
+     * @param[in] output_pin - The name of the output pin.
+     * @returns The output pin id or INVALID_PIN_ID if there is no such output pin.
+     */
+    u32 get_output_pin_id(const std::string& output_pin) const;
 
     /**
      * Add a boolean function with the specified name to the gate type.
@@ -154,7 +175,7 @@ public:
      *
      * @returns A map from function names to boolean functions.
      */
-    std::unordered_map<std::string, boolean_function> get_boolean_functions() const;
+    const std::unordered_map<std::string, boolean_function>& get_boolean_functions() const;
 
 protected:
     base_type m_base_type;
@@ -165,6 +186,10 @@ private:
     std::vector<std::string> m_input_pins;
     std::vector<std::string> m_output_pins;
 
+    /* pin name -> pin id, resolved once when the pin is added */
+    std::unordered_map<std::string, u32> m_input_pin_ids;
+    std::unordered_map<std::string, u32> m_output_pin_ids;
+
     std::unordered_map<std::string, boolean_function> m_functions;
 
     gate_type(const gate_type&) = delete;               // disable copy-constructor
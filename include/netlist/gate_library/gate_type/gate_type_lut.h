@@ -26,6 +26,8 @@
 #include "netlist/boolean_function.h"
 #include "netlist/gate_library/gate_type/gate_type.h"
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -53,12 +55,32 @@ public:
      */
     void add_output_from_init_string_pin(const std::string& output_pin);
 
+    /**
+     * Adds an output pin of a fracturable LUT that generates its output from a part of the initialization string.
+     * The output is a function of the first num_inputs input pins, and its row i is row (first_row + i) of the full LUT.
+     * For example, the O5 output of a 6-input LUT that uses the lower half of the INIT string is added with num_inputs = 5 and first_row = 0.
+     *
+     * @param[in] output_pin - The name of the output pin.
+     * @param[in] num_inputs - The number of leading input pins the output depends on.
+     * @param[in] first_row - The row of the full LUT at which the output's truth table starts.
+     */
+    void add_output_from_init_string_pin(const std::string& output_pin, u32 num_inputs, u32 first_row);
+
     /**
      * Get the set of output pins that generate their output not from a boolean function but an initialization string.
      *
      * @returns Set of oputput pin names.
      */
-    std::unordered_set<std::string> get_output_from_init_string_pins() const;
+    const std::unordered_set<std::string>& get_output_from_init_string_pins() const;
+
+    /**
+     * Get the part of the initialization string that generates the output of an output pin.
+     * Pins that use the whole initialization string depend on all input pins and start at row 0.
+     *
+     * @param[in] output_pin - The name of the output pin.
+     * @returns A pair of the number of leading input pins the output depends on and the first row of the full LUT.
+     */
+    std::pair<u32, u32> get_output_from_init_string_slice(const std::string& output_pin) const;
 
     /**
      * Set the category in which to find the INIT string.
@@ -72,7 +94,7 @@ public:
      *
      * @returns The string describing the category.
      */
-    std::string get_config_data_category() const;
+    const std::string& get_config_data_category() const;
 
     /**
      * Set the identifier used to specify the INIT string.
@@ -86,7 +108,7 @@ public:
      *
      * @returns The identifier as a string.
      */
-    std::string get_config_data_identifier() const;
+    const std::string& get_config_data_identifier() const;
 
     /**
      * Set the bit-order of the INIT string.
@@ -103,10 +125,21 @@ public:
     bool is_config_data_ascending_order() const;
 
 private:
+    friend class gate;
+
     std::unordered_set<std::string> m_output_from_init_string_pins;
+    std::unordered_map<std::string, std::pair<u32, u32>> m_output_from_init_string_slices;
     std::string m_config_data_category;
     std::string m_config_data_identifier;
     bool m_ascending;
 
+    /* slice -> INIT string -> decoded function, shared by all gates of this type and cleared once it holds too many functions */
+    static constexpr u32 MAX_LUT_FUNCTION_CACHE_SIZE = 4096;
+    mutable std::mutex m_lut_function_cache_mutex;
+    mutable std::map<std::pair<u32, u32>, std::unordered_map<std::string, boolean_function>> m_lut_function_cache;
+    mutable u32 m_lut_function_cache_size = 0;
+
+    void clear_lut_function_cache();
+
     bool do_compare(const gate_type& other) const override;
 };
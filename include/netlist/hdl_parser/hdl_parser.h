@@ -30,6 +30,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /* forward declaration*/
@@ -46,6 +47,14 @@ public:
      */
     explicit hdl_parser(std::stringstream& stream);
 
+    /**
+     * Parses directly from a view of the hdl code, e.g., a memory-mapped file.<br>
+     * The view is not copied and has to stay valid until parsing is done.
+     *
+     * @param[in] input - The view of the hdl code.
+     */
+    explicit hdl_parser(std::string_view input);
+
     virtual ~hdl_parser() = default;
 
     /**
@@ -60,6 +69,9 @@ protected:
     // stores the netlist
     std::shared_ptr<netlist> m_netlist;
 
-    // stores the input stream to the file
-    std::stringstream& m_fs;
+    // owns the hdl code if it was handed over as a stream
+    std::string m_buffer;
+
+    // the hdl code to parse
+    std::string_view m_input;
 };
@@ -47,10 +47,16 @@ public:
      */
     explicit hdl_parser_verilog(std::stringstream& stream);
 
+    /**
+     * @param[in] input - The view of the hdl code, e.g., of a memory-mapped file. It has to stay valid until parsing is done.
+     */
+    explicit hdl_parser_verilog(std::string_view input);
+
     ~hdl_parser_verilog() = default;
 
     /**
-     * Deserializes a netlist in Verilog format from the internal string stream into a netlist object.
+     * Deserializes a netlist in Verilog format from the internal string stream into a netlist object.<br>
+     * The input is tokenized and parsed one statement at a time, so only the intermediate representation of the modules is kept in memory.
      *
      * @param[in] gate_library - The gate library used in the serialized file.
      * @returns The deserialized netlist.
@@ -80,8 +86,20 @@ private:
         std::unordered_map<std::string, std::vector<std::string>> expanded_signal_names;
     };
 
+    // holds the tokens of the statement that is currently parsed
     token_stream m_token_stream;
     std::string m_last_entity;
+
+    // state of the tokenizer, the input is tokenized line by line while parsing
+    size_t m_input_position    = 0;
+    u32 m_line_number          = 0;
+    bool m_escaped             = false;
+    bool m_multi_line_comment  = false;
+    bool m_multi_line_property = false;
+    std::string m_line_buffer;
+    std::vector<token> m_line_tokens;
+    u32 m_next_line_token = 0;
+
     std::unordered_map<std::string, std::vector<std::string>> m_gate_to_pin_map;
 
     std::map<std::string, std::shared_ptr<net>> m_net_by_name;
@@ -92,7 +110,8 @@ private:
     std::unordered_map<std::string, entity> m_entities;
     std::unordered_map<std::string, std::vector<std::string>> m_nets_to_merge;
 
-    bool tokenize();
+    bool tokenize_next_line();
+    bool next_statement();
     bool parse_tokens();
 
     // parse the hdl into an intermediate format
@@ -102,17 +121,19 @@ private:
     bool parse_signal_definition(entity& e);
     bool parse_assign(entity& e);
     bool parse_instance(entity& e);
+    bool connect_instance(entity& e, instance& inst);
     bool connect_instances();
 
     // build the netlist from the intermediate format
     bool build_netlist(const std::string& top_module);
-    std::shared_ptr<module> instantiate(const entity& e, std::shared_ptr<module> parent, std::unordered_map<std::string, std::string> port_assignments);
+    std::shared_ptr<module> instantiate(entity& e, std::shared_ptr<module> parent, std::unordered_map<std::string, std::string> port_assignments);
 
     // helper functions
     void remove_comments(std::string& line, bool& multi_line_comment, bool& multi_line_property);
     void expand_signal(std::vector<std::string>& expanded_signal, std::string current_signal, std::vector<std::pair<i32, i32>> bounds, u32 dimension);
     std::unordered_map<std::string, std::vector<std::string>> get_expanded_signals(token_stream& signal_str);
     std::vector<std::string> get_assignment_signals(token_stream& signal_str, entity& e, bool allow_numerics);
+    bool references_declared_signals(const token_stream& signal_str, const entity& e) const;
     std::vector<std::string> get_port_signals(token_stream& port_str, const std::string& instance_type);
     std::string get_number_from_literal(const std::string& v, const u32 base);
     std::string get_unique_alias(const std::string& name);
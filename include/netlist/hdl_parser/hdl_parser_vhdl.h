@@ -47,6 +47,11 @@ public:
      */
     explicit hdl_parser_vhdl(std::stringstream& stream);
 
+    /**
+     * @param[in] input - The view of the hdl code, e.g., of a memory-mapped file. It has to stay valid until parsing is done.
+     */
+    explicit hdl_parser_vhdl(std::string_view input);
+
     ~hdl_parser_vhdl() = default;
 
     /**
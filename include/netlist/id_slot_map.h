@@ -0,0 +1,277 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "def.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Id-indexed storage of netlist objects (gates, nets or modules) with O(1) lookup and amortized O(1) insertion and removal.<br>
+ * Ids up to a bound that grows with the number of stored objects are resolved through a dense slot vector, far outliers
+ * through a hash map. All objects are additionally kept in one contiguous vector for linear iteration; its order is
+ * unspecified and changes on removal.<br>
+ * Ids of removed objects are kept in a min-heap for reuse, which adds O(log n) to removals and id allocations.<br>
+ * T has to provide get_id().
+ *
+ * @ingroup netlist
+ */
+template<typename T>
+class id_slot_map
+{
+public:
+    /**
+     * Check whether an object with the given id is stored.
+     *
+     * @param[in] id - The id.
+     * @returns True if the id is taken.
+     */
+    bool contains(u32 id) const
+    {
+        return find_position(id) != INVALID_POSITION;
+    }
+
+    /**
+     * Get the object with the given id.
+     *
+     * @param[in] id - The id.
+     * @returns The object or nullptr if there is none.
+     */
+    const std::shared_ptr<T>& get(u32 id) const
+    {
+        static const std::shared_ptr<T> none;
+
+        u32 pos = find_position(id);
+        return (pos == INVALID_POSITION) ? none : m_objects[pos];
+    }
+
+    /**
+     * Store an object under its id.
+     *
+     * @param[in] object - The object.
+     * @returns True on success, false if the id is already taken.
+     */
+    bool insert(const std::shared_ptr<T>& object)
+    {
+        u32 id = object->get_id();
+        if (contains(id))
+        {
+            return false;
+        }
+
+        // a free id stays in the heap until it surfaces, unless it is taken in ascending order as intended
+        if (is_free(id))
+        {
+            m_num_free_ids--;
+            if (m_free_ids.front() == id)
+            {
+                pop_free_id();
+            }
+        }
+
+        u32 pos = (u32)m_objects.size();
+        m_objects.push_back(object);
+        set_position(id, pos);
+        return true;
+    }
+
+    /**
+     * Remove the object with the given id. The id becomes available for get_unique_id() again.
+     *
+     * @param[in] id - The id.
+     * @returns True on success, false if there is no object with this id.
+     */
+    bool erase(u32 id)
+    {
+        u32 pos = find_position(id);
+        if (pos == INVALID_POSITION)
+        {
+            return false;
+        }
+
+        // move the last object into the gap to keep the object vector contiguous
+        if (pos + 1 != m_objects.size())
+        {
+            m_objects[pos] = std::move(m_objects.back());
+            set_position(m_objects[pos]->get_id(), pos);
+        }
+        m_objects.pop_back();
+        set_position(id, FREE_POSITION);
+        push_free_id(id);
+        return true;
+    }
+
+    /**
+     * Get an id that is currently not taken. The id is not reserved.<br>
+     * Ids of removed objects are reused before new ids are generated, the smallest one first.
+     *
+     * @returns The id.
+     */
+    u32 get_unique_id()
+    {
+        // drop ids that were taken again since they were freed
+        while (!m_free_ids.empty() && !is_free(m_free_ids.front()))
+        {
+            pop_free_id();
+        }
+        if (!m_free_ids.empty())
+        {
+            return m_free_ids.front();
+        }
+        while (contains(m_next_id))
+        {
+            m_next_id++;
+        }
+        return m_next_id;
+    }
+
+    /**
+     * Get all stored objects as a contiguous vector.
+     *
+     * @returns The objects in unspecified order.
+     */
+    const std::vector<std::shared_ptr<T>>& get_objects() const
+    {
+        return m_objects;
+    }
+
+    /**
+     * Get the number of stored objects.
+     *
+     * @returns The number of objects.
+     */
+    u32 size() const
+    {
+        return (u32)m_objects.size();
+    }
+
+private:
+    static constexpr u32 INVALID_POSITION = 0xFFFFFFFF;
+
+    /* marks the slot of a removed id that is queued in m_free_ids */
+    static constexpr u32 FREE_POSITION = 0xFFFFFFFE;
+
+    /* ids beyond this distance from the dense range are stored in the hash map */
+    static constexpr u32 MAX_DENSE_GAP = 1 << 16;
+
+    u32 find_slot(u32 id) const
+    {
+        if (id < m_dense.size())
+        {
+            return m_dense[id];
+        }
+        if (auto it = m_sparse.find(id); it != m_sparse.end())
+        {
+            return it->second;
+        }
+        return INVALID_POSITION;
+    }
+
+    u32 find_position(u32 id) const
+    {
+        u32 pos = find_slot(id);
+        return (pos == FREE_POSITION) ? INVALID_POSITION : pos;
+    }
+
+    bool is_free(u32 id) const
+    {
+        return find_slot(id) == FREE_POSITION;
+    }
+
+    void push_free_id(u32 id)
+    {
+        m_free_ids.push_back(id);
+        std::push_heap(m_free_ids.begin(), m_free_ids.end(), std::greater<u32>());
+        m_num_free_ids++;
+
+        // ids that were taken out of order stay behind as stale entries, drop them once they dominate the heap
+        if (m_free_ids.size() > 2 * (u64)m_num_free_ids + 64)
+        {
+            m_free_ids.erase(std::remove_if(m_free_ids.begin(), m_free_ids.end(), [this](u32 free_id) { return !is_free(free_id); }), m_free_ids.end());
+            std::sort(m_free_ids.begin(), m_free_ids.end());
+            m_free_ids.erase(std::unique(m_free_ids.begin(), m_free_ids.end()), m_free_ids.end());
+        }
+    }
+
+    void pop_free_id()
+    {
+        std::pop_heap(m_free_ids.begin(), m_free_ids.end(), std::greater<u32>());
+        m_free_ids.pop_back();
+    }
+
+    void set_position(u32 id, u32 pos)
+    {
+        if (id >= m_dense.size())
+        {
+            if (pos == INVALID_POSITION)
+            {
+                m_sparse.erase(id);
+                return;
+            }
+            if ((u64)id >= (u64)m_dense.size() + m_objects.size() + MAX_DENSE_GAP)
+            {
+                m_sparse[id] = pos;
+                return;
+            }
+            grow(id);
+        }
+        m_dense[id] = pos;
+    }
+
+    // the dense range at least doubles, hence the scan of m_sparse runs only O(log n) times in total
+    void grow(u32 id)
+    {
+        u64 new_size = std::max<u64>((u64)id + 1, 2 * (u64)m_dense.size());
+        m_dense.resize(new_size, INVALID_POSITION);
+
+        // pull sparse entries that are now covered by the dense range
+        for (auto it = m_sparse.begin(); it != m_sparse.end();)
+        {
+            if (it->first < m_dense.size())
+            {
+                m_dense[it->first] = it->second;
+                it                 = m_sparse.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /* id -> position in m_objects */
+    std::vector<u32> m_dense;
+    std::unordered_map<u32, u32> m_sparse;
+
+    std::vector<std::shared_ptr<T>> m_objects;
+
+    /* min-heap of ids of removed objects, reused in ascending order before m_next_id; may contain ids that were taken again */
+    std::vector<u32> m_free_ids;
+    u32 m_num_free_ids = 0;
+    u32 m_next_id = 1;
+};
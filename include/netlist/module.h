@@ -36,6 +36,7 @@
 #include <tuple>
 #include <type_traits>
 #include <functional>
+#include <unordered_map>
 
 /** forward declaration */
 class netlist;
@@ -102,6 +103,16 @@ public:
      */
     std::set<std::shared_ptr<module>> get_submodules(const std::function<bool(const std::shared_ptr<module>&)>& filter = nullptr, bool recursive = false) const;
 
+    /**
+     * Calls a function for every direct submodule of this module.<br>
+     * If \p recursive is true, all indirect submodules are visited as well.<br>
+     * In contrast to get_submodules(), no container is built. The module hierarchy must not be modified by the function.
+     *
+     * @param[in] visitor - The function to call for each submodule.
+     * @param[in] recursive - Look into submodules as well
+     */
+    void for_each_submodule(const std::function<void(const std::shared_ptr<module>&)>& visitor, bool recursive = false) const;
+
     /**
      * Checks whether another module is a submodule of this module.<br>
      * If \p recursive is true, all indirect submodules are also included.
@@ -199,6 +210,16 @@ public:
      */
     std::set<std::shared_ptr<gate>> get_gates(const std::function<bool(const std::shared_ptr<gate>&)>& filter = nullptr, bool recursive = false) const;
 
+    /**
+     * Calls a function for every gate of the module.<br>
+     * If \p recursive is true, the gates of all submodules are visited as well.<br>
+     * In contrast to get_gates(), no container is built. The module must not be modified by the function.
+     *
+     * @param[in] visitor - The function to call for each gate.
+     * @param[in] recursive - Look into submodules too
+     */
+    void for_each_gate(const std::function<void(const std::shared_ptr<gate>&)>& visitor, bool recursive = false) const;
+
 private:
     module(u32 id, std::shared_ptr<module> parent, const std::string& name, netlist_internal_manager* internal_manager);
 
@@ -217,4 +238,36 @@ private:
     /** stores gates sorted by id*/
     std::map<u32, std::shared_ptr<gate>> m_gates_map;
     std::set<std::shared_ptr<gate>> m_gates_set;
+
+    /** position in the pre-order of the module hierarchy and the last position covered by its submodules */
+    u32 m_preorder_first = 0;
+    u32 m_preorder_last  = 0;
+
+    /** range of the gates of this module and all submodules within the gate order of the internal manager */
+    u32 m_gate_order_begin = 0;
+    u32 m_gate_order_end   = 0;
+
+    /**
+     * Connectivity of a net relative to this module (including all submodules).
+     */
+    struct net_connectivity
+    {
+        u32 dsts_inside = 0;
+        bool src_inside = false;
+    };
+
+    /**
+     * Cached input, output, and internal nets.<br>
+     * The cache is built on first request and afterwards kept up to date by the netlist internal manager.
+     */
+    mutable bool m_net_cache_valid = false;
+    mutable std::unordered_map<u32, net_connectivity> m_net_connectivity;
+    mutable std::set<std::shared_ptr<net>> m_input_nets;
+    mutable std::set<std::shared_ptr<net>> m_output_nets;
+    mutable std::set<std::shared_ptr<net>> m_internal_nets;
+
+    void build_net_cache() const;
+    void classify_net(const std::shared_ptr<net>& n) const;
+    void update_net_cache(const std::shared_ptr<net>& n, i32 dst_delta, i32 src_delta);
+    void invalidate_net_cache();
 };
@@ -49,6 +49,7 @@ class netlist_internal_manager;
 class NETLIST_API net : public data_container, public std::enable_shared_from_this<net>
 {
     friend class netlist_internal_manager;
+    friend class netlist_graph_view;
 
 public:
     /**
@@ -169,6 +170,15 @@ public:
      **/
     bool is_a_dst(const endpoint& ep) const;
 
+    /**
+     * Check whether a gate's input pin is a destination of this net.
+     *
+     * @param[in] gate - The destination gate.
+     * @param[in] pin_id - The input pin id as given by gate_type::get_input_pin_id.
+     * @returns True if the input's pin is a destination.
+     **/
+    bool is_a_dst(const std::shared_ptr<gate>& gate, u32 pin_id) const;
+
     /**
      * Get the number of destinations.<br>
      * Faster than get_dsts().size().
@@ -185,6 +195,14 @@ public:
      */
     std::vector<endpoint> get_dsts(const std::function<bool(const endpoint& ep)>& filter = nullptr) const;
 
+    /**
+     * Calls a function for every destination of the net.<br>
+     * In contrast to get_dsts(), no endpoints are built and no reference counts are touched.
+     *
+     * @param[in] visitor - The function to call for each destination gate and input pin.
+     */
+    void for_each_dst(const std::function<void(const std::shared_ptr<gate>& gate, const std::string& pin_type)>& visitor) const;
+
     /**
      * Check whether the net is routed, i.e. it has no source or the no destinations.
      *
@@ -248,6 +266,19 @@ private:
     net(const net&) = delete;               //disable copy-constructor
     net& operator=(const net&) = delete;    //disable copy-assignment
 
+    /**
+     * Connection of the net to a gate pin.<br>
+     * The pin is stored by its id within the input (dst) or output (src) pins of the gate type.
+     */
+    struct pin_endpoint
+    {
+        std::shared_ptr<::gate> gate;
+        u32 pin_id;
+    };
+
+    endpoint to_src_endpoint(const pin_endpoint& ep) const;
+    endpoint to_dst_endpoint(const pin_endpoint& ep) const;
+
     netlist_internal_manager* m_internal_manager;
 
     /** stores the id of the net */
@@ -257,8 +288,8 @@ private:
     std::string m_name;
 
     /** stores the src gate and pin id of src gate*/
-    endpoint m_src;
+    pin_endpoint m_src;
 
     /** stores the dst gate and pin id of the dst gate*/
-    std::vector<endpoint> m_dsts;
+    std::vector<pin_endpoint> m_dsts;
 };
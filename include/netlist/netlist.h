@@ -26,6 +26,7 @@
 #include "def.h"
 
 #include "netlist/gate_library/gate_library.h"
+#include "netlist/id_slot_map.h"
 
 #include <memory>
 #include <string>
@@ -37,6 +38,8 @@
 
 /** forward declaration */
 class netlist_internal_manager;
+class netlist_arena;
+class netlist_journal;
 class net;
 class gate;
 class module;
@@ -50,6 +53,7 @@ struct endpoint;
 class NETLIST_API netlist : public std::enable_shared_from_this<netlist>
 {
     friend class netlist_internal_manager;
+    friend class netlist_journal;
 
 public:
     /**
@@ -201,6 +205,15 @@ public:
      */
     std::set<std::shared_ptr<module>> get_modules() const;
 
+    /**
+     * Calls a function for every module of the netlist including the top module.<br>
+     * In contrast to get_modules(), no container is built and no reference counts are touched.
+     * The netlist must not be modified by the function.
+     *
+     * @param[in] visitor - The function to call for each module.
+     */
+    void for_each_module(const std::function<void(const std::shared_ptr<module>&)>& visitor) const;
+
     /**
      * Checks whether a module is registered in the netlist.
      *
@@ -281,6 +294,15 @@ public:
      */
     std::set<std::shared_ptr<gate>> get_gates(const std::function<bool(const std::shared_ptr<gate>&)>& filter = nullptr) const;
 
+    /**
+     * Calls a function for every gate of the netlist regardless of the module it is in.<br>
+     * In contrast to get_gates(), no container is built and no reference counts are touched.
+     * The netlist must not be modified by the function.
+     *
+     * @param[in] visitor - The function to call for each gate.
+     */
+    void for_each_gate(const std::function<void(const std::shared_ptr<gate>&)>& visitor) const;
+
     /**
      * Mark a gate as a global vcc gate.
      *
@@ -409,6 +431,15 @@ public:
      */
     std::unordered_set<std::shared_ptr<net>> get_nets(const std::function<bool(const std::shared_ptr<net>&)>& filter = nullptr) const;
 
+    /**
+     * Calls a function for every net of the netlist.<br>
+     * In contrast to get_nets(), no container is built and no reference counts are touched.
+     * The netlist must not be modified by the function.
+     *
+     * @param[in] visitor - The function to call for each net.
+     */
+    void for_each_net(const std::function<void(const std::shared_ptr<net>&)>& visitor) const;
+
     /**
      * Mark a net as a global input net.
      *
@@ -471,10 +502,39 @@ public:
      */
     std::set<std::shared_ptr<net>> get_global_output_nets() const;
 
+    /**
+     * Starts a batch of modifications.<br>
+     * Until the batch is committed, events of this netlist are recorded instead of being dispatched, see event_controls::begin_batch().<br>
+     * Use this when applying many modifications at once, e.g., when moving large numbers of gates into a module.
+     * In C++, event_controls::scoped_batch commits the batch even if the modifications are aborted by an exception.
+     */
+    void begin_batch();
+
+    /**
+     * Commits a batch of modifications.<br>
+     * The recorded events are coalesced and dispatched, followed by a single summary of all changes, see event_controls::commit_batch().
+     *
+     * @returns False if no batch was active.
+     */
+    bool commit_batch();
+
+    /**
+     * Get the journal that records the modifications of this netlist.
+     *
+     * @returns The attached journal or a nullptr.
+     */
+    netlist_journal* get_journal() const;
+
 private:
     /** stores the pointer to the netlist internal manager */
     netlist_internal_manager* m_manager;
 
+    /** stores the slab storage of all gates, nets and modules */
+    std::shared_ptr<netlist_arena> m_arena;
+
+    /** stores the journal attached to this netlist, if any */
+    netlist_journal* m_journal = nullptr;
+
     /** stores the gate library */
     std::shared_ptr<gate_library> m_gate_library;
 
@@ -490,24 +550,15 @@ private:
     /* stores the name of the device */
     std::string m_device_name;
 
-    /** stores the auto generated ids for fast next id */
-    u32 m_next_gate_id;
-    std::set<u32> m_used_gate_ids;
-    std::set<u32> m_free_gate_ids;
-    u32 m_next_net_id;
-    std::set<u32> m_used_net_ids;
-    std::set<u32> m_free_net_ids;
-    u32 m_next_module_id;
-    std::set<u32> m_used_module_ids;
-    std::set<u32> m_free_module_ids;
+    /** stores all gates by id (the gates are additionally stored in their modules) */
+    id_slot_map<gate> m_gates;
 
     /** stores the modules */
     std::shared_ptr<module> m_top_module;
-    std::unordered_map<u32, std::shared_ptr<module>> m_modules;
+    id_slot_map<module> m_modules;
 
     /** stores the nets */
-    std::unordered_map<u32, std::shared_ptr<net>> m_nets_map;
-    std::unordered_set<std::shared_ptr<net>> m_nets_set;
+    id_slot_map<net> m_nets;
 
     /** stores the set of global gates and nets */
     std::set<std::shared_ptr<net>> m_global_input_nets;
@@ -0,0 +1,186 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "def.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Slab storage for the gates, nets and modules of a netlist.<br>
+ * Objects are placed into large chunks that are grouped by (rounded) object size, so creating an object does not hit the
+ * general purpose heap and freed slots are reused by later objects of the same size. Addresses are stable for the lifetime
+ * of an object. All chunks are released at once when the arena is destroyed, which happens as soon as the netlist and
+ * every object that was allocated in the arena are gone.<br>
+ * The last reference to a gate, net or module may be dropped on any thread, e.g., by the GUI or the python interpreter,
+ * so allocation and deallocation are serialized by a mutex. Everything else about the netlist remains single-threaded.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API netlist_arena
+{
+public:
+    /**
+     * Minimal allocator that places the shared_ptr control blocks of arena objects in the arena as well.<br>
+     * It holds a reference to the arena so that the arena outlives every control block.
+     */
+    template<typename T>
+    class allocator
+    {
+    public:
+        using value_type = T;
+
+        explicit allocator(std::shared_ptr<netlist_arena> arena) : m_arena(std::move(arena))
+        {
+        }
+
+        template<typename U>
+        allocator(const allocator<U>& other) : m_arena(other.m_arena)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(m_arena->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            m_arena->deallocate(p, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const allocator<U>& other) const
+        {
+            return m_arena == other.m_arena;
+        }
+
+        template<typename U>
+        bool operator!=(const allocator<U>& other) const
+        {
+            return m_arena != other.m_arena;
+        }
+
+    private:
+        template<typename U>
+        friend class allocator;
+
+        std::shared_ptr<netlist_arena> m_arena;
+    };
+
+    netlist_arena() = default;
+    ~netlist_arena() = default;
+
+    netlist_arena(const netlist_arena&) = delete;               //disable copy-constructor
+    netlist_arena& operator=(const netlist_arena&) = delete;    //disable copy-assignment
+
+    /**
+     * Creates a shared object inside the arena.<br>
+     * The construct function receives uninitialized memory of sizeof(T) bytes and has to placement-new the object into it.
+     * This allows callers with access to private constructors to construct the object themselves.
+     *
+     * @param[in] arena - The arena.
+     * @param[in] construct - Function that constructs the object in the given memory and returns it.
+     * @returns The shared object.
+     */
+    template<typename T, typename F>
+    static std::shared_ptr<T> create(const std::shared_ptr<netlist_arena>& arena, F construct)
+    {
+        T* object          = construct(arena->allocate(sizeof(T)));
+        netlist_arena* raw = arena.get();
+        return std::shared_ptr<T>(
+            object,
+            [raw](T* p) {
+                p->~T();
+                raw->deallocate(p, sizeof(T));
+            },
+            allocator<T>(arena));
+    }
+
+    /**
+     * Allocates memory for an object of the given size.
+     *
+     * @param[in] size - The object size in bytes.
+     * @returns Pointer to the memory, aligned for any fundamental type.
+     */
+    void* allocate(std::size_t size);
+
+    /**
+     * Returns memory that was obtained from allocate() to the arena.
+     *
+     * @param[in] p - The memory.
+     * @param[in] size - The size that was passed to allocate().
+     */
+    void deallocate(void* p, std::size_t size);
+
+    /**
+     * Get the number of bytes reserved in chunks.
+     *
+     * @returns The number of reserved bytes.
+     */
+    u64 get_reserved_bytes() const;
+
+    /**
+     * Get the number of bytes currently handed out to objects (rounded up to the size classes).
+     *
+     * @returns The number of used bytes.
+     */
+    u64 get_used_bytes() const;
+
+private:
+    /* slots are multiples of this granularity, which keeps all slots aligned */
+    static constexpr std::size_t GRANULARITY = 16;
+
+    /* objects larger than this are taken from the heap directly */
+    static constexpr std::size_t MAX_SLOT_SIZE = 1024;
+
+    /* minimal size of a chunk */
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    static std::size_t get_slot_size(std::size_t size);
+
+    struct free_slot
+    {
+        free_slot* next;
+    };
+
+    struct size_class
+    {
+        free_slot* free_list = nullptr;
+        char* next           = nullptr;
+        char* end            = nullptr;
+    };
+
+    size_class m_classes[MAX_SLOT_SIZE / GRANULARITY + 1];
+
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+
+    /* guards all members, deleters of arena objects run on whichever thread releases the last reference */
+    mutable std::mutex m_mutex;
+
+    u64 m_reserved_bytes = 0;
+    u64 m_used_bytes     = 0;
+};
@@ -0,0 +1,272 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class gate;
+class net;
+
+/**
+ * Read-only snapshot of the connectivity of a netlist.<br>
+ * All gates and nets are mapped to dense indices (ordered by id) and all connections are stored in compressed sparse row (CSR) arrays
+ * that refer to pins by their index within the input or output pins of the respective gate type.<br>
+ * The view registers itself at the gate and net event handlers and is invalidated as soon as the connectivity of its netlist changes.
+ * Call rebuild() to take a fresh snapshot.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API netlist_graph_view
+{
+public:
+    /** marks an invalid gate, net or pin index */
+    static constexpr u32 INVALID_INDEX = 0xFFFFFFFF;
+
+    /**
+     * A single connection, i.e., a (gate or net) index together with the pin index on the gate side.
+     */
+    struct connection
+    {
+        /** index of the connected gate or net */
+        u32 index;
+
+        /** index of the pin within the input or output pins of the gate type */
+        u32 pin;
+    };
+
+    /**
+     * Lightweight non-owning range over a contiguous part of one of the CSR arrays.
+     */
+    template<typename T>
+    struct range
+    {
+        const T* first;
+        const T* last;
+
+        const T* begin() const
+        {
+            return first;
+        }
+
+        const T* end() const
+        {
+            return last;
+        }
+
+        u32 size() const
+        {
+            return (u32)(last - first);
+        }
+
+        bool empty() const
+        {
+            return first == last;
+        }
+
+        const T& operator[](u32 i) const
+        {
+            return first[i];
+        }
+    };
+
+    /**
+     * Builds a snapshot of the given netlist.
+     *
+     * @param[in] nl - The netlist.
+     */
+    explicit netlist_graph_view(const std::shared_ptr<netlist>& nl);
+
+    ~netlist_graph_view();
+
+    netlist_graph_view(const netlist_graph_view&) = delete;               //disable copy-constructor
+    netlist_graph_view& operator=(const netlist_graph_view&) = delete;    //disable copy-assignment
+
+    /**
+     * Get the netlist this view was built from.
+     *
+     * @returns The netlist.
+     */
+    std::shared_ptr<netlist> get_netlist() const;
+
+    /**
+     * Checks whether the snapshot still reflects the netlist.<br>
+     * The view is invalidated whenever a gate or net is created or removed or a net source or destination changes.
+     *
+     * @returns True if no relevant change happened since the last (re)build.
+     */
+    bool is_valid() const;
+
+    /**
+     * Discards the current snapshot and builds a new one from the netlist in a single pass.
+     */
+    void rebuild();
+
+    /*
+     * ################################################################
+     *      index mapping
+     * ################################################################
+     */
+
+    /**
+     * Get the number of gates in the snapshot.
+     *
+     * @returns The number of gates.
+     */
+    u32 get_num_gates() const;
+
+    /**
+     * Get the number of nets in the snapshot.
+     *
+     * @returns The number of nets.
+     */
+    u32 get_num_nets() const;
+
+    /**
+     * Get the dense index of a gate.
+     *
+     * @param[in] g - The gate.
+     * @returns The index or INVALID_INDEX if the gate is not part of the snapshot.
+     */
+    u32 get_gate_index(const std::shared_ptr<gate>& g) const;
+
+    /**
+     * Get the dense index of a net.
+     *
+     * @param[in] n - The net.
+     * @returns The index or INVALID_INDEX if the net is not part of the snapshot.
+     */
+    u32 get_net_index(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Get the gate at a dense index.
+     *
+     * @param[in] index - The gate index.
+     * @returns The gate.
+     */
+    const std::shared_ptr<gate>& get_gate(u32 index) const;
+
+    /**
+     * Get the net at a dense index.
+     *
+     * @param[in] index - The net index.
+     * @returns The net.
+     */
+    const std::shared_ptr<net>& get_net(u32 index) const;
+
+    /*
+     * ################################################################
+     *      connectivity
+     * ################################################################
+     */
+
+    /**
+     * Get all fan-in connections of a gate, i.e., pairs (net index, input pin index), ordered by pin index.
+     *
+     * @param[in] gate_index - The gate index.
+     * @returns The fan-in connections.
+     */
+    range<connection> get_fan_in(u32 gate_index) const;
+
+    /**
+     * Get all fan-out connections of a gate, i.e., pairs (net index, output pin index), ordered by pin index.
+     *
+     * @param[in] gate_index - The gate index.
+     * @returns The fan-out connections.
+     */
+    range<connection> get_fan_out(u32 gate_index) const;
+
+    /**
+     * Get the source of a net as a pair (gate index, output pin index).<br>
+     * If the net has no source, both members are INVALID_INDEX.
+     *
+     * @param[in] net_index - The net index.
+     * @returns The source connection.
+     */
+    connection get_source(u32 net_index) const;
+
+    /**
+     * Get all destinations of a net, i.e., pairs (gate index, input pin index).
+     *
+     * @param[in] net_index - The net index.
+     * @returns The destination connections.
+     */
+    range<connection> get_destinations(u32 net_index) const;
+
+    /**
+     * Get the indices of all direct successor gates of a gate.<br>
+     * A gate is listed once for every connection, i.e., the result equals gate::get_successors().
+     *
+     * @param[in] gate_index - The gate index.
+     * @returns The successor gate indices.
+     */
+    range<u32> get_successors(u32 gate_index) const;
+
+    /**
+     * Get the indices of all direct predecessor gates of a gate.<br>
+     * A gate is listed once for every connection, i.e., the result equals gate::get_predecessors().
+     *
+     * @param[in] gate_index - The gate index.
+     * @returns The predecessor gate indices.
+     */
+    range<u32> get_predecessors(u32 gate_index) const;
+
+private:
+    void clear();
+
+    std::shared_ptr<netlist> m_netlist;
+
+    /* name of the registered event callbacks */
+    std::string m_callback_name;
+
+    bool m_valid;
+
+    /* dense index <-> object mapping */
+    std::vector<std::shared_ptr<gate>> m_gates;
+    std::vector<std::shared_ptr<net>> m_nets;
+    std::unordered_map<u32, u32> m_gate_id_to_index;
+    std::unordered_map<u32, u32> m_net_id_to_index;
+
+    /* CSR arrays, the offset vectors have one more entry than there are rows */
+    std::vector<u32> m_fan_in_offsets;
+    std::vector<connection> m_fan_in;
+    std::vector<u32> m_fan_out_offsets;
+    std::vector<connection> m_fan_out;
+
+    std::vector<connection> m_sources;
+    std::vector<u32> m_dst_offsets;
+    std::vector<connection> m_dsts;
+
+    std::vector<u32> m_successor_offsets;
+    std::vector<u32> m_successors;
+    std::vector<u32> m_predecessor_offsets;
+    std::vector<u32> m_predecessors;
+};
@@ -25,6 +25,8 @@
 
 #include "def.h"
 
+#include <vector>
+
 // forward declaration
 class netlist;
 class gate;
@@ -45,10 +47,24 @@ class NETLIST_API netlist_internal_manager
 private:
     netlist* m_netlist;
 
+    // modules in pre-order of the module hierarchy, each module covers the range [m_preorder_first, m_preorder_last]
+    bool m_module_index_valid = false;
+    std::vector<module*> m_module_order;
+
+    // gates grouped by their module in pre-order, so that the gates of a module and all its submodules are contiguous
+    bool m_gate_order_valid = false;
+    std::vector<std::shared_ptr<gate>> m_gate_order;
+
+    // number of gates and modules visited by recursive queries that walked the hierarchy because the gate order was invalid
+    u64 m_gate_order_walk_cost = 0;
+
     explicit netlist_internal_manager(netlist* nl);
 
     ~netlist_internal_manager() = default;
 
+    // releases all references between gates, nets and modules, called when the netlist is destroyed
+    void clear_references();
+
     // gate functions
 
     std::shared_ptr<gate> create_gate(u32 id, const std::shared_ptr<const gate_type>& gt, const std::string& name, float x, float y);
@@ -73,4 +89,18 @@ private:
 
     bool module_assign_gate(const std::shared_ptr<module>& m, const std::shared_ptr<gate>& g);
     bool module_remove_gate(const std::shared_ptr<module>& m, const std::shared_ptr<gate>& g);
+
+    // cached module nets
+
+    void module_update_net_caches(const std::shared_ptr<gate>& g, const std::shared_ptr<net>& net, i32 dst_delta, i32 src_delta);
+    void module_update_net_caches(const std::shared_ptr<net>& net);
+    void module_move_gate_net_caches(const std::shared_ptr<gate>& g, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to);
+
+    // module hierarchy index
+
+    void invalidate_module_index();
+    void invalidate_gate_order();
+    void update_module_index();
+    void update_gate_order();
+    bool use_gate_order();
 };
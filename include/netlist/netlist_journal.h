@@ -0,0 +1,223 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "def.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class data_container;
+class gate;
+class net;
+class module;
+
+/**
+ * Journal of the modifications of a netlist that allows to undo and redo them.<br>
+ * While a journal is attached to a netlist, every modification of gates, nets, modules, and global markings is appended to a compact
+ * binary log that stores all information required to revert it, including names, locations, data, and custom boolean functions of removed objects.<br>
+ * Modifications are grouped by checkpoints: undo() reverts all modifications since the previous checkpoint and redo() reapplies them.
+ * Any new modification discards all undone groups.<br>
+ * The memory of the journal is bounded, the oldest groups are dropped once the limit is exceeded.
+ * This includes the group that is currently being recorded: if it exceeds the limit on its own, all of its modifications become irreversible.<br>
+ * Changes to the data of a data_container are not recorded.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API netlist_journal
+{
+    friend class netlist_internal_manager;
+    friend class netlist;
+    friend class gate;
+    friend class net;
+    friend class module;
+
+public:
+    /**
+     * Attaches a new journal to a netlist.<br>
+     * Only one journal can be attached to a netlist at a time.
+     *
+     * @param[in] nl - The netlist.
+     * @param[in] max_size - The maximum number of bytes of all recorded groups, including the open one.
+     */
+    explicit netlist_journal(const std::shared_ptr<netlist>& nl, u64 max_size = 64 * 1024 * 1024);
+
+    /**
+     * Detaches the journal from its netlist.
+     */
+    ~netlist_journal();
+
+    /**
+     * Checks whether the journal is attached to its netlist, i.e., whether it records modifications.
+     *
+     * @returns True if the journal is attached.
+     */
+    bool is_attached() const;
+
+    /**
+     * Closes the current group of modifications.<br>
+     * Does nothing if no modification was recorded since the last checkpoint.
+     */
+    void checkpoint();
+
+    /**
+     * Reverts all modifications of the last group.<br>
+     * An open group is closed first.
+     *
+     * @returns True on success.
+     */
+    bool undo();
+
+    /**
+     * Reapplies the modifications of the last undone group.
+     *
+     * @returns True on success.
+     */
+    bool redo();
+
+    /**
+     * Get the number of groups that can be undone, including the open group.
+     *
+     * @returns The number of undo steps.
+     */
+    u32 get_num_undo_steps() const;
+
+    /**
+     * Get the number of groups that can be redone.
+     *
+     * @returns The number of redo steps.
+     */
+    u32 get_num_redo_steps() const;
+
+    /**
+     * Get the number of bytes occupied by all recorded groups.
+     *
+     * @returns The size of the journal.
+     */
+    u64 get_size() const;
+
+    /**
+     * Discards all recorded modifications.
+     */
+    void clear();
+
+private:
+    netlist_journal(const netlist_journal&) = delete;               //disable copy-constructor
+    netlist_journal& operator=(const netlist_journal&) = delete;    //disable copy-assignment
+
+    enum class operation : u8
+    {
+        create_gate,
+        delete_gate,
+        create_net,
+        delete_net,
+        set_src,
+        remove_src,
+        add_dst,
+        remove_dst,
+        create_module,
+        delete_module,
+        move_gate,
+        set_parent_module,
+        rename_gate,
+        rename_net,
+        rename_module,
+        move_location,
+        mark_global_input,
+        unmark_global_input,
+        mark_global_output,
+        unmark_global_output,
+        mark_vcc_gate,
+        unmark_vcc_gate,
+        mark_gnd_gate,
+        unmark_gnd_gate
+    };
+
+    /** a decoded operation */
+    struct entry
+    {
+        operation op;
+        std::vector<u64> values;
+        std::vector<float> floats;
+        std::vector<std::string> strings;
+    };
+
+    std::shared_ptr<netlist> m_netlist;
+    bool m_attached = false;
+    bool m_replaying = false;
+
+    u64 m_max_size;
+    u64 m_size = 0;
+
+    std::deque<std::vector<u8>> m_undo_groups;
+    std::vector<std::vector<u8>> m_redo_groups;
+    std::vector<u8> m_current_group;
+    u64 m_entry_begin = 0;
+
+    // recording, called by the netlist, its objects, and the internal manager
+
+    bool is_recording() const;
+    void begin_entry(operation op);
+    void end_entry();
+    void write_value(u64 value);
+    void write_float(float value);
+    void write_string(const std::string& value);
+    void write_data(const data_container& c);
+
+    void record_create_gate(const std::shared_ptr<gate>& g);
+    void record_delete_gate(const std::shared_ptr<gate>& g);
+    void record_create_net(const std::shared_ptr<net>& n);
+    void record_delete_net(const std::shared_ptr<net>& n);
+    void record_connection(operation op, const std::shared_ptr<net>& n, const std::shared_ptr<gate>& g, u32 pin_id);
+    void record_create_module(const std::shared_ptr<module>& m);
+    void record_delete_module(const std::shared_ptr<module>& m);
+    void record_move_gate(const std::shared_ptr<gate>& g, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to);
+    void record_set_parent_module(const std::shared_ptr<module>& m, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to);
+    void record_rename(operation op, u32 id, const std::string& old_name, const std::string& new_name);
+    void record_move_location(u32 id, float old_x, float old_y, float new_x, float new_y);
+    void record_marking(operation op, u32 id);
+
+    // replaying
+
+    std::vector<entry> decode(const std::vector<u8>& group) const;
+    bool apply(const entry& e, bool revert);
+    bool restore_gate(const entry& e);
+    bool restore_net(const entry& e);
+    bool restore_module(const entry& e);
+    bool delete_gate(u32 id);
+    bool delete_net(u32 id);
+    bool delete_module(u32 id);
+    bool connect(operation op, const entry& e);
+    bool move_gate(u32 gate_id, u32 module_id);
+    bool set_parent_module(u32 module_id, u32 parent_id);
+    bool rename(operation op, u32 id, const std::string& name);
+    bool move_location(u32 id, float x, float y);
+    bool mark(operation op, u32 id);
+
+    void enforce_size_limit();
+};
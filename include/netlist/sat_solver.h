@@ -0,0 +1,183 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+
+#include <vector>
+
+/**
+ * Incremental CDCL SAT solver.<br>
+ * Literals use the same encoding as the and_inverter_graph: bit 0 marks a negated literal, the remaining bits are the
+ * variable, see get_literal. Clauses can be added between calls to solve, and every call can be given a set of
+ * assumptions that only hold for this call, so a single solver can answer many related queries.<br>
+ * The solver implements conflict-driven clause learning with two watched literals, first-UIP conflict analysis with
+ * clause minimization, VSIDS decisions with phase saving, Luby restarts and periodic removal of inactive learnt
+ * clauses.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API sat_solver
+{
+public:
+    /** Returned by operations that failed. */
+    static constexpr u32 INVALID = 0xFFFFFFFF;
+
+    /**
+     * Result of a call to solve.
+     */
+    enum class result
+    {
+        SATISFIABLE,
+        UNSATISFIABLE,
+        UNKNOWN
+    };
+
+    /**
+     * Constructs a solver without variables and clauses.
+     */
+    sat_solver();
+
+    /**
+     * Creates a new variable.
+     *
+     * @returns The index of the variable.
+     */
+    u32 create_variable();
+
+    /**
+     * Get the number of variables.
+     *
+     * @returns The number of variables.
+     */
+    u32 get_num_variables() const;
+
+    /**
+     * Get the number of clauses that were added and not learnt, excluding unit clauses.
+     *
+     * @returns The number of clauses.
+     */
+    u32 get_num_clauses() const;
+
+    /**
+     * Get the number of conflicts over all calls to solve.
+     *
+     * @returns The number of conflicts.
+     */
+    u64 get_num_conflicts() const;
+
+    /**
+     * Get the literal of a variable.
+     *
+     * @param[in] variable - The variable.
+     * @param[in] negated - True for the negative literal.
+     * @returns The literal.
+     */
+    static u32 get_literal(u32 variable, bool negated = false);
+
+    /**
+     * Adds a clause, i.e., a disjunction of literals.
+     *
+     * @param[in] literals - The literals of the clause.
+     * @returns False if the clause refers to unknown variables or if the clauses became unsatisfiable, true otherwise.
+     */
+    bool add_clause(const std::vector<u32>& literals);
+
+    /**
+     * Decides whether the clauses are satisfiable under the given assumptions.<br>
+     * If a conflict limit is given, the search is aborted with UNKNOWN once the limit is reached.
+     *
+     * @param[in] assumptions - Literals that are assumed to be true for this call.
+     * @param[in] conflict_limit - The maximum number of conflicts for this call, 0 for no limit.
+     * @returns The result of the search.
+     */
+    result solve(const std::vector<u32>& assumptions = {}, u64 conflict_limit = 0);
+
+    /**
+     * Get the value of a variable in the satisfying assignment found by the last call to solve.
+     *
+     * @param[in] variable - The variable.
+     * @returns The value of the variable, false if the last call was not satisfiable.
+     */
+    bool get_model_value(u32 variable) const;
+
+private:
+    struct clause_data
+    {
+        std::vector<u32> literals;
+        bool learnt;
+        double activity;
+    };
+
+    u8 get_value(u32 literal) const;
+    u32 get_decision_level() const;
+
+    void enqueue(u32 literal, u32 reason);
+    u32 propagate();
+    std::vector<u32> analyze(u32 conflict, u32& backtrack_level);
+    void backtrack(u32 level);
+    u32 pick_branch_literal();
+    result search(const std::vector<u32>& assumptions, u64 restart_limit, u64 conflict_limit, u64& num_conflicts);
+    u32 attach_clause(std::vector<u32>&& literals, bool learnt);
+    void reduce_learnt_clauses();
+
+    void bump_variable(u32 variable);
+    void bump_clause(u32 index);
+
+    // binary max-heap of unassigned variables, ordered by activity
+    void heap_insert(u32 variable);
+    u32 heap_pop();
+    void heap_sift_up(u32 position);
+    void heap_sift_down(u32 position);
+
+    bool m_ok = true;
+
+    std::vector<clause_data> m_clauses;
+    u32 m_num_learnt_clauses = 0;
+    u32 m_max_learnt_clauses = 0;
+
+    // per literal: the clauses that watch it
+    std::vector<std::vector<u32>> m_watches;
+
+    // per variable
+    std::vector<u8> m_values;
+    std::vector<u8> m_phases;
+    std::vector<u32> m_levels;
+    std::vector<u32> m_reasons;
+    std::vector<double> m_activities;
+    std::vector<u8> m_seen;
+    std::vector<u8> m_model;
+
+    std::vector<u32> m_trail;
+    std::vector<u32> m_trail_limits;
+    u32 m_propagation_head = 0;
+
+    std::vector<u32> m_heap;
+    std::vector<u32> m_heap_positions;
+
+    double m_variable_increment = 1.0;
+    double m_clause_increment   = 1.0;
+    u64 m_num_conflicts         = 0;
+};
@@ -0,0 +1,159 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+#include "netlist/simulation/simulation_model.h"
+
+#include <memory>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class net;
+
+/**
+ * Cycle-based simulator for gate-level netlists.<br>
+ * The netlist is compiled into a simulation_model once. Within a cycle, the levelized combinational logic is evaluated
+ * in a single pass per settling step instead of scheduling events, and flip-flops capture their next state
+ * simultaneously on rising edges of their clock function. Latches and asynchronous set/reset are evaluated while the
+ * logic settles. All values use the three-valued semantics of boolean_function::value, i.e., uninitialized states,
+ * unset inputs and unconnected pins are X.<br>
+ * A cycle consists of two phases: all registered clock nets are driven ZERO and the logic settles, then they are
+ * driven ONE and the logic settles again. Inputs set before a cycle are applied for both phases.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API cycle_simulator
+{
+public:
+    /**
+     * Constructs a simulator for a netlist and resets it.<br>
+     * The netlist must not be modified while the simulator is in use.
+     *
+     * @param[in] nl - The netlist.
+     */
+    explicit cycle_simulator(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Get the compiled model of the netlist.
+     *
+     * @returns The simulation model.
+     */
+    const simulation_model& get_model() const;
+
+    /**
+     * Registers an input net as a clock which is toggled in every cycle.<br>
+     * The clock is driven ZERO until the next cycle starts.
+     *
+     * @param[in] n - The clock net.
+     * @returns True on success.
+     */
+    bool add_clock_net(const std::shared_ptr<net>& n);
+
+    /**
+     * Get the registered clock nets.
+     *
+     * @returns The clock nets.
+     */
+    std::vector<std::shared_ptr<net>> get_clock_nets() const;
+
+    /**
+     * Sets the value of an input net, i.e., a global input net or a net without a source.<br>
+     * The value is applied from the next cycle on and kept until it is set again.
+     *
+     * @param[in] n - The input net.
+     * @param[in] value - The new value.
+     * @returns True on success.
+     */
+    bool set_input(const std::shared_ptr<net>& n, boolean_function::value value);
+
+    /**
+     * Get the current value of a net.
+     *
+     * @param[in] n - The net.
+     * @returns The value of the net or X if the net is not part of the netlist.
+     */
+    boolean_function::value get_value(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Resets the simulator.<br>
+     * All flip-flops and latches are set to their initial values, all inputs except for the clocks are set to X and
+     * the cycle counter is set to 0.
+     */
+    void reset();
+
+    /**
+     * Simulates a number of cycles with the current input values.
+     *
+     * @param[in] num_cycles - The number of cycles.
+     */
+    void simulate(u64 num_cycles = 1);
+
+    /**
+     * Simulates one cycle per stimulus vector.<br>
+     * Before every cycle, each input net is set to the value at its position in the stimulus vector of the cycle.
+     * After every cycle, the values of the observed nets are recorded.
+     *
+     * @param[in] input_nets - The input nets to drive.
+     * @param[in] stimulus - One vector of values per cycle, ordered like the input nets.
+     * @param[in] observed_nets - The nets to record.
+     * @returns One vector of values per simulated cycle, ordered like the observed nets. Empty on error.
+     */
+    std::vector<std::vector<boolean_function::value>> run(const std::vector<std::shared_ptr<net>>& input_nets,
+                                                          const std::vector<std::vector<boolean_function::value>>& stimulus,
+                                                          const std::vector<std::shared_ptr<net>>& observed_nets);
+
+    /**
+     * Get the number of cycles simulated since the last reset.
+     *
+     * @returns The cycle count.
+     */
+    u64 get_cycle() const;
+
+private:
+    simulation_model m_model;
+
+    std::vector<boolean_function::value> m_values;
+    std::vector<boolean_function::value> m_states;
+    std::vector<boolean_function::value> m_inverted_states;
+    std::vector<boolean_function::value> m_clock_values;
+    std::vector<bool> m_set_reset_active;
+    std::vector<boolean_function::value> m_inputs;
+    std::vector<u32> m_flip_flops;
+    std::vector<u32> m_asynchronous_elements;
+    std::vector<u32> m_clock_nets;
+    u64 m_cycle = 0;
+
+    void run_phase(boolean_function::value clock_value);
+    void settle();
+    bool evaluate_combinational_logic(bool force_x);
+    bool update_asynchronous(bool force_x);
+    bool clock_flip_flops();
+    void initialize_clock_values();
+    bool write_state(u32 element, boolean_function::value state, boolean_function::value inverted_state, bool force_x);
+    boolean_function::value evaluate(u32 function, u32 first_input);
+};
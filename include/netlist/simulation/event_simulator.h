@@ -0,0 +1,216 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+#include "netlist/simulation/simulation_model.h"
+#include "netlist/simulation/vcd_writer.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class net;
+
+/**
+ * Event-driven simulator for gate-level netlists with per-gate-type delays.<br>
+ * Only the combinational nodes and sequential elements reading a net that changed are evaluated, and their new outputs
+ * are scheduled after the delay of their gate type, so the work per time step is proportional to the activity of the
+ * netlist rather than its size. Flip-flops capture on rising edges of their clock function; latches and asynchronous
+ * set/reset follow the same three-valued semantics as the cycle_simulator.<br>
+ * Value changes can be streamed to a VCD file while simulating.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API event_simulator
+{
+public:
+    /**
+     * Constructs a simulator for a netlist at time 0.<br>
+     * All inputs are X, flip-flops and latches hold their initial values and all combinational nodes are scheduled to
+     * be evaluated once. The netlist must not be modified while the simulator is in use.
+     *
+     * @param[in] nl - The netlist.
+     */
+    explicit event_simulator(const std::shared_ptr<netlist>& nl);
+
+    ~event_simulator();
+
+    /**
+     * Get the compiled model of the netlist.
+     *
+     * @returns The simulation model.
+     */
+    const simulation_model& get_model() const;
+
+    /**
+     * Sets the delay of all gates of a gate type. The default delay is 1.
+     *
+     * @param[in] type_name - The name of the gate type.
+     * @param[in] delay - The delay, at least 1.
+     * @returns True on success.
+     */
+    bool set_gate_type_delay(const std::string& type_name, u32 delay);
+
+    /**
+     * Get the delay of a gate type.
+     *
+     * @param[in] type_name - The name of the gate type.
+     * @returns The delay.
+     */
+    u32 get_gate_type_delay(const std::string& type_name) const;
+
+    /**
+     * Drives an input net with a clock that is ZERO at the current time and toggles every half period.
+     *
+     * @param[in] n - The clock net.
+     * @param[in] half_period - The time between two edges, at least 1.
+     * @returns True on success.
+     */
+    bool add_clock(const std::shared_ptr<net>& n, u64 half_period);
+
+    /**
+     * Schedules a value change of an input net, i.e., a global input net or a net without a source.
+     *
+     * @param[in] n - The input net.
+     * @param[in] value - The new value.
+     * @param[in] time - The time of the change, not earlier than the current time.
+     * @returns True on success.
+     */
+    bool set_input(const std::shared_ptr<net>& n, boolean_function::value value, u64 time);
+
+    /**
+     * Processes all events up to and including the given time.
+     *
+     * @param[in] time - The time to simulate to.
+     */
+    void run_until(u64 time);
+
+    /**
+     * Processes all events within the given duration from the current time.
+     *
+     * @param[in] duration - The duration.
+     */
+    void run_for(u64 duration);
+
+    /**
+     * Get the current simulation time.
+     *
+     * @returns The time.
+     */
+    u64 get_time() const;
+
+    /**
+     * Get the current value of a net.
+     *
+     * @param[in] n - The net.
+     * @returns The value of the net or X if the net is not part of the netlist.
+     */
+    boolean_function::value get_value(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Get the number of net value changes processed so far.
+     *
+     * @returns The number of changes.
+     */
+    u64 get_num_changes() const;
+
+    /**
+     * Starts streaming value changes to a VCD file.<br>
+     * Nets are named by their name followed by their id. The current values are written as initial values.
+     *
+     * @param[in] file_path - The output file.
+     * @param[in] nets - The nets to record, all nets if empty.
+     * @param[in] timescale - The time unit of one simulation time step.
+     * @returns True on success.
+     */
+    bool start_vcd(const hal::path& file_path, const std::vector<std::shared_ptr<net>>& nets = {}, const std::string& timescale = "1ns");
+
+    /**
+     * Starts streaming value changes in VCD format to a stream.<br>
+     * Nets are named by their name followed by their id. The current values are written as initial values.
+     * The stream must remain valid until stop_vcd is called or the simulator is destroyed.
+     *
+     * @param[in] stream - The output stream.
+     * @param[in] nets - The nets to record, all nets if empty.
+     * @param[in] timescale - The time unit of one simulation time step.
+     * @returns True on success.
+     */
+    bool start_vcd(std::ostream& stream, const std::vector<std::shared_ptr<net>>& nets = {}, const std::string& timescale = "1ns");
+
+    /**
+     * Stops streaming value changes and closes the VCD file if one was opened.
+     */
+    void stop_vcd();
+
+private:
+    struct event
+    {
+        u32 net;
+        boolean_function::value value;
+    };
+
+    simulation_model m_model;
+
+    std::vector<boolean_function::value> m_values;
+    std::vector<boolean_function::value> m_projected_values;
+    std::vector<boolean_function::value> m_states;
+    std::vector<boolean_function::value> m_inverted_states;
+    std::vector<boolean_function::value> m_clock_values;
+    std::vector<bool> m_set_reset_active;
+    std::vector<boolean_function::value> m_inputs;
+
+    std::vector<u32> m_gate_delays;
+    std::unordered_map<std::string, u32> m_type_delays;
+    std::vector<u64> m_clock_half_periods;
+
+    std::map<u64, std::vector<event>> m_queue;
+    u64 m_time        = 0;
+    u64 m_num_changes = 0;
+
+    // marks of the readers already collected in the current time step
+    std::vector<u32> m_node_marks;
+    std::vector<u32> m_element_marks;
+    std::vector<u32> m_affected_nodes;
+    std::vector<u32> m_affected_elements;
+    u32 m_step          = 0;
+    bool m_evaluate_all = true;
+
+    std::unique_ptr<std::ofstream> m_vcd_file;
+    std::unique_ptr<vcd_writer> m_vcd;
+    std::vector<u32> m_vcd_signals;
+
+    void process_next_time_step();
+    void evaluate_node(u32 node);
+    void evaluate_element(u32 element);
+    void schedule(u32 net_index, boolean_function::value value, u64 time);
+    boolean_function::value evaluate(u32 function, u32 first_input);
+};
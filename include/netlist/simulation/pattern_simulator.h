@@ -0,0 +1,188 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+#include "netlist/compiled_boolean_function.h"
+#include "netlist/simulation/simulation_model.h"
+
+#include <memory>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class net;
+
+/**
+ * Bit-parallel simulator evaluating many independent input patterns of the combinational logic at once.<br>
+ * Every net carries 64 patterns per word in two-rail encoding (see compiled_boolean_function::value_slice), so X is
+ * preserved. The number of words, and therefore the number of patterns per pass, is chosen on construction.<br>
+ * The inputs of the simulation are the input nets of the simulation_model and the states of all flip-flops and
+ * latches, which are treated as free variables, i.e., the simulation covers the combinational logic between them.
+ * The state output nets of a sequential element carry its state and the inverted state output nets its complement.<br>
+ * The resulting per-net signatures can be used to cluster candidates for functionally equivalent nets before running
+ * more expensive checks.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API pattern_simulator
+{
+public:
+    /**
+     * Constructs a simulator for a netlist with all inputs set to X.<br>
+     * The netlist must not be modified while the simulator is in use.
+     *
+     * @param[in] nl - The netlist.
+     * @param[in] num_words - The number of 64-bit words per net, at least 1.
+     */
+    explicit pattern_simulator(const std::shared_ptr<netlist>& nl, u32 num_words = 1);
+
+    /**
+     * Get the compiled model of the netlist.
+     *
+     * @returns The simulation model.
+     */
+    const simulation_model& get_model() const;
+
+    /**
+     * Get the number of 64-bit words per net.
+     *
+     * @returns The number of words.
+     */
+    u32 get_num_words() const;
+
+    /**
+     * Get the number of patterns simulated per pass, i.e., 64 times the number of words.
+     *
+     * @returns The number of patterns.
+     */
+    u32 get_num_patterns() const;
+
+    /**
+     * Get the nets whose values are inputs of the simulation, i.e., all input nets of the model followed by one
+     * output net per flip-flop or latch that has one.
+     *
+     * @returns The input nets.
+     */
+    std::vector<std::shared_ptr<net>> get_input_nets() const;
+
+    /**
+     * Sets an input to the same value in all patterns.<br>
+     * Setting a state or inverted state output net of a sequential element sets the state of the element.
+     *
+     * @param[in] n - The input net.
+     * @param[in] value - The value.
+     * @returns True on success.
+     */
+    bool set_input(const std::shared_ptr<net>& n, boolean_function::value value);
+
+    /**
+     * Sets an input to individual values per pattern in two-rail encoding.<br>
+     * Pattern i is ONE if bit (i % 64) of word (i / 64) is set in ones only, ZERO if it is set in zeros only and X
+     * otherwise. Setting a state or inverted state output net of a sequential element sets the state of the element.
+     *
+     * @param[in] n - The input net.
+     * @param[in] ones - One word per get_num_words() marking the ONE patterns.
+     * @param[in] zeros - One word per get_num_words() marking the ZERO patterns.
+     * @returns True on success.
+     */
+    bool set_input(const std::shared_ptr<net>& n, const std::vector<u64>& ones, const std::vector<u64>& zeros);
+
+    /**
+     * Sets all inputs to uniformly random ZERO or ONE values in every pattern.
+     *
+     * @param[in] seed - The seed of the random patterns.
+     */
+    void randomize_inputs(u64 seed);
+
+    /**
+     * Enumerates assignments of the given inputs.<br>
+     * In pattern i, the j-th input is set to bit j of (first_assignment + i), so consecutive passes with
+     * first_assignment advanced by get_num_patterns() exhaustively cover all assignments. All other inputs are kept.
+     *
+     * @param[in] nets - The input nets to enumerate.
+     * @param[in] first_assignment - The assignment of the first pattern.
+     * @returns True on success.
+     */
+    bool set_exhaustive_inputs(const std::vector<std::shared_ptr<net>>& nets, u64 first_assignment = 0);
+
+    /**
+     * Propagates the current inputs through the combinational logic.<br>
+     * Patterns that do not stabilize on combinational loops are set to X.
+     */
+    void simulate();
+
+    /**
+     * Get the value of a net in a single pattern.
+     *
+     * @param[in] n - The net.
+     * @param[in] pattern - The pattern index.
+     * @returns The value or X if the net is not part of the netlist or the pattern index is out of range.
+     */
+    boolean_function::value get_value(const std::shared_ptr<net>& n, u32 pattern) const;
+
+    /**
+     * Get the signature of a net, i.e., the patterns in which it is ONE.
+     *
+     * @param[in] n - The net.
+     * @returns One word per get_num_words() or an empty vector if the net is not part of the netlist.
+     */
+    std::vector<u64> get_signature(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Get the patterns in which a net is X.
+     *
+     * @param[in] n - The net.
+     * @returns One word per get_num_words() or an empty vector if the net is not part of the netlist.
+     */
+    std::vector<u64> get_x_mask(const std::shared_ptr<net>& n) const;
+
+    /**
+     * Groups nets that carry identical values in all patterns, including X.<br>
+     * Only groups of at least two nets are returned. Nets within a group and the groups are ordered by net id.
+     *
+     * @returns The groups of nets.
+     */
+    std::vector<std::vector<std::shared_ptr<net>>> get_signature_classes() const;
+
+private:
+    using value_slice = compiled_boolean_function::value_slice;
+
+    simulation_model m_model;
+    u32 m_num_words;
+
+    // values[net * num_words + word], the constant X is the last entry
+    std::vector<value_slice> m_values;
+    std::vector<value_slice> m_inputs;
+
+    // per net the sequential element whose state or inverted state it carries
+    std::vector<u32> m_element_of_net;
+    std::vector<bool> m_is_inverted_output;
+
+    u32 get_input_index(const std::shared_ptr<net>& n) const;
+    void write_input(u32 net_index, u32 word, value_slice value);
+    bool evaluate_node(const simulation_model::combinational_node& node, bool force_x);
+};
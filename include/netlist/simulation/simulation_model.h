@@ -0,0 +1,295 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+#include "netlist/compiled_boolean_function.h"
+#include "netlist/gate_library/gate_type/gate_type_sequential.h"
+#include "netlist/netlist_graph_view.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* forward declaration */
+class netlist;
+class net;
+
+/**
+ * Compiled representation of a netlist for simulation.<br>
+ * All nets are referred to by their dense index in the netlist_graph_view of the model. Every output pin of a
+ * combinational or LUT gate that has a boolean function becomes a combinational node, every flip-flop and latch becomes
+ * a sequential element. The boolean functions are compiled once per distinct function and shared by all gates using
+ * them.<br>
+ * The combinational nodes are levelized, i.e., ordered such that every node comes after all nodes driving its inputs,
+ * so a single pass over them propagates new input and state values through the whole combinational logic.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API simulation_model
+{
+public:
+    /** marks a missing function */
+    static constexpr u32 INVALID = 0xFFFFFFFF;
+
+    /**
+     * A gate output pin computed from the values of the input pins of its gate.
+     */
+    struct combinational_node
+    {
+        /** index of the compiled function */
+        u32 function;
+
+        /** position of the first input in get_input_indices(), the inputs are ordered by slot of the function */
+        u32 first_input;
+
+        /** index of the net written by the node */
+        u32 output;
+
+        /** index of the gate in the graph view */
+        u32 gate;
+    };
+
+    /**
+     * A flip-flop or latch.<br>
+     * The functions refer to the input pins of the gate, which are listed in get_input_indices() from first_input on.
+     */
+    struct sequential_element
+    {
+        /** index of the gate in the graph view */
+        u32 gate;
+
+        /** true for latches, false for flip-flops */
+        bool is_latch;
+
+        /** index of the next_state function of a flip-flop or the data_in function of a latch */
+        u32 next_state;
+
+        /** index of the clock function of a flip-flop or the enable function of a latch */
+        u32 clock;
+
+        /** index of the asynchronous set function */
+        u32 set;
+
+        /** index of the asynchronous reset function */
+        u32 reset;
+
+        /** position of the first input in get_input_indices(), one entry per input pin of the gate type */
+        u32 first_input;
+
+        /** behavior of the state and the inverted state if set and reset are active at the same time */
+        gate_type_sequential::set_reset_behavior state_behavior;
+        gate_type_sequential::set_reset_behavior inverted_state_behavior;
+
+        /** the state after initialization, taken from the init data of the gate */
+        boolean_function::value initial_value;
+
+        /** indices of the nets driven by the state and the inverted state respectively */
+        std::vector<u32> state_outputs;
+        std::vector<u32> inverted_state_outputs;
+    };
+
+    /**
+     * Compiles a netlist.<br>
+     * The netlist must not be modified while the model is in use.
+     *
+     * @param[in] nl - The netlist.
+     */
+    explicit simulation_model(const std::shared_ptr<netlist>& nl);
+
+    /**
+     * Get the connectivity snapshot that defines the net and gate indices.
+     *
+     * @returns The graph view.
+     */
+    const netlist_graph_view& get_graph_view() const;
+
+    /**
+     * Get the number of values a simulator has to store, i.e., one per net plus the constant X.
+     *
+     * @returns The number of values.
+     */
+    u32 get_num_values() const;
+
+    /**
+     * Get the index of the value that is constantly X.<br>
+     * Unconnected input pins refer to this value.
+     *
+     * @returns The index of the constant X.
+     */
+    u32 get_constant_x_index() const;
+
+    /**
+     * Get the nets whose values are not computed by the model, i.e., global input nets and nets without a source,
+     * ordered by index.
+     *
+     * @returns The net indices of the inputs.
+     */
+    const std::vector<u32>& get_input_nets() const;
+
+    /**
+     * Checks whether a net is an input of the model.
+     *
+     * @param[in] net_index - The net index.
+     * @returns True if the net is an input.
+     */
+    bool is_input_net(u32 net_index) const;
+
+    /**
+     * Get the combinational nodes in topological order.<br>
+     * Nodes on combinational loops cannot be ordered and are appended in the order of their gates.
+     *
+     * @returns The combinational nodes.
+     */
+    const std::vector<combinational_node>& get_combinational_nodes() const;
+
+    /**
+     * Get the number of combinational nodes that are part of or depend on a combinational loop.
+     *
+     * @returns The number of nodes that could not be ordered.
+     */
+    u32 get_num_unordered_nodes() const;
+
+    /**
+     * Get the flip-flops and latches.
+     *
+     * @returns The sequential elements.
+     */
+    const std::vector<sequential_element>& get_sequential_elements() const;
+
+    /**
+     * Get the value indices read by the combinational nodes and sequential elements.
+     *
+     * @returns The input indices.
+     */
+    const std::vector<u32>& get_input_indices() const;
+
+    /**
+     * Get a compiled function.
+     *
+     * @param[in] index - The function index.
+     * @returns The compiled function.
+     */
+    const compiled_boolean_function& get_function(u32 index) const;
+
+    /**
+     * Get the number of distinct compiled functions.
+     *
+     * @returns The number of functions.
+     */
+    u32 get_num_functions() const;
+
+    /**
+     * Get the maximum number of inputs of any combinational node or sequential element.<br>
+     * Simulators may use this to size the buffer the inputs of a function are gathered in.
+     *
+     * @returns The maximum number of inputs.
+     */
+    u32 get_max_num_inputs() const;
+
+    /**
+     * Get the combinational nodes that read a net.
+     *
+     * @param[in] net_index - The net index.
+     * @returns The indices of the reading nodes within get_combinational_nodes().
+     */
+    netlist_graph_view::range<u32> get_node_readers(u32 net_index) const;
+
+    /**
+     * Get the sequential elements that read a net.
+     *
+     * @param[in] net_index - The net index.
+     * @returns The indices of the reading elements within get_sequential_elements().
+     */
+    netlist_graph_view::range<u32> get_element_readers(u32 net_index) const;
+
+    /**
+     * Applies the asynchronous set and reset of a sequential element to its state.<br>
+     * If set or reset is X, the result is the common result of both possible values or X if they differ.<br>
+     * A toggling behavior inverts the state once when set and reset become active together. While both stay active,
+     * the simulators neither clock nor enable the element, so the toggled state is kept.
+     *
+     * @param[in] element - The sequential element.
+     * @param[in] set - The value of the set function, ZERO if the element has none.
+     * @param[in] reset - The value of the reset function, ZERO if the element has none.
+     * @param[in] state - The current state.
+     * @param[in] inverted_state - The current inverted state.
+     * @param[in] both_were_active - True if set and reset were both ONE at the previous application.
+     * @returns The new state and inverted state.
+     */
+    static std::pair<boolean_function::value, boolean_function::value> apply_set_reset(const sequential_element& element,
+                                                                                       boolean_function::value set,
+                                                                                       boolean_function::value reset,
+                                                                                       boolean_function::value state,
+                                                                                       boolean_function::value inverted_state,
+                                                                                       bool both_were_active = false);
+
+    /**
+     * Inverts a value, X stays X.
+     *
+     * @param[in] v - The value.
+     * @returns The inverted value.
+     */
+    static boolean_function::value invert(boolean_function::value v);
+
+    /**
+     * Merges two possible values of a signal.
+     *
+     * @param[in] a - The first value.
+     * @param[in] b - The second value.
+     * @returns The common value or X if they differ.
+     */
+    static boolean_function::value merge(boolean_function::value a, boolean_function::value b);
+
+    /**
+     * Advances a xorshift64 pseudo-random number generator, used to draw reproducible random stimuli.
+     *
+     * @param[in,out] state - The state of the generator, must not be zero.
+     * @returns The next pseudo-random word.
+     */
+    static u64 next_random(u64& state);
+
+private:
+    netlist_graph_view m_view;
+
+    std::vector<compiled_boolean_function> m_functions;
+    std::vector<combinational_node> m_nodes;
+    std::vector<sequential_element> m_elements;
+    std::vector<u32> m_input_indices;
+    std::vector<u32> m_input_nets;
+    std::vector<bool> m_is_input_net;
+    u32 m_num_unordered_nodes = 0;
+    u32 m_max_num_inputs      = 0;
+
+    // readers of every net in CSR form
+    std::vector<u32> m_node_reader_offsets;
+    std::vector<u32> m_node_readers;
+    std::vector<u32> m_element_reader_offsets;
+    std::vector<u32> m_element_readers;
+
+    void levelize();
+    void collect_readers();
+};
@@ -0,0 +1,111 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr-University Bochum, Germany, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "def.h"
+#include "netlist/boolean_function.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Incremental writer for value change dump (VCD) files of single-bit signals.<br>
+ * Signals are declared before the header is written. Afterwards, value changes are written to the stream as they are
+ * reported, so waveforms of arbitrarily long runs never have to be kept in memory.
+ *
+ * @ingroup netlist
+ */
+class NETLIST_API vcd_writer
+{
+public:
+    /** marks an invalid signal */
+    static constexpr u32 INVALID = 0xFFFFFFFF;
+
+    /**
+     * Constructs a writer on a stream.<br>
+     * The stream must outlive the writer.
+     *
+     * @param[in] stream - The output stream.
+     */
+    explicit vcd_writer(std::ostream& stream);
+
+    /**
+     * Declares a signal.<br>
+     * Whitespace in the reference is replaced by underscores.
+     *
+     * @param[in] reference - The name of the signal in the waveform.
+     * @returns The index of the signal or INVALID if the header was already written.
+     */
+    u32 add_signal(const std::string& reference);
+
+    /**
+     * Get the number of declared signals.
+     *
+     * @returns The number of signals.
+     */
+    u32 get_num_signals() const;
+
+    /**
+     * Writes the header including the declarations of all signals and their initial values.
+     *
+     * @param[in] scope - The name of the module scope containing the signals.
+     * @param[in] timescale - The time unit, e.g., "1ns".
+     * @param[in] time - The time of the initial values.
+     * @param[in] initial_values - The initial value of every signal.
+     * @returns True on success.
+     */
+    bool write_header(const std::string& scope, const std::string& timescale, u64 time, const std::vector<boolean_function::value>& initial_values);
+
+    /**
+     * Writes a value change.<br>
+     * Changes must be reported in non-decreasing order of time.
+     *
+     * @param[in] time - The time of the change.
+     * @param[in] signal - The index of the signal.
+     * @param[in] value - The new value.
+     */
+    void write_change(u64 time, u32 signal, boolean_function::value value);
+
+    /**
+     * Flushes the underlying stream.
+     */
+    void flush();
+
+    /**
+     * Get the short identifier code of a signal as used in the value changes.
+     *
+     * @param[in] signal - The index of the signal.
+     * @returns The identifier code.
+     */
+    static std::string get_identifier(u32 signal);
+
+private:
+    std::ostream& m_stream;
+    std::vector<std::string> m_references;
+    std::vector<std::string> m_identifiers;
+    bool m_header_written = false;
+    u64 m_time            = 0;
+};
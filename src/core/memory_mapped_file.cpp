@@ -0,0 +1,110 @@
+#include "core/memory_mapped_file.h"
+
+#include "core/log.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+memory_mapped_file::~memory_mapped_file()
+{
+    close();
+}
+
+bool memory_mapped_file::open(const hal::path& file_name)
+{
+    close();
+
+#ifdef _WIN32
+    std::ifstream ifs(file_name.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+    {
+        log_error("core", "cannot open '{}'", file_name.string());
+        return false;
+    }
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    m_buffer = ss.str();
+    m_data   = m_buffer.data();
+    m_size   = m_buffer.size();
+#else
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        log_error("core", "cannot open '{}'", file_name.string());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        log_error("core", "cannot map '{}' since it is not a regular file", file_name.string());
+        ::close(fd);
+        return false;
+    }
+
+    // mmap rejects empty mappings, an empty file is simply an empty view
+    if (info.st_size > 0)
+    {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            log_error("core", "cannot map '{}' into memory", file_name.string());
+            ::close(fd);
+            return false;
+        }
+        // the file is read front to back exactly once by the tokenizers
+        madvise(address, info.st_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(address);
+        m_size = info.st_size;
+    }
+
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+#endif
+
+    m_is_open = true;
+    return true;
+}
+
+void memory_mapped_file::close()
+{
+#ifdef _WIN32
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+#else
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data    = nullptr;
+    m_size    = 0;
+    m_is_open = false;
+}
+
+bool memory_mapped_file::is_open() const
+{
+    return m_is_open;
+}
+
+const char* memory_mapped_file::data() const
+{
+    return m_data;
+}
+
+u64 memory_mapped_file::size() const
+{
+    return m_size;
+}
+
+std::string_view memory_mapped_file::view() const
+{
+    return std::string_view(m_data, m_size);
+}
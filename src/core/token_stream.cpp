@@ -1,7 +1,7 @@
 #include "core/token_stream.h"
 #include "core/utils.h"
 
-token::token(u32 n, const std::string s, bool cs) : number(n), string(s), case_sensitive(cs)
+token::token(u32 n, std::string s, bool cs) : string(std::move(s)), number(n), case_sensitive(cs)
 {
 }
 
@@ -60,6 +60,12 @@ token_stream::token_stream(const std::vector<token>& init, const std::vector<std
     m_data = init;
 }
 
+token_stream::token_stream(std::vector<token>&& init, const std::vector<std::string>& increase_level_tokens, const std::vector<std::string>& decrease_level_tokens)
+    : token_stream(increase_level_tokens, decrease_level_tokens)
+{
+    m_data = std::move(init);
+}
+
 token& token_stream::at(u32 position)
 {
     if (position > m_data.size())
@@ -131,6 +131,31 @@ void graph_context_manager::handle_module_gate_removed(const std::shared_ptr<mod
     }
 }
 
+void graph_context_manager::handle_module_content_changed(const std::shared_ptr<module> m,
+                                                          const QSet<u32>& added_modules,
+                                                          const QSet<u32>& removed_modules,
+                                                          const QSet<u32>& assigned_gates,
+                                                          const QSet<u32>& removed_gates)
+{
+    // applies all content changes of a committed batch at once, a context is updated if it showed the module before the batch
+    for (graph_context* context : m_graph_contexts)
+    {
+        if (context->is_showing_module(m->get_id(), added_modules, assigned_gates, removed_modules, removed_gates))
+        {
+            context->remove(removed_modules, removed_gates);
+            context->add(added_modules, assigned_gates);
+            if (context->empty())
+            {
+                delete_graph_context(context);
+            }
+        }
+        // if a module is unfolded, then the gate is not deleted from the view
+        // but the color of the gate changes to its new parent's color
+        else if (context->gates().intersects(removed_gates))
+            context->schedule_scene_update();
+    }
+}
+
 void graph_context_manager::handle_gate_name_changed(const std::shared_ptr<gate> g) const
 {
     for (graph_context* context : m_graph_contexts)
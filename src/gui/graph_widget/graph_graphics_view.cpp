@@ -6,6 +6,8 @@
 #include "netlist/module.h"
 #include "netlist/net.h"
 
+#include "netlist/event_system/event_controls.h"
+
 #include "gui/graph_widget/contexts/graph_context.h"
 #include "gui/graph_widget/graph_widget.h"
 #include "gui/graph_widget/graph_widget_constants.h"
@@ -104,13 +106,16 @@ void graph_graphics_view::handle_move_action(QAction* action)
 {
     const u32 mod_id          = action->data().toInt();
     std::shared_ptr<module> m = g_netlist->get_module_by_id(mod_id);
-    for (const auto& id : g_selection_relay.m_selected_gates)
-    {
-        m->assign_gate(g_netlist->get_gate_by_id(id));
-    }
-    for (const auto& id : g_selection_relay.m_selected_modules)
     {
-        g_netlist->get_module_by_id(id)->set_parent_module(m);
+        event_controls::scoped_batch batch(g_netlist);
+        for (const auto& id : g_selection_relay.m_selected_gates)
+        {
+            m->assign_gate(g_netlist->get_gate_by_id(id));
+        }
+        for (const auto& id : g_selection_relay.m_selected_modules)
+        {
+            g_netlist->get_module_by_id(id)->set_parent_module(m);
+        }
     }
 
     auto gates   = g_selection_relay.m_selected_gates;
@@ -137,15 +142,17 @@ void graph_graphics_view::handle_move_new_action()
     QString name = QInputDialog::getText(nullptr, "", "New module will be created under \"" + parent_name + "\"\nModule Name:", QLineEdit::Normal, "", &ok);
     if (!ok || name.isEmpty())
         return;
-    std::shared_ptr<module> m = g_netlist->create_module(g_netlist->get_unique_module_id(), name.toStdString(), parent);
-
-    for (const auto& id : g_selection_relay.m_selected_gates)
-    {
-        m->assign_gate(g_netlist->get_gate_by_id(id));
-    }
-    for (const auto& id : g_selection_relay.m_selected_modules)
     {
-        g_netlist->get_module_by_id(id)->set_parent_module(m);
+        event_controls::scoped_batch batch(g_netlist);
+        std::shared_ptr<module> m = g_netlist->create_module(g_netlist->get_unique_module_id(), name.toStdString(), parent);
+        for (const auto& id : g_selection_relay.m_selected_gates)
+        {
+            m->assign_gate(g_netlist->get_gate_by_id(id));
+        }
+        for (const auto& id : g_selection_relay.m_selected_modules)
+        {
+            g_netlist->get_module_by_id(id)->set_parent_module(m);
+        }
     }
 
     auto gates   = g_selection_relay.m_selected_gates;
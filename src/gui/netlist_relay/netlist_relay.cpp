@@ -29,6 +29,7 @@ netlist_relay::~netlist_relay()
     net_event_handler::unregister_callback("relay");
     gate_event_handler::unregister_callback("relay");
     module_event_handler::unregister_callback("relay");
+    event_controls::unregister_batch_callback("relay");
 }
 
 void netlist_relay::register_callbacks()
@@ -48,6 +49,8 @@ void netlist_relay::register_callbacks()
     module_event_handler::register_callback("relay",
                                             std::function<void(module_event_handler::event, std::shared_ptr<module>, u32)>(
                                                 std::bind(&netlist_relay::relay_module_event, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)));
+
+    event_controls::register_batch_callback("relay", std::bind(&netlist_relay::relay_batch_committed, this, std::placeholders::_1));
 }
 
 QColor netlist_relay::get_module_color(const u32 id)
@@ -105,6 +108,7 @@ void netlist_relay::debug_add_selection_to_module(const u32 id)
 
     assert(m);
 
+    event_controls::scoped_batch batch(g_netlist);
     for (auto sel_id : g_selection_relay.m_selected_gates)
     {
         std::shared_ptr<gate> g = g_netlist->get_gate_by_id(sel_id);
@@ -137,6 +141,8 @@ void netlist_relay::debug_delete_module(const u32 id)
     std::shared_ptr<module> m = g_netlist->get_module_by_id(id);
     assert(m);
 
+    // all gates and submodules of the module are moved to its parent
+    event_controls::scoped_batch batch(g_netlist);
     g_netlist->delete_module(m);
 }
 
@@ -286,7 +292,10 @@ void netlist_relay::relay_module_event(module_event_handler::event ev, std::shar
 
             m_module_model->add_module(associated_data, object->get_id());
 
-            g_graph_context_manager.handle_module_submodule_added(object, associated_data);
+            if (event_controls::is_committing_batch())
+                m_batch_module_changes[object->get_id()].added_modules.insert(associated_data);
+            else
+                g_graph_context_manager.handle_module_submodule_added(object, associated_data);
 
             Q_EMIT module_submodule_added(object, associated_data);
             break;
@@ -297,7 +306,10 @@ void netlist_relay::relay_module_event(module_event_handler::event ev, std::shar
 
             m_module_model->remove_module(associated_data);
 
-            g_graph_context_manager.handle_module_submodule_removed(object, associated_data);
+            if (event_controls::is_committing_batch())
+                m_batch_module_changes[object->get_id()].removed_modules.insert(associated_data);
+            else
+                g_graph_context_manager.handle_module_submodule_removed(object, associated_data);
 
             Q_EMIT module_submodule_removed(object, associated_data);
             break;
@@ -306,7 +318,10 @@ void netlist_relay::relay_module_event(module_event_handler::event ev, std::shar
         {
             //< associated_data = id of inserted gate
 
-            g_graph_context_manager.handle_module_gate_assigned(object, associated_data);
+            if (event_controls::is_committing_batch())
+                m_batch_module_changes[object->get_id()].assigned_gates.insert(associated_data);
+            else
+                g_graph_context_manager.handle_module_gate_assigned(object, associated_data);
 
             Q_EMIT module_gate_assigned(object, associated_data);
             break;
@@ -315,7 +330,10 @@ void netlist_relay::relay_module_event(module_event_handler::event ev, std::shar
         {
             //< associated_data = id of removed gate
 
-            g_graph_context_manager.handle_module_gate_removed(object, associated_data);
+            if (event_controls::is_committing_batch())
+                m_batch_module_changes[object->get_id()].removed_gates.insert(associated_data);
+            else
+                g_graph_context_manager.handle_module_gate_removed(object, associated_data);
 
             Q_EMIT module_gate_removed(object, associated_data);
             break;
@@ -323,6 +341,31 @@ void netlist_relay::relay_module_event(module_event_handler::event ev, std::shar
     }
 }
 
+void netlist_relay::relay_batch_committed(const event_controls::change_set& changes)
+{
+    if (changes.batch_netlist != g_netlist)
+    {
+        m_batch_module_changes.clear();
+        return;
+    }
+
+    for (auto it = m_batch_module_changes.constBegin(); it != m_batch_module_changes.constEnd(); ++it)
+    {
+        std::shared_ptr<module> m = g_netlist->get_module_by_id(it.key());
+        if (!m)
+            continue;
+
+        // deleted submodules have already been removed from the contexts by handle_module_removed
+        QSet<u32> removed_modules;
+        for (u32 id : it.value().removed_modules)
+            if (g_netlist->get_module_by_id(id))
+                removed_modules.insert(id);
+
+        g_graph_context_manager.handle_module_content_changed(m, it.value().added_modules, removed_modules, it.value().assigned_gates, it.value().removed_gates);
+    }
+    m_batch_module_changes.clear();
+}
+
 void netlist_relay::relay_gate_event(gate_event_handler::event ev, std::shared_ptr<gate> object, u32 associated_data)
 {
     UNUSED(associated_data);
@@ -0,0 +1,480 @@
+#include "netlist/and_inverter_graph.h"
+
+#include "core/log.h"
+#include "netlist/gate.h"
+#include "netlist/gate_library/gate_type/gate_type.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
+
+#include <algorithm>
+
+and_inverter_graph::and_inverter_graph()
+{
+    m_nodes.push_back({INVALID, INVALID});
+    m_fan_out_counts.push_back(0);
+}
+
+u32 and_inverter_graph::get_num_nodes() const
+{
+    return m_nodes.size();
+}
+
+u32 and_inverter_graph::get_num_ands() const
+{
+    return m_nodes.size() - m_inputs.size() - 1;
+}
+
+u32 and_inverter_graph::create_input(const std::string& name)
+{
+    u32 literal = m_nodes.size() << 1;
+    m_nodes.push_back({INVALID, INVALID});
+    m_fan_out_counts.push_back(0);
+    m_inputs.push_back(literal);
+    m_input_names.emplace(literal >> 1, name);
+    return literal;
+}
+
+const std::vector<u32>& and_inverter_graph::get_inputs() const
+{
+    return m_inputs;
+}
+
+std::string and_inverter_graph::get_input_name(u32 literal) const
+{
+    if (auto it = m_input_names.find(literal >> 1); it != m_input_names.end())
+    {
+        return it->second;
+    }
+    return "";
+}
+
+bool and_inverter_graph::is_input(u32 literal) const
+{
+    return m_input_names.find(literal >> 1) != m_input_names.end();
+}
+
+bool and_inverter_graph::is_and(u32 literal) const
+{
+    return literal != INVALID && (literal >> 1) < m_nodes.size() && m_nodes[literal >> 1].fan_in_0 != INVALID;
+}
+
+std::pair<u32, u32> and_inverter_graph::get_fan_in(u32 literal) const
+{
+    if (!is_and(literal))
+    {
+        return {INVALID, INVALID};
+    }
+    const auto& n = m_nodes[literal >> 1];
+    return {n.fan_in_0, n.fan_in_1};
+}
+
+u32 and_inverter_graph::get_fan_out_count(u32 literal) const
+{
+    if (literal == INVALID || (literal >> 1) >= m_nodes.size())
+    {
+        return 0;
+    }
+    return m_fan_out_counts[literal >> 1];
+}
+
+u32 and_inverter_graph::create_not(u32 a)
+{
+    return (a == INVALID) ? INVALID : (a ^ 1);
+}
+
+u32 and_inverter_graph::create_and(u32 a, u32 b)
+{
+    if (a == INVALID || b == INVALID || (a >> 1) >= m_nodes.size() || (b >> 1) >= m_nodes.size())
+    {
+        return INVALID;
+    }
+
+    if (a > b)
+    {
+        std::swap(a, b);
+    }
+
+    // constant propagation and trivial cases
+    if (a == ZERO || a == (b ^ 1))
+    {
+        return ZERO;
+    }
+    if (a == ONE || a == b)
+    {
+        return b;
+    }
+
+    u64 key = ((u64)a << 32) | b;
+    if (auto it = m_structural_hash.find(key); it != m_structural_hash.end())
+    {
+        return it->second;
+    }
+
+    u32 literal = m_nodes.size() << 1;
+    m_nodes.push_back({a, b});
+    m_fan_out_counts.push_back(0);
+    m_fan_out_counts[a >> 1]++;
+    m_fan_out_counts[b >> 1]++;
+    m_structural_hash.emplace(key, literal);
+    return literal;
+}
+
+u32 and_inverter_graph::create_or(u32 a, u32 b)
+{
+    return create_not(create_and(create_not(a), create_not(b)));
+}
+
+u32 and_inverter_graph::create_xor(u32 a, u32 b)
+{
+    return create_or(create_and(a, create_not(b)), create_and(create_not(a), b));
+}
+
+u32 and_inverter_graph::create_mux(u32 s, u32 t, u32 e)
+{
+    return create_or(create_and(s, t), create_and(create_not(s), e));
+}
+
+void and_inverter_graph::add_output(u32 literal)
+{
+    if (literal == INVALID || (literal >> 1) >= m_nodes.size())
+    {
+        log_error("netlist", "cannot add invalid literal {} as output.", literal);
+        return;
+    }
+    m_outputs.push_back(literal);
+    m_fan_out_counts[literal >> 1]++;
+}
+
+const std::vector<u32>& and_inverter_graph::get_outputs() const
+{
+    return m_outputs;
+}
+
+u32 and_inverter_graph::from_boolean_function(const boolean_function& function, const std::unordered_map<std::string, u32>& variable_literals)
+{
+    std::unordered_map<const boolean_function::node*, u32> cache;
+    return from_boolean_function(function, variable_literals, cache);
+}
+
+u32 and_inverter_graph::from_boolean_function(const boolean_function& function,
+                                              const std::unordered_map<std::string, u32>& variable_literals,
+                                              std::unordered_map<const boolean_function::node*, u32>& cache)
+{
+    const auto& n = *function.m_node;
+    u32 result    = INVALID;
+    if (n.content == boolean_function::content_type::VARIABLE)
+    {
+        if (auto it = variable_literals.find(n.variable); it != variable_literals.end())
+        {
+            result = it->second;
+        }
+    }
+    else if (n.content == boolean_function::content_type::CONSTANT)
+    {
+        if (n.constant == boolean_function::ZERO)
+        {
+            result = ZERO;
+        }
+        else if (n.constant == boolean_function::ONE)
+        {
+            result = ONE;
+        }
+    }
+    else if (!n.operands.empty())
+    {
+        // shared subfunctions are converted only once
+        if (auto it = cache.find(&n); it != cache.end())
+        {
+            return it->second;
+        }
+
+        result = from_boolean_function(n.operands[0], variable_literals, cache);
+        for (u32 i = 1; i < n.operands.size() && result != INVALID; ++i)
+        {
+            u32 next = from_boolean_function(n.operands[i], variable_literals, cache);
+            if (n.op == boolean_function::operation::AND)
+            {
+                result = create_and(result, next);
+            }
+            else if (n.op == boolean_function::operation::OR)
+            {
+                result = create_or(result, next);
+            }
+            else
+            {
+                result = create_xor(result, next);
+            }
+        }
+        if (n.invert)
+        {
+            result = create_not(result);
+        }
+        cache.emplace(&n, result);
+        return result;
+    }
+
+    if (n.invert)
+    {
+        result = create_not(result);
+    }
+    return result;
+}
+
+boolean_function and_inverter_graph::to_boolean_function(u32 literal) const
+{
+    if (literal == INVALID || (literal >> 1) >= m_nodes.size())
+    {
+        return boolean_function();
+    }
+
+    // nodes are in topological order, so a single pass over the transitive fan-in suffices
+    std::vector<u32> cone;
+    std::unordered_set<u32> visited;
+    std::vector<u32> stack = {literal >> 1};
+    while (!stack.empty())
+    {
+        u32 id = stack.back();
+        stack.pop_back();
+        if (!visited.insert(id).second)
+        {
+            continue;
+        }
+        cone.push_back(id);
+        if (m_nodes[id].fan_in_0 != INVALID)
+        {
+            stack.push_back(m_nodes[id].fan_in_0 >> 1);
+            stack.push_back(m_nodes[id].fan_in_1 >> 1);
+        }
+    }
+    std::sort(cone.begin(), cone.end());
+
+    std::unordered_map<u32, boolean_function> functions;
+    auto get_function = [&functions](u32 l) { return (l & 1) ? !functions.at(l >> 1) : functions.at(l >> 1); };
+    for (u32 id : cone)
+    {
+        if (id == 0)
+        {
+            functions.emplace(id, boolean_function(boolean_function::ZERO));
+        }
+        else if (m_nodes[id].fan_in_0 == INVALID)
+        {
+            functions.emplace(id, boolean_function(m_input_names.at(id)));
+        }
+        else
+        {
+            functions.emplace(id, get_function(m_nodes[id].fan_in_0) & get_function(m_nodes[id].fan_in_1));
+        }
+    }
+    return get_function(literal);
+}
+
+std::vector<u32> and_inverter_graph::get_fanout_free_cone(u32 literal) const
+{
+    if (!is_and(literal))
+    {
+        log_error("netlist", "fanout-free cones can only be computed for AND nodes.");
+        return {};
+    }
+
+    // dereference the fan-in of the root, every node whose references all come from within the cone joins it
+    std::vector<u32> cone = {literal >> 1};
+    std::unordered_map<u32, u32> remaining_references;
+    std::vector<u32> stack = {literal >> 1};
+    while (!stack.empty())
+    {
+        const auto& n = m_nodes[stack.back()];
+        stack.pop_back();
+        for (u32 fan_in : {n.fan_in_0, n.fan_in_1})
+        {
+            if (!is_and(fan_in))
+            {
+                continue;
+            }
+            u32 id  = fan_in >> 1;
+            auto it = remaining_references.emplace(id, m_fan_out_counts[id]).first;
+            if (--it->second == 0)
+            {
+                cone.push_back(id);
+                stack.push_back(id);
+            }
+        }
+    }
+
+    std::sort(cone.begin(), cone.end());
+    for (auto& id : cone)
+    {
+        id <<= 1;
+    }
+    return cone;
+}
+
+bool and_inverter_graph::add_netlist(const std::shared_ptr<netlist>& nl)
+{
+    if (nl == nullptr)
+    {
+        log_error("netlist", "cannot add a netlist that is a nullptr.");
+        return false;
+    }
+    auto gates = nl->get_gates();
+    return add_gates(std::vector<std::shared_ptr<gate>>(gates.begin(), gates.end()));
+}
+
+bool and_inverter_graph::is_translated(const std::shared_ptr<gate>& g) const
+{
+    if (g == nullptr || m_gates.find(g->get_id()) == m_gates.end())
+    {
+        return false;
+    }
+    auto type = g->get_type()->get_base_type();
+    return type == gate_type::base_type::combinatorial || type == gate_type::base_type::lut;
+}
+
+bool and_inverter_graph::add_gates(const std::vector<std::shared_ptr<gate>>& gates)
+{
+    if (std::any_of(gates.begin(), gates.end(), [](const auto& g) { return g == nullptr; }))
+    {
+        log_error("netlist", "cannot add a gate that is a nullptr.");
+        return false;
+    }
+
+    for (const auto& g : gates)
+    {
+        m_gates.insert(g->get_id());
+    }
+
+    for (const auto& g : gates)
+    {
+        for (const auto& pin : g->get_output_pins())
+        {
+            if (auto n = g->get_fan_out_net(pin); n != nullptr)
+            {
+                translate_net(n);
+            }
+        }
+    }
+
+    // everything that is observed outside of the translated logic is an output
+    for (const auto& g : gates)
+    {
+        for (const auto& pin : g->get_output_pins())
+        {
+            auto n = g->get_fan_out_net(pin);
+            if (n == nullptr || m_output_nets.find(n->get_id()) != m_output_nets.end())
+            {
+                continue;
+            }
+            auto dsts = n->get_dsts();
+            if (n->is_global_output_net() || std::any_of(dsts.begin(), dsts.end(), [this](const auto& ep) { return !is_translated(ep.get_gate()); }))
+            {
+                m_output_nets.insert(n->get_id());
+                add_output(m_net_literals.at(n->get_id()));
+            }
+        }
+    }
+
+    return true;
+}
+
+u32 and_inverter_graph::create_net_input(const std::shared_ptr<net>& n)
+{
+    u32 literal = create_input(n->get_name());
+    m_net_literals[n->get_id()] = literal;
+    m_input_nets.push_back(n);
+    return literal;
+}
+
+u32 and_inverter_graph::translate_net(const std::shared_ptr<net>& root)
+{
+    // iterative depth-first search, since combinational paths may be much longer than the call stack allows
+    std::vector<std::pair<std::shared_ptr<net>, bool>> stack = {{root, false}};
+    std::unordered_set<u32> on_path;
+
+    while (!stack.empty())
+    {
+        auto [n, expanded] = stack.back();
+        if (m_net_literals.find(n->get_id()) != m_net_literals.end())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        auto src = n->get_src();
+        boolean_function function;
+        if (!n->is_global_input_net() && is_translated(src.get_gate()))
+        {
+            function = src.get_gate()->get_boolean_function(src.get_pin_type());
+        }
+        if (function.is_empty())
+        {
+            create_net_input(n);
+            stack.pop_back();
+            continue;
+        }
+
+        const auto& g = src.get_gate();
+        if (!expanded)
+        {
+            stack.back().second = true;
+            on_path.insert(n->get_id());
+            for (const auto& variable : function.get_variables())
+            {
+                auto fan_in = g->get_fan_in_net(variable);
+                if (fan_in == nullptr || m_net_literals.find(fan_in->get_id()) != m_net_literals.end())
+                {
+                    continue;
+                }
+                if (on_path.find(fan_in->get_id()) != on_path.end())
+                {
+                    log_warning("netlist", "combinational loop through net '{}' (id = {}) is cut.", fan_in->get_name(), fan_in->get_id());
+                    create_net_input(fan_in);
+                    continue;
+                }
+                stack.push_back({fan_in, false});
+            }
+            continue;
+        }
+
+        stack.pop_back();
+        on_path.erase(n->get_id());
+
+        std::unordered_map<std::string, u32> variable_literals;
+        for (const auto& variable : function.get_variables())
+        {
+            if (auto fan_in = g->get_fan_in_net(variable); fan_in != nullptr)
+            {
+                variable_literals.emplace(variable, m_net_literals.at(fan_in->get_id()));
+            }
+        }
+
+        // unconnected pins and X make the function unknown, the net is cut instead
+        u32 literal = from_boolean_function(function, variable_literals);
+        if (literal == INVALID)
+        {
+            create_net_input(n);
+        }
+        else
+        {
+            m_net_literals[n->get_id()] = literal;
+        }
+    }
+
+    return m_net_literals.at(root->get_id());
+}
+
+u32 and_inverter_graph::get_net_literal(const std::shared_ptr<net>& n) const
+{
+    if (n == nullptr)
+    {
+        return INVALID;
+    }
+    if (auto it = m_net_literals.find(n->get_id()); it != m_net_literals.end())
+    {
+        return it->second;
+    }
+    return INVALID;
+}
+
+const std::vector<std::shared_ptr<net>>& and_inverter_graph::get_input_nets() const
+{
+    return m_input_nets;
+}
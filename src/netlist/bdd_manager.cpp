@@ -0,0 +1,394 @@
+#include "netlist/bdd_manager.h"
+
+#include "core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // level of the constants, below all variables
+    constexpr u32 TERMINAL_LEVEL = 0xFFFFFFFF;
+}    // namespace
+
+bdd_manager::bdd_manager(const std::vector<std::string>& variable_order, u32 cache_size_log2)
+{
+    m_nodes.push_back({TERMINAL_LEVEL, ZERO, ZERO});
+    m_nodes.push_back({TERMINAL_LEVEL, ONE, ONE});
+    m_computed_cache.resize((u64)1 << cache_size_log2);
+
+    for (const auto& name : variable_order)
+    {
+        get_variable(name);
+    }
+}
+
+const std::vector<std::string>& bdd_manager::get_variable_order() const
+{
+    return m_variables;
+}
+
+u32 bdd_manager::get_num_nodes() const
+{
+    return m_nodes.size();
+}
+
+u32 bdd_manager::get_level(u32 f) const
+{
+    return m_nodes[f].level;
+}
+
+u32 bdd_manager::make_node(u32 level, u32 low, u32 high)
+{
+    if (low == high)
+    {
+        return low;
+    }
+
+    auto& table = m_unique_tables[level];
+    u64 key     = ((u64)low << 32) | high;
+    if (auto it = table.find(key); it != table.end())
+    {
+        return it->second;
+    }
+
+    u32 id = m_nodes.size();
+    m_nodes.push_back({level, low, high});
+    table.emplace(key, id);
+    return id;
+}
+
+u32 bdd_manager::get_variable(const std::string& name)
+{
+    auto it = m_levels.find(name);
+    if (it == m_levels.end())
+    {
+        it = m_levels.emplace(name, (u32)m_variables.size()).first;
+        m_variables.push_back(name);
+        m_unique_tables.emplace_back();
+    }
+    return make_node(it->second, ZERO, ONE);
+}
+
+u32 bdd_manager::ite(u32 f, u32 g, u32 h)
+{
+    if (f == INVALID || g == INVALID || h == INVALID)
+    {
+        return INVALID;
+    }
+
+    // terminal cases
+    if (f == ONE || g == h)
+    {
+        return g;
+    }
+    if (f == ZERO)
+    {
+        return h;
+    }
+    if (g == ONE && h == ZERO)
+    {
+        return f;
+    }
+
+    u64 slot    = (f * 12582917u + g * 4256249u + h * 741457u) & (m_computed_cache.size() - 1);
+    auto& entry = m_computed_cache[slot];
+    if (entry.f == f && entry.g == g && entry.h == h)
+    {
+        return entry.result;
+    }
+
+    // shannon expansion on the topmost variable
+    u32 level = std::min(get_level(f), std::min(get_level(g), get_level(h)));
+    auto cofactor = [this, level](u32 x, bool high) {
+        const auto& n = m_nodes[x];
+        if (n.level != level)
+        {
+            return x;
+        }
+        return high ? n.high : n.low;
+    };
+
+    u32 high   = ite(cofactor(f, true), cofactor(g, true), cofactor(h, true));
+    u32 low    = ite(cofactor(f, false), cofactor(g, false), cofactor(h, false));
+    u32 result = make_node(level, low, high);
+
+    m_computed_cache[slot] = {f, g, h, result};
+    return result;
+}
+
+u32 bdd_manager::apply_not(u32 f)
+{
+    return ite(f, ZERO, ONE);
+}
+
+u32 bdd_manager::apply_and(u32 f, u32 g)
+{
+    return ite(f, g, ZERO);
+}
+
+u32 bdd_manager::apply_or(u32 f, u32 g)
+{
+    return ite(f, ONE, g);
+}
+
+u32 bdd_manager::apply_xor(u32 f, u32 g)
+{
+    return ite(f, apply_not(g), g);
+}
+
+u32 bdd_manager::from_boolean_function(const boolean_function& function)
+{
+    std::unordered_map<const boolean_function::node*, u32> cache;
+    u32 result = from_boolean_function(function, cache);
+    if (result == INVALID)
+    {
+        log_error("netlist", "cannot convert function into a BDD, only two-valued non-empty functions are supported.");
+    }
+    return result;
+}
+
+u32 bdd_manager::from_boolean_function(const boolean_function& function, std::unordered_map<const boolean_function::node*, u32>& cache)
+{
+    const auto& n = *function.m_node;
+    u32 result    = INVALID;
+    if (n.content == boolean_function::content_type::VARIABLE)
+    {
+        result = get_variable(n.variable);
+    }
+    else if (n.content == boolean_function::content_type::CONSTANT)
+    {
+        if (n.constant == boolean_function::ZERO)
+        {
+            result = ZERO;
+        }
+        else if (n.constant == boolean_function::ONE)
+        {
+            result = ONE;
+        }
+    }
+    else if (!n.operands.empty())
+    {
+        // shared subfunctions are converted only once
+        if (auto it = cache.find(&n); it != cache.end())
+        {
+            return it->second;
+        }
+
+        result = from_boolean_function(n.operands[0], cache);
+        for (u32 i = 1; i < n.operands.size() && result != INVALID; ++i)
+        {
+            u32 next = from_boolean_function(n.operands[i], cache);
+            if (n.op == boolean_function::operation::AND)
+            {
+                result = apply_and(result, next);
+            }
+            else if (n.op == boolean_function::operation::OR)
+            {
+                result = apply_or(result, next);
+            }
+            else
+            {
+                result = apply_xor(result, next);
+            }
+        }
+        if (n.invert)
+        {
+            result = apply_not(result);
+        }
+        cache.emplace(&n, result);
+        return result;
+    }
+
+    if (n.invert)
+    {
+        result = apply_not(result);
+    }
+    return result;
+}
+
+boolean_function bdd_manager::to_boolean_function(u32 f)
+{
+    if (f == ZERO)
+    {
+        return boolean_function(boolean_function::ZERO);
+    }
+    if (f == ONE)
+    {
+        return boolean_function(boolean_function::ONE);
+    }
+    if (f == INVALID || f >= m_nodes.size())
+    {
+        return boolean_function();
+    }
+    if (auto it = m_to_function_cache.find(f); it != m_to_function_cache.end())
+    {
+        return it->second;
+    }
+
+    const auto n = m_nodes[f];
+    boolean_function var(m_variables[n.level]);
+    boolean_function result;
+    if (n.low == ZERO && n.high == ONE)
+    {
+        result = var;
+    }
+    else if (n.low == ONE && n.high == ZERO)
+    {
+        result = !var;
+    }
+    else if (n.low == ZERO)
+    {
+        result = var & to_boolean_function(n.high);
+    }
+    else if (n.high == ZERO)
+    {
+        result = (!var) & to_boolean_function(n.low);
+    }
+    else if (n.low == ONE)
+    {
+        result = (!var) | to_boolean_function(n.high);
+    }
+    else if (n.high == ONE)
+    {
+        result = var | to_boolean_function(n.low);
+    }
+    else
+    {
+        result = (var & to_boolean_function(n.high)) | ((!var) & to_boolean_function(n.low));
+    }
+
+    m_to_function_cache.emplace(f, result);
+    return result;
+}
+
+boolean_function bdd_manager::get_canonical_form(const boolean_function& function)
+{
+    u32 f = from_boolean_function(function);
+    if (f == INVALID)
+    {
+        return boolean_function();
+    }
+    return to_boolean_function(f);
+}
+
+bool bdd_manager::are_equivalent(const boolean_function& a, const boolean_function& b)
+{
+    u32 f = from_boolean_function(a);
+    u32 g = from_boolean_function(b);
+    return f != INVALID && f == g;
+}
+
+double bdd_manager::count_satisfying_assignments(u32 f) const
+{
+    if (f == INVALID || f >= m_nodes.size())
+    {
+        return 0;
+    }
+
+    u32 num_vars = m_variables.size();
+    auto level_of = [this, num_vars](u32 x) { return (x == ZERO || x == ONE) ? num_vars : m_nodes[x].level; };
+
+    // number of satisfying assignments of the variables at and below the level of a node
+    std::unordered_map<u32, double> counts;
+    std::vector<u32> stack = {f};
+    while (!stack.empty())
+    {
+        u32 x = stack.back();
+        if (x == ZERO || x == ONE)
+        {
+            counts[x] = (x == ONE) ? 1 : 0;
+            stack.pop_back();
+            continue;
+        }
+        if (counts.find(x) != counts.end())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const auto& n = m_nodes[x];
+        auto low_it   = counts.find(n.low);
+        auto high_it  = counts.find(n.high);
+        if (low_it == counts.end() || high_it == counts.end())
+        {
+            stack.push_back(n.low);
+            stack.push_back(n.high);
+            continue;
+        }
+
+        counts[x] = low_it->second * std::ldexp(1.0, (i32)(level_of(n.low) - n.level - 1)) + high_it->second * std::ldexp(1.0, (i32)(level_of(n.high) - n.level - 1));
+        stack.pop_back();
+    }
+
+    return counts[f] * std::ldexp(1.0, (i32)level_of(f));
+}
+
+
+std::vector<std::vector<std::pair<std::string, bool>>> bdd_manager::get_isop(u32 f)
+{
+    std::vector<std::vector<std::pair<std::string, bool>>> result;
+    if (f == INVALID || f >= m_nodes.size())
+    {
+        return result;
+    }
+
+    std::vector<std::vector<std::pair<u32, bool>>> cover;
+    get_isop(f, f, cover);
+    for (auto& cube : cover)
+    {
+        std::sort(cube.begin(), cube.end());
+        std::vector<std::pair<std::string, bool>> literals;
+        for (const auto& [level, polarity] : cube)
+        {
+            literals.emplace_back(m_variables[level], polarity);
+        }
+        result.push_back(literals);
+    }
+    return result;
+}
+
+u32 bdd_manager::get_isop(u32 lower, u32 upper, std::vector<std::vector<std::pair<u32, bool>>>& cover)
+{
+    if (lower == ZERO)
+    {
+        return ZERO;
+    }
+    if (upper == ONE)
+    {
+        cover.emplace_back();
+        return ONE;
+    }
+
+    u32 level = std::min(get_level(lower), get_level(upper));
+    auto cofactor = [this, level](u32 x, bool high) {
+        const auto& n = m_nodes[x];
+        if (n.level != level)
+        {
+            return x;
+        }
+        return high ? n.high : n.low;
+    };
+    u32 lower_0 = cofactor(lower, false);
+    u32 lower_1 = cofactor(lower, true);
+    u32 upper_0 = cofactor(upper, false);
+    u32 upper_1 = cofactor(upper, true);
+
+    // cubes that require the variable to be ZERO, cubes that require it to be ONE and cubes that do not depend on it
+    u64 first    = cover.size();
+    u32 result_0 = get_isop(apply_and(lower_0, apply_not(upper_1)), upper_0, cover);
+    for (u64 i = first; i < cover.size(); ++i)
+    {
+        cover[i].emplace_back(level, false);
+    }
+    first        = cover.size();
+    u32 result_1 = get_isop(apply_and(lower_1, apply_not(upper_0)), upper_1, cover);
+    for (u64 i = first; i < cover.size(); ++i)
+    {
+        cover[i].emplace_back(level, true);
+    }
+    u32 remaining_lower = apply_or(apply_and(lower_0, apply_not(result_0)), apply_and(lower_1, apply_not(result_1)));
+    u32 result_rest     = get_isop(remaining_lower, apply_and(upper_0, upper_1), cover);
+
+    return apply_or(make_node(level, result_0, result_1), result_rest);
+}
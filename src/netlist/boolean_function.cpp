@@ -1,8 +1,12 @@
 #include "netlist/boolean_function.h"
 
+#include "core/log.h"
 #include "core/utils.h"
+#include "netlist/bdd_manager.h"
+#include "netlist/compiled_boolean_function.h"
 
 #include <algorithm>
+#include <mutex>
 
 std::string boolean_function::to_string(const operation& op)
 {
@@ -42,44 +46,308 @@ std::ostream& operator<<(std::ostream& os, const boolean_function::value& v)
     return os << boolean_function::to_string(v);
 }
 
+namespace
+{
+    // functions of up to this many variables are minimized on truth tables
+    constexpr u32 MAX_TRUTH_TABLE_ISOP_VARIABLES = 16;
+
+    // cube over up to 32 variables, each variable is either required to be ONE, ZERO or not part of the cube
+    struct cube
+    {
+        u32 positive;
+        u32 negative;
+    };
+
+    // packed truth tables over the variables 0 to num_vars-1, as in packed_truth_table
+    using truth_table = std::vector<u64>;
+
+    u64 word_mask(u32 num_vars)
+    {
+        return (num_vars >= 6) ? ~0ull : ((1ull << (1u << num_vars)) - 1);
+    }
+
+    bool is_zero(const truth_table& t)
+    {
+        return std::all_of(t.begin(), t.end(), [](u64 w) { return w == 0; });
+    }
+
+    bool is_one(const truth_table& t, u32 num_vars)
+    {
+        u64 mask = word_mask(num_vars);
+        return std::all_of(t.begin(), t.end(), [mask](u64 w) { return w == mask; });
+    }
+
+    // returns the tables of both cofactors of the topmost variable
+    std::pair<truth_table, truth_table> split(const truth_table& t, u32 num_vars)
+    {
+        if (num_vars > 6)
+        {
+            auto middle = t.begin() + t.size() / 2;
+            return {truth_table(t.begin(), middle), truth_table(middle, t.end())};
+        }
+        u64 mask = word_mask(num_vars - 1);
+        return {{t[0] & mask}, {(t[0] >> (1u << (num_vars - 1))) & mask}};
+    }
+
+    // inverse of split
+    truth_table join(const truth_table& t0, const truth_table& t1, u32 num_vars)
+    {
+        if (num_vars > 6)
+        {
+            truth_table result(t0);
+            result.insert(result.end(), t1.begin(), t1.end());
+            return result;
+        }
+        return {t0[0] | (t1[0] << (1u << (num_vars - 1)))};
+    }
+
+    template<typename F>
+    truth_table combine_tables(const truth_table& a, const truth_table& b, F op)
+    {
+        truth_table result(a.size());
+        for (u32 i = 0; i < a.size(); ++i)
+        {
+            result[i] = op(a[i], b[i]);
+        }
+        return result;
+    }
+
+    /*
+     * Minato-Morreale: computes an irredundant cover of a function between lower and upper (i.e., lower is the onset
+     * and upper the complement of the offset) and returns the covered function.
+     */
+    truth_table isop(const truth_table& lower, const truth_table& upper, u32 num_vars, std::vector<cube>& cover)
+    {
+        if (is_zero(lower))
+        {
+            return truth_table(lower.size(), 0);
+        }
+        if (is_one(upper, num_vars))
+        {
+            cover.push_back({0, 0});
+            return truth_table(upper.size(), word_mask(num_vars));
+        }
+
+        u32 var                   = num_vars - 1;
+        auto [lower_0, lower_1]   = split(lower, num_vars);
+        auto [upper_0, upper_1]   = split(upper, num_vars);
+        auto and_not              = [](u64 a, u64 b) { return a & ~b; };
+        auto bit_or               = [](u64 a, u64 b) { return a | b; };
+        auto bit_and              = [](u64 a, u64 b) { return a & b; };
+        if (lower_0 == lower_1 && upper_0 == upper_1)
+        {
+            auto result = isop(lower_0, upper_0, var, cover);
+            return join(result, result, num_vars);
+        }
+
+        u64 first     = cover.size();
+        auto result_0 = isop(combine_tables(lower_0, upper_1, and_not), upper_0, var, cover);
+        for (u64 i = first; i < cover.size(); ++i)
+        {
+            cover[i].negative |= 1u << var;
+        }
+        first         = cover.size();
+        auto result_1 = isop(combine_tables(lower_1, upper_0, and_not), upper_1, var, cover);
+        for (u64 i = first; i < cover.size(); ++i)
+        {
+            cover[i].positive |= 1u << var;
+        }
+        auto remaining_lower = combine_tables(combine_tables(lower_0, result_0, and_not), combine_tables(lower_1, result_1, and_not), bit_or);
+        auto result_rest     = isop(remaining_lower, combine_tables(upper_0, upper_1, bit_and), var, cover);
+
+        return join(combine_tables(result_0, result_rest, bit_or), combine_tables(result_1, result_rest, bit_or), num_vars);
+    }
+
+    // BDD of the rows [first_row, first_row + 2^num_vars) of a packed truth table over the variables 0 to num_vars-1, rows beyond the table are ZERO
+    u32 truth_table_to_bdd(bdd_manager& manager, const truth_table& table, const std::vector<std::string>& variables, u32 num_vars, u64 first_row)
+    {
+        if (first_row / 64 >= table.size())
+        {
+            return bdd_manager::ZERO;
+        }
+        if (num_vars <= 6)
+        {
+            u64 rows = (table[first_row / 64] >> (first_row % 64)) & word_mask(num_vars);
+            if (rows == 0)
+            {
+                return bdd_manager::ZERO;
+            }
+            if (rows == word_mask(num_vars))
+            {
+                return bdd_manager::ONE;
+            }
+        }
+
+        u32 low  = truth_table_to_bdd(manager, table, variables, num_vars - 1, first_row);
+        u32 high = truth_table_to_bdd(manager, table, variables, num_vars - 1, first_row + (1ull << (num_vars - 1)));
+        return manager.ite(manager.get_variable(variables[num_vars - 1]), high, low);
+    }
+}    // namespace
+
+/*
+ * Table of all live nodes.
+ * A node removes itself from the table when its last reference is dropped.
+ */
+class boolean_function::unique_table
+{
+public:
+    static unique_table& instance()
+    {
+        // intentionally never destroyed, functions in static storage may outlive any static object
+        static unique_table* table = new unique_table();
+        return *table;
+    }
+
+    std::shared_ptr<const node> get(node&& n)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = m_nodes.find(&n); it != m_nodes.end())
+        {
+            if (auto existing = it->second.lock(); existing != nullptr)
+            {
+                return existing;
+            }
+            // the existing node is currently being destroyed
+            m_nodes.erase(it);
+        }
+        std::shared_ptr<const node> result(new node(std::move(n)), [this](const node* dead) { release(dead); });
+        m_nodes.emplace(result.get(), result);
+        return result;
+    }
+
+private:
+    struct node_hash
+    {
+        std::size_t operator()(const node* n) const
+        {
+            return n->hash;
+        }
+    };
+
+    struct node_equal
+    {
+        bool operator()(const node* a, const node* b) const
+        {
+            if (a->hash != b->hash || a->content != b->content || a->invert != b->invert || a->constant != b->constant || a->op != b->op || a->variable != b->variable
+                || a->operands.size() != b->operands.size())
+            {
+                return false;
+            }
+            // operands are unique nodes themselves
+            for (u32 i = 0; i < a->operands.size(); ++i)
+            {
+                if (a->operands[i].m_node != b->operands[i].m_node)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    void release(const node* dead)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto it = m_nodes.find(dead); it != m_nodes.end() && it->first == dead)
+            {
+                m_nodes.erase(it);
+            }
+        }
+        // releases the operands, which acquire the lock themselves
+        delete dead;
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<const node*, std::weak_ptr<const node>, node_hash, node_equal> m_nodes;
+};
+
+std::shared_ptr<const boolean_function::node> boolean_function::make_node(node&& n)
+{
+    // reset irrelevant fields so that they do not distinguish otherwise identical nodes
+    if (n.content != content_type::CONSTANT)
+    {
+        n.constant = value::X;
+    }
+    if (n.content != content_type::VARIABLE)
+    {
+        n.variable.clear();
+    }
+    if (n.content != content_type::TERMS)
+    {
+        n.op = operation::AND;
+        n.operands.clear();
+    }
+    else if (n.operands.empty())
+    {
+        n.invert = false;
+        n.op     = operation::AND;
+    }
+
+    auto combine_hash = [&n](std::size_t h) { n.hash ^= h + 0x9e3779b97f4a7c15ull + (n.hash << 6) + (n.hash >> 2); };
+    n.hash            = 0;
+    combine_hash((std::size_t)n.content);
+    combine_hash((std::size_t)n.invert);
+    combine_hash((std::size_t)(n.constant + 1));
+    combine_hash((std::size_t)n.op);
+    combine_hash(std::hash<std::string>()(n.variable));
+    for (const auto& operand : n.operands)
+    {
+        combine_hash(std::hash<const node*>()(operand.m_node.get()));
+    }
+
+    return unique_table::instance().get(std::move(n));
+}
+
+boolean_function::boolean_function(std::shared_ptr<const node> n) : m_node(std::move(n))
+{
+}
+
 boolean_function::boolean_function()
 {
-    m_content = content_type::TERMS;
-    m_invert  = false;
+    static const std::shared_ptr<const node> empty = make_node(node());
+    m_node                                         = empty;
 }
 
-boolean_function::boolean_function(operation op, const std::vector<boolean_function>& operands, bool invert_result) : boolean_function()
+boolean_function::boolean_function(operation op, const std::vector<boolean_function>& operands, bool invert_result)
 {
     if (operands.empty())
     {
-        m_content  = content_type::CONSTANT;
-        m_constant = value::X;
+        node n;
+        n.content  = content_type::CONSTANT;
+        n.constant = value::X;
+        m_node     = make_node(std::move(n));
     }
     else if (operands.size() == 1)
     {
-        *this = operands[0];
+        m_node = operands[0].m_node;
     }
     else
     {
-        m_content = content_type::TERMS;
-        m_invert  = invert_result;
-
-        m_op = op;
-        std::copy_if(operands.begin(), operands.end(), std::back_inserter(m_operands), [](auto op2) { return !op2.is_empty(); });
+        node n;
+        n.content = content_type::TERMS;
+        n.invert  = invert_result;
+        n.op      = op;
+        std::copy_if(operands.begin(), operands.end(), std::back_inserter(n.operands), [](const auto& op2) { return !op2.is_empty(); });
+        m_node = make_node(std::move(n));
     }
 }
 
-boolean_function::boolean_function(const std::string& variable_name) : boolean_function()
+boolean_function::boolean_function(const std::string& variable_name)
 {
-    m_content  = content_type::VARIABLE;
-    m_variable = core_utils::trim(variable_name);
-    assert(!m_variable.empty());
+    node n;
+    n.content  = content_type::VARIABLE;
+    n.variable = core_utils::trim(variable_name);
+    assert(!n.variable.empty());
+    m_node = make_node(std::move(n));
 }
 
-boolean_function::boolean_function(value constant) : boolean_function()
+boolean_function::boolean_function(value constant)
 {
-    m_content  = content_type::CONSTANT;
-    m_constant = constant;
+    node n;
+    n.content  = content_type::CONSTANT;
+    n.constant = constant;
+    m_node     = make_node(std::move(n));
 }
 
 boolean_function boolean_function::substitute(const std::string& old_variable_name, const std::string& new_variable_name) const
@@ -89,9 +357,15 @@ boolean_function boolean_function::substitute(const std::string& old_variable_na
 
 boolean_function boolean_function::substitute(const std::string& variable_name, const boolean_function& function) const
 {
-    if (m_content == content_type::VARIABLE && m_variable == variable_name)
+    std::unordered_map<const node*, boolean_function> cache;
+    return substitute(variable_name, function, cache);
+}
+
+boolean_function boolean_function::substitute(const std::string& variable_name, const boolean_function& function, std::unordered_map<const node*, boolean_function>& cache) const
+{
+    if (m_node->content == content_type::VARIABLE && m_node->variable == variable_name)
     {
-        if (m_invert)
+        if (m_node->invert)
         {
             return !function;
         }
@@ -100,13 +374,20 @@ boolean_function boolean_function::substitute(const std::string& variable_name,
             return function;
         }
     }
-    else if (m_content == content_type::TERMS)
+    else if (m_node->content == content_type::TERMS)
     {
-        auto result = *this;
-        for (u32 i = 0; i < m_operands.size(); ++i)
+        // shared subfunctions are substituted only once
+        if (auto it = cache.find(m_node.get()); it != cache.end())
         {
-            result.m_operands[i] = result.m_operands[i].substitute(variable_name, function);
+            return it->second;
         }
+        node n = *m_node;
+        for (auto& operand : n.operands)
+        {
+            operand = operand.substitute(variable_name, function, cache);
+        }
+        boolean_function result(make_node(std::move(n)));
+        cache.emplace(m_node.get(), result);
         return result;
     }
     return *this;
@@ -115,32 +396,32 @@ boolean_function boolean_function::substitute(const std::string& variable_name,
 boolean_function::value boolean_function::evaluate(const std::map<std::string, value>& inputs) const
 {
     value result = X;
-    if (m_content == content_type::VARIABLE)
+    if (m_node->content == content_type::VARIABLE)
     {
-        auto it = inputs.find(m_variable);
+        auto it = inputs.find(m_node->variable);
         if (it != inputs.end())
         {
             result = it->second;
         }
     }
-    else if (m_content == content_type::CONSTANT)
+    else if (m_node->content == content_type::CONSTANT)
     {
-        result = m_constant;
+        result = m_node->constant;
     }
-    else if (!m_operands.empty())
+    else if (!m_node->operands.empty())
     {
-        result = m_operands[0].evaluate(inputs);
+        result = m_node->operands[0].evaluate(inputs);
 
-        for (u32 i = 1; i < m_operands.size(); ++i)
+        for (u32 i = 1; i < m_node->operands.size(); ++i)
         {
             // early exit
-            if ((m_op == operation::AND && result == 0) || (m_op == operation::OR && result == 1) || (m_op == operation::XOR && result == X))
+            if ((m_node->op == operation::AND && result == 0) || (m_node->op == operation::OR && result == 1) || (m_node->op == operation::XOR && result == X))
             {
                 break;
             }
 
-            auto next = m_operands[i].evaluate(inputs);
-            if (m_op == operation::AND)
+            auto next = m_node->operands[i].evaluate(inputs);
+            if (m_node->op == operation::AND)
             {
                 if (next == 0 || result == 0)
                 {
@@ -151,7 +432,7 @@ boolean_function::value boolean_function::evaluate(const std::map<std::string, v
                     result = X;
                 }
             }
-            else if (m_op == operation::OR)
+            else if (m_node->op == operation::OR)
             {
                 if (next == 1 || result == 1)
                 {
@@ -162,7 +443,7 @@ boolean_function::value boolean_function::evaluate(const std::map<std::string, v
                     result = X;
                 }
             }
-            else if (m_op == operation::XOR)
+            else if (m_node->op == operation::XOR)
             {
                 if (next == 1)
                 {
@@ -176,7 +457,7 @@ boolean_function::value boolean_function::evaluate(const std::map<std::string, v
         }
     }
 
-    if (m_invert)
+    if (m_node->invert)
     {
         if (result == 1)
         {
@@ -197,383 +478,354 @@ boolean_function::value boolean_function::operator()(const std::map<std::string,
 
 bool boolean_function::is_constant_one() const
 {
-    if (m_content == content_type::CONSTANT)
+    if (m_node->content == content_type::CONSTANT)
     {
-        return m_constant == ONE;
+        return m_node->constant == ONE;
     }
     auto tmp = optimize();
-    return tmp.m_content == content_type::CONSTANT && tmp.m_constant == ONE;
+    return tmp.m_node->content == content_type::CONSTANT && tmp.m_node->constant == ONE;
 }
 
 bool boolean_function::is_constant_zero() const
 {
-    if (m_content == content_type::CONSTANT)
+    if (m_node->content == content_type::CONSTANT)
     {
-        return m_constant == ZERO;
+        return m_node->constant == ZERO;
     }
     auto tmp = optimize();
-    return tmp.m_content == content_type::CONSTANT && tmp.m_constant == ZERO;
+    return tmp.m_node->content == content_type::CONSTANT && tmp.m_node->constant == ZERO;
 }
 
 bool boolean_function::is_empty() const
 {
-    return m_content == content_type::TERMS && m_operands.empty();
+    return m_node->content == content_type::TERMS && m_node->operands.empty();
 }
 
 std::set<std::string> boolean_function::get_variables() const
 {
-    if (m_content == content_type::VARIABLE)
+    std::set<std::string> result;
+    std::unordered_set<const node*> visited;
+    collect_variables(result, visited);
+    return result;
+}
+
+void boolean_function::collect_variables(std::set<std::string>& variables, std::unordered_set<const node*>& visited) const
+{
+    if (m_node->content == content_type::VARIABLE)
     {
-        return {m_variable};
+        variables.insert(m_node->variable);
     }
-    else if (m_content == content_type::TERMS)
+    else if (m_node->content == content_type::TERMS && visited.insert(m_node.get()).second)
     {
-        std::set<std::string> result;
-        for (const auto& f : m_operands)
+        for (const auto& f : m_node->operands)
         {
-            auto tmp = f.get_variables();
-            result.insert(tmp.begin(), tmp.end());
+            f.collect_variables(variables, visited);
         }
-        return result;
     }
-    return {};
 }
 
-boolean_function boolean_function::from_string(std::string expression, const std::vector<std::string>& variable_names)
+namespace
 {
-    auto sorted_variable_names = variable_names;
-    std::sort(sorted_variable_names.begin(), sorted_variable_names.end(), [](const auto& a, const auto& b) { return a.size() > b.size(); });
-
-    for (u32 i = 0; i < sorted_variable_names.size(); ++i)
-    {
-        auto pos = expression.find(sorted_variable_names[i]);
-        if (pos != std::string::npos)
+    /*
+     * Single-pass parser for the string representation of boolean functions.
+     * Operands are parsed by recursive descent, binary operators by precedence climbing. Names are scanned in place
+     * and only copied once a variable is created.
+     */
+    class function_parser
+    {
+    public:
+        function_parser(const std::string& expression, const std::vector<std::string>& variable_names) : m_expression(expression), m_variable_names(variable_names)
         {
-            expression.replace(pos, sorted_variable_names[i].size(), "__v_" + std::to_string(i));
+            // longer names first, so that a name is never matched by one of its prefixes
+            std::sort(m_variable_names.begin(), m_variable_names.end(), [](const auto& a, const auto& b) { return a.size() > b.size(); });
         }
-    }
 
-    return from_string_internal(expression, sorted_variable_names);
-}
+        boolean_function parse()
+        {
+            auto result = parse_binary(PRECEDENCE_OR);
+            skip_whitespace();
+            if (m_error || m_position < m_expression.size())
+            {
+                // unbalanced brackets
+                return boolean_function(boolean_function::X);
+            }
+            return result;
+        }
 
-boolean_function boolean_function::from_string_internal(std::string expression, const std::vector<std::string>& variable_names)
-{
-    expression = core_utils::trim(expression);
+    private:
+        static constexpr u32 PRECEDENCE_OR  = 1;
+        static constexpr u32 PRECEDENCE_XOR = 2;
+        static constexpr u32 PRECEDENCE_AND = 3;
 
-    if (expression.empty())
-    {
-        return boolean_function();
-    }
+        const std::string& m_expression;
+        std::vector<std::string> m_variable_names;
+        u32 m_position = 0;
+        bool m_error   = false;
 
-    const std::string delimiters = "!^&|'+* ";
+        static bool is_whitespace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
 
-    // check for constants
-    if (expression == "0")
-    {
-        return boolean_function(ZERO);
-    }
-    else if (expression == "1")
-    {
-        return boolean_function(ONE);
-    }
-    else if (expression == "X")
-    {
-        return boolean_function(X);
-    }
-    else
-    {
-        // check for variable
-        bool is_term = false;
-        for (const auto& d : delimiters + "()")
+        static bool is_delimiter(char c)
         {
-            if (expression.find(d) != std::string::npos)
+            switch (c)
             {
-                is_term = true;
-                break;
+                case '!':
+                case '\'':
+                case '&':
+                case '*':
+                case '|':
+                case '+':
+                case '^':
+                case '(':
+                case ')':
+                    return true;
+                default:
+                    return is_whitespace(c);
             }
         }
-        if (!is_term)
+
+        // returns the precedence of a binary operator or 0 if the character is none
+        static u32 get_precedence(char c)
         {
-            if (core_utils::starts_with(expression, "__v_"))
+            switch (c)
             {
-                u32 idx    = std::stoul(expression.substr(4));
-                expression = variable_names[idx];
+                case '&':
+                case '*':
+                    return PRECEDENCE_AND;
+                case '^':
+                    return PRECEDENCE_XOR;
+                case '|':
+                case '+':
+                    return PRECEDENCE_OR;
+                default:
+                    return 0;
             }
-
-            return boolean_function(expression);
         }
-    }
 
-    // simple bracket check
-    i32 level = 0;
-    for (const auto& c : expression)
-    {
-        if (c == '(')
+        bool at_end() const
         {
-            level += 1;
+            return m_position >= m_expression.size();
         }
-        else if (c == ')')
+
+        void skip_whitespace()
         {
-            level -= 1;
-            if (level < 0)
+            while (!at_end() && is_whitespace(m_expression[m_position]))
             {
-                return value::X;
+                m_position++;
             }
         }
-    }
-    if (level != 0)
-    {
-        return value::X;
-    }
 
-    // parse expression
-    std::vector<std::string> terms;
-    {
-        std::string current_term;
-        u32 bracket_level = 0;
-        for (u32 i = 0; i < expression.size(); i++)
+        boolean_function parse_binary(u32 min_precedence)
         {
-            if (expression[i] == '(')
+            auto result = parse_unary();
+            while (true)
             {
-                // if this is a top-level term, store everything before the bracket
-                if (bracket_level == 0)
+                skip_whitespace();
+                if (at_end() || m_expression[m_position] == ')')
                 {
-                    current_term = core_utils::trim(current_term);
-                    if (!current_term.empty())
+                    return result;
+                }
+
+                // adjacent operands are joined by AND, of consecutive operators the last one counts
+                u32 precedence = PRECEDENCE_AND;
+                u32 position   = m_position;
+                while (position < m_expression.size())
+                {
+                    char c = m_expression[position];
+                    if (u32 p = get_precedence(c); p != 0)
                     {
-                        terms.push_back(current_term);
-                        current_term.clear();
+                        precedence = p;
                     }
+                    else if (!is_whitespace(c))
+                    {
+                        break;
+                    }
+                    position++;
+                }
+                if (precedence < min_precedence)
+                {
+                    return result;
+                }
+                m_position = position;
+                if (at_end() || m_expression[m_position] == ')')
+                {
+                    // dangling operator
+                    return result;
                 }
 
-                bracket_level++;
-            }
-
-            if (bracket_level == 0 && delimiters.find(expression[i]) != std::string::npos)
-            {
-                // not in brackets and there was a delimiter -> save term and operation
-                current_term = core_utils::trim(current_term);
-                if (!current_term.empty())
+                auto operand = parse_binary(precedence + 1);
+                if (precedence == PRECEDENCE_AND)
                 {
-                    terms.push_back(current_term);
-                    current_term.clear();
+                    result = result & operand;
                 }
-                if (expression[i] != ' ')
+                else if (precedence == PRECEDENCE_XOR)
                 {
-                    terms.push_back(std::string(1, expression[i]));
+                    result = result ^ operand;
+                }
+                else
+                {
+                    result = result | operand;
                 }
             }
-            else
-            {
-                // no special conditions -> char is term of current term
-                current_term += expression[i];
-            }
+        }
 
-            if (expression[i] == ')')
+        boolean_function parse_unary()
+        {
+            // prefix '!' and postfix '\'' both negate the operand
+            bool negate = false;
+            while (true)
             {
-                bracket_level--;
-
-                if (bracket_level == 0)
+                skip_whitespace();
+                if (at_end() || (m_expression[m_position] != '!' && m_expression[m_position] != '\''))
                 {
-                    // if we are back at top-level, store everything that was in the brackets
-                    current_term = core_utils::trim(current_term);
-                    if (!current_term.empty())
-                    {
-                        terms.push_back(current_term);
-                        current_term.clear();
-                    }
+                    break;
                 }
+                negate = negate != (m_expression[m_position] == '!');
+                m_position++;
             }
-        }
-        current_term = core_utils::trim(current_term);
-        if (!current_term.empty())
-        {
-            terms.push_back(current_term);
-        }
-    }
 
-    // process terms
-    if (terms.size() == 1)
-    {
-        // only a single term but not filtered before?
-        // -> was of the form "(...)" so remove the outer brackets and repeat
-        return from_string_internal(terms[0].substr(1, terms[0].size() - 2), variable_names);
-    }
+            auto result = parse_primary();
 
-    // small mutable datastructure for parsing
-    struct op_term
-    {
-        operation op;
-        boolean_function term;
-    };
-    std::vector<op_term> parsed_terms;
-
-    bool negate_next  = false;
-    operation next_op = operation::AND;
-
-    {
-        // multiple terms available -> initialize return value with first term
-        u32 i = 0;
-        while (terms[i] == "!")
-        {
-            negate_next = !negate_next;
-            ++i;
-        }
-        boolean_function first_term = from_string_internal(terms[i], variable_names);
-        while (i + 1 < terms.size() && terms[i + 1] == "'")
-        {
-            negate_next = !negate_next;
-            ++i;
-        }
-        if (negate_next)
-        {
-            first_term  = !first_term;
-            negate_next = false;
+            while (true)
+            {
+                skip_whitespace();
+                if (at_end() || m_expression[m_position] != '\'')
+                {
+                    break;
+                }
+                negate = !negate;
+                m_position++;
+            }
+            return negate ? !result : result;
         }
 
-        parsed_terms.push_back({operation::AND, first_term});
-
-        // process the remaining terms
-        while (++i < terms.size())
+        boolean_function parse_primary()
         {
-            if (terms[i] == "!")
+            if (at_end() || m_expression[m_position] == ')' || get_precedence(m_expression[m_position]) != 0)
             {
-                negate_next = !negate_next;
+                // missing operand
+                return boolean_function();
             }
-            else if (terms[i] == "&" || terms[i] == "*")
+
+            if (m_expression[m_position] == '(')
             {
-                next_op = operation::AND;
+                m_position++;
+                auto result = parse_binary(PRECEDENCE_OR);
+                skip_whitespace();
+                if (at_end())
+                {
+                    m_error = true;
+                }
+                else
+                {
+                    m_position++;
+                }
+                return result;
             }
-            else if (terms[i] == "|" || terms[i] == "+")
+
+            // known names may contain delimiters, they are matched as a whole
+            for (const auto& name : m_variable_names)
             {
-                next_op = operation::OR;
+                u32 end = m_position + name.size();
+                if (!name.empty() && m_expression.compare(m_position, name.size(), name) == 0 && (end >= m_expression.size() || is_delimiter(m_expression[end])))
+                {
+                    m_position = end;
+                    return boolean_function(name);
+                }
             }
-            else if (terms[i] == "^")
+
+            u32 begin = m_position;
+            while (!at_end() && !is_delimiter(m_expression[m_position]))
             {
-                next_op = operation::XOR;
+                m_position++;
             }
-            else
+            if (m_position - begin == 1)
             {
-                auto next_term = from_string_internal(terms[i], variable_names);
-                while (i + 1 < terms.size() && terms[i + 1] == "'")
+                switch (m_expression[begin])
                 {
-                    negate_next = !negate_next;
-                    ++i;
+                    case '0':
+                        return boolean_function(boolean_function::ZERO);
+                    case '1':
+                        return boolean_function(boolean_function::ONE);
+                    case 'X':
+                        return boolean_function(boolean_function::X);
+                    default:
+                        break;
                 }
-                if (negate_next)
-                {
-                    next_term = !next_term;
-                }
-
-                parsed_terms.push_back({next_op, next_term});
-
-                negate_next = false;
-                next_op     = operation::AND;
             }
+            return boolean_function(m_expression.substr(begin, m_position - begin));
         }
-    }
-
-    // assemble terms in order of operator precedence
+    };
+}    // namespace
 
-    for (u32 i = 1; i < parsed_terms.size(); ++i)
-    {
-        if (parsed_terms[i].op == operation::AND)
-        {
-            parsed_terms[i - 1].term = parsed_terms[i - 1].term & parsed_terms[i].term;
-            parsed_terms.erase(parsed_terms.begin() + i);
-            --i;
-        }
-    }
+boolean_function boolean_function::from_string(const std::string& expression, const std::vector<std::string>& variable_names)
+{
+    return function_parser(expression, variable_names).parse();
+}
 
-    for (u32 i = 1; i < parsed_terms.size(); ++i)
-    {
-        if (parsed_terms[i].op == operation::XOR)
-        {
-            parsed_terms[i - 1].term = parsed_terms[i - 1].term ^ parsed_terms[i].term;
-            parsed_terms.erase(parsed_terms.begin() + i);
-            --i;
-        }
-    }
+std::string boolean_function::to_string() const
+{
+    std::string result;
+    result.reserve(64);
+    to_string(result);
+    return result;
+}
 
-    for (u32 i = 1; i < parsed_terms.size(); ++i)
+void boolean_function::to_string(std::string& out) const
+{
+    if (is_empty())
     {
-        if (parsed_terms[i].op == operation::OR)
-        {
-            parsed_terms[i - 1].term = parsed_terms[i - 1].term | parsed_terms[i].term;
-            parsed_terms.erase(parsed_terms.begin() + i);
-            --i;
-        }
+        out += "<empty>";
+        return;
     }
-
-    return parsed_terms[0].term;
+    write_string(out, true);
 }
 
-std::string boolean_function::to_string() const
+void boolean_function::write_string(std::string& buffer, bool top_level) const
 {
-    if (is_empty())
+    if (m_node->invert)
     {
-        return "<empty>";
+        buffer += '!';
     }
-    auto s = to_string_internal();
 
-    // remove outer parantheses
-    if (s[0] == '(')
+    if (m_node->content == content_type::VARIABLE)
     {
-        u32 lvl = 0;
-        u32 i   = 0;
-        for (; i < s.size(); ++i)
-        {
-            if (s[i] == '(')
-            {
-                lvl++;
-            }
-            else if (s[i] == ')')
-            {
-                lvl--;
-                if (lvl == 0)
-                {
-                    break;
-                }
-            }
-        }
-        if (i >= s.size() - 1)
-        {
-            s = s.substr(1, s.size() - 2);
-        }
+        buffer += m_node->variable;
     }
-
-    return s;
-}
-
-std::string boolean_function::to_string_internal() const
-{
-    std::string result = to_string(value::X);
-    if (m_content == content_type::VARIABLE)
+    else if (m_node->content == content_type::CONSTANT)
     {
-        result = m_variable;
+        buffer += (m_node->constant == ZERO) ? '0' : ((m_node->constant == ONE) ? '1' : 'X');
     }
-    else if (m_content == content_type::CONSTANT)
+    else if (m_node->operands.empty())
     {
-        result = to_string(m_constant);
+        buffer += 'X';
     }
-    else if (!m_operands.empty())
+    else
     {
-        std::string op_str = " " + to_string(m_op) + " ";
-
-        std::vector<std::string> terms;
-        for (const auto& f : m_operands)
+        // the brackets of the outermost term are omitted unless it is negated
+        bool brackets = !top_level || m_node->invert;
+        char op       = (m_node->op == operation::AND) ? '&' : ((m_node->op == operation::OR) ? '|' : '^');
+        if (brackets)
         {
-            terms.push_back(f.to_string_internal());
+            buffer += '(';
+        }
+        for (u32 i = 0; i < m_node->operands.size(); ++i)
+        {
+            if (i != 0)
+            {
+                buffer += ' ';
+                buffer += op;
+                buffer += ' ';
+            }
+            m_node->operands[i].write_string(buffer, false);
+        }
+        if (brackets)
+        {
+            buffer += ')';
         }
-
-        result = "(" + core_utils::join(op_str, terms) + ")";
-    }
-
-    if (m_invert)
-    {
-        result = "!" + result;
     }
-    return result;
 }
 
 std::ostream& operator<<(std::ostream& os, const boolean_function& f)
@@ -591,24 +843,24 @@ boolean_function boolean_function::combine(operation op, const boolean_function&
     {
         return *this;
     }
-    else if (m_content == content_type::TERMS && other.m_content == content_type::TERMS && m_op == op && m_op == other.m_op && !m_invert && !other.m_invert)
+    else if (m_node->content == content_type::TERMS && other.m_node->content == content_type::TERMS && m_node->op == op && m_node->op == other.m_node->op && !m_node->invert && !other.m_node->invert)
     {
-        auto joint_operands = m_operands;
-        joint_operands.insert(joint_operands.end(), other.m_operands.begin(), other.m_operands.end());
+        auto joint_operands = m_node->operands;
+        joint_operands.insert(joint_operands.end(), other.m_node->operands.begin(), other.m_node->operands.end());
         boolean_function result(op, joint_operands);
         return result;
     }
-    else if (m_content == content_type::TERMS && m_op == op && !m_invert)
+    else if (m_node->content == content_type::TERMS && m_node->op == op && !m_node->invert)
     {
-        boolean_function result = *this;
-        result.m_operands.push_back(other);
-        return result;
+        node n = *m_node;
+        n.operands.push_back(other);
+        return boolean_function(make_node(std::move(n)));
     }
-    else if (other.m_content == content_type::TERMS && other.m_op == op && !other.m_invert)
+    else if (other.m_node->content == content_type::TERMS && other.m_node->op == op && !other.m_node->invert)
     {
-        boolean_function result = other;
-        result.m_operands.insert(result.m_operands.begin(), *this);
-        return result;
+        node n = *other.m_node;
+        n.operands.insert(n.operands.begin(), *this);
+        return boolean_function(make_node(std::move(n)));
     }
     return boolean_function(op, {*this, other});
 }
@@ -646,19 +898,20 @@ boolean_function& boolean_function::operator^=(const boolean_function& other)
 
 boolean_function boolean_function::operator!() const
 {
-    auto result = *this;
-    if ((m_content == content_type::TERMS && !m_operands.empty()) || m_content == content_type::VARIABLE)
+    if ((m_node->content == content_type::TERMS && !m_node->operands.empty()) || m_node->content == content_type::VARIABLE)
     {
-        result.m_invert = !result.m_invert;
+        node n   = *m_node;
+        n.invert = !n.invert;
+        return boolean_function(make_node(std::move(n)));
     }
-    else if (m_content == content_type::CONSTANT)
+    else if (m_node->content == content_type::CONSTANT)
     {
-        if (m_constant == ZERO)
-            result.m_constant = ONE;
-        else if (m_constant == ONE)
-            result.m_constant = ZERO;
+        if (m_node->constant == ZERO)
+            return boolean_function(ONE);
+        else if (m_node->constant == ONE)
+            return boolean_function(ZERO);
     }
-    return result;
+    return *this;
 }
 
 bool boolean_function::operator==(const boolean_function& other) const
@@ -667,12 +920,8 @@ bool boolean_function::operator==(const boolean_function& other) const
     {
         return true;
     }
-    if (m_content != other.m_content)
-        return false;
-    if (m_invert != other.m_invert)
-        return false;
-    return (m_content == content_type::VARIABLE && m_variable == other.m_variable) || (m_content == content_type::CONSTANT && m_constant == other.m_constant)
-           || (m_content == content_type::TERMS && m_op == other.m_op && m_operands == other.m_operands);
+    // nodes are unique per structure
+    return m_node == other.m_node;
 }
 bool boolean_function::operator!=(const boolean_function& other) const
 {
@@ -681,18 +930,18 @@ bool boolean_function::operator!=(const boolean_function& other) const
 
 boolean_function boolean_function::replace_xors() const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         return *this;
     }
     std::vector<boolean_function> terms;
-    for (const auto& operand : m_operands)
+    for (const auto& operand : m_node->operands)
     {
         terms.push_back(operand.replace_xors());
     }
-    if (m_op != operation::XOR)
+    if (m_node->op != operation::XOR)
     {
-        return boolean_function(m_op, terms, m_invert);
+        return boolean_function(m_node->op, terms, m_node->invert);
     }
 
     // actually replace the current xors
@@ -702,7 +951,7 @@ boolean_function boolean_function::replace_xors() const
         result = (result & (!terms[i])) | ((!result) & terms[i]);
     }
 
-    if (m_invert)
+    if (m_node->invert)
     {
         result = !result;
     }
@@ -715,11 +964,11 @@ std::vector<boolean_function> boolean_function::expand_ands_internal(const std::
 
     auto set_identifier = [](const boolean_function& f) -> std::string {
         std::string id;
-        for (const auto& var : f.m_operands)
+        for (const auto& var : f.m_node->operands)
         {
-            if (var.m_invert)
+            if (var.m_node->invert)
                 id += "!";
-            id += var.m_variable;
+            id += var.m_node->variable;
             id += " ";
         }
         return id;
@@ -735,11 +984,13 @@ std::vector<boolean_function> boolean_function::expand_ands_internal(const std::
             for (const auto& bf2 : result)
             {
                 auto combined = (bf2 & bf).optimize_constants();
-                if (!(combined.m_content == content_type::CONSTANT && combined.m_constant == value::ZERO))
+                if (!(combined.m_node->content == content_type::CONSTANT && combined.m_node->constant == value::ZERO))
                 {
-                    if (combined.m_content == content_type::TERMS)
+                    if (combined.m_node->content == content_type::TERMS)
                     {
-                        std::sort(combined.m_operands.begin(), combined.m_operands.end(), [](const auto& f1, const auto& f2) { return f1.m_variable < f2.m_variable; });
+                        node n = *combined.m_node;
+                        std::sort(n.operands.begin(), n.operands.end(), [](const auto& f1, const auto& f2) { return f1.m_node->variable < f2.m_node->variable; });
+                        combined = boolean_function(make_node(std::move(n)));
                     }
                     auto s = set_identifier(combined);
                     if (seen.find(s) == seen.end())
@@ -758,25 +1009,25 @@ std::vector<boolean_function> boolean_function::expand_ands_internal(const std::
 
 std::vector<boolean_function> boolean_function::get_primitives() const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         return {*this};
     }
 
-    if (m_op == operation::OR)
+    if (m_node->op == operation::OR)
     {
         std::vector<boolean_function> primitives;
-        for (const auto& operand : m_operands)
+        for (const auto& operand : m_node->operands)
         {
             auto tmp = operand.get_primitives();
             primitives.insert(primitives.end(), tmp.begin(), tmp.end());
         }
         return primitives;
     }
-    else    // m_op == AND
+    else    // m_node->op == AND
     {
         std::vector<std::vector<boolean_function>> sub_primitives;
-        for (const auto& operand : m_operands)
+        for (const auto& operand : m_node->operands)
         {
             sub_primitives.push_back(operand.get_primitives());
         }
@@ -796,16 +1047,16 @@ boolean_function boolean_function::expand_ands() const
 
 boolean_function boolean_function::optimize_constants() const
 {
-    if (is_empty() || m_content == content_type::VARIABLE || m_content == content_type::CONSTANT)
+    if (is_empty() || m_node->content == content_type::VARIABLE || m_node->content == content_type::CONSTANT)
     {
         return *this;
     }
 
     std::vector<boolean_function> terms;
-    for (const auto& operand : m_operands)
+    for (const auto& operand : m_node->operands)
     {
         auto term = operand.optimize_constants();
-        if (m_op == operation::OR)
+        if (m_node->op == operation::OR)
         {
             if (term.is_constant_one())
             {
@@ -816,7 +1067,7 @@ boolean_function boolean_function::optimize_constants() const
                 continue;
             }
         }
-        else if (m_op == operation::AND)
+        else if (m_node->op == operation::AND)
         {
             if (term.is_constant_one())
             {
@@ -832,11 +1083,11 @@ boolean_function boolean_function::optimize_constants() const
 
     if (terms.empty())
     {
-        if (m_op == operation::OR)
+        if (m_node->op == operation::OR)
         {
             return boolean_function::ZERO;
         }
-        else if (m_op == operation::AND)
+        else if (m_node->op == operation::AND)
         {
             return boolean_function::ONE;
         }
@@ -847,22 +1098,22 @@ boolean_function boolean_function::optimize_constants() const
     {
         for (u32 j = i + 1; j < terms.size(); ++j)
         {
-            if (terms[i].m_content == content_type::VARIABLE && terms[j].m_content == content_type::VARIABLE && terms[i].m_variable == terms[j].m_variable)
+            if (terms[i].m_node->content == content_type::VARIABLE && terms[j].m_node->content == content_type::VARIABLE && terms[i].m_node->variable == terms[j].m_node->variable)
             {
-                if (terms[i].m_invert != terms[j].m_invert)
+                if (terms[i].m_node->invert != terms[j].m_node->invert)
                 {
-                    if (m_op == operation::AND)
+                    if (m_node->op == operation::AND)
                     {
                         return boolean_function::ZERO;
                     }
-                    else if (m_op == operation::OR)
+                    else if (m_node->op == operation::OR)
                     {
                         return boolean_function::ONE;
                     }
                 }
                 else
                 {
-                    if (m_op == operation::AND || m_op == operation::OR)
+                    if (m_node->op == operation::AND || m_node->op == operation::OR)
                     {
                         terms.erase(terms.begin() + j);
                         j--;
@@ -873,12 +1124,12 @@ boolean_function boolean_function::optimize_constants() const
         }
     }
 
-    return boolean_function(m_op, terms);
+    return boolean_function(m_node->op, terms);
 }
 
 boolean_function boolean_function::propagate_negations(bool negate_term) const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         if (negate_term)
         {
@@ -887,25 +1138,25 @@ boolean_function boolean_function::propagate_negations(bool negate_term) const
         return *this;
     }
 
-    bool use_de_morgan = m_invert ^ negate_term;
+    bool use_de_morgan = m_node->invert ^ negate_term;
 
     if (!use_de_morgan)
     {
         std::vector<boolean_function> terms;
-        for (const auto& operand : m_operands)
+        for (const auto& operand : m_node->operands)
         {
             terms.push_back(operand.propagate_negations(false));
         }
-        return boolean_function(m_op, terms);
+        return boolean_function(m_node->op, terms);
     }
     else
     {
         std::vector<boolean_function> terms;
-        for (const auto& operand : m_operands)
+        for (const auto& operand : m_node->operands)
         {
             terms.push_back(operand.propagate_negations(true));
         }
-        if (m_op == operation::AND)
+        if (m_node->op == operation::AND)
         {
             return boolean_function(operation::OR, terms);
         }
@@ -918,18 +1169,18 @@ boolean_function boolean_function::propagate_negations(bool negate_term) const
 
 boolean_function boolean_function::flatten() const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         return *this;
     }
 
     std::vector<boolean_function> terms;
-    for (const auto& operand : m_operands)
+    for (const auto& operand : m_node->operands)
     {
         auto term = operand.flatten();
-        if (term.m_content == content_type::TERMS && m_op == term.m_op)
+        if (term.m_node->content == content_type::TERMS && m_node->op == term.m_node->op)
         {
-            for (const auto& x : term.m_operands)
+            for (const auto& x : term.m_node->operands)
             {
                 terms.push_back(x);
             }
@@ -939,38 +1190,38 @@ boolean_function boolean_function::flatten() const
             terms.push_back(term);
         }
     }
-    return boolean_function(m_op, terms);
+    return boolean_function(m_node->op, terms);
 }
 
 bool boolean_function::is_dnf() const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         return true;
     }
-    if (m_op == operation::AND)
+    if (m_node->op == operation::AND)
     {
-        for (const auto& subterm : m_operands)
+        for (const auto& subterm : m_node->operands)
         {
-            if (subterm.m_content == content_type::TERMS || subterm.m_content == content_type::CONSTANT)
+            if (subterm.m_node->content == content_type::TERMS || subterm.m_node->content == content_type::CONSTANT)
             {
                 return false;
             }
         }
     }
-    else if (m_op != operation::OR)
+    else if (m_node->op != operation::OR)
     {
         return false;
     }
-    for (const auto& term : m_operands)
+    for (const auto& term : m_node->operands)
     {
-        if (term.m_content == content_type::TERMS)
+        if (term.m_node->content == content_type::TERMS)
         {
-            if (term.m_op == operation::AND)
+            if (term.m_node->op == operation::AND)
             {
-                for (const auto& subterm : term.m_operands)
+                for (const auto& subterm : term.m_node->operands)
                 {
-                    if (subterm.m_content == content_type::TERMS || subterm.m_content == content_type::CONSTANT)
+                    if (subterm.m_node->content == content_type::TERMS || subterm.m_node->content == content_type::CONSTANT)
                     {
                         return false;
                     }
@@ -1033,31 +1284,31 @@ std::vector<std::vector<std::pair<std::string, bool>>> boolean_function::get_dnf
 
     auto dnf = to_dnf();
 
-    if (dnf.m_content == content_type::VARIABLE)
+    if (dnf.m_node->content == content_type::VARIABLE)
     {
-        result.push_back({std::make_pair(dnf.m_variable, !dnf.m_invert)});
+        result.push_back({std::make_pair(dnf.m_node->variable, !dnf.m_node->invert)});
         return result;
     }
-    else if (dnf.m_content == content_type::CONSTANT)
+    else if (dnf.m_node->content == content_type::CONSTANT)
     {
-        result.push_back({std::make_pair(to_string(dnf.m_constant), true)});
+        result.push_back({std::make_pair(to_string(dnf.m_node->constant), true)});
         return result;
     }
-    if (dnf.m_op == operation::OR)
+    if (dnf.m_node->op == operation::OR)
     {
-        for (const auto& term : dnf.m_operands)
+        for (const auto& term : dnf.m_node->operands)
         {
             std::vector<std::pair<std::string, bool>> clause;
-            if (term.m_content == content_type::TERMS)
+            if (term.m_node->content == content_type::TERMS)
             {
-                for (const auto& v : term.m_operands)
+                for (const auto& v : term.m_node->operands)
                 {
-                    clause.push_back(std::make_pair(v.m_variable, !v.m_invert));
+                    clause.push_back(std::make_pair(v.m_node->variable, !v.m_node->invert));
                 }
             }
             else
             {
-                clause.push_back(std::make_pair(term.m_variable, !term.m_invert));
+                clause.push_back(std::make_pair(term.m_node->variable, !term.m_node->invert));
             }
             result.push_back(clause);
         }
@@ -1065,9 +1316,9 @@ std::vector<std::vector<std::pair<std::string, bool>>> boolean_function::get_dnf
     else
     {
         std::vector<std::pair<std::string, bool>> clause;
-        for (const auto& v : dnf.m_operands)
+        for (const auto& v : dnf.m_node->operands)
         {
-            clause.push_back(std::make_pair(v.m_variable, !v.m_invert));
+            clause.push_back(std::make_pair(v.m_node->variable, !v.m_node->invert));
         }
         result.push_back(clause);
     }
@@ -1076,8 +1327,6 @@ std::vector<std::vector<std::pair<std::string, bool>>> boolean_function::get_dnf
 
 std::vector<boolean_function::value> boolean_function::get_truth_table(std::vector<std::string> variables, bool remove_unknown_variables) const
 {
-    std::vector<value> result;
-
     auto unique_vars = get_variables();
     if (variables.empty())
     {
@@ -1088,30 +1337,33 @@ std::vector<boolean_function::value> boolean_function::get_truth_table(std::vect
         variables.erase(std::remove_if(variables.begin(), variables.end(), [&unique_vars](auto& s) { return unique_vars.find(s) == unique_vars.end(); }), variables.end());
     }
 
-    for (u32 values = 0; values < (u32)(1 << variables.size()); ++values)
-    {
-        std::map<std::string, boolean_function::value> inputs;
-        u32 tmp = values;
-        for (const auto& var : variables)
-        {
-            inputs[var] = (boolean_function::value)(tmp & 1);
-            tmp >>= 1;
-        }
-        result.push_back(evaluate(inputs));
-    }
-    return result;
+    return compiled_boolean_function(*this, variables).get_truth_table();
 }
 
 boolean_function boolean_function::optimize() const
 {
-    if (m_content != content_type::TERMS)
+    if (m_node->content != content_type::TERMS)
     {
         return *this;
     }
 
+    std::unordered_set<const node*> visited;
+    if (is_two_valued(visited))
+    {
+        auto vars_set = get_variables();
+        std::vector<std::string> vars(vars_set.begin(), vars_set.end());
+        if (vars.size() <= MAX_TRUTH_TABLE_ISOP_VARIABLES)
+        {
+            return from_truth_table(compiled_boolean_function(*this, vars).get_packed_truth_table().ones, vars);
+        }
+
+        bdd_manager manager(vars);
+        return from_clauses(manager.get_isop(manager.from_boolean_function(*this)));
+    }
+
     boolean_function result = to_dnf().propagate_negations().optimize_constants();
 
-    if (result.m_content != content_type::TERMS || result.m_op == operation::AND)
+    if (result.m_node->content != content_type::TERMS || result.m_node->op == operation::AND)
     {
         return result;
     }
@@ -1120,21 +1372,21 @@ boolean_function boolean_function::optimize() const
     std::vector<std::vector<value>> terms;
     auto vars_set = get_variables();
     std::vector<std::string> vars(vars_set.begin(), vars_set.end());
-    for (const auto& or_term : result.m_operands)
+    for (const auto& or_term : result.m_node->operands)
     {
         std::vector<value> term(vars.size(), value::X);
-        if (or_term.m_content == content_type::TERMS)
+        if (or_term.m_node->content == content_type::TERMS)
         {
-            for (const auto& and_term : or_term.m_operands)
+            for (const auto& and_term : or_term.m_node->operands)
             {
-                int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), and_term.m_variable));
-                term[index] = and_term.m_invert ? value::ZERO : value::ONE;
+                int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), and_term.m_node->variable));
+                term[index] = and_term.m_node->invert ? value::ZERO : value::ONE;
             }
         }
         else
         {
-            int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), or_term.m_variable));
-            term[index] = or_term.m_invert ? value::ZERO : value::ONE;
+            int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), or_term.m_node->variable));
+            term[index] = or_term.m_node->invert ? value::ZERO : value::ONE;
         }
         terms.emplace_back(term);
     }
@@ -1166,6 +1418,100 @@ boolean_function boolean_function::optimize() const
     return result;
 }
 
+bool boolean_function::is_two_valued(std::unordered_set<const node*>& visited) const
+{
+    if (m_node->content == content_type::CONSTANT)
+    {
+        return m_node->constant != value::X;
+    }
+    if (m_node->content == content_type::TERMS)
+    {
+        if (m_node->operands.empty())
+        {
+            return false;
+        }
+        if (visited.insert(m_node.get()).second)
+        {
+            return std::all_of(m_node->operands.begin(), m_node->operands.end(), [&visited](const auto& operand) { return operand.is_two_valued(visited); });
+        }
+    }
+    return true;
+}
+
+boolean_function boolean_function::from_truth_table(const std::vector<u64>& table, const std::vector<std::string>& variables)
+{
+    if (variables.size() > 32)
+    {
+        log_error("netlist", "truth tables are limited to 32 variables, but {} were given.", variables.size());
+        return boolean_function();
+    }
+
+    u32 num_vars  = variables.size();
+    u64 num_words = (num_vars <= 6) ? 1 : (1ull << (num_vars - 6));
+    if (table.size() > num_words)
+    {
+        log_error("netlist", "a truth table over {} variables consists of {} words, but {} were given.", num_vars, num_words, table.size());
+        return boolean_function();
+    }
+
+    if (num_vars > MAX_TRUTH_TABLE_ISOP_VARIABLES)
+    {
+        // the table is split at the most significant variable first, hence it is the top of the BDD
+        bdd_manager manager(std::vector<std::string>(variables.rbegin(), variables.rend()));
+        return from_clauses(manager.get_isop(truth_table_to_bdd(manager, table, variables, num_vars, 0)));
+    }
+
+    // missing rows are ZERO and unused bits of a small table must not end up in the cover
+    truth_table onset(table);
+    onset.resize(num_words, 0);
+    onset[0] &= word_mask(num_vars);
+
+    std::vector<cube> cover;
+    isop(onset, onset, num_vars, cover);
+
+    std::vector<std::vector<std::pair<std::string, bool>>> clauses;
+    for (const auto& c : cover)
+    {
+        std::vector<std::pair<std::string, bool>> clause;
+        for (u32 i = 0; i < num_vars; ++i)
+        {
+            if ((c.positive >> i) & 1)
+            {
+                clause.emplace_back(variables[i], true);
+            }
+            else if ((c.negative >> i) & 1)
+            {
+                clause.emplace_back(variables[i], false);
+            }
+        }
+        clauses.push_back(clause);
+    }
+    return from_clauses(clauses);
+}
+
+boolean_function boolean_function::from_clauses(const std::vector<std::vector<std::pair<std::string, bool>>>& clauses)
+{
+    boolean_function result;
+    for (const auto& clause : clauses)
+    {
+        boolean_function tmp;
+        for (const auto& [variable, polarity] : clause)
+        {
+            tmp &= polarity ? boolean_function(variable) : !boolean_function(variable);
+        }
+        if (tmp.is_empty())    // all variables are "dont care"
+        {
+            tmp = value::ONE;
+        }
+        result |= tmp;
+    }
+    if (result.is_empty())    // no clause at all
+    {
+        result = value::ZERO;
+    }
+    return result;
+}
+
 std::vector<std::vector<boolean_function::value>> boolean_function::qmc(const std::vector<std::vector<value>>& terms)
 {
     std::vector<std::vector<value>> result;
@@ -0,0 +1,327 @@
+#include "netlist/compiled_boolean_function.h"
+
+#include "core/log.h"
+
+#include <algorithm>
+
+namespace
+{
+    using value = boolean_function::value;
+
+    // three-valued truth tables, indexed by value + 1
+    constexpr value AND_TABLE[3][3] = {{value::X, value::ZERO, value::X}, {value::ZERO, value::ZERO, value::ZERO}, {value::X, value::ZERO, value::ONE}};
+    constexpr value OR_TABLE[3][3]  = {{value::X, value::X, value::ONE}, {value::X, value::ZERO, value::ONE}, {value::ONE, value::ONE, value::ONE}};
+    constexpr value XOR_TABLE[3][3] = {{value::X, value::X, value::X}, {value::X, value::ZERO, value::ONE}, {value::X, value::ONE, value::ZERO}};
+    constexpr value NOT_TABLE[3]    = {value::X, value::ONE, value::ZERO};
+
+    // bit-sliced values of the six fastest changing truth table variables within one word of 64 rows
+    constexpr u64 ROW_PATTERNS[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull, 0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+    std::vector<std::string> sorted_variables(const boolean_function& function)
+    {
+        auto unique_vars = function.get_variables();
+        return std::vector<std::string>(unique_vars.begin(), unique_vars.end());
+    }
+}    // namespace
+
+u64 packed_truth_table::size() const
+{
+    return (u64)1 << num_variables;
+}
+
+boolean_function::value packed_truth_table::get(u64 row) const
+{
+    u64 mask = (u64)1 << (row & 63);
+    if (ones[row >> 6] & mask)
+    {
+        return value::ONE;
+    }
+    if (zeros[row >> 6] & mask)
+    {
+        return value::ZERO;
+    }
+    return value::X;
+}
+
+std::vector<boolean_function::value> packed_truth_table::unpack() const
+{
+    std::vector<value> result;
+    result.reserve(size());
+    for (u64 row = 0; row < size(); ++row)
+    {
+        result.push_back(get(row));
+    }
+    return result;
+}
+
+bool packed_truth_table::operator==(const packed_truth_table& other) const
+{
+    return num_variables == other.num_variables && ones == other.ones && zeros == other.zeros;
+}
+
+bool packed_truth_table::operator!=(const packed_truth_table& other) const
+{
+    return !(*this == other);
+}
+
+compiled_boolean_function::compiled_boolean_function()
+{
+    m_instructions.push_back({opcode::LOAD_CONST, value::X});
+    m_stack_size = 1;
+}
+
+compiled_boolean_function::compiled_boolean_function(const boolean_function& function) : compiled_boolean_function(function, sorted_variables(function))
+{
+}
+
+compiled_boolean_function::compiled_boolean_function(const boolean_function& function, const std::vector<std::string>& variables) : m_variables(variables)
+{
+    for (u32 i = 0; i < m_variables.size(); ++i)
+    {
+        // a repeated variable is bound to its last slot
+        m_slots[m_variables[i]] = i;
+    }
+
+    m_stack_size = 0;
+    compile(function, 0);
+}
+
+void compiled_boolean_function::compile(const boolean_function& function, u32 depth)
+{
+    m_stack_size = std::max(m_stack_size, depth + 1);
+
+    if (function.m_node->content == boolean_function::content_type::VARIABLE)
+    {
+        if (auto it = m_slots.find(function.m_node->variable); it != m_slots.end())
+        {
+            m_instructions.push_back({opcode::LOAD_SLOT, (i32)it->second});
+        }
+        else
+        {
+            m_instructions.push_back({opcode::LOAD_CONST, value::X});
+        }
+    }
+    else if (function.m_node->content == boolean_function::content_type::CONSTANT)
+    {
+        m_instructions.push_back({opcode::LOAD_CONST, function.m_node->constant});
+    }
+    else if (function.m_node->operands.empty())
+    {
+        m_instructions.push_back({opcode::LOAD_CONST, value::X});
+    }
+    else
+    {
+        opcode op = opcode::AND;
+        if (function.m_node->op == boolean_function::operation::OR)
+        {
+            op = opcode::OR;
+        }
+        else if (function.m_node->op == boolean_function::operation::XOR)
+        {
+            op = opcode::XOR;
+        }
+
+        // n-ary operations are lowered into a left-leaning chain of binary operations
+        compile(function.m_node->operands[0], depth);
+        for (u32 i = 1; i < function.m_node->operands.size(); ++i)
+        {
+            compile(function.m_node->operands[i], depth + 1);
+            m_instructions.push_back({op, 0});
+        }
+    }
+
+    if (function.m_node->invert)
+    {
+        auto& last = m_instructions.back();
+        if (last.op == opcode::LOAD_CONST)
+        {
+            last.operand = NOT_TABLE[last.operand + 1];
+        }
+        else
+        {
+            m_instructions.push_back({opcode::NOT, 0});
+        }
+    }
+}
+
+const std::vector<std::string>& compiled_boolean_function::get_variables() const
+{
+    return m_variables;
+}
+
+u32 compiled_boolean_function::get_num_slots() const
+{
+    return m_variables.size();
+}
+
+i32 compiled_boolean_function::get_slot(const std::string& variable) const
+{
+    auto it = m_slots.find(variable);
+    if (it == m_slots.end())
+    {
+        return -1;
+    }
+    return it->second;
+}
+
+u32 compiled_boolean_function::get_num_instructions() const
+{
+    return m_instructions.size();
+}
+
+boolean_function::value compiled_boolean_function::run(const boolean_function::value* inputs, boolean_function::value* stack) const
+{
+    value* top = stack - 1;
+    for (const auto& ins : m_instructions)
+    {
+        switch (ins.op)
+        {
+            case opcode::LOAD_SLOT:
+                *(++top) = inputs[ins.operand];
+                break;
+            case opcode::LOAD_CONST:
+                *(++top) = (value)ins.operand;
+                break;
+            case opcode::AND:
+                --top;
+                *top = AND_TABLE[*top + 1][*(top + 1) + 1];
+                break;
+            case opcode::OR:
+                --top;
+                *top = OR_TABLE[*top + 1][*(top + 1) + 1];
+                break;
+            case opcode::XOR:
+                --top;
+                *top = XOR_TABLE[*top + 1][*(top + 1) + 1];
+                break;
+            case opcode::NOT:
+                *top = NOT_TABLE[*top + 1];
+                break;
+        }
+    }
+    return *top;
+}
+
+boolean_function::value compiled_boolean_function::evaluate(const boolean_function::value* inputs) const
+{
+    if (m_stack_size <= MAX_INLINE_STACK_SIZE)
+    {
+        value stack[MAX_INLINE_STACK_SIZE];
+        return run(inputs, stack);
+    }
+
+    // only pathologically deep functions need a heap-allocated stack
+    std::vector<value> stack(m_stack_size);
+    return run(inputs, stack.data());
+}
+
+boolean_function::value compiled_boolean_function::evaluate(const std::vector<boolean_function::value>& inputs) const
+{
+    if (inputs.size() < m_variables.size())
+    {
+        log_error("netlist", "cannot evaluate compiled function, expected {} inputs but got {}.", m_variables.size(), inputs.size());
+        return value::X;
+    }
+    return evaluate(inputs.data());
+}
+
+boolean_function::value compiled_boolean_function::operator()(const boolean_function::value* inputs) const
+{
+    return evaluate(inputs);
+}
+
+compiled_boolean_function::value_slice compiled_boolean_function::run(const value_slice* inputs, value_slice* stack) const
+{
+    value_slice* top = stack - 1;
+    for (const auto& ins : m_instructions)
+    {
+        switch (ins.op)
+        {
+            case opcode::LOAD_SLOT:
+                *(++top) = inputs[ins.operand];
+                break;
+            case opcode::LOAD_CONST:
+                *(++top) = {(ins.operand == value::ONE) ? ~0ull : 0ull, (ins.operand == value::ZERO) ? ~0ull : 0ull};
+                break;
+            case opcode::AND: {
+                const value_slice b = *(top--);
+                top->ones &= b.ones;
+                top->zeros |= b.zeros;
+                break;
+            }
+            case opcode::OR: {
+                const value_slice b = *(top--);
+                top->ones |= b.ones;
+                top->zeros &= b.zeros;
+                break;
+            }
+            case opcode::XOR: {
+                const value_slice b = *(top--);
+                const value_slice a = *top;
+                *top                = {(a.ones & b.zeros) | (a.zeros & b.ones), (a.ones & b.ones) | (a.zeros & b.zeros)};
+                break;
+            }
+            case opcode::NOT:
+                std::swap(top->ones, top->zeros);
+                break;
+        }
+    }
+    return *top;
+}
+
+compiled_boolean_function::value_slice compiled_boolean_function::evaluate(const value_slice* inputs) const
+{
+    if (m_stack_size <= MAX_INLINE_STACK_SIZE)
+    {
+        value_slice stack[MAX_INLINE_STACK_SIZE];
+        return run(inputs, stack);
+    }
+
+    std::vector<value_slice> stack(m_stack_size);
+    return run(inputs, stack.data());
+}
+
+packed_truth_table compiled_boolean_function::get_packed_truth_table() const
+{
+    packed_truth_table result;
+
+    u32 num_vars = m_variables.size();
+    if (num_vars >= 64)
+    {
+        log_error("netlist", "cannot compute a truth table of {} variables.", num_vars);
+        return result;
+    }
+
+    u64 num_rows  = (u64)1 << num_vars;
+    u64 num_words = (num_rows + 63) / 64;
+    u64 row_mask  = (num_rows >= 64) ? ~0ull : (((u64)1 << num_rows) - 1);
+
+    result.num_variables = num_vars;
+    result.ones.resize(num_words);
+    result.zeros.resize(num_words);
+
+    // the first six variables follow a fixed pattern within every word, all others are constant per word
+    std::vector<value_slice> inputs(num_vars);
+    for (u32 i = 0; i < std::min(num_vars, 6u); ++i)
+    {
+        inputs[i] = {ROW_PATTERNS[i], ~ROW_PATTERNS[i]};
+    }
+    for (u64 word = 0; word < num_words; ++word)
+    {
+        for (u32 i = 6; i < num_vars; ++i)
+        {
+            bool bit  = (word >> (i - 6)) & 1;
+            inputs[i] = {bit ? ~0ull : 0ull, bit ? 0ull : ~0ull};
+        }
+
+        auto slice         = evaluate(inputs.data());
+        result.ones[word]  = slice.ones & row_mask;
+        result.zeros[word] = slice.zeros & row_mask;
+    }
+    return result;
+}
+
+std::vector<boolean_function::value> compiled_boolean_function::get_truth_table() const
+{
+    return get_packed_truth_table().unpack();
+}
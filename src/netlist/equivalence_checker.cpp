@@ -0,0 +1,277 @@
+#include "netlist/equivalence_checker.h"
+
+#include "core/log.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
+#include "netlist/simulation/simulation_model.h"
+
+#include <algorithm>
+
+equivalence_checker::equivalence_checker(const std::shared_ptr<netlist>& nl, u32 num_simulation_words, u64 seed) : m_netlist(nl)
+{
+    if (nl == nullptr)
+    {
+        log_error("netlist", "cannot check the nets of a netlist that is a nullptr.");
+    }
+    else
+    {
+        m_aig.add_netlist(nl);
+    }
+
+    m_sat_variables.assign(m_aig.get_num_nodes(), sat_solver::INVALID);
+
+    u64 state = (seed == 0) ? 1 : seed;
+    std::vector<u64> input_word(m_aig.get_inputs().size());
+    for (u32 w = 0; w < std::max<u32>(num_simulation_words, 1); ++w)
+    {
+        for (auto& value : input_word)
+        {
+            value = simulation_model::next_random(state);
+        }
+        m_signatures.push_back(simulate(input_word));
+    }
+}
+
+std::vector<u64> equivalence_checker::simulate(const std::vector<u64>& input_word) const
+{
+    std::vector<u64> values(m_aig.get_num_nodes(), 0);
+    const auto& inputs = m_aig.get_inputs();
+    for (u32 i = 0; i < inputs.size(); ++i)
+    {
+        values[inputs[i] >> 1] = input_word[i];
+    }
+
+    // node order is a topological order
+    auto get_value = [&values](u32 literal) { return values[literal >> 1] ^ ((literal & 1) ? ~0ull : 0); };
+    for (u32 node = 1; node < values.size(); ++node)
+    {
+        if (m_aig.is_and(node << 1))
+        {
+            auto [a, b]  = m_aig.get_fan_in(node << 1);
+            values[node] = get_value(a) & get_value(b);
+        }
+    }
+    return values;
+}
+
+u64 equivalence_checker::get_signature(u32 literal, u32 word) const
+{
+    return m_signatures[word][literal >> 1] ^ ((literal & 1) ? ~0ull : 0);
+}
+
+bool equivalence_checker::have_equal_signatures(u32 a, u32 b) const
+{
+    for (u32 w = 0; w < m_signatures.size(); ++w)
+    {
+        if (get_signature(a, w) != get_signature(b, w))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+u32 equivalence_checker::encode(u32 literal)
+{
+    // Tseitin encoding of the cone, fan-ins are encoded before their fan-outs
+    std::vector<u32> stack = {literal >> 1};
+    while (!stack.empty())
+    {
+        u32 node = stack.back();
+        if (m_sat_variables[node] != sat_solver::INVALID)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        if (node == 0)
+        {
+            m_sat_variables[node] = m_solver.create_variable();
+            m_solver.add_clause({sat_solver::get_literal(m_sat_variables[node], true)});
+            stack.pop_back();
+            continue;
+        }
+        if (!m_aig.is_and(node << 1))
+        {
+            m_sat_variables[node] = m_solver.create_variable();
+            stack.pop_back();
+            continue;
+        }
+
+        auto [a, b]      = m_aig.get_fan_in(node << 1);
+        bool fan_in_done = true;
+        for (u32 fan_in : {a, b})
+        {
+            if (m_sat_variables[fan_in >> 1] == sat_solver::INVALID)
+            {
+                stack.push_back(fan_in >> 1);
+                fan_in_done = false;
+            }
+        }
+        if (!fan_in_done)
+        {
+            continue;
+        }
+
+        u32 variable = m_solver.create_variable();
+        u32 out      = sat_solver::get_literal(variable);
+        u32 in_a     = sat_solver::get_literal(m_sat_variables[a >> 1], a & 1);
+        u32 in_b     = sat_solver::get_literal(m_sat_variables[b >> 1], b & 1);
+        m_solver.add_clause({out ^ 1, in_a});
+        m_solver.add_clause({out ^ 1, in_b});
+        m_solver.add_clause({out, in_a ^ 1, in_b ^ 1});
+        m_sat_variables[node] = variable;
+        stack.pop_back();
+    }
+
+    return sat_solver::get_literal(m_sat_variables[literal >> 1], literal & 1);
+}
+
+bool equivalence_checker::is_unsatisfiable(const std::vector<u32>& assumptions)
+{
+    m_num_sat_calls++;
+    auto res = m_solver.solve(assumptions);
+    if (res == sat_solver::result::SATISFIABLE)
+    {
+        add_counterexample();
+    }
+    return res == sat_solver::result::UNSATISFIABLE;
+}
+
+void equivalence_checker::add_counterexample()
+{
+    // counterexamples are collected bit by bit in an additional word, starting from an arbitrary valid pattern
+    u32 bit = m_num_counterexamples++ % 64;
+    if (bit == 0)
+    {
+        m_counterexample_word.clear();
+        for (u32 input : m_aig.get_inputs())
+        {
+            m_counterexample_word.push_back(m_signatures[0][input >> 1]);
+        }
+        m_signatures.emplace_back();
+    }
+
+    const auto& inputs = m_aig.get_inputs();
+    for (u32 i = 0; i < inputs.size(); ++i)
+    {
+        u32 variable = m_sat_variables[inputs[i] >> 1];
+        if (variable != sat_solver::INVALID)
+        {
+            u64 mask = 1ull << bit;
+            m_counterexample_word[i] = m_solver.get_model_value(variable) ? (m_counterexample_word[i] | mask) : (m_counterexample_word[i] & ~mask);
+        }
+    }
+    m_signatures.back() = simulate(m_counterexample_word);
+}
+
+bool equivalence_checker::are_equivalent(const std::shared_ptr<net>& a, const std::shared_ptr<net>& b)
+{
+    u32 literal_a = m_aig.get_net_literal(a);
+    u32 literal_b = m_aig.get_net_literal(b);
+    if (literal_a == and_inverter_graph::INVALID || literal_b == and_inverter_graph::INVALID)
+    {
+        log_error("netlist", "cannot check the equivalence of nets that are not part of the netlist.");
+        return false;
+    }
+
+    if (literal_a == literal_b)
+    {
+        return true;
+    }
+    if (!have_equal_signatures(literal_a, literal_b))
+    {
+        return false;
+    }
+
+    u32 sat_a = encode(literal_a);
+    u32 sat_b = encode(literal_b);
+    if (!is_unsatisfiable({sat_a, sat_b ^ 1}) || !is_unsatisfiable({sat_a ^ 1, sat_b}))
+    {
+        return false;
+    }
+
+    // the equivalence holds, so it can be used to speed up later queries
+    m_solver.add_clause({sat_a ^ 1, sat_b});
+    m_solver.add_clause({sat_a, sat_b ^ 1});
+    return true;
+}
+
+boolean_function::value equivalence_checker::get_constant_value(const std::shared_ptr<net>& n)
+{
+    u32 literal = m_aig.get_net_literal(n);
+    if (literal == and_inverter_graph::INVALID)
+    {
+        log_error("netlist", "cannot check whether a net is constant that is not part of the netlist.");
+        return boolean_function::X;
+    }
+
+    if (literal == and_inverter_graph::ZERO || literal == and_inverter_graph::ONE)
+    {
+        return (literal == and_inverter_graph::ONE) ? boolean_function::ONE : boolean_function::ZERO;
+    }
+    if (m_aig.is_input(literal))
+    {
+        return boolean_function::X;
+    }
+
+    for (auto candidate : {boolean_function::ZERO, boolean_function::ONE})
+    {
+        u64 expected = (candidate == boolean_function::ONE) ? ~0ull : 0;
+        bool matches = true;
+        for (u32 w = 0; w < m_signatures.size() && matches; ++w)
+        {
+            matches = (get_signature(literal, w) == expected);
+        }
+        if (!matches)
+        {
+            continue;
+        }
+
+        // the net is constant if it cannot take the other value
+        u32 sat_literal = encode(literal) ^ ((candidate == boolean_function::ONE) ? 1 : 0);
+        if (is_unsatisfiable({sat_literal}))
+        {
+            m_solver.add_clause({sat_literal ^ 1});
+            return candidate;
+        }
+        return boolean_function::X;
+    }
+    return boolean_function::X;
+}
+
+std::map<std::shared_ptr<net>, boolean_function::value> equivalence_checker::find_constant_nets()
+{
+    std::map<std::shared_ptr<net>, boolean_function::value> result;
+    if (m_netlist == nullptr)
+    {
+        return result;
+    }
+
+    auto nets = m_netlist->get_nets();
+    std::vector<std::shared_ptr<net>> sorted_nets(nets.begin(), nets.end());
+    std::sort(sorted_nets.begin(), sorted_nets.end(), [](const auto& a, const auto& b) { return a->get_id() < b->get_id(); });
+
+    for (const auto& n : sorted_nets)
+    {
+        if (m_aig.get_net_literal(n) == and_inverter_graph::INVALID)
+        {
+            continue;
+        }
+        if (auto value = get_constant_value(n); value != boolean_function::X)
+        {
+            result.emplace(n, value);
+        }
+    }
+    return result;
+}
+
+const and_inverter_graph& equivalence_checker::get_and_inverter_graph() const
+{
+    return m_aig;
+}
+
+u32 equivalence_checker::get_num_sat_calls() const
+{
+    return m_num_sat_calls;
+}
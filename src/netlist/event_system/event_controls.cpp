@@ -1,14 +1,259 @@
 #include "netlist/event_system/event_controls.h"
 
+#include "netlist/gate.h"
+#include "netlist/module.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
 
-#include "netlist/event_system/gate_event_handler.h"
-#include "netlist/event_system/module_event_handler.h"
-#include "netlist/event_system/net_event_handler.h"
-#include "netlist/event_system/netlist_event_handler.h"
+#include "core/log.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
 
 namespace event_controls
 {
-    
+    namespace
+    {
+        enum class handler_kind : u8
+        {
+            netlist,
+            gate,
+            net,
+            module
+        };
+
+        /** how an event is treated when a batch is coalesced */
+        enum class event_category
+        {
+            lifecycle_created,
+            lifecycle_removed,
+            state,        // only the last occurrence matters
+            pair_add,       // cancelled by a later matching pair_remove
+            pair_remove,
+            other
+        };
+
+        struct recorded_event
+        {
+            handler_kind kind;
+            u32 event;
+            std::shared_ptr<void> object;
+            u32 associated_data;
+        };
+
+        struct batch
+        {
+            std::shared_ptr<netlist> nl;
+            u32 depth = 0;
+            std::vector<recorded_event> recorded;
+        };
+
+        // active batches by netlist, the batch keeps its netlist alive until it is committed
+        std::map<const netlist*, batch> batches;
+        u32 committing = 0;
+        callback_hook<void(const change_set&)> batch_callback;
+
+        // returns the batch of the netlist or nullptr if none is active
+        batch* find_batch(const netlist* nl)
+        {
+            if (batches.empty())
+            {
+                return nullptr;
+            }
+            auto it = batches.find(nl);
+            return (it == batches.end()) ? nullptr : &it->second;
+        }
+
+        bool record_in_batch(const netlist* nl, handler_kind kind, u32 ev, const std::shared_ptr<void>& object, u32 associated_data)
+        {
+            auto b = find_batch(nl);
+            if (b == nullptr)
+            {
+                return false;
+            }
+            b->recorded.push_back({kind, ev, object, associated_data});
+            return true;
+        }
+
+        // returns the category of an event and for paired events the event that opens the pair
+        std::pair<event_category, u32> categorize(handler_kind kind, u32 ev)
+        {
+            switch (kind)
+            {
+                case handler_kind::netlist:
+                    switch (ev)
+                    {
+                        case netlist_event_handler::input_filename_changed:
+                        case netlist_event_handler::design_name_changed:
+                        case netlist_event_handler::device_name_changed:
+                            return {event_category::state, ev};
+                        case netlist_event_handler::marked_global_vcc:
+                        case netlist_event_handler::marked_global_gnd:
+                        case netlist_event_handler::marked_global_input:
+                        case netlist_event_handler::marked_global_output:
+                        case netlist_event_handler::marked_global_inout:
+                            return {event_category::pair_add, ev};
+                        case netlist_event_handler::unmarked_global_vcc:
+                            return {event_category::pair_remove, netlist_event_handler::marked_global_vcc};
+                        case netlist_event_handler::unmarked_global_gnd:
+                            return {event_category::pair_remove, netlist_event_handler::marked_global_gnd};
+                        case netlist_event_handler::unmarked_global_input:
+                            return {event_category::pair_remove, netlist_event_handler::marked_global_input};
+                        case netlist_event_handler::unmarked_global_output:
+                            return {event_category::pair_remove, netlist_event_handler::marked_global_output};
+                        case netlist_event_handler::unmarked_global_inout:
+                            return {event_category::pair_remove, netlist_event_handler::marked_global_inout};
+                        default:
+                            return {event_category::other, ev};
+                    }
+                case handler_kind::gate:
+                    switch (ev)
+                    {
+                        case gate_event_handler::created:
+                            return {event_category::lifecycle_created, ev};
+                        case gate_event_handler::removed:
+                            return {event_category::lifecycle_removed, ev};
+                        case gate_event_handler::name_changed:
+                        case gate_event_handler::location_changed:
+                            return {event_category::state, ev};
+                        default:
+                            return {event_category::other, ev};
+                    }
+                case handler_kind::net:
+                    switch (ev)
+                    {
+                        case net_event_handler::created:
+                            return {event_category::lifecycle_created, ev};
+                        case net_event_handler::removed:
+                            return {event_category::lifecycle_removed, ev};
+                        case net_event_handler::name_changed:
+                        case net_event_handler::src_changed:
+                            return {event_category::state, ev};
+                        case net_event_handler::dst_added:
+                            return {event_category::pair_add, ev};
+                        case net_event_handler::dst_removed:
+                            return {event_category::pair_remove, net_event_handler::dst_added};
+                        default:
+                            return {event_category::other, ev};
+                    }
+                case handler_kind::module:
+                    switch (ev)
+                    {
+                        case module_event_handler::created:
+                            return {event_category::lifecycle_created, ev};
+                        case module_event_handler::removed:
+                            return {event_category::lifecycle_removed, ev};
+                        case module_event_handler::name_changed:
+                        case module_event_handler::parent_changed:
+                            return {event_category::state, ev};
+                        case module_event_handler::submodule_added:
+                        case module_event_handler::gate_assigned:
+                            return {event_category::pair_add, ev};
+                        case module_event_handler::submodule_removed:
+                            return {event_category::pair_remove, module_event_handler::submodule_added};
+                        case module_event_handler::gate_removed:
+                            return {event_category::pair_remove, module_event_handler::gate_assigned};
+                        default:
+                            return {event_category::other, ev};
+                    }
+            }
+            return {event_category::other, ev};
+        }
+
+        std::vector<recorded_event> coalesce(std::vector<recorded_event>&& events)
+        {
+            std::vector<bool> keep(events.size(), true);
+
+            // objects removed within the batch only need their removal, objects that were also created need nothing at all
+            std::map<std::pair<handler_kind, const void*>, std::pair<bool, bool>> lifecycle;
+            for (const auto& e : events)
+            {
+                auto category = categorize(e.kind, e.event).first;
+                if (category == event_category::lifecycle_created)
+                {
+                    lifecycle[{e.kind, e.object.get()}].first = true;
+                }
+                else if (category == event_category::lifecycle_removed)
+                {
+                    lifecycle[{e.kind, e.object.get()}].second = true;
+                }
+            }
+
+            // per state event only the last occurrence, per pair a removal cancels the latest pending addition
+            // (e.g., a net connected to two pins of the same gate yields two additions that must not be merged)
+            std::map<std::tuple<handler_kind, u32, const void*>, u32> last_state;
+            std::map<std::tuple<handler_kind, u32, const void*, u32>, std::vector<u32>> pending_additions;
+            for (u32 i = 0; i < events.size(); ++i)
+            {
+                const auto& e = events[i];
+                if (auto it = lifecycle.find({e.kind, e.object.get()}); it != lifecycle.end() && it->second.second)
+                {
+                    bool created = it->second.first;
+                    keep[i]      = !created && categorize(e.kind, e.event).first == event_category::lifecycle_removed;
+                    continue;
+                }
+
+                auto [category, group] = categorize(e.kind, e.event);
+                if (category == event_category::state)
+                {
+                    auto key = std::make_tuple(e.kind, e.event, e.object.get());
+                    if (auto it = last_state.find(key); it != last_state.end())
+                    {
+                        keep[it->second] = false;
+                    }
+                    last_state[key] = i;
+                }
+                else if (category == event_category::pair_add)
+                {
+                    pending_additions[std::make_tuple(e.kind, group, e.object.get(), e.associated_data)].push_back(i);
+                }
+                else if (category == event_category::pair_remove)
+                {
+                    // a removal without a pending addition is kept, e.g. removed and added again with another pin
+                    auto& pending = pending_additions[std::make_tuple(e.kind, group, e.object.get(), e.associated_data)];
+                    if (!pending.empty())
+                    {
+                        keep[pending.back()] = false;
+                        keep[i]              = false;
+                        pending.pop_back();
+                    }
+                }
+            }
+
+            std::vector<recorded_event> res;
+            for (u32 i = 0; i < events.size(); ++i)
+            {
+                if (keep[i])
+                {
+                    res.push_back(std::move(events[i]));
+                }
+            }
+            return res;
+        }
+
+        template<typename T>
+        void summarize(const recorded_event& e, std::set<std::shared_ptr<T>>& created, std::set<std::shared_ptr<T>>& removed, std::set<std::shared_ptr<T>>& modified)
+        {
+            auto object   = std::static_pointer_cast<T>(e.object);
+            auto category = categorize(e.kind, e.event).first;
+            if (category == event_category::lifecycle_created)
+            {
+                created.insert(object);
+                modified.erase(object);
+            }
+            else if (category == event_category::lifecycle_removed)
+            {
+                removed.insert(object);
+                modified.erase(object);
+            }
+            else if (created.find(object) == created.end() && removed.find(object) == removed.end())
+            {
+                modified.insert(object);
+            }
+        }
+    }    // namespace
+
     void enable_all(bool flag)
     {
         netlist_event_handler::enable(flag);
@@ -17,4 +262,129 @@ namespace event_controls
         module_event_handler::enable(flag);
     }
 
+    void begin_batch(const std::shared_ptr<netlist>& nl)
+    {
+        if (nl == nullptr)
+        {
+            log_error("event", "cannot begin batch, netlist is a nullptr.");
+            return;
+        }
+        auto& b = batches[nl.get()];
+        b.nl    = nl;
+        ++b.depth;
+    }
+
+    bool commit_batch(const std::shared_ptr<netlist>& nl)
+    {
+        auto it = batches.find(nl.get());
+        if (nl == nullptr || it == batches.end())
+        {
+            log_error("event", "cannot commit batch, no batch is active for the netlist.");
+            return false;
+        }
+        if (--it->second.depth > 0)
+        {
+            return true;
+        }
+
+        // the batch ends before dispatching, so that callbacks may modify the netlist and start new batches
+        auto events = coalesce(std::move(it->second.recorded));
+        batches.erase(it);
+
+        change_set changes;
+        changes.batch_netlist = nl;
+        for (const auto& e : events)
+        {
+            switch (e.kind)
+            {
+                case handler_kind::netlist:
+                    changes.modified_netlists.insert(std::static_pointer_cast<netlist>(e.object));
+                    break;
+                case handler_kind::gate:
+                    summarize(e, changes.created_gates, changes.removed_gates, changes.modified_gates);
+                    break;
+                case handler_kind::net:
+                    summarize(e, changes.created_nets, changes.removed_nets, changes.modified_nets);
+                    break;
+                case handler_kind::module:
+                    summarize(e, changes.created_modules, changes.removed_modules, changes.modified_modules);
+                    break;
+            }
+        }
+
+        ++committing;
+        for (const auto& e : events)
+        {
+            switch (e.kind)
+            {
+                case handler_kind::netlist:
+                    netlist_event_handler::notify((netlist_event_handler::event)e.event, std::static_pointer_cast<netlist>(e.object), e.associated_data);
+                    break;
+                case handler_kind::gate:
+                    gate_event_handler::notify((gate_event_handler::event)e.event, std::static_pointer_cast<gate>(e.object), e.associated_data);
+                    break;
+                case handler_kind::net:
+                    net_event_handler::notify((net_event_handler::event)e.event, std::static_pointer_cast<net>(e.object), e.associated_data);
+                    break;
+                case handler_kind::module:
+                    module_event_handler::notify((module_event_handler::event)e.event, std::static_pointer_cast<module>(e.object), e.associated_data);
+                    break;
+            }
+        }
+        batch_callback(changes);
+        --committing;
+
+        return true;
+    }
+
+    bool is_batch_active(const std::shared_ptr<netlist>& nl)
+    {
+        return find_batch(nl.get()) != nullptr;
+    }
+
+    bool is_committing_batch()
+    {
+        return committing > 0;
+    }
+
+    void register_batch_callback(const std::string& name, std::function<void(const change_set&)> function)
+    {
+        batch_callback.add_callback(name, std::move(function));
+    }
+
+    void unregister_batch_callback(const std::string& name)
+    {
+        batch_callback.remove_callback(name);
+    }
+
+    bool record(netlist_event_handler::event ev, const std::shared_ptr<netlist>& object, u32 associated_data)
+    {
+        return !batches.empty() && record_in_batch(object.get(), handler_kind::netlist, (u32)ev, object, associated_data);
+    }
+
+    bool record(gate_event_handler::event ev, const std::shared_ptr<gate>& object, u32 associated_data)
+    {
+        return !batches.empty() && record_in_batch(object->get_netlist().get(), handler_kind::gate, (u32)ev, object, associated_data);
+    }
+
+    bool record(net_event_handler::event ev, const std::shared_ptr<net>& object, u32 associated_data)
+    {
+        return !batches.empty() && record_in_batch(object->get_netlist().get(), handler_kind::net, (u32)ev, object, associated_data);
+    }
+
+    bool record(module_event_handler::event ev, const std::shared_ptr<module>& object, u32 associated_data)
+    {
+        return !batches.empty() && record_in_batch(object->get_netlist().get(), handler_kind::module, (u32)ev, object, associated_data);
+    }
+
+    scoped_batch::scoped_batch(const std::shared_ptr<netlist>& nl) : m_netlist(nl)
+    {
+        begin_batch(m_netlist);
+    }
+
+    scoped_batch::~scoped_batch()
+    {
+        commit_batch(m_netlist);
+    }
+
 }    // namespace event_controls
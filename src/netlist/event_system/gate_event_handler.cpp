@@ -1,11 +1,12 @@
 #include "netlist/event_system/gate_event_handler.h"
+#include "netlist/event_system/event_controls.h"
 #include "netlist/gate.h"
 
 namespace gate_event_handler
 {
     namespace
     {
-        callback_hook<void(event, std::shared_ptr<gate>, u32)> m_callback;
+        callback_hook<void(event, const std::shared_ptr<gate>&, u32)> m_callback;
         bool enabled = true;
     }    // namespace
 
@@ -14,17 +15,20 @@ namespace gate_event_handler
         enabled = flag;
     }
 
-    void notify(event c, std::shared_ptr<gate> gate, u32 associated_data)
+    void notify(event c, const std::shared_ptr<gate>& gate, u32 associated_data)
     {
         if (enabled)
         {
-            m_callback(c, gate, associated_data);
+            if (!event_controls::record(c, gate, associated_data))
+            {
+                m_callback(c, gate, associated_data);
+            }
         }
     }
 
     void register_callback(const std::string& name, std::function<void(event, std::shared_ptr<gate>, u32)> function)
     {
-        m_callback.add_callback(name, function);
+        m_callback.add_callback(name, std::move(function));
     }
 
     void unregister_callback(const std::string& name)
@@ -1,4 +1,5 @@
 #include "netlist/event_system/netlist_event_handler.h"
+#include "netlist/event_system/event_controls.h"
 
 #include "netlist/netlist.h"
 
@@ -6,7 +7,7 @@ namespace netlist_event_handler
 {
     namespace
     {
-        callback_hook<void(event, std::shared_ptr<netlist>, u32)> m_callback;
+        callback_hook<void(event, const std::shared_ptr<netlist>&, u32)> m_callback;
         bool enabled = true;
     }    // namespace
 
@@ -15,17 +16,20 @@ namespace netlist_event_handler
         enabled = flag;
     }
 
-    void notify(event c, std::shared_ptr<netlist> netlist, u32 associated_data)
+    void notify(event c, const std::shared_ptr<netlist>& netlist, u32 associated_data)
     {
         if (enabled)
         {
-            m_callback(c, netlist, associated_data);
+            if (!event_controls::record(c, netlist, associated_data))
+            {
+                m_callback(c, netlist, associated_data);
+            }
         }
     }
 
     void register_callback(const std::string& name, std::function<void(event, std::shared_ptr<netlist>, u32)> function)
     {
-        m_callback.add_callback(name, function);
+        m_callback.add_callback(name, std::move(function));
     }
 
     void unregister_callback(const std::string& name)
@@ -6,20 +6,25 @@
 #include "netlist/module.h"
 #include "netlist/net.h"
 #include "netlist/netlist.h"
+#include "netlist/netlist_journal.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <iomanip>
 #include <sstream>
 
-gate::gate(std::shared_ptr<netlist> const g, const u32 id, std::shared_ptr<const gate_type> gt, const std::string& name, float x, float y)
+gate::gate(netlist* nl, const u32 id, std::shared_ptr<const gate_type> gt, const std::string& name, float x, float y)
 {
-    assert(g != nullptr);
-    m_netlist = g;
+    assert(nl != nullptr);
+    m_netlist = nl;
     m_id      = id;
     m_type    = gt;
     m_name    = name;
     m_x       = x;
     m_y       = y;
+
+    m_in_nets.resize(gt->get_input_pins().size());
+    m_out_nets.resize(gt->get_output_pins().size());
 }
 
 u32 gate::get_id() const
@@ -29,7 +34,7 @@ u32 gate::get_id() const
 
 std::shared_ptr<netlist> gate::get_netlist() const
 {
-    return m_netlist;
+    return m_netlist->get_shared();
 }
 
 std::string gate::get_name() const
@@ -48,6 +53,11 @@ void gate::set_name(const std::string& name)
     {
         log_info("netlist.internal", "changed name for gate (id = {}, type = {}) from '{}' to '{}'.", m_id, m_type->get_name(), m_name, name);
 
+        if (auto journal = m_netlist->get_journal(); journal != nullptr)
+        {
+            journal->record_rename(netlist_journal::operation::rename_gate, m_id, m_name, name);
+        }
+
         m_name = name;
 
         gate_event_handler::notify(gate_event_handler::event::name_changed, shared_from_this());
@@ -83,6 +93,10 @@ void gate::set_location_x(float x)
 {
     if (x != m_x)
     {
+        if (auto journal = m_netlist->get_journal(); journal != nullptr)
+        {
+            journal->record_move_location(m_id, m_x, m_y, x, m_y);
+        }
         m_x = x;
         gate_event_handler::notify(gate_event_handler::event::location_changed, shared_from_this());
     }
@@ -92,6 +106,10 @@ void gate::set_location_y(float y)
 {
     if (y != m_y)
     {
+        if (auto journal = m_netlist->get_journal(); journal != nullptr)
+        {
+            journal->record_move_location(m_id, m_x, m_y, m_x, y);
+        }
         m_y = y;
         gate_event_handler::notify(gate_event_handler::event::location_changed, shared_from_this());
     }
@@ -112,7 +130,7 @@ boolean_function gate::get_boolean_function(std::string name) const
 {
     if (name.empty())
     {
-        auto output_pins = m_type->get_output_pins();
+        const auto& output_pins = m_type->get_output_pins();
         if (output_pins.empty())
         {
             return boolean_function();
@@ -122,8 +140,7 @@ boolean_function gate::get_boolean_function(std::string name) const
 
     if (m_type->get_base_type() == gate_type::base_type::lut)
     {
-        auto lut_type = std::static_pointer_cast<const gate_type_lut>(m_type);
-        auto lut_pins = lut_type->get_output_from_init_string_pins();
+        const auto& lut_pins = std::static_pointer_cast<const gate_type_lut>(m_type)->get_output_from_init_string_pins();
         if (lut_pins.find(name) != lut_pins.end())
         {
             return get_lut_function(name);
@@ -135,7 +152,7 @@ boolean_function gate::get_boolean_function(std::string name) const
         return it->second;
     }
 
-    auto map = m_type->get_boolean_functions();
+    const auto& map = m_type->get_boolean_functions();
     if (auto it = map.find(name); it != map.end())
     {
         return it->second;
@@ -172,32 +189,61 @@ std::unordered_map<std::string, boolean_function> gate::get_boolean_functions(bo
 
 boolean_function gate::get_lut_function(const std::string& pin) const
 {
-    UNUSED(pin);
+    static const std::string no_config;
 
-    auto lut_type = std::static_pointer_cast<const gate_type_lut>(m_type);
+    auto lut_type                = std::static_pointer_cast<const gate_type_lut>(m_type);
+    auto slice                   = lut_type->get_output_from_init_string_slice(pin);
+    auto [num_inputs, first_row] = slice;
 
-    std::string category   = lut_type->get_config_data_category();
-    std::string key        = lut_type->get_config_data_identifier();
-    std::string config_str = std::get<1>(get_data_by_key(category, key));
-    auto is_ascending      = lut_type->is_config_data_ascending_order();
-    auto inputs            = get_input_pins();
+    // the INIT string is only referenced, lookups in the cache do not copy it
+    auto config_it                = m_data.find(std::make_tuple(lut_type->get_config_data_category(), lut_type->get_config_data_identifier()));
+    const std::string& config_str = (config_it != m_data.end()) ? std::get<1>(config_it->second) : no_config;
 
-    boolean_function result = boolean_function::ZERO;
+    // the decoded function only depends on the type, the slice of the output pin and the INIT string
+    {
+        std::lock_guard<std::mutex> lock(lut_type->m_lut_function_cache_mutex);
+        if (auto slice_it = lut_type->m_lut_function_cache.find(slice); slice_it != lut_type->m_lut_function_cache.end())
+        {
+            if (auto it = slice_it->second.find(config_str); it != slice_it->second.end())
+            {
+                return it->second;
+            }
+        }
+    }
+
+    auto is_ascending  = lut_type->is_config_data_ascending_order();
+    const auto& inputs = get_input_pins();
 
     if (config_str.empty())
     {
-        return result;
+        return boolean_function::ZERO;
+    }
+
+    if (inputs.size() > 32)
+    {
+        log_error("netlist.internal", "LUT-gate '{}' (id = {}) has more than 32 input pins (unsupported)", get_name(), get_id());
+        return boolean_function();
     }
 
-    if (inputs.size() > 6)
+    u64 config_size = 1ull << inputs.size();
+    u64 num_rows    = 1ull << num_inputs;
+
+    if (num_inputs > inputs.size() || first_row + num_rows > config_size)
     {
-        log_error("netlist.internal", "LUT-gate '{}' (id = {}) has more than six input pins (unsupported)", get_name(), get_id());
+        log_error("netlist.internal",
+                  "output pin '{}' of LUT-gate '{}' (id = {}) uses {} rows starting at row {}, but the LUT only has {} rows",
+                  pin,
+                  get_name(),
+                  get_id(),
+                  num_rows,
+                  first_row,
+                  config_size);
         return boolean_function();
     }
 
-    u32 config_size = 1 << inputs.size();
+    u32 begin = (config_str.size() > 2 && config_str[0] == '0' && (config_str[1] == 'x' || config_str[1] == 'X')) ? 2 : 0;
 
-    if (config_str.size() > config_size / 4)
+    if (config_str.size() - begin > (config_size + 3) / 4)
     {
         log_error("netlist.internal",
                   "LUT-gate '{}' (id = {}) supports a config of up to {} bits, but config string {} contains {} bits",
@@ -205,89 +251,133 @@ boolean_function gate::get_lut_function(const std::string& pin) const
                   get_id(),
                   config_size,
                   config_str,
-                  config_str.size() * 4);
+                  (config_str.size() - begin) * 4);
         return boolean_function();
     }
 
-    u64 config = 0;
-    try
+    // decode the config value into a bitvector, starting at the least significant digit, only the bits of the string are stored
+    u64 num_bits = std::min<u64>((config_str.size() - begin) * 4, config_size);
+    std::vector<u64> config((num_bits + 63) / 64, 0);
+    u64 bit = 0;
+    for (auto it = config_str.rbegin(); it != config_str.rend() - begin; ++it, bit += 4)
     {
-        config = std::stoull(config_str, nullptr, 16);
+        u64 digit;
+        if (*it >= '0' && *it <= '9')
+        {
+            digit = *it - '0';
+        }
+        else if (*it >= 'a' && *it <= 'f')
+        {
+            digit = *it - 'a' + 10;
+        }
+        else if (*it >= 'A' && *it <= 'F')
+        {
+            digit = *it - 'A' + 10;
+        }
+        else
+        {
+            log_error("netlist.internal", "LUT-gate '{}' (id = {}) has invalid config string: '{}' is not a hex value", get_name(), get_id(), config_str);
+            return boolean_function();
+        }
+        config[bit / 64] |= digit << (bit % 64);
     }
-    catch (std::invalid_argument& ex)
+    if (config_size < 64)
     {
-        log_error("netlist.internal", "LUT-gate '{}' (id = {}) has invalid config string: '{}' is not a hex value", get_name(), get_id(), config_str);
-        return boolean_function();
+        config[0] &= (1ull << config_size) - 1;
     }
 
-    for (u32 i = 0; config != 0 && i < config_size; i++)
+    // in descending order, row r of the LUT is bit (first_row + r) of the config, in ascending order it is bit (config_size - 1 - first_row - r)
+    // bits beyond the config string are ZERO, hence the table only covers the rows up to the last stored bit
+    auto get_config_bit = [&config, num_bits](u64 index) -> u64 { return (index < num_bits) ? ((config[index / 64] >> (index % 64)) & 1) : 0; };
+    std::vector<std::string> variables(inputs.begin(), inputs.begin() + num_inputs);
+
+    // ascending LUTs of up to this many inputs are decoded into a table of all rows
+    constexpr u32 MAX_FULL_TABLE_INPUTS = 16;
+
+    boolean_function result;
+    if (!is_ascending)
     {
-        u8 bit;
-        if (is_ascending)
+        u64 num_table_rows = std::min(num_rows, (num_bits > first_row) ? num_bits - first_row : 0);
+        std::vector<u64> table((num_table_rows + 63) / 64, 0);
+        for (u64 row = 0; row < num_table_rows; ++row)
         {
-            bit = (config >> (config_size - 1)) & 1;
-            config <<= 1;
+            table[row / 64] |= get_config_bit(first_row + row) << (row % 64);
         }
-        else
+        result = boolean_function::from_truth_table(table, variables);
+    }
+    else if (num_inputs <= MAX_FULL_TABLE_INPUTS)
+    {
+        std::vector<u64> table((num_rows + 63) / 64, 0);
+        for (u64 row = 0; row < num_rows; ++row)
         {
-            bit = (config & 1);
-            config >>= 1;
+            table[row / 64] |= get_config_bit(config_size - 1 - (first_row + row)) << (row % 64);
         }
-        if (bit == 1)
+        result = boolean_function::from_truth_table(table, variables);
+    }
+    else
+    {
+        // the stored bits are the last rows of a wide LUT, decode the rows in reverse order, i.e., with all inputs inverted
+        u64 first_bit      = config_size - first_row - num_rows;
+        u64 num_table_rows = std::min(num_rows, (num_bits > first_bit) ? num_bits - first_bit : 0);
+        std::vector<u64> table((num_table_rows + 63) / 64, 0);
+        for (u64 row = 0; row < num_table_rows; ++row)
         {
-            boolean_function clause;
-            auto input_values = i;
-            for (auto input : inputs)
-            {
-                if ((input_values & 1) == 1)
-                {
-                    clause &= boolean_function(input);
-                }
-                else
-                {
-                    clause &= !boolean_function(input);
-                }
-                input_values >>= 1;
-            }
-            result |= clause;
+            table[row / 64] |= get_config_bit(first_bit + row) << (row % 64);
+        }
+        result = boolean_function::from_truth_table(table, variables);
+        for (const auto& var : variables)
+        {
+            result = result.substitute(var, !boolean_function(var));
         }
     }
 
-    return result.optimize();
+    // only successfully decoded functions are cached, errors are reported for every gate
+    std::lock_guard<std::mutex> lock(lut_type->m_lut_function_cache_mutex);
+    if (lut_type->m_lut_function_cache_size >= gate_type_lut::MAX_LUT_FUNCTION_CACHE_SIZE)
+    {
+        lut_type->m_lut_function_cache.clear();
+        lut_type->m_lut_function_cache_size = 0;
+    }
+    if (lut_type->m_lut_function_cache[slice].emplace(config_str, result).second)
+    {
+        lut_type->m_lut_function_cache_size++;
+    }
+    return result;
 }
 
 void gate::add_boolean_function(const std::string& name, const boolean_function& func)
 {
     if (m_type->get_base_type() == gate_type::base_type::lut)
     {
-        auto output_pins = m_type->get_output_pins();
-        if (!output_pins.empty() && name == output_pins[0])
+        auto lut_type        = std::static_pointer_cast<const gate_type_lut>(m_type);
+        const auto& inputs   = get_input_pins();
+        const auto& lut_pins = lut_type->get_output_from_init_string_pins();
+        if (lut_pins.find(name) != lut_pins.end() && lut_type->get_output_from_init_string_slice(name).first == inputs.size() && inputs.size() <= 32)
         {
-            auto lut_type = std::static_pointer_cast<const gate_type_lut>(m_type);
-            auto tt       = func.get_truth_table(get_input_pins());
+            auto tt = func.get_truth_table(inputs);
 
-            u64 config_value = 0;
-            if (lut_type->is_config_data_ascending_order())
+            // inverse of get_lut_function: row r is bit r of the config in descending order and bit (config_size - 1 - r) in ascending order
+            u64 config_size = tt.size();
+            std::vector<u64> config((config_size + 63) / 64, 0);
+            for (u64 row = 0; row < config_size; ++row)
             {
-                std::reverse(tt.begin(), tt.end());
-            }
-            for (auto v : tt)
-            {
-                if (v == boolean_function::X)
+                if (tt[row] == boolean_function::X)
                 {
                     log_error("netlist", "function truth table contained undefined values");
                     return;
                 }
-                config_value <<= 1;
-                config_value |= v;
+                u64 index = lut_type->is_config_data_ascending_order() ? (config_size - 1 - row) : row;
+                config[index / 64] |= (u64)tt[row] << (index % 64);
             }
 
-            std::string category = lut_type->get_config_data_category();
-            std::string key      = lut_type->get_config_data_identifier();
+            const char* digits = "0123456789ABCDEF";
+            std::string config_str((config_size + 3) / 4, '0');
+            for (u64 i = 0; i < config_str.size(); ++i)
+            {
+                config_str[config_str.size() - 1 - i] = digits[(config[i / 16] >> (4 * (i % 16))) & 0xF];
+            }
 
-            std::stringstream stream;
-            stream << std::hex << config_value;
-            set_data(category, key, "bit_vector", stream.str());
+            set_data(lut_type->get_config_data_category(), lut_type->get_config_data_identifier(), "bit_vector", config_str);
 
             return;
         }
@@ -326,12 +416,12 @@ bool gate::is_gnd_gate() const
     return m_netlist->is_gnd_gate(const_cast<gate*>(this)->shared_from_this());
 }
 
-std::vector<std::string> gate::get_input_pins() const
+const std::vector<std::string>& gate::get_input_pins() const
 {
     return m_type->get_input_pins();
 }
 
-std::vector<std::string> gate::get_output_pins() const
+const std::vector<std::string>& gate::get_output_pins() const
 {
     return m_type->get_output_pins();
 }
@@ -340,9 +430,12 @@ std::set<std::shared_ptr<net>> gate::get_fan_in_nets() const
 {
     std::set<std::shared_ptr<net>> nets;
 
-    for (const auto& it : m_in_nets)
+    for (const auto& n : m_in_nets)
     {
-        nets.insert(it.second);
+        if (n != nullptr)
+        {
+            nets.insert(n);
+        }
     }
 
     return nets;
@@ -350,24 +443,48 @@ std::set<std::shared_ptr<net>> gate::get_fan_in_nets() const
 
 std::shared_ptr<net> gate::get_fan_in_net(const std::string& pin_type) const
 {
-    auto it = m_in_nets.find(pin_type);
+    auto n = get_fan_in_net_by_pin_id(m_type->get_input_pin_id(pin_type));
 
-    if (it == m_in_nets.end())
+    if (n == nullptr)
     {
         log_debug("netlist.internal", "gate ('{}',  type = {}) has no net connected to input pin '{}'.", get_name(), get_type()->get_name(), pin_type);
+    }
+
+    return n;
+}
+
+std::shared_ptr<net> gate::get_fan_in_net_by_pin_id(u32 pin_id) const
+{
+    if (pin_id >= m_in_nets.size())
+    {
         return nullptr;
     }
 
-    return it->second;
+    return m_in_nets[pin_id];
+}
+
+void gate::for_each_fan_in_net(const std::function<void(const std::string& pin_type, const std::shared_ptr<net>& net)>& visitor) const
+{
+    const auto& pins = m_type->get_input_pins();
+    for (u32 pin_id = 0; pin_id < m_in_nets.size(); ++pin_id)
+    {
+        if (m_in_nets[pin_id] != nullptr)
+        {
+            visitor(pins[pin_id], m_in_nets[pin_id]);
+        }
+    }
 }
 
 std::set<std::shared_ptr<net>> gate::get_fan_out_nets() const
 {
     std::set<std::shared_ptr<net>> nets;
 
-    for (const auto& it : m_out_nets)
+    for (const auto& n : m_out_nets)
     {
-        nets.insert(it.second);
+        if (n != nullptr)
+        {
+            nets.insert(n);
+        }
     }
 
     return nets;
@@ -375,15 +492,36 @@ std::set<std::shared_ptr<net>> gate::get_fan_out_nets() const
 
 std::shared_ptr<net> gate::get_fan_out_net(const std::string& pin_type) const
 {
-    auto it = m_out_nets.find(pin_type);
+    auto n = get_fan_out_net_by_pin_id(m_type->get_output_pin_id(pin_type));
 
-    if (it == m_out_nets.end())
+    if (n == nullptr)
     {
         log_debug("netlist.internal", "gate ('{}',  type = {}) has no net connected to output pin '{}'.", get_name(), get_type()->get_name(), pin_type);
+    }
+
+    return n;
+}
+
+std::shared_ptr<net> gate::get_fan_out_net_by_pin_id(u32 pin_id) const
+{
+    if (pin_id >= m_out_nets.size())
+    {
         return nullptr;
     }
 
-    return it->second;
+    return m_out_nets[pin_id];
+}
+
+void gate::for_each_fan_out_net(const std::function<void(const std::string& pin_type, const std::shared_ptr<net>& net)>& visitor) const
+{
+    const auto& pins = m_type->get_output_pins();
+    for (u32 pin_id = 0; pin_id < m_out_nets.size(); ++pin_id)
+    {
+        if (m_out_nets[pin_id] != nullptr)
+        {
+            visitor(pins[pin_id], m_out_nets[pin_id]);
+        }
+    }
 }
 
 std::set<endpoint> gate::get_unique_predecessors(const std::function<bool(const std::string& starting_pin, const endpoint&)>& filter) const
@@ -395,10 +533,15 @@ std::set<endpoint> gate::get_unique_predecessors(const std::function<bool(const
 std::vector<endpoint> gate::get_predecessors(const std::function<bool(const std::string& starting_pin, const endpoint&)>& filter) const
 {
     std::vector<endpoint> result;
-    for (const auto& it : m_in_nets)
+    const auto& pins = m_type->get_input_pins();
+    for (u32 pin_id = 0; pin_id < m_in_nets.size(); ++pin_id)
     {
-        auto& net = it.second;
-        auto& pin = it.first;
+        auto& net = m_in_nets[pin_id];
+        if (net == nullptr)
+        {
+            continue;
+        }
+        auto& pin = pins[pin_id];
         auto pred = net->get_src();
         if (pred.gate == nullptr)
         {
@@ -439,26 +582,22 @@ std::set<endpoint> gate::get_unique_successors(const std::function<bool(const st
 std::vector<endpoint> gate::get_successors(const std::function<bool(const std::string& starting_pin, const endpoint&)>& filter) const
 {
     std::vector<endpoint> result;
-    for (const auto& it : m_out_nets)
+    const auto& pins = m_type->get_output_pins();
+    for (u32 pin_id = 0; pin_id < m_out_nets.size(); ++pin_id)
     {
-        auto& pin       = it.first;
-        auto& net       = it.second;
-        auto successors = net->get_dsts();
-        if (!filter)
+        auto& net = m_out_nets[pin_id];
+        if (net == nullptr)
         {
-            result.insert(result.end(), successors.begin(), successors.end());
+            continue;
         }
-        else
-        {
-            for (const auto& suc : successors)
+        auto& pin = pins[pin_id];
+        net->for_each_dst([&](const std::shared_ptr<gate>& dst_gate, const std::string& dst_pin) {
+            endpoint suc{dst_gate, dst_pin};
+            if (!filter || filter(pin, suc))
             {
-                if (!filter(pin, suc))
-                {
-                    continue;
-                }
-                result.push_back(suc);
+                result.push_back(std::move(suc));
             }
-        }
+        });
     }
     return result;
 }
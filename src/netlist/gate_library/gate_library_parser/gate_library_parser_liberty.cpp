@@ -6,6 +6,9 @@
 #include "netlist/gate_library/gate_type/gate_type_lut.h"
 #include "netlist/gate_library/gate_type/gate_type_sequential.h"
 
+#include <algorithm>
+#include <limits>
+
 gate_library_parser_liberty::gate_library_parser_liberty(std::stringstream& stream) : gate_library_parser(stream)
 {
 }
@@ -97,7 +100,7 @@ bool gate_library_parser_liberty::tokenize()
         }
     }
 
-    m_token_stream = token_stream(parsed_tokens, {"(", "{"}, {")", "}"});
+    m_token_stream = token_stream(std::move(parsed_tokens), {"(", "{"}, {")", "}"});
     return true;
 }
 
@@ -444,7 +447,8 @@ bool gate_library_parser_liberty::parse_lut(token_stream& cell_stream)
 {
     cell_stream.consume("lut");
     cell_stream.consume("(", true);
-    m_current_cell.state1 = cell_stream.consume().string;
+    auto function_name = cell_stream.consume().string;
+    m_current_cell.lut_functions.insert(function_name);
     cell_stream.consume(")", true);
     cell_stream.consume("{", true);
     auto lut_stream = cell_stream.extract_until("}", token_stream::END_OF_STREAM, true, true);
@@ -482,6 +486,36 @@ bool gate_library_parser_liberty::parse_lut(token_stream& cell_stream)
 
             lut_stream.consume(";", true);
         }
+        else if (lut_stream.peek() == "input_count" || lut_stream.peek() == "first_row")
+        {
+            auto attribute = lut_stream.consume();
+            lut_stream.consume(":", true);
+            auto value = lut_stream.consume();
+
+            u32 number;
+            try
+            {
+                number = std::stoul(value.string);
+            }
+            catch (std::exception&)
+            {
+                log_error("netlist", "invalid {} '{}' near line {}.", attribute.string, value.string, value.number);
+                return false;
+            }
+
+            // a slice without input count uses all inputs, which are only known once the cell is complete
+            auto& slice = m_current_cell.lut_slices.emplace(function_name, std::make_pair(std::numeric_limits<u32>::max(), 0)).first->second;
+            if (attribute == "input_count")
+            {
+                slice.first = number;
+            }
+            else
+            {
+                slice.second = number;
+            }
+
+            lut_stream.consume(";", true);
+        }
         else
         {
             lut_stream.consume();
@@ -585,7 +619,12 @@ std::shared_ptr<gate_type> gate_library_parser_liberty::construct_gate_type()
 
         for (auto& [pin_name, bf_string] : m_current_cell.functions)
         {
-            if (bf_string == m_current_cell.state1)
+            if (auto it = m_current_cell.lut_slices.find(bf_string.string); it != m_current_cell.lut_slices.end())
+            {
+                auto [input_count, first_row] = it->second;
+                lut_gt->add_output_from_init_string_pin(pin_name, std::min(input_count, (u32)m_current_cell.input_pins.size()), first_row);
+            }
+            else if (m_current_cell.lut_functions.find(bf_string.string) != m_current_cell.lut_functions.end())
             {
                 lut_gt->add_output_from_init_string_pin(pin_name);
             }
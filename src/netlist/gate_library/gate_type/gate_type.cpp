@@ -41,22 +41,30 @@ bool gate_type::do_compare(const gate_type& other) const
 
 void gate_type::add_input_pin(std::string input_pin)
 {
+    m_input_pin_ids.emplace(input_pin, (u32)m_input_pins.size());
     m_input_pins.push_back(input_pin);
 }
 
 void gate_type::add_input_pins(const std::vector<std::string>& input_pins)
 {
-    m_input_pins.insert(m_input_pins.end(), input_pins.begin(), input_pins.end());
+    for (const auto& pin : input_pins)
+    {
+        add_input_pin(pin);
+    }
 }
 
 void gate_type::add_output_pin(std::string output_pin)
 {
+    m_output_pin_ids.emplace(output_pin, (u32)m_output_pins.size());
     m_output_pins.push_back(output_pin);
 }
 
 void gate_type::add_output_pins(const std::vector<std::string>& output_pins)
 {
-    m_output_pins.insert(m_output_pins.end(), output_pins.begin(), output_pins.end());
+    for (const auto& pin : output_pins)
+    {
+        add_output_pin(pin);
+    }
 }
 
 void gate_type::add_boolean_function(std::string pin_name, boolean_function bf)
@@ -74,17 +82,35 @@ gate_type::base_type gate_type::get_base_type() const
     return m_base_type;
 }
 
-std::vector<std::string> gate_type::get_input_pins() const
+const std::vector<std::string>& gate_type::get_input_pins() const
 {
     return m_input_pins;
 }
 
-std::vector<std::string> gate_type::get_output_pins() const
+u32 gate_type::get_input_pin_id(const std::string& input_pin) const
+{
+    if (auto it = m_input_pin_ids.find(input_pin); it != m_input_pin_ids.end())
+    {
+        return it->second;
+    }
+    return INVALID_PIN_ID;
+}
+
+const std::vector<std::string>& gate_type::get_output_pins() const
 {
     return m_output_pins;
 }
 
-std::unordered_map<std::string, boolean_function> gate_type::get_boolean_functions() const
+u32 gate_type::get_output_pin_id(const std::string& output_pin) const
+{
+    if (auto it = m_output_pin_ids.find(output_pin); it != m_output_pin_ids.end())
+    {
+        return it->second;
+    }
+    return INVALID_PIN_ID;
+}
+
+const std::unordered_map<std::string, boolean_function>& gate_type::get_boolean_functions() const
 {
     return m_functions;
 }
@@ -16,6 +16,7 @@ bool gate_type_lut::do_compare(const gate_type& other) const
         equal = m_config_data_category == gt->get_config_data_category();
         equal &= m_config_data_identifier == gt->get_config_data_identifier();
         equal &= m_ascending == gt->is_config_data_ascending_order();
+        equal &= m_output_from_init_string_slices == gt->m_output_from_init_string_slices;
     }
 
     return equal;
@@ -24,34 +25,62 @@ bool gate_type_lut::do_compare(const gate_type& other) const
 void gate_type_lut::add_output_from_init_string_pin(const std::string& output_pin_name)
 {
     m_output_from_init_string_pins.insert(output_pin_name);
+    m_output_from_init_string_slices.erase(output_pin_name);
+    clear_lut_function_cache();
+}
+
+void gate_type_lut::add_output_from_init_string_pin(const std::string& output_pin_name, u32 num_inputs, u32 first_row)
+{
+    m_output_from_init_string_pins.insert(output_pin_name);
+    m_output_from_init_string_slices[output_pin_name] = {num_inputs, first_row};
+    clear_lut_function_cache();
 }
 
 void gate_type_lut::set_config_data_category(const std::string& category)
 {
     m_config_data_category = category;
+    clear_lut_function_cache();
 }
 
 void gate_type_lut::set_config_data_identifier(const std::string& identifier)
 {
     m_config_data_identifier = identifier;
+    clear_lut_function_cache();
 }
 
 void gate_type_lut::set_config_data_ascending_order(bool ascending)
 {
     m_ascending = ascending;
+    clear_lut_function_cache();
+}
+
+void gate_type_lut::clear_lut_function_cache()
+{
+    std::lock_guard<std::mutex> lock(m_lut_function_cache_mutex);
+    m_lut_function_cache.clear();
+    m_lut_function_cache_size = 0;
 }
 
-std::unordered_set<std::string> gate_type_lut::get_output_from_init_string_pins() const
+const std::unordered_set<std::string>& gate_type_lut::get_output_from_init_string_pins() const
 {
     return m_output_from_init_string_pins;
 }
 
-std::string gate_type_lut::get_config_data_category() const
+std::pair<u32, u32> gate_type_lut::get_output_from_init_string_slice(const std::string& output_pin) const
+{
+    if (auto it = m_output_from_init_string_slices.find(output_pin); it != m_output_from_init_string_slices.end())
+    {
+        return it->second;
+    }
+    return {(u32)get_input_pins().size(), 0};
+}
+
+const std::string& gate_type_lut::get_config_data_category() const
 {
     return m_config_data_category;
 }
 
-std::string gate_type_lut::get_config_data_identifier() const
+const std::string& gate_type_lut::get_config_data_identifier() const
 {
     return m_config_data_identifier;
 }
@@ -1,6 +1,11 @@
 #include "netlist/hdl_parser/hdl_parser.h"
 
-hdl_parser::hdl_parser(std::stringstream& stream) : m_fs(stream)
+hdl_parser::hdl_parser(std::stringstream& stream) : m_buffer(stream.str()), m_input(m_buffer)
+{
+    m_netlist = nullptr;
+}
+
+hdl_parser::hdl_parser(std::string_view input) : m_input(input)
 {
     m_netlist = nullptr;
 }
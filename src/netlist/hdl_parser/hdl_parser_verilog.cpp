@@ -15,6 +15,10 @@ hdl_parser_verilog::hdl_parser_verilog(std::stringstream& stream) : hdl_parser(s
 {
 }
 
+hdl_parser_verilog::hdl_parser_verilog(std::string_view input) : hdl_parser(input)
+{
+}
+
 // ###########################################################################
 // ###########          Parse HDL into intermediate format          ##########
 // ###########################################################################
@@ -29,13 +33,7 @@ std::shared_ptr<netlist> hdl_parser_verilog::parse(const std::string& gate_libra
         return nullptr;
     }
 
-    // tokenize file
-    if (!tokenize())
-    {
-        return nullptr;
-    }
-
-    // parse tokens into intermediate format
+    // tokenize and parse the input statement by statement into intermediate format
     try
     {
         if (!parse_tokens())
@@ -145,65 +143,106 @@ std::shared_ptr<netlist> hdl_parser_verilog::parse(const std::string& gate_libra
     return m_netlist;
 }
 
-bool hdl_parser_verilog::tokenize()
+bool hdl_parser_verilog::tokenize_next_line()
 {
+    if (m_input_position >= m_input.size())
+    {
+        return false;
+    }
+
     std::string delimiters = ",()[]{}\\#: ;=.";
     std::string current_token;
-    u32 line_number = 0;
 
-    std::string line;
-    bool escaped             = false;
-    bool multi_line_comment  = false;
-    bool multi_line_property = false;
+    size_t line_end = m_input.find('\n', m_input_position);
+    if (line_end == std::string_view::npos)
+    {
+        line_end = m_input.size();
+    }
+    std::string_view line = m_input.substr(m_input_position, line_end - m_input_position);
+    m_input_position      = line_end + 1;
 
-    std::vector<token> parsed_tokens;
-    while (std::getline(m_fs, line))
+    m_line_number++;
+    m_line_tokens.clear();
+    m_next_line_token = 0;
+
+    // only lines that may contain comments or properties are copied, all others are tokenized in place
+    if (m_multi_line_comment || m_multi_line_property || line.find_first_of("/*") != std::string_view::npos)
     {
-        line_number++;
-        this->remove_comments(line, multi_line_comment, multi_line_property);
+        m_line_buffer.assign(line);
+        this->remove_comments(m_line_buffer, m_multi_line_comment, m_multi_line_property);
+        line = m_line_buffer;
+    }
 
-        for (char c : line)
+    for (char c : line)
+    {
+        if (c == '\\')
         {
-            if (c == '\\')
+            m_escaped = true;
+            continue;
+        }
+        else if (m_escaped && std::isspace(c))
+        {
+            m_escaped = false;
+        }
+
+        if ((!std::isspace(c) && delimiters.find(c) == std::string::npos) || m_escaped)
+        {
+            current_token += c;
+        }
+        else
+        {
+            if (!current_token.empty())
             {
-                escaped = true;
-                continue;
+                m_line_tokens.emplace_back(m_line_number, current_token);
+                current_token.clear();
             }
-            else if (escaped && std::isspace(c))
+
+            if (!std::isspace(c))
             {
-                escaped = false;
+                m_line_tokens.emplace_back(m_line_number, std::string(1, c));
             }
+        }
+    }
+    if (!current_token.empty())
+    {
+        m_line_tokens.emplace_back(m_line_number, current_token);
+    }
 
-            if ((!std::isspace(c) && delimiters.find(c) == std::string::npos) || escaped)
+    return true;
+}
+
+bool hdl_parser_verilog::next_statement()
+{
+    // a statement ends with ';' or with 'endmodule'
+    std::vector<token> statement;
+    while (statement.empty() || (statement.back() != ";" && statement.back() != "endmodule"))
+    {
+        if (m_next_line_token == m_line_tokens.size())
+        {
+            if (!tokenize_next_line())
             {
-                current_token += c;
+                break;
             }
-            else
-            {
-                if (!current_token.empty())
-                {
-                    parsed_tokens.emplace_back(line_number, current_token);
-                    current_token.clear();
-                }
+            continue;
+        }
 
-                if (c == '(' && parsed_tokens.back() == "#")
-                {
-                    parsed_tokens.back() = "#(";
-                }
-                else if (!std::isspace(c))
-                {
-                    parsed_tokens.emplace_back(line_number, std::string(1, c));
-                }
-            }
+        auto& next = m_line_tokens[m_next_line_token++];
+        if (next == "(" && !statement.empty() && statement.back() == "#")
+        {
+            statement.back() = "#(";
         }
-        if (!current_token.empty())
+        else
         {
-            parsed_tokens.emplace_back(line_number, current_token);
-            current_token.clear();
+            statement.push_back(std::move(next));
         }
     }
 
-    m_token_stream = token_stream(parsed_tokens, {"(", "["}, {")", "]"});
+    if (statement.empty())
+    {
+        return false;
+    }
+
+    m_token_stream = token_stream(std::move(statement), {"(", "["}, {")", "]"});
     return true;
 }
 
@@ -211,7 +250,7 @@ bool hdl_parser_verilog::parse_tokens()
 {
     std::string last_entity;
 
-    while (m_token_stream.remaining() > 0)
+    while (next_statement())
     {
         if (!parse_entity_definiton())
         {
@@ -219,6 +258,7 @@ bool hdl_parser_verilog::parse_tokens()
         }
     }
 
+    // connect the instances of entities that were defined after their first use
     if (!connect_instances())
     {
         return false;
@@ -248,9 +288,20 @@ bool hdl_parser_verilog::parse_entity_definiton()
 
     m_token_stream.consume(";", true);
 
-    auto next_token = m_token_stream.peek();
-    while (next_token != "endmodule")
+    // the module body is read one statement at a time
+    while (true)
     {
+        if (!next_statement())
+        {
+            throw token_stream::token_stream_exception({"expected token 'endmodule' but reached the end of the input", m_line_number});
+        }
+
+        auto next_token = m_token_stream.peek();
+        if (next_token == "endmodule")
+        {
+            break;
+        }
+
         if (next_token == "input" || next_token == "output")
         {
             if (!parse_port_definition(e))
@@ -285,16 +336,39 @@ bool hdl_parser_verilog::parse_entity_definiton()
                 return false;
             }
         }
-
-        next_token = m_token_stream.peek();
     }
 
     m_token_stream.consume("endmodule", true);
 
+    // connect the instances that use signals declared after them, only instances of entities defined later are left open
+    bool all_connected = true;
+    for (auto& inst : e.instances)
+    {
+        if (inst.port_streams.empty() && inst.generic_streams.empty())
+        {
+            continue;
+        }
+        if (m_entities.find(inst.type) == m_entities.end() && m_netlist->get_gate_library()->get_gate_types().count(inst.type) == 0)
+        {
+            all_connected = false;
+            continue;
+        }
+        if (!connect_instance(e, inst))
+        {
+            return false;
+        }
+    }
+
+    // the names of the expanded signals are only needed to connect instances
+    if (all_connected)
+    {
+        std::unordered_map<std::string, std::vector<std::string>>().swap(e.expanded_signal_names);
+    }
+
     if (!e.name.empty())
     {
-        m_entities[e.name] = e;
-        m_last_entity      = e.name;
+        m_last_entity             = e.name;
+        m_entities[m_last_entity] = std::move(e);
     }
 
     return true;
@@ -441,7 +515,7 @@ bool hdl_parser_verilog::parse_instance(entity& e)
 
             if (generic_rhs.size() != 0)
             {
-                inst.generic_streams.emplace_back(generic_lhs, generic_rhs);
+                inst.generic_streams.emplace_back(std::move(generic_lhs), std::move(generic_rhs));
             }
         }
 
@@ -471,75 +545,101 @@ bool hdl_parser_verilog::parse_instance(entity& e)
 
         if (port_rhs.size() != 0)
         {
-            inst.port_streams.emplace_back(port_lhs, port_rhs);
+            inst.port_streams.emplace_back(std::move(port_lhs), std::move(port_rhs));
         }
     }
 
     m_token_stream.consume(")", true);
     m_token_stream.consume(";", true);
 
+    // connect the instance right away if possible, so its token streams do not have to be kept until the end of the entity
+    bool known_type = m_entities.find(inst.type) != m_entities.end() || m_netlist->get_gate_library()->get_gate_types().count(inst.type) != 0;
+    bool declared   = std::all_of(inst.port_streams.begin(), inst.port_streams.end(), [this, &e](const auto& port) { return references_declared_signals(port.second, e); });
+    if (known_type && declared && !connect_instance(e, inst))
+    {
+        return false;
+    }
+
     // add to vector of instances of current entity
-    e.instances.push_back(inst);
+    e.instances.push_back(std::move(inst));
 
     return true;
 }
 
-bool hdl_parser_verilog::connect_instances()
+bool hdl_parser_verilog::connect_instance(entity& e, instance& inst)
 {
-    for (auto& [name, e] : m_entities)
+    for (auto& generic : inst.generic_streams)
     {
-        UNUSED(name);
+        inst.generics.emplace_back(generic.first.consume().string, generic.second.consume().string);
+    }
 
-        for (auto& inst : e.instances)
+    for (auto& port : inst.port_streams)
+    {
+        if (port.second.remaining() == 0)
         {
-            for (auto& generic : inst.generic_streams)
-            {
-                inst.generics.emplace_back(generic.first.consume().string, generic.second.consume().string);
-            }
+            // unconnected
+            continue;
+        }
 
-            for (auto& port : inst.port_streams)
-            {
-                if (port.second.remaining() == 0)
-                {
-                    // unconnected
-                    continue;
-                }
+        std::unordered_map<std::string, std::string> port_assignments;
 
-                std::unordered_map<std::string, std::string> port_assignments;
+        auto port_line = port.first.peek().number;
 
-                auto port_line = port.first.peek().number;
+        auto port_lhs = get_port_signals(port.first, inst.type);
+        auto port_rhs = get_assignment_signals(port.second, e, true);
 
-                auto port_lhs = get_port_signals(port.first, inst.type);
-                auto port_rhs = get_assignment_signals(port.second, e, true);
+        if (port_lhs.empty() || port_rhs.empty())
+        {
+            // error already printed in subfunction
+            return false;
+        }
 
-                if (port_lhs.empty() || port_rhs.empty())
-                {
-                    // error already printed in subfunction
-                    return {};
-                }
+        if (port_lhs.size() != port_rhs.size())
+        {
+            log_error("hdl_parser", "cannot parse port assignment in line '{}' due to width mismatch.", port_line);
+            return false;
+        }
 
-                if (port_lhs.size() != port_rhs.size())
-                {
-                    log_error("hdl_parser", "cannot parse port assignment in line '{}' due to width mismatch.", port_line);
-                    return {};
-                }
+        for (u32 i = 0; i < port_rhs.size(); i++)
+        {
+            port_assignments[port_lhs[i]] = port_rhs[i];
+        }
 
-                for (u32 i = 0; i < port_rhs.size(); i++)
-                {
-                    port_assignments[port_lhs[i]] = port_rhs[i];
-                }
+        if (port_assignments.empty() == true)
+        {
+            return false;
+        }
 
-                if (port_assignments.empty() == true)
-                {
-                    return false;
-                }
+        for (const auto& a : port_assignments)
+        {
+            inst.ports.push_back(a);
+        }
+    }
 
-                for (const auto& a : port_assignments)
-                {
-                    inst.ports.push_back(a);
-                }
+    // the token streams are not needed anymore once the instance is connected
+    inst.generic_streams.clear();
+    inst.generic_streams.shrink_to_fit();
+    inst.port_streams.clear();
+    inst.port_streams.shrink_to_fit();
+
+    return true;
+}
+
+bool hdl_parser_verilog::connect_instances()
+{
+    for (auto& [name, e] : m_entities)
+    {
+        UNUSED(name);
+
+        for (auto& inst : e.instances)
+        {
+            if ((!inst.port_streams.empty() || !inst.generic_streams.empty()) && !connect_instance(e, inst))
+            {
+                return false;
             }
         }
+
+        std::unordered_map<std::string, std::vector<std::string>>().swap(e.expanded_signal_names);
     }
 
     return true;
@@ -738,8 +838,11 @@ bool hdl_parser_verilog::build_netlist(const std::string& top_module)
     return true;
 }
 
-std::shared_ptr<module> hdl_parser_verilog::instantiate(const entity& e, std::shared_ptr<module> parent, std::unordered_map<std::string, std::string> parent_module_assignments)
+std::shared_ptr<module> hdl_parser_verilog::instantiate(entity& e, std::shared_ptr<module> parent, std::unordered_map<std::string, std::string> parent_module_assignments)
 {
+    // an entity that is instantiated only once can release each instance as soon as it is created
+    bool release_instances = m_name_occurrences[e.name] < 2;
+
     // remember assigned aliases so they are not lost when recursively going deeper
     std::unordered_map<std::string, std::string> aliases;
 
@@ -803,11 +906,14 @@ std::shared_ptr<module> hdl_parser_verilog::instantiate(const entity& e, std::sh
     }
 
     // cache global vcc/gnd types
-    auto vcc_gate_types = m_netlist->get_gate_library()->get_vcc_gate_types();
-    auto gnd_gate_types = m_netlist->get_gate_library()->get_gnd_gate_types();
+    const auto& vcc_gate_types = m_netlist->get_gate_library()->get_vcc_gate_types();
+    const auto& gnd_gate_types = m_netlist->get_gate_library()->get_gnd_gate_types();
+
+    // internal signals of the entity for fast lookup
+    std::unordered_set<std::string_view> internal_signals(e.signals_expanded.begin(), e.signals_expanded.end());
 
     // process instances i.e. gates or other entities
-    for (const auto& inst : e.instances)
+    for (auto& inst : e.instances)
     {
         // will later hold either module or gate, so attributes can be assigned properly
         data_container* container;
@@ -855,7 +961,7 @@ std::shared_ptr<module> hdl_parser_verilog::instantiate(const entity& e, std::sh
             aliases[inst.name] = get_unique_alias(inst.name);
 
             std::shared_ptr<gate> new_gate;
-            auto gate_types = m_netlist->get_gate_library()->get_gate_types();
+            const auto& gate_types = m_netlist->get_gate_library()->get_gate_types();
 
             if (auto gate_type_it = gate_types.find(inst.type); gate_type_it == gate_types.end())
             {
@@ -898,7 +1004,7 @@ std::shared_ptr<module> hdl_parser_verilog::instantiate(const entity& e, std::sh
                 }
 
                 // if the net is an internal signal, use its alias
-                if (std::find(e.signals_expanded.begin(), e.signals_expanded.end(), net_name) != e.signals_expanded.end())
+                if (internal_signals.find(net_name) != internal_signals.end())
                 {
                     net_name = aliases.at(net_name);
                 }
@@ -989,6 +1095,16 @@ std::shared_ptr<module> hdl_parser_verilog::instantiate(const entity& e, std::sh
                 return nullptr;
             }
         }
+
+        if (release_instances)
+        {
+            inst = instance();
+        }
+    }
+
+    if (release_instances)
+    {
+        std::vector<instance>().swap(e.instances);
     }
 
     return module;
@@ -1302,10 +1418,28 @@ std::vector<std::string> hdl_parser_verilog::get_assignment_signals(token_stream
     return result;
 }
 
+bool hdl_parser_verilog::references_declared_signals(const token_stream& signal_str, const entity& e) const
+{
+    // numbers and indices need no declaration, every other name has to be a declared signal
+    for (u32 i = signal_str.position(); i < signal_str.size(); ++i)
+    {
+        const auto& name = signal_str.at(i).string;
+        if (name == "{" || name == "}" || name == "," || name == "[" || name == "]" || name == ":" || isdigit(name[0]) || name[0] == '\'')
+        {
+            continue;
+        }
+        if (e.expanded_signal_names.find(name) == e.expanded_signal_names.end())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::vector<std::string> hdl_parser_verilog::get_port_signals(token_stream& port_str, const std::string& instance_type)
 {
     std::vector<std::string> result;
-    auto gate_types = m_netlist->get_gate_library()->get_gate_types();
+    const auto& gate_types = m_netlist->get_gate_library()->get_gate_types();
 
     auto port_name = port_str.consume();
 
@@ -15,6 +15,10 @@ hdl_parser_vhdl::hdl_parser_vhdl(std::stringstream& stream) : hdl_parser(stream)
 {
 }
 
+hdl_parser_vhdl::hdl_parser_vhdl(std::string_view input) : hdl_parser(input)
+{
+}
+
 // ###########################################################################
 // ###########          Parse HDL into intermediate format          ##########
 // ###########################################################################
@@ -159,17 +163,29 @@ bool hdl_parser_vhdl::tokenize()
     std::string current_token;
     u32 line_number = 0;
 
-    std::string line;
     bool in_string = false;
     bool escaped   = false;
-    while (std::getline(m_fs, line))
+    for (size_t line_begin = 0; line_begin < m_input.size();)
     {
+        size_t line_end = m_input.find('\n', line_begin);
+        if (line_end == std::string_view::npos)
+        {
+            line_end = m_input.size();
+        }
+        std::string_view line = m_input.substr(line_begin, line_end - line_begin);
+        line_begin            = line_end + 1;
+
         line_number++;
-        if (line.find("--") != std::string::npos)
+        if (line.find("--") != std::string_view::npos)
         {
             line = line.substr(0, line.find("--"));
         }
-        for (char c : core_utils::trim(line))
+
+        // trim the line in place instead of copying it
+        auto first = line.find_first_not_of(" \t\r\n");
+        line       = (first == std::string_view::npos) ? std::string_view() : line.substr(first, line.find_last_not_of(" \t\r\n") - first + 1);
+
+        for (char c : line)
         {
             if (c == '\\')
             {
@@ -222,7 +238,7 @@ bool hdl_parser_vhdl::tokenize()
             current_token.clear();
         }
     }
-    m_token_stream = token_stream(tmp_tokens, {"("}, {")"});
+    m_token_stream = token_stream(std::move(tmp_tokens), {"("}, {")"});
     return true;
 }
 
@@ -4,6 +4,7 @@
 #include "netlist/net.h"
 #include "netlist/netlist.h"
 #include "netlist/netlist_internal_manager.h"
+#include "netlist/netlist_journal.h"
 
 #include "netlist/event_system/module_event_handler.h"
 
@@ -36,6 +37,11 @@ void module::set_name(const std::string& name)
     }
     if (name != m_name)
     {
+        if (auto journal = m_internal_manager->m_netlist->get_journal(); journal != nullptr)
+        {
+            journal->record_rename(netlist_journal::operation::rename_module, m_id, m_name, name);
+        }
+
         m_name = name;
 
         module_event_handler::notify(module_event_handler::event::name_changed, shared_from_this());
@@ -79,15 +85,25 @@ bool module::set_parent_module(const std::shared_ptr<module>& new_parent)
         new_parent->set_parent_module(m_parent);
     }
 
+    // the gates of this module are moved to another branch of the hierarchy
+    m_parent->invalidate_net_cache();
+    new_parent->invalidate_net_cache();
+
     m_parent->m_submodules_map.erase(m_id);
     m_parent->m_submodules_set.erase(shared_from_this());
 
     module_event_handler::notify(module_event_handler::event::submodule_removed, m_parent, m_id);
 
+    if (auto journal = m_internal_manager->m_netlist->get_journal(); journal != nullptr)
+    {
+        journal->record_set_parent_module(shared_from_this(), m_parent, new_parent);
+    }
+
     m_parent = new_parent;
 
     m_parent->m_submodules_map[m_id] = shared_from_this();
     m_parent->m_submodules_set.insert(shared_from_this());
+    m_internal_manager->invalidate_module_index();
 
     module_event_handler::notify(module_event_handler::event::parent_changed, shared_from_this());
     module_event_handler::notify(module_event_handler::event::submodule_added, m_parent, m_id);
@@ -115,34 +131,50 @@ std::set<std::shared_ptr<module>> module::get_submodules(const std::function<boo
 
     if (recursive)
     {
-        for (const auto& sm : m_submodules_set)
+        m_internal_manager->update_module_index();
+        const auto& order = m_internal_manager->m_module_order;
+        for (u32 i = m_preorder_first + 1; i <= m_preorder_last; ++i)
         {
-            auto more = sm->get_submodules(filter, true);
-            res.insert(more.begin(), more.end());
+            auto sm = order[i]->shared_from_this();
+            if (!filter || filter(sm))
+            {
+                res.insert(sm);
+            }
         }
     }
     return res;
 }
 
+void module::for_each_submodule(const std::function<void(const std::shared_ptr<module>&)>& visitor, bool recursive) const
+{
+    for (const auto& sm : m_submodules_set)
+    {
+        visitor(sm);
+        if (recursive)
+        {
+            sm->for_each_submodule(visitor, true);
+        }
+    }
+}
+
 bool module::contains_module(const std::shared_ptr<module>& other, bool recursive) const
 {
     if (other == nullptr)
     {
         return false;
     }
-    for (const auto& sm : m_submodules_set)
+    if (!recursive)
     {
-        if (sm == other)
-        {
-            return true;
-        }
-        else if (recursive && sm->contains_module(other, true))
-        {
-            return true;
-        }
+        return m_submodules_set.find(other) != m_submodules_set.end();
+    }
+    // a deleted module keeps its pre-order position until the index is rebuilt, hence its membership is checked first
+    if (other->m_internal_manager != m_internal_manager || !m_internal_manager->m_netlist->is_module_in_netlist(other))
+    {
+        return false;
     }
 
-    return false;
+    m_internal_manager->update_module_index();
+    return other->m_preorder_first > m_preorder_first && other->m_preorder_first <= m_preorder_last;
 }
 
 std::shared_ptr<netlist> module::get_netlist() const
@@ -166,36 +198,34 @@ bool module::contains_gate(std::shared_ptr<gate> const gate, bool recursive) con
     {
         return false;
     }
-    bool success = (m_gates_set.find(gate) != m_gates_set.end());
-    if (!success && recursive)
+    if (!recursive)
     {
-        for (const auto& sm : m_submodules_set)
-        {
-            if (sm->contains_gate(gate, true))
-            {
-                return true;
-            }
-        }
+        return m_gates_set.find(gate) != m_gates_set.end();
+    }
+
+    // a gate is contained recursively if its module lies within the pre-order range of this module
+    // a deleted gate still references its former module, hence its membership is checked first
+    auto m = gate->get_module();
+    if (m == nullptr || m->m_internal_manager != m_internal_manager || !m_internal_manager->m_netlist->is_gate_in_netlist(gate))
+    {
+        return false;
     }
-    return success;
+
+    m_internal_manager->update_module_index();
+    return m->m_preorder_first >= m_preorder_first && m->m_preorder_first <= m_preorder_last;
 }
 
 std::shared_ptr<gate> module::get_gate_by_id(const u32 gate_id, bool recursive) const
 {
+    if (recursive)
+    {
+        auto g = m_internal_manager->m_netlist->get_gate_by_id(gate_id);
+        return contains_gate(g, true) ? g : nullptr;
+    }
+
     auto it = m_gates_map.find(gate_id);
     if (it == m_gates_map.end())
     {
-        if (recursive)
-        {
-            for (const auto& sm : m_submodules_set)
-            {
-                auto res = sm->get_gate_by_id(gate_id, true);
-                if (res != nullptr)
-                {
-                    return res;
-                }
-            }
-        }
         return nullptr;
     }
     return it->second;
@@ -204,105 +234,197 @@ std::shared_ptr<gate> module::get_gate_by_id(const u32 gate_id, bool recursive)
 std::set<std::shared_ptr<gate>> module::get_gates(const std::function<bool(const std::shared_ptr<gate>&)>& filter, bool recursive) const
 {
     std::set<std::shared_ptr<gate>> res;
-    if (!filter)
+    if (!filter && !recursive)
     {
-        res = m_gates_set;
+        return m_gates_set;
     }
-    else
-    {
-        for (const auto& it : m_gates_map)
-        {
-            auto current_gate = it.second;
-            if (!filter(current_gate))
+
+    for_each_gate(
+        [&res, &filter](const std::shared_ptr<gate>& g) {
+            if (!filter || filter(g))
             {
-                continue;
+                res.insert(g);
             }
-            res.insert(current_gate);
+        },
+        recursive);
+
+    return res;
+}
+
+void module::for_each_gate(const std::function<void(const std::shared_ptr<gate>&)>& visitor, bool recursive) const
+{
+    if (!recursive)
+    {
+        for (const auto& g : m_gates_set)
+        {
+            visitor(g);
         }
+        return;
     }
 
-    if (recursive)
+    if (m_internal_manager->use_gate_order())
     {
-        for (const auto& sm : m_submodules_set)
+        // the gates of all submodules form a contiguous range in the gate order
+        const auto& order = m_internal_manager->m_gate_order;
+        for (u32 i = m_gate_order_begin; i < m_gate_order_end; ++i)
         {
-            auto more = sm->get_gates(filter, true);
-            res.insert(more.begin(), more.end());
+            visitor(order[i]);
         }
+        return;
     }
 
-    return res;
+    u64 cost = 0;
+    std::vector<const module*> stack = {this};
+    while (!stack.empty())
+    {
+        auto m = stack.back();
+        stack.pop_back();
+        for (const auto& g : m->m_gates_set)
+        {
+            visitor(g);
+        }
+        for (const auto& it : m->m_submodules_map)
+        {
+            stack.push_back(it.second.get());
+        }
+        cost += m->m_gates_set.size() + 1;
+    }
+    m_internal_manager->m_gate_order_walk_cost += cost;
 }
 
 std::set<std::shared_ptr<net>> module::get_input_nets() const
 {
-    std::set<std::shared_ptr<net>> res;
-    auto gates = get_gates(nullptr, true);
-    std::set<std::shared_ptr<net>> seen;
-    for (const auto& gate : gates)
+    if (!m_net_cache_valid)
     {
-        for (const auto& net : gate->get_fan_in_nets())
+        build_net_cache();
+    }
+    return m_input_nets;
+}
+
+std::set<std::shared_ptr<net>> module::get_output_nets() const
+{
+    if (!m_net_cache_valid)
+    {
+        build_net_cache();
+    }
+    return m_output_nets;
+}
+
+std::set<std::shared_ptr<net>> module::get_internal_nets() const
+{
+    if (!m_net_cache_valid)
+    {
+        build_net_cache();
+    }
+    return m_internal_nets;
+}
+
+void module::build_net_cache() const
+{
+    m_net_connectivity.clear();
+    m_input_nets.clear();
+    m_output_nets.clear();
+    m_internal_nets.clear();
+
+    std::vector<std::shared_ptr<net>> nets;
+    auto record = [this, &nets](const std::shared_ptr<net>& n) -> net_connectivity& {
+        auto it = m_net_connectivity.find(n->get_id());
+        if (it == m_net_connectivity.end())
         {
-            if (seen.find(net) != seen.end())
-            {
-                continue;
-            }
-            seen.insert(net);
-            if (m_internal_manager->m_netlist->is_global_input_net(net))
-            {
-                res.insert(net);
-            }
-            else if (gates.find(net->get_src().gate) == gates.end())
-            {
-                res.insert(net);
-            }
+            nets.push_back(n);
+            it = m_net_connectivity.emplace(n->get_id(), net_connectivity()).first;
         }
+        return it->second;
+    };
+
+    for_each_gate(
+        [&record](const std::shared_ptr<gate>& g) {
+            g->for_each_fan_in_net([&record](const std::string&, const std::shared_ptr<net>& n) { record(n).dsts_inside++; });
+            g->for_each_fan_out_net([&record](const std::string&, const std::shared_ptr<net>& n) { record(n).src_inside = true; });
+        },
+        true);
+
+    for (const auto& n : nets)
+    {
+        classify_net(n);
     }
-    return res;
+    m_net_cache_valid = true;
 }
 
-std::set<std::shared_ptr<net>> module::get_output_nets() const
+void module::classify_net(const std::shared_ptr<net>& n) const
 {
-    std::set<std::shared_ptr<net>> res;
-    auto gates = get_gates(nullptr, true);
-    for (const auto& gate : gates)
+    net_connectivity conn;
+    if (auto it = m_net_connectivity.find(n->get_id()); it != m_net_connectivity.end())
     {
-        for (const auto& net : gate->get_fan_out_nets())
+        conn = it->second;
+        if (conn.dsts_inside == 0 && !conn.src_inside)
         {
-            if (m_internal_manager->m_netlist->is_global_output_net(net))
-            {
-                res.insert(net);
-                continue;
-            }
-            for (const auto& dst : net->get_dsts())
-            {
-                if (gates.find(dst.gate) == gates.end())
-                {
-                    res.insert(net);
-                    break;
-                }
-            }
+            m_net_connectivity.erase(it);
         }
     }
-    return res;
+
+    auto nl = m_internal_manager->m_netlist;
+
+    // input: used inside, driven from outside or by the environment
+    if (conn.dsts_inside > 0 && (!conn.src_inside || nl->is_global_input_net(n)))
+    {
+        m_input_nets.insert(n);
+    }
+    else
+    {
+        m_input_nets.erase(n);
+    }
+
+    // output: driven inside, used outside or by the environment
+    if (conn.src_inside && (conn.dsts_inside < n->get_num_of_dsts() || nl->is_global_output_net(n)))
+    {
+        m_output_nets.insert(n);
+    }
+    else
+    {
+        m_output_nets.erase(n);
+    }
+
+    // internal: driven and used inside
+    if (conn.src_inside && conn.dsts_inside > 0)
+    {
+        m_internal_nets.insert(n);
+    }
+    else
+    {
+        m_internal_nets.erase(n);
+    }
 }
 
-std::set<std::shared_ptr<net>> module::get_internal_nets() const
+void module::update_net_cache(const std::shared_ptr<net>& n, i32 dst_delta, i32 src_delta)
 {
-    std::set<std::shared_ptr<net>> res;
-    auto gates = get_gates(nullptr, true);
-    for (const auto& gate : gates)
+    if (!m_net_cache_valid)
+    {
+        return;
+    }
+    if (dst_delta != 0 || src_delta != 0)
     {
-        for (const auto& net : gate->get_fan_out_nets())
+        auto& conn = m_net_connectivity[n->get_id()];
+        conn.dsts_inside += dst_delta;
+        if (src_delta != 0)
         {
-            for (const auto& dst : net->get_dsts())
-            {
-                if (gates.find(dst.gate) != gates.end())
-                {
-                    res.insert(net);
-                    break;
-                }
-            }
+            conn.src_inside = (src_delta > 0);
+        }
+    }
+    classify_net(n);
+}
+
+void module::invalidate_net_cache()
+{
+    for (auto m = this; m != nullptr; m = m->m_parent.get())
+    {
+        if (m->m_net_cache_valid)
+        {
+            m->m_net_cache_valid = false;
+            m->m_net_connectivity.clear();
+            m->m_input_nets.clear();
+            m->m_output_nets.clear();
+            m->m_internal_nets.clear();
         }
     }
-    return res;
 }
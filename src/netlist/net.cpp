@@ -1,8 +1,10 @@
 #include "netlist/net.h"
 
 #include "netlist/gate.h"
+#include "netlist/gate_library/gate_type/gate_type.h"
 #include "netlist/netlist.h"
 #include "netlist/netlist_internal_manager.h"
+#include "netlist/netlist_journal.h"
 
 #include "netlist/event_system/net_event_handler.h"
 
@@ -17,7 +19,21 @@ net::net(netlist_internal_manager* internal_manager, const u32 id, const std::st
     m_internal_manager = internal_manager;
     m_id               = id;
     m_name             = name;
-    m_src              = {nullptr, ""};
+    m_src              = {nullptr, gate_type::INVALID_PIN_ID};
+}
+
+endpoint net::to_src_endpoint(const pin_endpoint& ep) const
+{
+    if (ep.gate == nullptr)
+    {
+        return {nullptr, ""};
+    }
+    return {ep.gate, ep.gate->get_type()->get_output_pins()[ep.pin_id]};
+}
+
+endpoint net::to_dst_endpoint(const pin_endpoint& ep) const
+{
+    return {ep.gate, ep.gate->get_type()->get_input_pins()[ep.pin_id]};
 }
 
 u32 net::get_id() const
@@ -46,6 +62,11 @@ void net::set_name(const std::string& name)
     {
         log_info("netlist.internal", "changed name for net (id = {}) from '{}' to '{}'.", m_id, m_name, name);
 
+        if (auto journal = m_internal_manager->m_netlist->get_journal(); journal != nullptr)
+        {
+            journal->record_rename(netlist_journal::operation::rename_net, m_id, m_name, name);
+        }
+
         m_name = name;
 
         net_event_handler::notify(net_event_handler::event::name_changed, shared_from_this());
@@ -69,7 +90,7 @@ bool net::remove_src()
 
 endpoint net::get_src() const
 {
-    return m_src;
+    return to_src_endpoint(m_src);
 }
 
 bool net::add_dst(const std::shared_ptr<gate>& gate, const std::string& pin_type)
@@ -128,7 +149,19 @@ bool net::is_a_dst(const endpoint& ep) const
         return false;
     }
 
-    return std::find(m_dsts.begin(), m_dsts.end(), ep) != m_dsts.end();
+    return is_a_dst(ep.gate, ep.gate->get_type()->get_input_pin_id(ep.pin_type));
+}
+
+bool net::is_a_dst(const std::shared_ptr<gate>& gate, u32 pin_id) const
+{
+    for (const auto& dst : m_dsts)
+    {
+        if (dst.gate == gate && dst.pin_id == pin_id)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 u32 net::get_num_of_dsts() const
@@ -138,24 +171,29 @@ u32 net::get_num_of_dsts() const
 
 std::vector<endpoint> net::get_dsts(const std::function<bool(const endpoint& ep)>& filter) const
 {
-    if (!filter)
-    {
-        return m_dsts;
-    }
-
     std::vector<endpoint> dsts;
+    dsts.reserve(m_dsts.size());
     for (const auto& dst : m_dsts)
     {
-        if (!filter(dst))
+        auto ep = to_dst_endpoint(dst);
+        if (filter && !filter(ep))
         {
             continue;
         }
-        dsts.push_back(dst);
+        dsts.push_back(std::move(ep));
     }
     return dsts;
 }
 
 
+void net::for_each_dst(const std::function<void(const std::shared_ptr<gate>& gate, const std::string& pin_type)>& visitor) const
+{
+    for (const auto& dst : m_dsts)
+    {
+        visitor(dst.gate, dst.gate->get_type()->get_input_pins()[dst.pin_id]);
+    }
+}
+
 bool net::is_unrouted() const
 {
     return ((m_src.gate == nullptr) || (this->get_num_of_dsts() == 0));
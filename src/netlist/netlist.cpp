@@ -3,8 +3,11 @@
 #include "netlist/gate.h"
 #include "netlist/module.h"
 #include "netlist/net.h"
+#include "netlist/netlist_arena.h"
 #include "netlist/netlist_internal_manager.h"
+#include "netlist/netlist_journal.h"
 
+#include "netlist/event_system/event_controls.h"
 #include "netlist/event_system/netlist_event_handler.h"
 
 #include "core/log.h"
@@ -12,16 +15,15 @@
 netlist::netlist(std::shared_ptr<gate_library> library) : m_gate_library(library)
 {
     m_manager        = new netlist_internal_manager(this);
+    m_arena          = std::make_shared<netlist_arena>();
     m_netlist_id     = 1;
-    m_next_gate_id   = 1;
-    m_next_net_id    = 1;
-    m_next_module_id = 1;
     m_top_module     = nullptr;    // this triggers the internal manager to allow creation of a module without parent
     m_top_module     = create_module("top module", nullptr);
 }
 
 netlist::~netlist()
 {
+    m_manager->clear_references();
     delete m_manager;
 }
 
@@ -99,15 +101,7 @@ std::shared_ptr<gate_library> netlist::get_gate_library() const
 
 u32 netlist::get_unique_module_id()
 {
-    if (!m_free_module_ids.empty())
-    {
-        return *(m_free_module_ids.begin());
-    }
-    while (m_used_module_ids.find(m_next_module_id) != m_used_module_ids.end())
-    {
-        m_next_module_id++;
-    }
-    return m_next_module_id;
+    return m_modules.get_unique_id();
 }
 
 std::shared_ptr<module> netlist::create_module(const u32 id, const std::string& name, std::shared_ptr<module> parent, const std::vector<std::shared_ptr<gate>>& gates)
@@ -137,28 +131,31 @@ std::shared_ptr<module> netlist::get_top_module()
 
 std::shared_ptr<module> netlist::get_module_by_id(u32 id) const
 {
-    auto it = m_modules.find(id);
-    if (it == m_modules.end())
+    const auto& m = m_modules.get(id);
+    if (m == nullptr)
     {
         log_error("netlist", "there is no module with id = {}.", id);
-        return nullptr;
     }
-    return it->second;
+    return m;
 }
 
 std::set<std::shared_ptr<module>> netlist::get_modules() const
 {
-    std::set<std::shared_ptr<module>> res;
-    for (const auto& it : m_modules)
+    const auto& modules = m_modules.get_objects();
+    return std::set<std::shared_ptr<module>>(modules.begin(), modules.end());
+}
+
+void netlist::for_each_module(const std::function<void(const std::shared_ptr<module>&)>& visitor) const
+{
+    for (const auto& m : m_modules.get_objects())
     {
-        res.insert(it.second);
+        visitor(m);
     }
-    return res;
 }
 
 bool netlist::is_module_in_netlist(const std::shared_ptr<module> module) const
 {
-    return (module != nullptr) && (module->get_netlist() == shared_from_this()) && (m_modules.find(module->get_id()) != m_modules.end());
+    return (module != nullptr) && (m_modules.get(module->get_id()) == module);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -168,15 +165,7 @@ bool netlist::is_module_in_netlist(const std::shared_ptr<module> module) const
 
 u32 netlist::get_unique_gate_id()
 {
-    if (!m_free_gate_ids.empty())
-    {
-        return *(m_free_gate_ids.begin());
-    }
-    while (m_used_gate_ids.find(m_next_gate_id) != m_used_gate_ids.end())
-    {
-        m_next_gate_id++;
-    }
-    return m_next_gate_id;
+    return m_gates.get_unique_id();
 }
 
 std::shared_ptr<gate> netlist::create_gate(const u32 id, std::shared_ptr<const gate_type> gt, const std::string& name, float x, float y)
@@ -196,17 +185,38 @@ bool netlist::delete_gate(std::shared_ptr<gate> gate)
 
 bool netlist::is_gate_in_netlist(std::shared_ptr<gate> const gate) const
 {
-    return m_top_module->contains_gate(gate, true);
+    return (gate != nullptr) && (m_gates.get(gate->get_id()) == gate);
 }
 
 std::shared_ptr<gate> netlist::get_gate_by_id(const u32 gate_id) const
 {
-    return m_top_module->get_gate_by_id(gate_id, true);
+    return m_gates.get(gate_id);
 }
 
 std::set<std::shared_ptr<gate>> netlist::get_gates(const std::function<bool(const std::shared_ptr<gate>&)>& filter) const
 {
-    return m_top_module->get_gates(filter, true);
+    const auto& gates = m_gates.get_objects();
+    if (!filter)
+    {
+        return std::set<std::shared_ptr<gate>>(gates.begin(), gates.end());
+    }
+    std::set<std::shared_ptr<gate>> res;
+    for (const auto& g : gates)
+    {
+        if (filter(g))
+        {
+            res.insert(g);
+        }
+    }
+    return res;
+}
+
+void netlist::for_each_gate(const std::function<void(const std::shared_ptr<gate>&)>& visitor) const
+{
+    for (const auto& g : m_gates.get_objects())
+    {
+        visitor(g);
+    }
 }
 
 bool netlist::mark_vcc_gate(const std::shared_ptr<gate> gate)
@@ -221,6 +231,10 @@ bool netlist::mark_vcc_gate(const std::shared_ptr<gate> gate)
         return true;
     }
     m_vcc_gates.insert(gate);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::mark_vcc_gate, gate->get_id());
+    }
     netlist_event_handler::notify(netlist_event_handler::event::marked_global_vcc, shared_from_this(), gate->get_id());
     return true;
 }
@@ -237,6 +251,10 @@ bool netlist::mark_gnd_gate(const std::shared_ptr<gate> gate)
         return true;
     }
     m_gnd_gates.insert(gate);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::mark_gnd_gate, gate->get_id());
+    }
     netlist_event_handler::notify(netlist_event_handler::event::marked_global_gnd, shared_from_this(), gate->get_id());
     return true;
 }
@@ -254,6 +272,10 @@ bool netlist::unmark_vcc_gate(const std::shared_ptr<gate> gate)
         return false;
     }
     m_vcc_gates.erase(it);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::unmark_vcc_gate, gate->get_id());
+    }
     netlist_event_handler::notify(netlist_event_handler::event::unmarked_global_vcc, shared_from_this(), gate->get_id());
     return true;
 }
@@ -271,6 +293,10 @@ bool netlist::unmark_gnd_gate(const std::shared_ptr<gate> gate)
         return false;
     }
     m_gnd_gates.erase(it);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::unmark_gnd_gate, gate->get_id());
+    }
     netlist_event_handler::notify(netlist_event_handler::event::unmarked_global_gnd, shared_from_this(), gate->get_id());
     return true;
 }
@@ -302,15 +328,7 @@ std::set<std::shared_ptr<gate>> netlist::get_gnd_gates() const
 
 u32 netlist::get_unique_net_id()
 {
-    if (!m_free_net_ids.empty())
-    {
-        return *(m_free_net_ids.begin());
-    }
-    while (m_used_net_ids.find(m_next_net_id) != m_used_net_ids.end())
-    {
-        m_next_net_id++;
-    }
-    return m_next_net_id;
+    return m_nets.get_unique_id();
 }
 
 std::shared_ptr<net> netlist::create_net(const u32 id, const std::string& name)
@@ -330,28 +348,28 @@ bool netlist::delete_net(std::shared_ptr<net> n)
 
 bool netlist::is_net_in_netlist(const std::shared_ptr<net> n) const
 {
-    return m_nets_set.find(n) != m_nets_set.end();
+    return (n != nullptr) && (m_nets.get(n->get_id()) == n);
 }
 
 std::shared_ptr<net> netlist::get_net_by_id(u32 net_id) const
 {
-    auto it = m_nets_map.find(net_id);
-    if (it == m_nets_map.end())
+    const auto& n = m_nets.get(net_id);
+    if (n == nullptr)
     {
         log_error("netlist", "no net with id {:08x} registered in netlist.", net_id);
-        return nullptr;
     }
-    return it->second;
+    return n;
 }
 
 std::unordered_set<std::shared_ptr<net>> netlist::get_nets(const std::function<bool(const std::shared_ptr<net>&)>& filter) const
 {
+    const auto& nets = m_nets.get_objects();
     if (!filter)
     {
-        return m_nets_set;
+        return std::unordered_set<std::shared_ptr<net>>(nets.begin(), nets.end());
     }
     std::unordered_set<std::shared_ptr<net>> res;
-    for (const auto& net : m_nets_set)
+    for (const auto& net : nets)
     {
         if (!filter(net))
         {
@@ -362,6 +380,14 @@ std::unordered_set<std::shared_ptr<net>> netlist::get_nets(const std::function<b
     return res;
 }
 
+void netlist::for_each_net(const std::function<void(const std::shared_ptr<net>&)>& visitor) const
+{
+    for (const auto& n : m_nets.get_objects())
+    {
+        visitor(n);
+    }
+}
+
 bool netlist::mark_global_input_net(std::shared_ptr<net> const n)
 {
     if (!is_net_in_netlist(n))
@@ -379,6 +405,11 @@ bool netlist::mark_global_input_net(std::shared_ptr<net> const n)
         return false;
     }
     m_global_input_nets.insert(n);
+    m_manager->module_update_net_caches(n);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::mark_global_input, n->get_id());
+    }
 
     netlist_event_handler::notify(netlist_event_handler::event::marked_global_input, shared_from_this(), n->get_id());
     return true;
@@ -401,6 +432,11 @@ bool netlist::mark_global_output_net(std::shared_ptr<net> const n)
     //     return false;
     // }
     m_global_output_nets.insert(n);
+    m_manager->module_update_net_caches(n);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::mark_global_output, n->get_id());
+    }
 
     netlist_event_handler::notify(netlist_event_handler::event::marked_global_output, shared_from_this(), n->get_id());
     return true;
@@ -419,6 +455,11 @@ bool netlist::unmark_global_input_net(std::shared_ptr<net> const n)
         return false;
     }
     m_global_input_nets.erase(it);
+    m_manager->module_update_net_caches(n);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::unmark_global_input, n->get_id());
+    }
 
     netlist_event_handler::notify(netlist_event_handler::event::unmarked_global_input, shared_from_this(), n->get_id());
     return true;
@@ -437,6 +478,11 @@ bool netlist::unmark_global_output_net(std::shared_ptr<net> const n)
         return false;
     }
     m_global_output_nets.erase(it);
+    m_manager->module_update_net_caches(n);
+    if (m_journal != nullptr)
+    {
+        m_journal->record_marking(netlist_journal::operation::unmark_global_output, n->get_id());
+    }
 
     netlist_event_handler::notify(netlist_event_handler::event::unmarked_global_output, shared_from_this(), n->get_id());
     return true;
@@ -461,3 +507,18 @@ std::set<std::shared_ptr<net>> netlist::get_global_output_nets() const
 {
     return m_global_output_nets;
 }
+
+void netlist::begin_batch()
+{
+    event_controls::begin_batch(get_shared());
+}
+
+bool netlist::commit_batch()
+{
+    return event_controls::commit_batch(get_shared());
+}
+
+netlist_journal* netlist::get_journal() const
+{
+    return m_journal;
+}
@@ -0,0 +1,78 @@
+#include "netlist/netlist_arena.h"
+
+std::size_t netlist_arena::get_slot_size(std::size_t size)
+{
+    if (size == 0)
+    {
+        return GRANULARITY;
+    }
+    return ((size + GRANULARITY - 1) / GRANULARITY) * GRANULARITY;
+}
+
+void* netlist_arena::allocate(std::size_t size)
+{
+    std::size_t slot_size = get_slot_size(size);
+    if (slot_size > MAX_SLOT_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_used_bytes += slot_size;
+
+    auto& sc = m_classes[slot_size / GRANULARITY];
+    if (sc.free_list != nullptr)
+    {
+        auto slot    = sc.free_list;
+        sc.free_list = slot->next;
+        return slot;
+    }
+
+    if (sc.next == sc.end)
+    {
+        std::size_t chunk_size = (CHUNK_SIZE / slot_size) * slot_size;
+        m_chunks.emplace_back(new char[chunk_size]);
+        m_reserved_bytes += chunk_size;
+        sc.next = m_chunks.back().get();
+        sc.end  = sc.next + chunk_size;
+    }
+
+    void* slot = sc.next;
+    sc.next += slot_size;
+    return slot;
+}
+
+void netlist_arena::deallocate(void* p, std::size_t size)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    std::size_t slot_size = get_slot_size(size);
+    if (slot_size > MAX_SLOT_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_used_bytes -= slot_size;
+
+    auto& sc     = m_classes[slot_size / GRANULARITY];
+    auto slot    = static_cast<free_slot*>(p);
+    slot->next   = sc.free_list;
+    sc.free_list = slot;
+}
+
+u64 netlist_arena::get_reserved_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reserved_bytes;
+}
+
+u64 netlist_arena::get_used_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_used_bytes;
+}
@@ -0,0 +1,291 @@
+#include "netlist/netlist_graph_view.h"
+
+#include "netlist/event_system/gate_event_handler.h"
+#include "netlist/event_system/net_event_handler.h"
+#include "netlist/gate.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace
+{
+    u32 g_next_view_id = 1;
+
+    // turns per-row counts into prefix sums, i.e., offsets[i] is the start of row i and offsets[i+1] its end
+    void counts_to_offsets(std::vector<u32>& offsets)
+    {
+        u32 sum = 0;
+        for (auto& x : offsets)
+        {
+            u32 count = x;
+            x         = sum;
+            sum += count;
+        }
+    }
+}    // namespace
+
+netlist_graph_view::netlist_graph_view(const std::shared_ptr<netlist>& nl) : m_netlist(nl), m_valid(false)
+{
+    assert(nl != nullptr);
+
+    m_callback_name = "netlist_graph_view_" + std::to_string(g_next_view_id++);
+
+    netlist* raw_netlist = nl.get();
+    gate_event_handler::register_callback(m_callback_name, [this, raw_netlist](gate_event_handler::event e, std::shared_ptr<gate> g, u32) {
+        if ((e == gate_event_handler::event::created || e == gate_event_handler::event::removed) && g->get_netlist().get() == raw_netlist)
+        {
+            m_valid = false;
+        }
+    });
+    net_event_handler::register_callback(m_callback_name, [this, raw_netlist](net_event_handler::event e, std::shared_ptr<net> n, u32) {
+        if (e != net_event_handler::event::name_changed && n->get_netlist().get() == raw_netlist)
+        {
+            m_valid = false;
+        }
+    });
+
+    rebuild();
+}
+
+netlist_graph_view::~netlist_graph_view()
+{
+    gate_event_handler::unregister_callback(m_callback_name);
+    net_event_handler::unregister_callback(m_callback_name);
+}
+
+std::shared_ptr<netlist> netlist_graph_view::get_netlist() const
+{
+    return m_netlist;
+}
+
+bool netlist_graph_view::is_valid() const
+{
+    return m_valid;
+}
+
+void netlist_graph_view::clear()
+{
+    m_gates.clear();
+    m_nets.clear();
+    m_gate_id_to_index.clear();
+    m_net_id_to_index.clear();
+    m_fan_in_offsets.clear();
+    m_fan_in.clear();
+    m_fan_out_offsets.clear();
+    m_fan_out.clear();
+    m_sources.clear();
+    m_dst_offsets.clear();
+    m_dsts.clear();
+    m_successor_offsets.clear();
+    m_successors.clear();
+    m_predecessor_offsets.clear();
+    m_predecessors.clear();
+}
+
+void netlist_graph_view::rebuild()
+{
+    clear();
+
+    // assign dense indices ordered by id
+    m_netlist->for_each_gate([this](const std::shared_ptr<gate>& g) { m_gates.push_back(g); });
+    std::sort(m_gates.begin(), m_gates.end(), [](const auto& a, const auto& b) { return a->get_id() < b->get_id(); });
+
+    m_netlist->for_each_net([this](const std::shared_ptr<net>& n) { m_nets.push_back(n); });
+    std::sort(m_nets.begin(), m_nets.end(), [](const auto& a, const auto& b) { return a->get_id() < b->get_id(); });
+
+    u32 num_gates = (u32)m_gates.size();
+    u32 num_nets  = (u32)m_nets.size();
+
+    m_gate_id_to_index.reserve(num_gates);
+    for (u32 i = 0; i < num_gates; ++i)
+    {
+        m_gate_id_to_index.emplace(m_gates[i]->get_id(), i);
+    }
+    m_net_id_to_index.reserve(num_nets);
+    for (u32 i = 0; i < num_nets; ++i)
+    {
+        m_net_id_to_index.emplace(m_nets[i]->get_id(), i);
+    }
+
+    // resolve all endpoints once: per net the source and the destinations
+    m_sources.assign(num_nets, {INVALID_INDEX, INVALID_INDEX});
+    m_dst_offsets.assign(num_nets + 1, 0);
+    m_fan_in_offsets.assign(num_gates + 1, 0);
+    m_fan_out_offsets.assign(num_gates + 1, 0);
+
+    for (u32 i = 0; i < num_nets; ++i)
+    {
+        const auto& n = m_nets[i];
+        if (n->m_src.gate != nullptr)
+        {
+            u32 g        = m_gate_id_to_index.at(n->m_src.gate->get_id());
+            m_sources[i] = {g, n->m_src.pin_id};
+            m_fan_out_offsets[g]++;
+        }
+        m_dst_offsets[i] = (u32)n->m_dsts.size();
+        for (const auto& dst : n->m_dsts)
+        {
+            m_fan_in_offsets[m_gate_id_to_index.at(dst.gate->get_id())]++;
+        }
+    }
+
+    counts_to_offsets(m_dst_offsets);
+    counts_to_offsets(m_fan_in_offsets);
+    counts_to_offsets(m_fan_out_offsets);
+
+    m_dsts.resize(m_dst_offsets[num_nets]);
+    m_fan_in.resize(m_fan_in_offsets[num_gates]);
+    m_fan_out.resize(m_fan_out_offsets[num_gates]);
+
+    // fill the rows, using a per-row write cursor
+    {
+        std::vector<u32> fan_in_cursor(m_fan_in_offsets.begin(), m_fan_in_offsets.end() - 1);
+        std::vector<u32> fan_out_cursor(m_fan_out_offsets.begin(), m_fan_out_offsets.end() - 1);
+
+        for (u32 i = 0; i < num_nets; ++i)
+        {
+            const auto& n = m_nets[i];
+            if (m_sources[i].index != INVALID_INDEX)
+            {
+                m_fan_out[fan_out_cursor[m_sources[i].index]++] = {i, m_sources[i].pin};
+            }
+            u32 pos = m_dst_offsets[i];
+            for (const auto& dst : n->m_dsts)
+            {
+                u32 g                        = m_gate_id_to_index.at(dst.gate->get_id());
+                m_dsts[pos++]                = {g, dst.pin_id};
+                m_fan_in[fan_in_cursor[g]++] = {i, dst.pin_id};
+            }
+        }
+    }
+
+    // order the fan-in and fan-out of every gate by pin index
+    auto by_pin = [](const connection& a, const connection& b) { return a.pin < b.pin; };
+    for (u32 g = 0; g < num_gates; ++g)
+    {
+        std::sort(m_fan_in.begin() + m_fan_in_offsets[g], m_fan_in.begin() + m_fan_in_offsets[g + 1], by_pin);
+        std::sort(m_fan_out.begin() + m_fan_out_offsets[g], m_fan_out.begin() + m_fan_out_offsets[g + 1], by_pin);
+    }
+
+    // derive the gate-level adjacency
+    m_successor_offsets.assign(num_gates + 1, 0);
+    m_predecessor_offsets.assign(num_gates + 1, 0);
+    for (u32 g = 0; g < num_gates; ++g)
+    {
+        for (const auto& c : get_fan_out(g))
+        {
+            m_successor_offsets[g] += m_dst_offsets[c.index + 1] - m_dst_offsets[c.index];
+        }
+        for (const auto& c : get_fan_in(g))
+        {
+            if (m_sources[c.index].index != INVALID_INDEX)
+            {
+                m_predecessor_offsets[g]++;
+            }
+        }
+    }
+    counts_to_offsets(m_successor_offsets);
+    counts_to_offsets(m_predecessor_offsets);
+
+    m_successors.reserve(m_successor_offsets[num_gates]);
+    m_predecessors.reserve(m_predecessor_offsets[num_gates]);
+    for (u32 g = 0; g < num_gates; ++g)
+    {
+        for (const auto& c : get_fan_out(g))
+        {
+            for (const auto& dst : get_destinations(c.index))
+            {
+                m_successors.push_back(dst.index);
+            }
+        }
+        for (const auto& c : get_fan_in(g))
+        {
+            if (m_sources[c.index].index != INVALID_INDEX)
+            {
+                m_predecessors.push_back(m_sources[c.index].index);
+            }
+        }
+    }
+
+    m_valid = true;
+}
+
+u32 netlist_graph_view::get_num_gates() const
+{
+    return (u32)m_gates.size();
+}
+
+u32 netlist_graph_view::get_num_nets() const
+{
+    return (u32)m_nets.size();
+}
+
+u32 netlist_graph_view::get_gate_index(const std::shared_ptr<gate>& g) const
+{
+    if (g == nullptr)
+    {
+        return INVALID_INDEX;
+    }
+    auto it = m_gate_id_to_index.find(g->get_id());
+    if (it == m_gate_id_to_index.end() || m_gates[it->second] != g)
+    {
+        return INVALID_INDEX;
+    }
+    return it->second;
+}
+
+u32 netlist_graph_view::get_net_index(const std::shared_ptr<net>& n) const
+{
+    if (n == nullptr)
+    {
+        return INVALID_INDEX;
+    }
+    auto it = m_net_id_to_index.find(n->get_id());
+    if (it == m_net_id_to_index.end() || m_nets[it->second] != n)
+    {
+        return INVALID_INDEX;
+    }
+    return it->second;
+}
+
+const std::shared_ptr<gate>& netlist_graph_view::get_gate(u32 index) const
+{
+    return m_gates[index];
+}
+
+const std::shared_ptr<net>& netlist_graph_view::get_net(u32 index) const
+{
+    return m_nets[index];
+}
+
+netlist_graph_view::range<netlist_graph_view::connection> netlist_graph_view::get_fan_in(u32 gate_index) const
+{
+    return {m_fan_in.data() + m_fan_in_offsets[gate_index], m_fan_in.data() + m_fan_in_offsets[gate_index + 1]};
+}
+
+netlist_graph_view::range<netlist_graph_view::connection> netlist_graph_view::get_fan_out(u32 gate_index) const
+{
+    return {m_fan_out.data() + m_fan_out_offsets[gate_index], m_fan_out.data() + m_fan_out_offsets[gate_index + 1]};
+}
+
+netlist_graph_view::connection netlist_graph_view::get_source(u32 net_index) const
+{
+    return m_sources[net_index];
+}
+
+netlist_graph_view::range<netlist_graph_view::connection> netlist_graph_view::get_destinations(u32 net_index) const
+{
+    return {m_dsts.data() + m_dst_offsets[net_index], m_dsts.data() + m_dst_offsets[net_index + 1]};
+}
+
+netlist_graph_view::range<u32> netlist_graph_view::get_successors(u32 gate_index) const
+{
+    return {m_successors.data() + m_successor_offsets[gate_index], m_successors.data() + m_successor_offsets[gate_index + 1]};
+}
+
+netlist_graph_view::range<u32> netlist_graph_view::get_predecessors(u32 gate_index) const
+{
+    return {m_predecessors.data() + m_predecessor_offsets[gate_index], m_predecessors.data() + m_predecessor_offsets[gate_index + 1]};
+}
@@ -7,16 +7,46 @@
 #include "netlist/module.h"
 #include "netlist/net.h"
 #include "netlist/netlist.h"
+#include "netlist/netlist_arena.h"
+#include "netlist/netlist_journal.h"
 
 #include "netlist/event_system/gate_event_handler.h"
 #include "netlist/event_system/module_event_handler.h"
 #include "netlist/event_system/net_event_handler.h"
 
+#include <unordered_set>
+
 netlist_internal_manager::netlist_internal_manager(netlist* nl) : m_netlist(nl)
 {
     assert(nl != nullptr);
 }
 
+void netlist_internal_manager::clear_references()
+{
+    // gates reference their module and nets, modules reference their gates, parent and submodules, and nets reference
+    // their gates, so without breaking these cycles nothing would be released when the netlist is destroyed
+    invalidate_module_index();
+    for (const auto& n : m_netlist->m_nets.get_objects())
+    {
+        n->m_src = {nullptr, gate_type::INVALID_PIN_ID};
+        n->m_dsts.clear();
+    }
+    for (const auto& m : m_netlist->m_modules.get_objects())
+    {
+        for (const auto& g : m->m_gates_set)
+        {
+            g->m_in_nets.clear();
+            g->m_out_nets.clear();
+            g->m_module = nullptr;
+        }
+        m->m_gates_map.clear();
+        m->m_gates_set.clear();
+        m->m_submodules_map.clear();
+        m->m_submodules_set.clear();
+        m->m_parent = nullptr;
+    }
+}
+
 //######################################################################
 //###                      gates                                     ###
 //######################################################################
@@ -28,7 +58,7 @@ std::shared_ptr<gate> netlist_internal_manager::create_gate(const u32 id, const
         log_error("netlist.internal", "netlist::create_gate: id 0 represents 'invalid ID'.");
         return nullptr;
     }
-    if (m_netlist->m_used_gate_ids.find(id) != m_netlist->m_used_gate_ids.end())
+    if (m_netlist->m_gates.contains(id))
     {
         log_error("netlist.internal", "netlist::create_gate: gate id {:08x} is already taken.", id);
         return nullptr;
@@ -44,20 +74,20 @@ std::shared_ptr<gate> netlist_internal_manager::create_gate(const u32 id, const
         return nullptr;
     }
 
-    auto new_gate = std::shared_ptr<gate>(new gate(m_netlist->get_shared(), id, gt, name, x, y));
+    auto new_gate = netlist_arena::create<gate>(m_netlist->m_arena, [&](void* mem) { return new (mem) gate(m_netlist, id, gt, name, x, y); });
 
-    auto free_id_it = m_netlist->m_free_gate_ids.find(id);
-    if (free_id_it != m_netlist->m_free_gate_ids.end())
-    {
-        m_netlist->m_free_gate_ids.erase(free_id_it);
-    }
-
-    m_netlist->m_used_gate_ids.insert(id);
+    m_netlist->m_gates.insert(new_gate);
 
     // add gate to top module
     new_gate->m_module                       = m_netlist->m_top_module;
     m_netlist->m_top_module->m_gates_map[id] = new_gate;
     m_netlist->m_top_module->m_gates_set.insert(new_gate);
+    invalidate_gate_order();
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_create_gate(new_gate);
+    }
 
     // notify
     module_event_handler::notify(module_event_handler::event::gate_assigned, m_netlist->m_top_module, id);
@@ -98,10 +128,15 @@ bool netlist_internal_manager::delete_gate(std::shared_ptr<gate> gate)
     // remove gate from modules
     gate->m_module->m_gates_map.erase(gate->m_module->m_gates_map.find(gate->get_id()));
     gate->m_module->m_gates_set.erase(gate);
+    invalidate_gate_order();
 
-    // free ids
-    m_netlist->m_free_gate_ids.insert(gate->get_id());
-    m_netlist->m_used_gate_ids.erase(gate->get_id());
+    // remove gate from netlist
+    m_netlist->m_gates.erase(gate->get_id());
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_delete_gate(gate);
+    }
 
     module_event_handler::notify(module_event_handler::event::gate_removed, gate->m_module, gate->get_id());
     gate_event_handler::notify(gate_event_handler::event::removed, gate);
@@ -131,7 +166,7 @@ std::shared_ptr<net> netlist_internal_manager::create_net(const u32 id, const st
         log_error("netlist.internal", "netlist::create_net: id 0 represents 'invalid ID'.");
         return nullptr;
     }
-    if (m_netlist->m_used_net_ids.find(id) != m_netlist->m_used_net_ids.end())
+    if (m_netlist->m_nets.contains(id))
     {
         log_error("netlist.internal", "netlist::create_net: net id {:08x} is already taken.", id);
         return nullptr;
@@ -142,20 +177,16 @@ std::shared_ptr<net> netlist_internal_manager::create_net(const u32 id, const st
         return nullptr;
     }
 
-    auto new_net = std::shared_ptr<net>(new net(this, id, name));
+    auto new_net = netlist_arena::create<net>(m_netlist->m_arena, [&](void* mem) { return new (mem) net(this, id, name); });
 
-    auto free_id_it = m_netlist->m_free_net_ids.find(id);
-    if (free_id_it != m_netlist->m_free_net_ids.end())
+    // add net to netlist
+    m_netlist->m_nets.insert(new_net);
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
     {
-        m_netlist->m_free_net_ids.erase(free_id_it);
+        journal->record_create_net(new_net);
     }
 
-    m_netlist->m_used_net_ids.insert(id);
-
-    // add net to netlist
-    m_netlist->m_nets_map[id] = new_net;
-    m_netlist->m_nets_set.insert(new_net);
-
     // notify
     net_event_handler::notify(net_event_handler::event::created, new_net);
 
@@ -169,7 +200,7 @@ bool netlist_internal_manager::delete_net(const std::shared_ptr<net>& net)
         return false;
     }
 
-    auto dsts = net->m_dsts;
+    auto dsts = net->get_dsts();
     for (const auto& dst : dsts)
     {
         if (net->is_a_dst(dst) && !this->net_remove_dst(net, dst))
@@ -188,11 +219,12 @@ bool netlist_internal_manager::delete_net(const std::shared_ptr<net>& net)
     m_netlist->unmark_global_output_net(net);
 
     // remove net from netlist
-    m_netlist->m_nets_map.erase(m_netlist->m_nets_map.find(net->get_id()));
-    m_netlist->m_nets_set.erase(net);
+    m_netlist->m_nets.erase(net->get_id());
 
-    m_netlist->m_free_net_ids.insert(net->get_id());
-    m_netlist->m_used_net_ids.erase(net->get_id());
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_delete_net(net);
+    }
 
     net_event_handler::notify(net_event_handler::event::removed, net);
 
@@ -207,26 +239,29 @@ bool netlist_internal_manager::net_set_src(const std::shared_ptr<net>& net, cons
     }
 
     // check whether pin is valid for this gate
-    auto output_pins = src.gate->get_type()->get_output_pins();
-    if ((std::find(output_pins.begin(), output_pins.end(), src.pin_type) == output_pins.end()))
+    u32 pin_id = src.gate->get_type()->get_output_pin_id(src.pin_type);
+    if (pin_id == gate_type::INVALID_PIN_ID)
     {
         log_error("netlist.internal", "net::set_src: src gate ('{}, type = {}) has no output type '{}'.", src.gate->get_name(), src.gate->get_type()->get_name(), src.pin_type);
         return false;
     }
 
+    // the pin may have been added to the gate type after the gate was created
+    if (pin_id >= src.gate->m_out_nets.size())
+    {
+        src.gate->m_out_nets.resize(pin_id + 1);
+    }
+
     // check whether src already belongs to other net
-    for (const auto& out_net : src.gate->get_fan_out_nets())
+    if (auto out_net = src.gate->m_out_nets[pin_id]; (out_net != nullptr) && (net != out_net))
     {
-        if ((out_net->get_src() == src) && (net != out_net))
-        {
-            log_error("netlist.internal",
-                      "net::set_src: src gate ('{}', {}) has already associated net '{}'. Cannot assign {} as new src.",
-                      src.gate->get_name(),
-                      src.pin_type,
-                      out_net->get_name(),
-                      net->get_name());
-            return false;
-        }
+        log_error("netlist.internal",
+                  "net::set_src: src gate ('{}', {}) has already associated net '{}'. Cannot assign {} as new src.",
+                  src.gate->get_name(),
+                  src.pin_type,
+                  out_net->get_name(),
+                  net->get_name());
+        return false;
     }
 
     // check whether net has already assigned src (if so remove it first)
@@ -235,8 +270,14 @@ bool netlist_internal_manager::net_set_src(const std::shared_ptr<net>& net, cons
         return false;
     }
 
-    net->m_src                         = src;
-    src.gate->m_out_nets[src.pin_type] = net;
+    net->m_src                   = {src.gate, pin_id};
+    src.gate->m_out_nets[pin_id] = net;
+
+    module_update_net_caches(src.gate, net, 0, 1);
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_connection(netlist_journal::operation::set_src, net, src.gate, pin_id);
+    }
 
     net_event_handler::notify(net_event_handler::event::src_changed, net);
 
@@ -258,8 +299,14 @@ bool netlist_internal_manager::net_remove_src(const std::shared_ptr<net>& net)
 
     auto old_src = net->m_src;
 
-    net->m_src.gate->m_out_nets.erase(net->m_src.pin_type);
-    net->m_src = {nullptr, ""};
+    net->m_src.gate->m_out_nets[net->m_src.pin_id] = nullptr;
+    net->m_src                                     = {nullptr, gate_type::INVALID_PIN_ID};
+
+    module_update_net_caches(old_src.gate, net, 0, -1);
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_connection(netlist_journal::operation::remove_src, net, old_src.gate, old_src.pin_id);
+    }
 
     net_event_handler::notify(net_event_handler::event::src_changed, net);
 
@@ -280,29 +327,45 @@ bool netlist_internal_manager::net_add_dst(const std::shared_ptr<net>& net, cons
     }
 
     // check whether pin id is valid for this gate
-    auto input_pins = dst.gate->get_type()->get_input_pins();
-
-    if ((std::find(input_pins.begin(), input_pins.end(), dst.pin_type) == input_pins.end()))
+    u32 pin_id = dst.gate->get_type()->get_input_pin_id(dst.pin_type);
+    if (pin_id == gate_type::INVALID_PIN_ID)
     {
         log_error("netlist.internal", "net::add_dst: dst gate ('{}',  type = {}) has no input type '{}'.", dst.gate->get_name(), dst.gate->get_type()->get_name(), dst.pin_type);
         return false;
     }
 
+    // the pin may have been added to the gate type after the gate was created
+    if (pin_id >= dst.gate->m_in_nets.size())
+    {
+        dst.gate->m_in_nets.resize(pin_id + 1);
+    }
+
     // check whether dst has already assigned src
-    if (dst.gate->get_fan_in_net(dst.pin_type) != nullptr)
+    if (auto in_net = dst.gate->m_in_nets[pin_id]; in_net != nullptr)
     {
         log_error("netlist.internal",
                   "net::add_dst: dst gate ('{}', type = {}) has already an assigned net '{}' for pin '{}' (new_net: {}).",
                   dst.gate->get_name(),
                   dst.gate->get_type()->get_name(),
-                  dst.gate->get_fan_in_net(dst.pin_type)->get_name(),
+                  in_net->get_name(),
                   dst.pin_type,
                   net->get_name());
         return false;
     }
 
-    net->m_dsts.push_back(dst);
-    dst.gate->m_in_nets[dst.pin_type] = net;
+    net->m_dsts.push_back({dst.gate, pin_id});
+    dst.gate->m_in_nets[pin_id] = net;
+
+    module_update_net_caches(dst.gate, net, 1, 0);
+    if (net->m_src.gate != nullptr)
+    {
+        // the number of destinations outside of the source's modules changed
+        module_update_net_caches(net->m_src.gate, net, 0, 0);
+    }
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_connection(netlist_journal::operation::add_dst, net, dst.gate, pin_id);
+    }
 
     net_event_handler::notify(net_event_handler::event::dst_added, net, dst.gate->get_id());
 
@@ -316,12 +379,23 @@ bool netlist_internal_manager::net_remove_dst(const std::shared_ptr<net>& net, c
         return false;
     }
 
-    auto it = std::find(net->m_dsts.begin(), net->m_dsts.end(), dst);
+    u32 pin_id = dst.gate->get_type()->get_input_pin_id(dst.pin_type);
+    auto it    = std::find_if(net->m_dsts.begin(), net->m_dsts.end(), [&dst, pin_id](const auto& ep) { return ep.gate == dst.gate && ep.pin_id == pin_id; });
 
     if (it != net->m_dsts.end())
     {
-        (*it).gate->m_in_nets.erase((*it).pin_type);
+        (*it).gate->m_in_nets[pin_id] = nullptr;
         net->m_dsts.erase(it);
+
+        module_update_net_caches(dst.gate, net, -1, 0);
+        if (net->m_src.gate != nullptr)
+        {
+            module_update_net_caches(net->m_src.gate, net, 0, 0);
+        }
+        if (auto journal = m_netlist->m_journal; journal != nullptr)
+        {
+            journal->record_connection(netlist_journal::operation::remove_dst, net, dst.gate, pin_id);
+        }
         net_event_handler::notify(net_event_handler::event::dst_removed, net, dst.gate->get_id());
     }
 
@@ -339,7 +413,7 @@ std::shared_ptr<module> netlist_internal_manager::create_module(const u32 id, co
         log_error("netlist.internal", "netlist::create_module: id 0 represents 'invalid ID'.");
         return nullptr;
     }
-    if (m_netlist->m_used_module_ids.find(id) != m_netlist->m_used_module_ids.end())
+    if (m_netlist->m_modules.contains(id))
     {
         log_error("netlist.internal", "netlist::create_module: module id {:08x} is already taken.", id);
         return nullptr;
@@ -360,23 +434,21 @@ std::shared_ptr<module> netlist_internal_manager::create_module(const u32 id, co
         return nullptr;
     }
 
-    auto m = std::shared_ptr<module>(new module(id, parent, name, this));
-
-    auto free_id_it = m_netlist->m_free_module_ids.find(id);
-    if (free_id_it != m_netlist->m_free_module_ids.end())
-    {
-        m_netlist->m_free_module_ids.erase(free_id_it);
-    }
-
-    m_netlist->m_used_module_ids.insert(id);
+    auto m = netlist_arena::create<module>(m_netlist->m_arena, [&](void* mem) { return new (mem) module(id, parent, name, this); });
 
-    m_netlist->m_modules[id] = m;
+    m_netlist->m_modules.insert(m);
 
     if (parent != nullptr)
     {
         parent->m_submodules_map[id] = m;
         parent->m_submodules_set.insert(m);
     }
+    invalidate_module_index();
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr && parent != nullptr)
+    {
+        journal->record_create_module(m);
+    }
 
     module_event_handler::notify(module_event_handler::event::created, m);
 
@@ -418,6 +490,10 @@ bool netlist_internal_manager::delete_module(const std::shared_ptr<module>& to_r
         module_event_handler::notify(module_event_handler::event::submodule_removed, sm->get_parent_module(), sm->get_id());
 
         sm->m_parent = to_remove->m_parent;
+        if (auto journal = m_netlist->m_journal; journal != nullptr)
+        {
+            journal->record_set_parent_module(sm, to_remove, to_remove->m_parent);
+        }
 
         module_event_handler::notify(module_event_handler::event::parent_changed, sm, 0);
         module_event_handler::notify(module_event_handler::event::submodule_added, to_remove->m_parent, sm->get_id());
@@ -426,12 +502,15 @@ bool netlist_internal_manager::delete_module(const std::shared_ptr<module>& to_r
     // remove module from parent
     to_remove->m_parent->m_submodules_map.erase(to_remove->get_id());
     to_remove->m_parent->m_submodules_set.erase(to_remove);
+    invalidate_module_index();
     module_event_handler::notify(module_event_handler::event::submodule_removed, to_remove->m_parent, to_remove->get_id());
 
     m_netlist->m_modules.erase(to_remove->get_id());
 
-    m_netlist->m_free_module_ids.insert(to_remove->get_id());
-    m_netlist->m_used_module_ids.erase(to_remove->get_id());
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_delete_module(to_remove);
+    }
 
     module_event_handler::notify(module_event_handler::event::removed, to_remove);
     return true;
@@ -449,6 +528,8 @@ bool netlist_internal_manager::module_assign_gate(const std::shared_ptr<module>&
     }
     auto prev_module = g->m_module;
 
+    module_move_gate_net_caches(g, prev_module, m);
+
     prev_module->m_gates_map.erase(prev_module->m_gates_map.find(g->get_id()));
     prev_module->m_gates_set.erase(g);
 
@@ -456,6 +537,12 @@ bool netlist_internal_manager::module_assign_gate(const std::shared_ptr<module>&
     m->m_gates_set.insert(g);
 
     g->m_module = m;
+    invalidate_gate_order();
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_move_gate(g, prev_module, m);
+    }
 
     module_event_handler::notify(module_event_handler::event::gate_removed, prev_module, g->get_id());
     module_event_handler::notify(module_event_handler::event::gate_assigned, m, g->get_id());
@@ -483,15 +570,183 @@ bool netlist_internal_manager::module_remove_gate(const std::shared_ptr<module>&
         return false;
     }
 
+    module_move_gate_net_caches(g, m, m_netlist->m_top_module);
+
     m->m_gates_map.erase(it);
     m->m_gates_set.erase(g);
 
     m_netlist->m_top_module->m_gates_map[g->get_id()] = g;
     m_netlist->m_top_module->m_gates_set.insert(g);
     g->m_module = m_netlist->m_top_module;
+    invalidate_gate_order();
+
+    if (auto journal = m_netlist->m_journal; journal != nullptr)
+    {
+        journal->record_move_gate(g, m, m_netlist->m_top_module);
+    }
 
     module_event_handler::notify(module_event_handler::event::gate_removed, m, g->get_id());
     module_event_handler::notify(module_event_handler::event::gate_assigned, m_netlist->m_top_module, g->get_id());
 
     return true;
 }
+
+void netlist_internal_manager::module_update_net_caches(const std::shared_ptr<gate>& g, const std::shared_ptr<net>& net, i32 dst_delta, i32 src_delta)
+{
+    // a gate is contained in its module and all of the module's ancestors
+    for (auto m = g->m_module.get(); m != nullptr; m = m->m_parent.get())
+    {
+        m->update_net_cache(net, dst_delta, src_delta);
+    }
+}
+
+void netlist_internal_manager::module_update_net_caches(const std::shared_ptr<net>& net)
+{
+    if (net->m_src.gate != nullptr)
+    {
+        module_update_net_caches(net->m_src.gate, net, 0, 0);
+    }
+    for (const auto& dst : net->m_dsts)
+    {
+        module_update_net_caches(dst.gate, net, 0, 0);
+    }
+}
+
+void netlist_internal_manager::module_move_gate_net_caches(const std::shared_ptr<gate>& g, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to)
+{
+    // only modules that contain the gate before but not after the move (or vice versa) are affected
+    std::unordered_set<module*> from_chain;
+    for (auto m = from.get(); m != nullptr; m = m->m_parent.get())
+    {
+        from_chain.insert(m);
+    }
+    std::unordered_set<module*> to_chain;
+    for (auto m = to.get(); m != nullptr; m = m->m_parent.get())
+    {
+        to_chain.insert(m);
+    }
+
+    auto apply = [&g](module* m, i32 sign) {
+        for (const auto& net : g->m_in_nets)
+        {
+            if (net != nullptr)
+            {
+                m->update_net_cache(net, sign, 0);
+            }
+        }
+        for (const auto& net : g->m_out_nets)
+        {
+            if (net != nullptr)
+            {
+                m->update_net_cache(net, 0, sign);
+            }
+        }
+    };
+
+    for (auto m : from_chain)
+    {
+        if (to_chain.find(m) == to_chain.end())
+        {
+            apply(m, -1);
+        }
+    }
+    for (auto m : to_chain)
+    {
+        if (from_chain.find(m) == from_chain.end())
+        {
+            apply(m, 1);
+        }
+    }
+}
+
+void netlist_internal_manager::invalidate_module_index()
+{
+    m_module_index_valid = false;
+    m_module_order.clear();
+    invalidate_gate_order();
+}
+
+void netlist_internal_manager::invalidate_gate_order()
+{
+    m_gate_order_valid = false;
+    m_gate_order.clear();
+}
+
+void netlist_internal_manager::update_module_index()
+{
+    if (m_module_index_valid)
+    {
+        return;
+    }
+
+    m_module_order.clear();
+    m_module_order.reserve(m_netlist->m_modules.size());
+
+    // iterative pre-order traversal, the second element marks that all submodules of the module have been visited
+    std::vector<std::pair<module*, bool>> stack;
+    if (m_netlist->m_top_module != nullptr)
+    {
+        stack.emplace_back(m_netlist->m_top_module.get(), false);
+    }
+    while (!stack.empty())
+    {
+        auto [m, done] = stack.back();
+        stack.pop_back();
+        if (done)
+        {
+            m->m_preorder_last = m_module_order.size() - 1;
+            continue;
+        }
+        m->m_preorder_first = m_module_order.size();
+        m_module_order.push_back(m);
+        stack.emplace_back(m, true);
+        for (auto it = m->m_submodules_map.rbegin(); it != m->m_submodules_map.rend(); ++it)
+        {
+            stack.emplace_back(it->second.get(), false);
+        }
+    }
+
+    m_module_index_valid = true;
+}
+
+bool netlist_internal_manager::use_gate_order()
+{
+    // while the order is invalid, recursive queries walk the hierarchy until the walks since the last rebuild have cost as
+    // much as rebuilding the order, so that alternating edits and queries neither rebuild on every query nor never at all
+    if (!m_gate_order_valid && m_gate_order_walk_cost < m_netlist->m_gates.size() + m_netlist->m_modules.size())
+    {
+        return false;
+    }
+    update_gate_order();
+    return true;
+}
+
+void netlist_internal_manager::update_gate_order()
+{
+    if (m_gate_order_valid)
+    {
+        return;
+    }
+    update_module_index();
+
+    m_gate_order.clear();
+    m_gate_order.reserve(m_netlist->m_gates.size());
+    for (auto m : m_module_order)
+    {
+        m->m_gate_order_begin = m_gate_order.size();
+        for (const auto& it : m->m_gates_map)
+        {
+            m_gate_order.push_back(it.second);
+        }
+    }
+
+    // the gates of a module's submodules directly follow its own gates and end where the next module outside of its subtree begins
+    for (auto m : m_module_order)
+    {
+        u32 next            = m->m_preorder_last + 1;
+        m->m_gate_order_end = (next < m_module_order.size()) ? m_module_order[next]->m_gate_order_begin : m_gate_order.size();
+    }
+
+    m_gate_order_valid     = true;
+    m_gate_order_walk_cost = 0;
+}
@@ -0,0 +1,752 @@
+#include "netlist/netlist_journal.h"
+
+#include "core/log.h"
+
+#include "netlist/boolean_function.h"
+#include "netlist/gate.h"
+#include "netlist/gate_library/gate_library.h"
+#include "netlist/module.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
+
+#include "netlist/event_system/event_controls.h"
+
+#include <cstring>
+
+namespace
+{
+    // field layout of each operation: u = varint, f = float, s = string, D = data entries, F = boolean functions
+    const char* const schema[] = {
+        "ussff",      // create_gate: id, type, name, x, y
+        "ussffuDF",   // delete_gate: id, type, name, x, y, module, data, functions
+        "us",         // create_net: id, name
+        "usD",        // delete_net: id, name, data
+        "uuu",        // set_src: net, gate, pin
+        "uuu",        // remove_src: net, gate, pin
+        "uuu",        // add_dst: net, gate, pin
+        "uuu",        // remove_dst: net, gate, pin
+        "uus",        // create_module: id, parent, name
+        "uusD",       // delete_module: id, parent, name, data
+        "uuu",        // move_gate: gate, from, to
+        "uuu",        // set_parent_module: module, from, to
+        "uss",        // rename_gate: id, old name, new name
+        "uss",        // rename_net: id, old name, new name
+        "uss",        // rename_module: id, old name, new name
+        "uffff",      // move_location: id, old x, old y, new x, new y
+        "u",          // mark_global_input: net
+        "u",          // unmark_global_input: net
+        "u",          // mark_global_output: net
+        "u",          // unmark_global_output: net
+        "u",          // mark_vcc_gate: gate
+        "u",          // unmark_vcc_gate: gate
+        "u",          // mark_gnd_gate: gate
+        "u",          // unmark_gnd_gate: gate
+    };
+}    // namespace
+
+netlist_journal::netlist_journal(const std::shared_ptr<netlist>& nl, u64 max_size) : m_netlist(nl), m_max_size(max_size)
+{
+    if (m_netlist == nullptr)
+    {
+        log_error("netlist", "netlist_journal: netlist must not be nullptr.");
+        return;
+    }
+    if (m_netlist->m_journal != nullptr)
+    {
+        log_error("netlist", "netlist_journal: netlist already has a journal attached.");
+        return;
+    }
+    m_netlist->m_journal = this;
+    m_attached           = true;
+}
+
+netlist_journal::~netlist_journal()
+{
+    if (m_attached)
+    {
+        m_netlist->m_journal = nullptr;
+    }
+}
+
+bool netlist_journal::is_attached() const
+{
+    return m_attached;
+}
+
+void netlist_journal::checkpoint()
+{
+    if (m_current_group.empty())
+    {
+        return;
+    }
+    m_undo_groups.push_back(std::move(m_current_group));
+    m_current_group.clear();
+    enforce_size_limit();
+}
+
+bool netlist_journal::undo()
+{
+    checkpoint();
+    if (m_undo_groups.empty())
+    {
+        return false;
+    }
+
+    auto group = std::move(m_undo_groups.back());
+    m_undo_groups.pop_back();
+
+    auto entries = decode(group);
+    bool success = true;
+
+    m_replaying = true;
+    {
+        event_controls::scoped_batch batch(m_netlist);
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+        {
+            success &= apply(*it, true);
+        }
+    }
+    m_replaying = false;
+
+    m_redo_groups.push_back(std::move(group));
+    return success;
+}
+
+bool netlist_journal::redo()
+{
+    if (m_redo_groups.empty())
+    {
+        return false;
+    }
+
+    auto group = std::move(m_redo_groups.back());
+    m_redo_groups.pop_back();
+
+    auto entries = decode(group);
+    bool success = true;
+
+    m_replaying = true;
+    {
+        event_controls::scoped_batch batch(m_netlist);
+        for (const auto& e : entries)
+        {
+            success &= apply(e, false);
+        }
+    }
+    m_replaying = false;
+
+    m_undo_groups.push_back(std::move(group));
+    return success;
+}
+
+u32 netlist_journal::get_num_undo_steps() const
+{
+    return m_undo_groups.size() + (m_current_group.empty() ? 0 : 1);
+}
+
+u32 netlist_journal::get_num_redo_steps() const
+{
+    return m_redo_groups.size();
+}
+
+u64 netlist_journal::get_size() const
+{
+    return m_size;
+}
+
+void netlist_journal::clear()
+{
+    m_undo_groups.clear();
+    m_redo_groups.clear();
+    m_current_group.clear();
+    m_size = 0;
+}
+
+void netlist_journal::enforce_size_limit()
+{
+    while (m_size > m_max_size && !m_undo_groups.empty())
+    {
+        m_size -= m_undo_groups.front().size();
+        m_undo_groups.pop_front();
+    }
+
+    // an open group that exceeds the limit on its own cannot be reverted partially, hence it is dropped as a whole
+    if (m_size > m_max_size)
+    {
+        m_size -= m_current_group.size();
+        m_current_group.clear();
+    }
+}
+
+/*
+ * ################################################################
+ *      recording
+ * ################################################################
+ */
+
+bool netlist_journal::is_recording() const
+{
+    return m_attached && !m_replaying;
+}
+
+void netlist_journal::begin_entry(operation op)
+{
+    // a new modification invalidates everything that was undone
+    for (const auto& group : m_redo_groups)
+    {
+        m_size -= group.size();
+    }
+    m_redo_groups.clear();
+
+    m_entry_begin = m_current_group.size();
+    m_current_group.push_back((u8)op);
+}
+
+void netlist_journal::end_entry()
+{
+    m_size += m_current_group.size() - m_entry_begin;
+    enforce_size_limit();
+}
+
+void netlist_journal::write_value(u64 value)
+{
+    // LEB128, ids and counts mostly fit into one or two bytes
+    do
+    {
+        u8 byte = value & 0x7F;
+        value >>= 7;
+        m_current_group.push_back(byte | (value != 0 ? 0x80 : 0));
+    } while (value != 0);
+}
+
+void netlist_journal::write_float(float value)
+{
+    u8 bytes[sizeof(float)];
+    std::memcpy(bytes, &value, sizeof(float));
+    m_current_group.insert(m_current_group.end(), bytes, bytes + sizeof(float));
+}
+
+void netlist_journal::write_string(const std::string& value)
+{
+    write_value(value.size());
+    m_current_group.insert(m_current_group.end(), value.begin(), value.end());
+}
+
+void netlist_journal::write_data(const data_container& c)
+{
+    auto data = c.get_data();
+    write_value(data.size());
+    for (const auto& [key, value] : data)
+    {
+        write_string(std::get<0>(key));
+        write_string(std::get<1>(key));
+        write_string(std::get<0>(value));
+        write_string(std::get<1>(value));
+    }
+}
+
+void netlist_journal::record_create_gate(const std::shared_ptr<gate>& g)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::create_gate);
+    write_value(g->get_id());
+    write_string(g->get_type()->get_name());
+    write_string(g->get_name());
+    write_float(g->get_location_x());
+    write_float(g->get_location_y());
+    end_entry();
+}
+
+void netlist_journal::record_delete_gate(const std::shared_ptr<gate>& g)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::delete_gate);
+    write_value(g->get_id());
+    write_string(g->get_type()->get_name());
+    write_string(g->get_name());
+    write_float(g->get_location_x());
+    write_float(g->get_location_y());
+    write_value(g->get_module()->get_id());
+    write_data(*g);
+    auto functions = g->get_boolean_functions(true);
+    write_value(functions.size());
+    for (const auto& [name, function] : functions)
+    {
+        write_string(name);
+        write_string(function.to_string());
+    }
+    end_entry();
+}
+
+void netlist_journal::record_create_net(const std::shared_ptr<net>& n)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::create_net);
+    write_value(n->get_id());
+    write_string(n->get_name());
+    end_entry();
+}
+
+void netlist_journal::record_delete_net(const std::shared_ptr<net>& n)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::delete_net);
+    write_value(n->get_id());
+    write_string(n->get_name());
+    write_data(*n);
+    end_entry();
+}
+
+void netlist_journal::record_connection(operation op, const std::shared_ptr<net>& n, const std::shared_ptr<gate>& g, u32 pin_id)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(op);
+    write_value(n->get_id());
+    write_value(g->get_id());
+    write_value(pin_id);
+    end_entry();
+}
+
+void netlist_journal::record_create_module(const std::shared_ptr<module>& m)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::create_module);
+    write_value(m->get_id());
+    write_value(m->get_parent_module()->get_id());
+    write_string(m->get_name());
+    end_entry();
+}
+
+void netlist_journal::record_delete_module(const std::shared_ptr<module>& m)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::delete_module);
+    write_value(m->get_id());
+    write_value(m->get_parent_module()->get_id());
+    write_string(m->get_name());
+    write_data(*m);
+    end_entry();
+}
+
+void netlist_journal::record_move_gate(const std::shared_ptr<gate>& g, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::move_gate);
+    write_value(g->get_id());
+    write_value(from->get_id());
+    write_value(to->get_id());
+    end_entry();
+}
+
+void netlist_journal::record_set_parent_module(const std::shared_ptr<module>& m, const std::shared_ptr<module>& from, const std::shared_ptr<module>& to)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::set_parent_module);
+    write_value(m->get_id());
+    write_value(from->get_id());
+    write_value(to->get_id());
+    end_entry();
+}
+
+void netlist_journal::record_rename(operation op, u32 id, const std::string& old_name, const std::string& new_name)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(op);
+    write_value(id);
+    write_string(old_name);
+    write_string(new_name);
+    end_entry();
+}
+
+void netlist_journal::record_move_location(u32 id, float old_x, float old_y, float new_x, float new_y)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(operation::move_location);
+    write_value(id);
+    write_float(old_x);
+    write_float(old_y);
+    write_float(new_x);
+    write_float(new_y);
+    end_entry();
+}
+
+void netlist_journal::record_marking(operation op, u32 id)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+    begin_entry(op);
+    write_value(id);
+    end_entry();
+}
+
+/*
+ * ################################################################
+ *      replaying
+ * ################################################################
+ */
+
+std::vector<netlist_journal::entry> netlist_journal::decode(const std::vector<u8>& group) const
+{
+    std::vector<entry> entries;
+    u64 pos = 0;
+
+    auto read_value = [&group, &pos]() {
+        u64 value = 0;
+        u32 shift = 0;
+        u8 byte;
+        do
+        {
+            byte = group[pos++];
+            value |= (u64)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    };
+    auto read_string = [&group, &pos, &read_value]() {
+        u64 size = read_value();
+        std::string value(group.begin() + pos, group.begin() + pos + size);
+        pos += size;
+        return value;
+    };
+
+    while (pos < group.size())
+    {
+        entry e;
+        e.op = (operation)group[pos++];
+        for (const char* field = schema[(u8)e.op]; *field != '\0'; ++field)
+        {
+            switch (*field)
+            {
+                case 'u':
+                    e.values.push_back(read_value());
+                    break;
+                case 'f': {
+                    float value;
+                    std::memcpy(&value, &group[pos], sizeof(float));
+                    pos += sizeof(float);
+                    e.floats.push_back(value);
+                    break;
+                }
+                case 's':
+                    e.strings.push_back(read_string());
+                    break;
+                case 'D':
+                case 'F': {
+                    u64 count = read_value();
+                    e.values.push_back(count);
+                    for (u64 i = 0; i < count * (*field == 'D' ? 4 : 2); ++i)
+                    {
+                        e.strings.push_back(read_string());
+                    }
+                    break;
+                }
+            }
+        }
+        entries.push_back(std::move(e));
+    }
+    return entries;
+}
+
+bool netlist_journal::apply(const entry& e, bool revert)
+{
+    switch (e.op)
+    {
+        case operation::create_gate:
+            return revert ? delete_gate(e.values[0]) : restore_gate(e);
+        case operation::delete_gate:
+            return revert ? restore_gate(e) : delete_gate(e.values[0]);
+        case operation::create_net:
+            return revert ? delete_net(e.values[0]) : restore_net(e);
+        case operation::delete_net:
+            return revert ? restore_net(e) : delete_net(e.values[0]);
+        case operation::set_src:
+            return connect(revert ? operation::remove_src : operation::set_src, e);
+        case operation::remove_src:
+            return connect(revert ? operation::set_src : operation::remove_src, e);
+        case operation::add_dst:
+            return connect(revert ? operation::remove_dst : operation::add_dst, e);
+        case operation::remove_dst:
+            return connect(revert ? operation::add_dst : operation::remove_dst, e);
+        case operation::create_module:
+            return revert ? delete_module(e.values[0]) : restore_module(e);
+        case operation::delete_module:
+            return revert ? restore_module(e) : delete_module(e.values[0]);
+        case operation::move_gate:
+            return move_gate(e.values[0], revert ? e.values[1] : e.values[2]);
+        case operation::set_parent_module:
+            return set_parent_module(e.values[0], revert ? e.values[1] : e.values[2]);
+        case operation::rename_gate:
+        case operation::rename_net:
+        case operation::rename_module:
+            return rename(e.op, e.values[0], revert ? e.strings[0] : e.strings[1]);
+        case operation::move_location:
+            return revert ? move_location(e.values[0], e.floats[0], e.floats[1]) : move_location(e.values[0], e.floats[2], e.floats[3]);
+        case operation::mark_global_input:
+            return mark(revert ? operation::unmark_global_input : e.op, e.values[0]);
+        case operation::unmark_global_input:
+            return mark(revert ? operation::mark_global_input : e.op, e.values[0]);
+        case operation::mark_global_output:
+            return mark(revert ? operation::unmark_global_output : e.op, e.values[0]);
+        case operation::unmark_global_output:
+            return mark(revert ? operation::mark_global_output : e.op, e.values[0]);
+        case operation::mark_vcc_gate:
+            return mark(revert ? operation::unmark_vcc_gate : e.op, e.values[0]);
+        case operation::unmark_vcc_gate:
+            return mark(revert ? operation::mark_vcc_gate : e.op, e.values[0]);
+        case operation::mark_gnd_gate:
+            return mark(revert ? operation::unmark_gnd_gate : e.op, e.values[0]);
+        case operation::unmark_gnd_gate:
+            return mark(revert ? operation::mark_gnd_gate : e.op, e.values[0]);
+    }
+    return false;
+}
+
+bool netlist_journal::restore_gate(const entry& e)
+{
+    const auto& gate_types = m_netlist->get_gate_library()->get_gate_types();
+    auto type_it           = gate_types.find(e.strings[0]);
+    if (type_it == gate_types.end())
+    {
+        log_error("netlist", "netlist_journal: gate type '{}' does not exist in the gate library.", e.strings[0]);
+        return false;
+    }
+
+    auto g = m_netlist->create_gate(e.values[0], type_it->second, e.strings[1], e.floats[0], e.floats[1]);
+    if (g == nullptr)
+    {
+        return false;
+    }
+    if (e.op != operation::delete_gate)
+    {
+        return true;
+    }
+
+    u64 num_data = e.values[2];
+    u64 idx      = 2;
+    for (u64 i = 0; i < num_data; ++i, idx += 4)
+    {
+        g->set_data(e.strings[idx], e.strings[idx + 1], e.strings[idx + 2], e.strings[idx + 3]);
+    }
+    u64 num_functions = e.values[3];
+    for (u64 i = 0; i < num_functions; ++i, idx += 2)
+    {
+        g->add_boolean_function(e.strings[idx], boolean_function::from_string(e.strings[idx + 1], g->get_input_pins()));
+    }
+
+    if (e.values[1] != m_netlist->get_top_module()->get_id())
+    {
+        return move_gate(e.values[0], e.values[1]);
+    }
+    return true;
+}
+
+bool netlist_journal::restore_net(const entry& e)
+{
+    auto n = m_netlist->create_net(e.values[0], e.strings[0]);
+    if (n == nullptr)
+    {
+        return false;
+    }
+    if (e.op == operation::delete_net)
+    {
+        u64 idx = 1;
+        for (u64 i = 0; i < e.values[1]; ++i, idx += 4)
+        {
+            n->set_data(e.strings[idx], e.strings[idx + 1], e.strings[idx + 2], e.strings[idx + 3]);
+        }
+    }
+    return true;
+}
+
+bool netlist_journal::restore_module(const entry& e)
+{
+    auto parent = m_netlist->get_module_by_id(e.values[1]);
+    if (parent == nullptr)
+    {
+        log_error("netlist", "netlist_journal: module with id {:08x} does not exist.", e.values[1]);
+        return false;
+    }
+    auto m = m_netlist->create_module(e.values[0], e.strings[0], parent);
+    if (m == nullptr)
+    {
+        return false;
+    }
+    if (e.op == operation::delete_module)
+    {
+        u64 idx = 1;
+        for (u64 i = 0; i < e.values[2]; ++i, idx += 4)
+        {
+            m->set_data(e.strings[idx], e.strings[idx + 1], e.strings[idx + 2], e.strings[idx + 3]);
+        }
+    }
+    return true;
+}
+
+bool netlist_journal::delete_gate(u32 id)
+{
+    return m_netlist->delete_gate(m_netlist->get_gate_by_id(id));
+}
+
+bool netlist_journal::delete_net(u32 id)
+{
+    return m_netlist->delete_net(m_netlist->get_net_by_id(id));
+}
+
+bool netlist_journal::delete_module(u32 id)
+{
+    return m_netlist->delete_module(m_netlist->get_module_by_id(id));
+}
+
+bool netlist_journal::connect(operation op, const entry& e)
+{
+    auto n = m_netlist->get_net_by_id(e.values[0]);
+    auto g = m_netlist->get_gate_by_id(e.values[1]);
+    if (n == nullptr || g == nullptr)
+    {
+        log_error("netlist", "netlist_journal: net with id {:08x} or gate with id {:08x} does not exist.", e.values[0], e.values[1]);
+        return false;
+    }
+
+    const auto& pins = (op == operation::set_src || op == operation::remove_src) ? g->get_output_pins() : g->get_input_pins();
+    if (e.values[2] >= pins.size())
+    {
+        log_error("netlist", "netlist_journal: gate '{}' has no pin with id {}.", g->get_name(), e.values[2]);
+        return false;
+    }
+    const auto& pin = pins[e.values[2]];
+
+    switch (op)
+    {
+        case operation::set_src:
+            return n->set_src(g, pin);
+        case operation::remove_src:
+            return n->remove_src();
+        case operation::add_dst:
+            return n->add_dst(g, pin);
+        default:
+            return n->remove_dst(g, pin);
+    }
+}
+
+bool netlist_journal::move_gate(u32 gate_id, u32 module_id)
+{
+    auto g = m_netlist->get_gate_by_id(gate_id);
+    auto m = m_netlist->get_module_by_id(module_id);
+    if (g == nullptr || m == nullptr)
+    {
+        log_error("netlist", "netlist_journal: gate with id {:08x} or module with id {:08x} does not exist.", gate_id, module_id);
+        return false;
+    }
+    return m->assign_gate(g);
+}
+
+bool netlist_journal::set_parent_module(u32 module_id, u32 parent_id)
+{
+    auto m      = m_netlist->get_module_by_id(module_id);
+    auto parent = m_netlist->get_module_by_id(parent_id);
+    if (m == nullptr || parent == nullptr)
+    {
+        log_error("netlist", "netlist_journal: module with id {:08x} or {:08x} does not exist.", module_id, parent_id);
+        return false;
+    }
+    return m->set_parent_module(parent);
+}
+
+bool netlist_journal::rename(operation op, u32 id, const std::string& name)
+{
+    if (op == operation::rename_gate)
+    {
+        if (auto g = m_netlist->get_gate_by_id(id); g != nullptr)
+        {
+            g->set_name(name);
+            return true;
+        }
+    }
+    else if (op == operation::rename_net)
+    {
+        if (auto n = m_netlist->get_net_by_id(id); n != nullptr)
+        {
+            n->set_name(name);
+            return true;
+        }
+    }
+    else if (auto m = m_netlist->get_module_by_id(id); m != nullptr)
+    {
+        m->set_name(name);
+        return true;
+    }
+    log_error("netlist", "netlist_journal: object with id {:08x} to rename does not exist.", id);
+    return false;
+}
+
+bool netlist_journal::move_location(u32 id, float x, float y)
+{
+    auto g = m_netlist->get_gate_by_id(id);
+    if (g == nullptr)
+    {
+        log_error("netlist", "netlist_journal: gate with id {:08x} does not exist.", id);
+        return false;
+    }
+    g->set_location({x, y});
+    return true;
+}
+
+bool netlist_journal::mark(operation op, u32 id)
+{
+    switch (op)
+    {
+        case operation::mark_global_input:
+            return m_netlist->mark_global_input_net(m_netlist->get_net_by_id(id));
+        case operation::unmark_global_input:
+            return m_netlist->unmark_global_input_net(m_netlist->get_net_by_id(id));
+        case operation::mark_global_output:
+            return m_netlist->mark_global_output_net(m_netlist->get_net_by_id(id));
+        case operation::unmark_global_output:
+            return m_netlist->unmark_global_output_net(m_netlist->get_net_by_id(id));
+        case operation::mark_vcc_gate:
+            return m_netlist->mark_vcc_gate(m_netlist->get_gate_by_id(id));
+        case operation::unmark_vcc_gate:
+            return m_netlist->unmark_vcc_gate(m_netlist->get_gate_by_id(id));
+        case operation::mark_gnd_gate:
+            return m_netlist->mark_gnd_gate(m_netlist->get_gate_by_id(id));
+        case operation::unmark_gnd_gate:
+            return m_netlist->unmark_gnd_gate(m_netlist->get_gate_by_id(id));
+        default:
+            return false;
+    }
+}
@@ -62,7 +62,8 @@ namespace netlist_serializer
             return val;
         }
 
-        rapidjson::Value serialize(const std::shared_ptr<gate>& g, rapidjson::Document::AllocatorType& allocator)
+        // function_buffer is reused across gates to avoid allocating a string per custom function
+        rapidjson::Value serialize(const std::shared_ptr<gate>& g, std::string& function_buffer, rapidjson::Document::AllocatorType& allocator)
         {
             rapidjson::Value val(rapidjson::kObjectType);
             val.AddMember("id", g->get_id(), allocator);
@@ -77,8 +78,9 @@ namespace netlist_serializer
                 rapidjson::Value functions(rapidjson::kObjectType);
                 for (const auto& it : g->get_boolean_functions(true))
                 {
-                    auto s = it.second.to_string();
-                    functions.AddMember(JSON_STR_HELPER(it.first), JSON_STR_HELPER(s), allocator);
+                    function_buffer.clear();
+                    it.second.to_string(function_buffer);
+                    functions.AddMember(JSON_STR_HELPER(it.first), JSON_STR_HELPER(function_buffer), allocator);
                 }
                 if (functions.MemberCount() > 0)
                 {
@@ -175,9 +177,10 @@ namespace netlist_serializer
                 auto to_sort = nl->get_gates();
                 std::vector<std::shared_ptr<gate>> sorted(to_sort.begin(), to_sort.end());
                 std::sort(sorted.begin(), sorted.end(), [](const std::shared_ptr<gate>& lhs, const std::shared_ptr<gate>& rhs) { return lhs->get_id() < rhs->get_id(); });
+                std::string function_buffer;
                 for (const auto& gate : sorted)
                 {
-                    gates.PushBack(serialize(gate, allocator), allocator);
+                    gates.PushBack(serialize(gate, function_buffer, allocator), allocator);
                     if (nl->is_gnd_gate(gate))
                     {
                         global_gnds.PushBack(gate->get_id(), allocator);
@@ -0,0 +1,590 @@
+#include "netlist/sat_solver.h"
+
+#include "core/log.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr u8 FALSE      = 0;
+    constexpr u8 TRUE       = 1;
+    constexpr u8 UNASSIGNED = 2;
+
+    constexpr u32 NO_REASON = 0xFFFFFFFF;
+
+    constexpr double VARIABLE_DECAY = 0.95;
+    constexpr double CLAUSE_DECAY   = 0.999;
+    constexpr u64 RESTART_BASE      = 100;
+
+    // i-th element of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+    u64 luby(u64 i)
+    {
+        u64 size     = 1;
+        u32 exponent = 0;
+        while (size < i + 1)
+        {
+            size = 2 * size + 1;
+            exponent++;
+        }
+        while (size - 1 != i)
+        {
+            size = (size - 1) >> 1;
+            exponent--;
+            i = i % size;
+        }
+        return 1ull << exponent;
+    }
+}    // namespace
+
+sat_solver::sat_solver()
+{
+}
+
+u32 sat_solver::create_variable()
+{
+    u32 variable = m_values.size();
+    m_values.push_back(UNASSIGNED);
+    m_phases.push_back(FALSE);
+    m_levels.push_back(0);
+    m_reasons.push_back(NO_REASON);
+    m_activities.push_back(0);
+    m_seen.push_back(0);
+    m_heap_positions.push_back(INVALID);
+    m_watches.emplace_back();
+    m_watches.emplace_back();
+    heap_insert(variable);
+    return variable;
+}
+
+u32 sat_solver::get_num_variables() const
+{
+    return m_values.size();
+}
+
+u32 sat_solver::get_num_clauses() const
+{
+    return m_clauses.size() - m_num_learnt_clauses;
+}
+
+u64 sat_solver::get_num_conflicts() const
+{
+    return m_num_conflicts;
+}
+
+u32 sat_solver::get_literal(u32 variable, bool negated)
+{
+    return (variable << 1) | (negated ? 1 : 0);
+}
+
+u8 sat_solver::get_value(u32 literal) const
+{
+    u8 value = m_values[literal >> 1];
+    return (value == UNASSIGNED) ? UNASSIGNED : (value ^ (literal & 1));
+}
+
+u32 sat_solver::get_decision_level() const
+{
+    return m_trail_limits.size();
+}
+
+bool sat_solver::add_clause(const std::vector<u32>& literals)
+{
+    if (std::any_of(literals.begin(), literals.end(), [this](u32 l) { return (l >> 1) >= m_values.size(); }))
+    {
+        log_error("netlist", "clause refers to a variable that does not exist.");
+        return false;
+    }
+    if (!m_ok)
+    {
+        return false;
+    }
+
+    // clauses are only added in between searches, i.e., at decision level 0
+    std::vector<u32> sorted(literals);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<u32> simplified;
+    for (u32 i = 0; i < sorted.size(); ++i)
+    {
+        u32 l = sorted[i];
+        if (get_value(l) == TRUE || (i + 1 < sorted.size() && sorted[i + 1] == (l ^ 1)))
+        {
+            // satisfied or tautology
+            return true;
+        }
+        if (get_value(l) == UNASSIGNED)
+        {
+            simplified.push_back(l);
+        }
+    }
+
+    if (simplified.empty())
+    {
+        m_ok = false;
+    }
+    else if (simplified.size() == 1)
+    {
+        enqueue(simplified[0], NO_REASON);
+        m_ok = (propagate() == NO_REASON);
+    }
+    else
+    {
+        attach_clause(std::move(simplified), false);
+    }
+    return m_ok;
+}
+
+u32 sat_solver::attach_clause(std::vector<u32>&& literals, bool learnt)
+{
+    u32 index = m_clauses.size();
+    m_watches[literals[0]].push_back(index);
+    m_watches[literals[1]].push_back(index);
+    m_clauses.push_back({std::move(literals), learnt, 0});
+    if (learnt)
+    {
+        m_num_learnt_clauses++;
+        bump_clause(index);
+    }
+    return index;
+}
+
+void sat_solver::enqueue(u32 literal, u32 reason)
+{
+    u32 variable        = literal >> 1;
+    m_values[variable]  = (literal & 1) ? FALSE : TRUE;
+    m_levels[variable]  = get_decision_level();
+    m_reasons[variable] = reason;
+    m_trail.push_back(literal);
+}
+
+u32 sat_solver::propagate()
+{
+    while (m_propagation_head < m_trail.size())
+    {
+        u32 false_literal = m_trail[m_propagation_head++] ^ 1;
+        auto& watches     = m_watches[false_literal];
+
+        u32 j = 0;
+        for (u32 i = 0; i < watches.size(); ++i)
+        {
+            u32 index = watches[i];
+            auto& c   = m_clauses[index].literals;
+
+            // the false literal is moved to position 1, the other watch is at position 0
+            if (c[0] == false_literal)
+            {
+                std::swap(c[0], c[1]);
+            }
+            if (get_value(c[0]) == TRUE)
+            {
+                watches[j++] = index;
+                continue;
+            }
+
+            bool found_watch = false;
+            for (u32 k = 2; k < c.size(); ++k)
+            {
+                if (get_value(c[k]) != FALSE)
+                {
+                    std::swap(c[1], c[k]);
+                    m_watches[c[1]].push_back(index);
+                    found_watch = true;
+                    break;
+                }
+            }
+            if (found_watch)
+            {
+                continue;
+            }
+
+            watches[j++] = index;
+            if (get_value(c[0]) == FALSE)
+            {
+                for (++i; i < watches.size(); ++i)
+                {
+                    watches[j++] = watches[i];
+                }
+                watches.resize(j);
+                m_propagation_head = m_trail.size();
+                return index;
+            }
+            enqueue(c[0], index);
+        }
+        watches.resize(j);
+    }
+    return NO_REASON;
+}
+
+std::vector<u32> sat_solver::analyze(u32 conflict, u32& backtrack_level)
+{
+    // first unique implication point, the asserting literal is placed at position 0
+    std::vector<u32> learnt = {INVALID};
+    u32 open_literals       = 0;
+    u32 literal             = INVALID;
+    u32 trail_index         = m_trail.size();
+    u32 reason              = conflict;
+
+    do
+    {
+        if (m_clauses[reason].learnt)
+        {
+            bump_clause(reason);
+        }
+        const auto& reason_literals = m_clauses[reason].literals;
+        for (u32 k = (literal == INVALID) ? 0 : 1; k < reason_literals.size(); ++k)
+        {
+            u32 variable = reason_literals[k] >> 1;
+            if (!m_seen[variable] && m_levels[variable] > 0)
+            {
+                m_seen[variable] = 1;
+                bump_variable(variable);
+                if (m_levels[variable] >= get_decision_level())
+                {
+                    open_literals++;
+                }
+                else
+                {
+                    learnt.push_back(reason_literals[k]);
+                }
+            }
+        }
+
+        while (!m_seen[m_trail[--trail_index] >> 1])
+        {
+        }
+        literal              = m_trail[trail_index];
+        reason               = m_reasons[literal >> 1];
+        m_seen[literal >> 1] = 0;
+        open_literals--;
+    } while (open_literals > 0);
+    learnt[0] = literal ^ 1;
+
+    // drop literals that are implied by the other literals of the clause
+    std::vector<u32> minimized = {learnt[0]};
+    for (u32 i = 1; i < learnt.size(); ++i)
+    {
+        u32 r = m_reasons[learnt[i] >> 1];
+        if (r == NO_REASON)
+        {
+            minimized.push_back(learnt[i]);
+            continue;
+        }
+        const auto& reason_literals = m_clauses[r].literals;
+        bool redundant              = std::all_of(reason_literals.begin() + 1, reason_literals.end(), [this](u32 l) { return m_seen[l >> 1] || m_levels[l >> 1] == 0; });
+        if (!redundant)
+        {
+            minimized.push_back(learnt[i]);
+        }
+    }
+    for (u32 i = 1; i < learnt.size(); ++i)
+    {
+        m_seen[learnt[i] >> 1] = 0;
+    }
+    learnt = std::move(minimized);
+
+    // the literal of the highest remaining level becomes the second watch
+    backtrack_level = 0;
+    if (learnt.size() > 1)
+    {
+        u32 max_index = 1;
+        for (u32 i = 2; i < learnt.size(); ++i)
+        {
+            if (m_levels[learnt[i] >> 1] > m_levels[learnt[max_index] >> 1])
+            {
+                max_index = i;
+            }
+        }
+        std::swap(learnt[1], learnt[max_index]);
+        backtrack_level = m_levels[learnt[1] >> 1];
+    }
+    return learnt;
+}
+
+void sat_solver::backtrack(u32 level)
+{
+    if (get_decision_level() <= level)
+    {
+        return;
+    }
+    for (u32 i = m_trail.size(); i > m_trail_limits[level]; --i)
+    {
+        u32 variable       = m_trail[i - 1] >> 1;
+        m_phases[variable] = m_values[variable];
+        m_values[variable] = UNASSIGNED;
+        if (m_heap_positions[variable] == INVALID)
+        {
+            heap_insert(variable);
+        }
+    }
+    m_trail.resize(m_trail_limits[level]);
+    m_trail_limits.resize(level);
+    m_propagation_head = m_trail.size();
+}
+
+u32 sat_solver::pick_branch_literal()
+{
+    while (!m_heap.empty())
+    {
+        u32 variable = heap_pop();
+        if (m_values[variable] == UNASSIGNED)
+        {
+            return get_literal(variable, m_phases[variable] == FALSE);
+        }
+    }
+    return INVALID;
+}
+
+sat_solver::result sat_solver::solve(const std::vector<u32>& assumptions, u64 conflict_limit)
+{
+    m_model.clear();
+    if (std::any_of(assumptions.begin(), assumptions.end(), [this](u32 l) { return (l >> 1) >= m_values.size(); }))
+    {
+        log_error("netlist", "assumption refers to a variable that does not exist.");
+        return result::UNKNOWN;
+    }
+    if (!m_ok)
+    {
+        return result::UNSATISFIABLE;
+    }
+
+    m_max_learnt_clauses = std::max<u32>(get_num_clauses() / 3, 2000);
+
+    u64 num_conflicts = 0;
+    result res        = result::UNKNOWN;
+    for (u64 restart = 0; res == result::UNKNOWN && (conflict_limit == 0 || num_conflicts < conflict_limit); ++restart)
+    {
+        if (m_num_learnt_clauses >= m_max_learnt_clauses)
+        {
+            reduce_learnt_clauses();
+        }
+        res = search(assumptions, luby(restart) * RESTART_BASE, conflict_limit, num_conflicts);
+    }
+
+    if (res == result::SATISFIABLE)
+    {
+        m_model = m_values;
+    }
+    backtrack(0);
+    return res;
+}
+
+sat_solver::result sat_solver::search(const std::vector<u32>& assumptions, u64 restart_limit, u64 conflict_limit, u64& num_conflicts)
+{
+    u64 local_conflicts = 0;
+    while (true)
+    {
+        u32 conflict = propagate();
+        if (conflict != NO_REASON)
+        {
+            num_conflicts++;
+            local_conflicts++;
+            m_num_conflicts++;
+            if (get_decision_level() == 0)
+            {
+                m_ok = false;
+                return result::UNSATISFIABLE;
+            }
+
+            u32 backtrack_level;
+            auto learnt = analyze(conflict, backtrack_level);
+            backtrack(backtrack_level);
+            if (learnt.size() == 1)
+            {
+                enqueue(learnt[0], NO_REASON);
+            }
+            else
+            {
+                u32 literal = learnt[0];
+                enqueue(literal, attach_clause(std::move(learnt), true));
+            }
+
+            m_variable_increment /= VARIABLE_DECAY;
+            m_clause_increment /= CLAUSE_DECAY;
+            continue;
+        }
+
+        if (local_conflicts >= restart_limit || (conflict_limit != 0 && num_conflicts >= conflict_limit))
+        {
+            backtrack(0);
+            return result::UNKNOWN;
+        }
+
+        // assumptions are decided first, one decision level each
+        u32 next = INVALID;
+        while (get_decision_level() < assumptions.size())
+        {
+            u32 assumption = assumptions[get_decision_level()];
+            if (get_value(assumption) == TRUE)
+            {
+                m_trail_limits.push_back(m_trail.size());
+            }
+            else if (get_value(assumption) == FALSE)
+            {
+                backtrack(0);
+                return result::UNSATISFIABLE;
+            }
+            else
+            {
+                next = assumption;
+                break;
+            }
+        }
+
+        if (next == INVALID)
+        {
+            next = pick_branch_literal();
+            if (next == INVALID)
+            {
+                return result::SATISFIABLE;
+            }
+        }
+        m_trail_limits.push_back(m_trail.size());
+        enqueue(next, NO_REASON);
+    }
+}
+
+void sat_solver::reduce_learnt_clauses()
+{
+    // only called at decision level 0, where no reason clause is needed anymore
+    std::vector<u32> learnt;
+    for (u32 i = 0; i < m_clauses.size(); ++i)
+    {
+        if (m_clauses[i].learnt && m_clauses[i].literals.size() > 2)
+        {
+            learnt.push_back(i);
+        }
+    }
+    std::sort(learnt.begin(), learnt.end(), [this](u32 a, u32 b) { return m_clauses[a].activity < m_clauses[b].activity; });
+
+    std::vector<u8> removed(m_clauses.size(), 0);
+    for (u32 i = 0; i < learnt.size() / 2; ++i)
+    {
+        removed[learnt[i]] = 1;
+    }
+
+    std::vector<clause_data> kept;
+    m_num_learnt_clauses = 0;
+    for (u32 i = 0; i < m_clauses.size(); ++i)
+    {
+        if (!removed[i])
+        {
+            m_num_learnt_clauses += m_clauses[i].learnt ? 1 : 0;
+            kept.push_back(std::move(m_clauses[i]));
+        }
+    }
+    m_clauses = std::move(kept);
+
+    for (auto& watches : m_watches)
+    {
+        watches.clear();
+    }
+    for (u32 i = 0; i < m_clauses.size(); ++i)
+    {
+        m_watches[m_clauses[i].literals[0]].push_back(i);
+        m_watches[m_clauses[i].literals[1]].push_back(i);
+    }
+    std::fill(m_reasons.begin(), m_reasons.end(), NO_REASON);
+
+    m_max_learnt_clauses += m_max_learnt_clauses / 10;
+}
+
+bool sat_solver::get_model_value(u32 variable) const
+{
+    return variable < m_model.size() && m_model[variable] == TRUE;
+}
+
+void sat_solver::bump_variable(u32 variable)
+{
+    m_activities[variable] += m_variable_increment;
+    if (m_activities[variable] > 1e100)
+    {
+        for (auto& activity : m_activities)
+        {
+            activity *= 1e-100;
+        }
+        m_variable_increment *= 1e-100;
+    }
+    if (m_heap_positions[variable] != INVALID)
+    {
+        heap_sift_up(m_heap_positions[variable]);
+    }
+}
+
+void sat_solver::bump_clause(u32 index)
+{
+    m_clauses[index].activity += m_clause_increment;
+    if (m_clauses[index].activity > 1e20)
+    {
+        for (auto& c : m_clauses)
+        {
+            c.activity *= 1e-20;
+        }
+        m_clause_increment *= 1e-20;
+    }
+}
+
+void sat_solver::heap_insert(u32 variable)
+{
+    m_heap_positions[variable] = m_heap.size();
+    m_heap.push_back(variable);
+    heap_sift_up(m_heap.size() - 1);
+}
+
+u32 sat_solver::heap_pop()
+{
+    u32 top                     = m_heap[0];
+    m_heap[0]                   = m_heap.back();
+    m_heap_positions[m_heap[0]] = 0;
+    m_heap.pop_back();
+    m_heap_positions[top] = INVALID;
+    if (!m_heap.empty())
+    {
+        heap_sift_down(0);
+    }
+    return top;
+}
+
+void sat_solver::heap_sift_up(u32 position)
+{
+    u32 variable = m_heap[position];
+    while (position > 0)
+    {
+        u32 parent = (position - 1) / 2;
+        if (m_activities[m_heap[parent]] >= m_activities[variable])
+        {
+            break;
+        }
+        m_heap[position]                   = m_heap[parent];
+        m_heap_positions[m_heap[position]] = position;
+        position                           = parent;
+    }
+    m_heap[position]           = variable;
+    m_heap_positions[variable] = position;
+}
+
+void sat_solver::heap_sift_down(u32 position)
+{
+    u32 variable = m_heap[position];
+    while (true)
+    {
+        u32 child = 2 * position + 1;
+        if (child >= m_heap.size())
+        {
+            break;
+        }
+        if (child + 1 < m_heap.size() && m_activities[m_heap[child + 1]] > m_activities[m_heap[child]])
+        {
+            child++;
+        }
+        if (m_activities[m_heap[child]] <= m_activities[variable])
+        {
+            break;
+        }
+        m_heap[position]                   = m_heap[child];
+        m_heap_positions[m_heap[position]] = position;
+        position                           = child;
+    }
+    m_heap[position]           = variable;
+    m_heap_positions[variable] = position;
+}
@@ -0,0 +1,348 @@
+#include "netlist/simulation/cycle_simulator.h"
+
+#include "core/log.h"
+#include "netlist/net.h"
+
+#include <algorithm>
+#include <tuple>
+
+cycle_simulator::cycle_simulator(const std::shared_ptr<netlist>& nl) : m_model(nl)
+{
+    const auto& elements = m_model.get_sequential_elements();
+    for (u32 i = 0; i < elements.size(); ++i)
+    {
+        if (!elements[i].is_latch && elements[i].clock != simulation_model::INVALID)
+        {
+            m_flip_flops.push_back(i);
+        }
+        if ((elements[i].is_latch && elements[i].clock != simulation_model::INVALID) || elements[i].set != simulation_model::INVALID || elements[i].reset != simulation_model::INVALID)
+        {
+            m_asynchronous_elements.push_back(i);
+        }
+    }
+    m_inputs.resize(m_model.get_max_num_inputs());
+
+    reset();
+}
+
+const simulation_model& cycle_simulator::get_model() const
+{
+    return m_model;
+}
+
+bool cycle_simulator::add_clock_net(const std::shared_ptr<net>& n)
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (!m_model.is_input_net(index))
+    {
+        log_error("netlist", "cannot use net '{}' as a clock since it is not an input of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+        return false;
+    }
+    if (std::find(m_clock_nets.begin(), m_clock_nets.end(), index) == m_clock_nets.end())
+    {
+        m_clock_nets.push_back(index);
+    }
+
+    // registering the clock does not trigger any flip-flop
+    m_values[index] = boolean_function::ZERO;
+    settle();
+    initialize_clock_values();
+    return true;
+}
+
+std::vector<std::shared_ptr<net>> cycle_simulator::get_clock_nets() const
+{
+    std::vector<std::shared_ptr<net>> result;
+    for (u32 index : m_clock_nets)
+    {
+        result.push_back(m_model.get_graph_view().get_net(index));
+    }
+    return result;
+}
+
+bool cycle_simulator::set_input(const std::shared_ptr<net>& n, boolean_function::value value)
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (!m_model.is_input_net(index))
+    {
+        log_error("netlist", "cannot set the value of net '{}' since it is not an input of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+        return false;
+    }
+    m_values[index] = value;
+    return true;
+}
+
+boolean_function::value cycle_simulator::get_value(const std::shared_ptr<net>& n) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (index == netlist_graph_view::INVALID_INDEX)
+    {
+        return boolean_function::X;
+    }
+    return m_values[index];
+}
+
+void cycle_simulator::reset()
+{
+    m_values.assign(m_model.get_num_values(), boolean_function::X);
+    for (u32 index : m_clock_nets)
+    {
+        m_values[index] = boolean_function::ZERO;
+    }
+
+    const auto& elements = m_model.get_sequential_elements();
+    m_states.assign(elements.size(), boolean_function::X);
+    m_inverted_states.assign(elements.size(), boolean_function::X);
+    m_clock_values.assign(elements.size(), boolean_function::X);
+    m_set_reset_active.assign(elements.size(), false);
+    for (u32 i = 0; i < elements.size(); ++i)
+    {
+        write_state(i, elements[i].initial_value, simulation_model::invert(elements[i].initial_value), false);
+    }
+
+    m_cycle = 0;
+    settle();
+    initialize_clock_values();
+}
+
+void cycle_simulator::simulate(u64 num_cycles)
+{
+    for (u64 i = 0; i < num_cycles; ++i)
+    {
+        run_phase(boolean_function::ZERO);
+        run_phase(boolean_function::ONE);
+        m_cycle++;
+    }
+}
+
+std::vector<std::vector<boolean_function::value>> cycle_simulator::run(const std::vector<std::shared_ptr<net>>& input_nets,
+                                                                       const std::vector<std::vector<boolean_function::value>>& stimulus,
+                                                                       const std::vector<std::shared_ptr<net>>& observed_nets)
+{
+    const auto& view = m_model.get_graph_view();
+
+    std::vector<u32> inputs;
+    for (const auto& n : input_nets)
+    {
+        u32 index = view.get_net_index(n);
+        if (!m_model.is_input_net(index))
+        {
+            log_error("netlist", "cannot drive net '{}' since it is not an input of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+            return {};
+        }
+        inputs.push_back(index);
+    }
+
+    std::vector<u32> observed;
+    for (const auto& n : observed_nets)
+    {
+        u32 index = view.get_net_index(n);
+        if (index == netlist_graph_view::INVALID_INDEX)
+        {
+            log_error("netlist", "cannot observe net '{}' since it is not part of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+            return {};
+        }
+        observed.push_back(index);
+    }
+
+    for (u32 cycle = 0; cycle < stimulus.size(); ++cycle)
+    {
+        if (stimulus[cycle].size() != inputs.size())
+        {
+            log_error("netlist", "stimulus of cycle {} contains {} values for {} input nets.", cycle, stimulus[cycle].size(), inputs.size());
+            return {};
+        }
+    }
+
+    std::vector<std::vector<boolean_function::value>> result;
+    result.reserve(stimulus.size());
+    for (const auto& values : stimulus)
+    {
+        for (u32 i = 0; i < inputs.size(); ++i)
+        {
+            m_values[inputs[i]] = values[i];
+        }
+        simulate(1);
+
+        auto& row = result.emplace_back();
+        row.reserve(observed.size());
+        for (u32 index : observed)
+        {
+            row.push_back(m_values[index]);
+        }
+    }
+    return result;
+}
+
+u64 cycle_simulator::get_cycle() const
+{
+    return m_cycle;
+}
+
+void cycle_simulator::run_phase(boolean_function::value clock_value)
+{
+    for (u32 index : m_clock_nets)
+    {
+        m_values[index] = clock_value;
+    }
+    settle();
+
+    // flip-flops clocked by other flip-flops trigger in later iterations, the bound only guards against oscillation
+    for (u32 i = 0; i <= m_flip_flops.size() && clock_flip_flops(); ++i)
+    {
+        settle();
+    }
+}
+
+void cycle_simulator::settle()
+{
+    // without loops one pass over the levelized logic is stable unless a latch or set/reset changes a state
+    u32 max_iterations = m_asynchronous_elements.size() + m_model.get_num_unordered_nodes() + 2;
+    for (u32 i = 0; i < max_iterations; ++i)
+    {
+        bool force_x              = (i + 1 == max_iterations);
+        bool logic_changed        = evaluate_combinational_logic(force_x && m_model.get_num_unordered_nodes() != 0);
+        bool asynchronous_changed = update_asynchronous(force_x);
+        if (!asynchronous_changed && (!logic_changed || m_model.get_num_unordered_nodes() == 0))
+        {
+            return;
+        }
+    }
+
+    // values that still oscillated were set to X, propagate them
+    evaluate_combinational_logic(false);
+}
+
+bool cycle_simulator::evaluate_combinational_logic(bool force_x)
+{
+    bool changed = false;
+    for (const auto& node : m_model.get_combinational_nodes())
+    {
+        auto result = evaluate(node.function, node.first_input);
+        auto& out   = m_values[node.output];
+        if (result != out)
+        {
+            out     = force_x ? boolean_function::X : result;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool cycle_simulator::update_asynchronous(bool force_x)
+{
+    const auto& elements = m_model.get_sequential_elements();
+
+    bool changed = false;
+    for (u32 i : m_asynchronous_elements)
+    {
+        const auto& e = elements[i];
+        auto state    = m_states[i];
+        auto inverted = m_inverted_states[i];
+
+        if (e.is_latch && e.clock != simulation_model::INVALID && !m_set_reset_active[i])
+        {
+            auto enable = evaluate(e.clock, e.first_input);
+            if (enable != boolean_function::ZERO)
+            {
+                auto data = (e.next_state != simulation_model::INVALID) ? evaluate(e.next_state, e.first_input) : boolean_function::X;
+                if (enable == boolean_function::X)
+                {
+                    data = simulation_model::merge(data, state);
+                }
+                state    = data;
+                inverted = simulation_model::invert(data);
+            }
+        }
+
+        auto set   = (e.set != simulation_model::INVALID) ? evaluate(e.set, e.first_input) : boolean_function::ZERO;
+        auto reset = (e.reset != simulation_model::INVALID) ? evaluate(e.reset, e.first_input) : boolean_function::ZERO;
+
+        std::tie(state, inverted) = simulation_model::apply_set_reset(e, set, reset, state, inverted, m_set_reset_active[i]);
+        m_set_reset_active[i]     = (set == boolean_function::ONE && reset == boolean_function::ONE);
+        changed |= write_state(i, state, inverted, force_x);
+    }
+    return changed;
+}
+
+bool cycle_simulator::clock_flip_flops()
+{
+    const auto& elements = m_model.get_sequential_elements();
+
+    // all flip-flops sample their inputs before any state is updated
+    std::vector<std::pair<u32, boolean_function::value>> updates;
+    for (u32 i : m_flip_flops)
+    {
+        const auto& e = elements[i];
+        auto clock    = evaluate(e.clock, e.first_input);
+        auto previous = m_clock_values[i];
+
+        m_clock_values[i] = clock;
+        if (previous == boolean_function::ONE || clock == boolean_function::ZERO || previous == clock || m_set_reset_active[i])
+        {
+            continue;
+        }
+
+        auto next = (e.next_state != simulation_model::INVALID) ? evaluate(e.next_state, e.first_input) : boolean_function::X;
+        if (previous == boolean_function::X || clock == boolean_function::X)
+        {
+            // the edge is uncertain, so the state is kept only if it would not change anyway
+            next = simulation_model::merge(next, m_states[i]);
+        }
+        updates.emplace_back(i, next);
+    }
+
+    bool changed = false;
+    for (const auto& [i, next] : updates)
+    {
+        changed |= write_state(i, next, simulation_model::invert(next), false);
+    }
+    return changed;
+}
+
+void cycle_simulator::initialize_clock_values()
+{
+    const auto& elements = m_model.get_sequential_elements();
+    for (u32 i : m_flip_flops)
+    {
+        m_clock_values[i] = evaluate(elements[i].clock, elements[i].first_input);
+    }
+}
+
+bool cycle_simulator::write_state(u32 element, boolean_function::value state, boolean_function::value inverted_state, bool force_x)
+{
+    if (force_x)
+    {
+        state          = simulation_model::merge(state, m_states[element]);
+        inverted_state = simulation_model::merge(inverted_state, m_inverted_states[element]);
+    }
+    if (state == m_states[element] && inverted_state == m_inverted_states[element])
+    {
+        return false;
+    }
+
+    m_states[element]          = state;
+    m_inverted_states[element] = inverted_state;
+
+    const auto& e = m_model.get_sequential_elements()[element];
+    for (u32 index : e.state_outputs)
+    {
+        m_values[index] = state;
+    }
+    for (u32 index : e.inverted_state_outputs)
+    {
+        m_values[index] = inverted_state;
+    }
+    return true;
+}
+
+boolean_function::value cycle_simulator::evaluate(u32 function, u32 first_input)
+{
+    const auto& f       = m_model.get_function(function);
+    const auto& indices = m_model.get_input_indices();
+    for (u32 i = 0; i < f.get_num_slots(); ++i)
+    {
+        m_inputs[i] = m_values[indices[first_input + i]];
+    }
+    return f.evaluate(m_inputs.data());
+}
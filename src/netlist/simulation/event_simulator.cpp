@@ -0,0 +1,406 @@
+#include "netlist/simulation/event_simulator.h"
+
+#include "core/log.h"
+#include "netlist/gate.h"
+#include "netlist/net.h"
+#include "netlist/netlist.h"
+
+#include <algorithm>
+#include <tuple>
+
+event_simulator::event_simulator(const std::shared_ptr<netlist>& nl) : m_model(nl)
+{
+    const auto& view     = m_model.get_graph_view();
+    const auto& elements = m_model.get_sequential_elements();
+
+    m_values.assign(m_model.get_num_values(), boolean_function::X);
+    m_states.assign(elements.size(), boolean_function::X);
+    m_inverted_states.assign(elements.size(), boolean_function::X);
+    m_clock_values.assign(elements.size(), boolean_function::X);
+    m_set_reset_active.assign(elements.size(), false);
+    for (u32 i = 0; i < elements.size(); ++i)
+    {
+        m_states[i]          = elements[i].initial_value;
+        m_inverted_states[i] = simulation_model::invert(elements[i].initial_value);
+        for (u32 index : elements[i].state_outputs)
+        {
+            m_values[index] = m_states[i];
+        }
+        for (u32 index : elements[i].inverted_state_outputs)
+        {
+            m_values[index] = m_inverted_states[i];
+        }
+    }
+    m_projected_values = m_values;
+    m_inputs.resize(m_model.get_max_num_inputs());
+
+    m_gate_delays.assign(view.get_num_gates(), 1);
+    m_clock_half_periods.assign(view.get_num_nets(), 0);
+    m_node_marks.assign(m_model.get_combinational_nodes().size(), 0);
+    m_element_marks.assign(elements.size(), 0);
+
+    // the first time step evaluates everything once
+    m_queue[0];
+}
+
+event_simulator::~event_simulator()
+{
+    stop_vcd();
+}
+
+const simulation_model& event_simulator::get_model() const
+{
+    return m_model;
+}
+
+bool event_simulator::set_gate_type_delay(const std::string& type_name, u32 delay)
+{
+    if (delay == 0)
+    {
+        log_error("netlist", "the delay of gate type '{}' must be at least 1.", type_name);
+        return false;
+    }
+
+    m_type_delays[type_name] = delay;
+    const auto& view         = m_model.get_graph_view();
+    for (u32 i = 0; i < view.get_num_gates(); ++i)
+    {
+        if (view.get_gate(i)->get_type()->get_name() == type_name)
+        {
+            m_gate_delays[i] = delay;
+        }
+    }
+    return true;
+}
+
+u32 event_simulator::get_gate_type_delay(const std::string& type_name) const
+{
+    auto it = m_type_delays.find(type_name);
+    return (it == m_type_delays.end()) ? 1 : it->second;
+}
+
+bool event_simulator::add_clock(const std::shared_ptr<net>& n, u64 half_period)
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (!m_model.is_input_net(index))
+    {
+        log_error("netlist", "cannot use net '{}' as a clock since it is not an input of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+        return false;
+    }
+    if (half_period == 0)
+    {
+        log_error("netlist", "the half period of clock '{}' must be at least 1.", n->get_name());
+        return false;
+    }
+    if (m_clock_half_periods[index] != 0)
+    {
+        log_error("netlist", "net '{}' is already driven by a clock.", n->get_name());
+        return false;
+    }
+
+    m_clock_half_periods[index] = half_period;
+    schedule(index, boolean_function::ZERO, m_time);
+    return true;
+}
+
+bool event_simulator::set_input(const std::shared_ptr<net>& n, boolean_function::value value, u64 time)
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (!m_model.is_input_net(index))
+    {
+        log_error("netlist", "cannot set the value of net '{}' since it is not an input of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+        return false;
+    }
+    if (m_clock_half_periods[index] != 0)
+    {
+        log_error("netlist", "cannot set the value of net '{}' since it is driven by a clock.", n->get_name());
+        return false;
+    }
+    if (time < m_time)
+    {
+        log_error("netlist", "cannot set the value of net '{}' at time {} since the simulation is already at time {}.", n->get_name(), time, m_time);
+        return false;
+    }
+
+    schedule(index, value, time);
+    return true;
+}
+
+void event_simulator::run_until(u64 time)
+{
+    while (!m_queue.empty() && m_queue.begin()->first <= time)
+    {
+        process_next_time_step();
+    }
+    m_time = std::max(m_time, time);
+
+    if (m_vcd != nullptr)
+    {
+        m_vcd->flush();
+    }
+}
+
+void event_simulator::run_for(u64 duration)
+{
+    run_until(m_time + duration);
+}
+
+u64 event_simulator::get_time() const
+{
+    return m_time;
+}
+
+boolean_function::value event_simulator::get_value(const std::shared_ptr<net>& n) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (index == netlist_graph_view::INVALID_INDEX)
+    {
+        return boolean_function::X;
+    }
+    return m_values[index];
+}
+
+u64 event_simulator::get_num_changes() const
+{
+    return m_num_changes;
+}
+
+bool event_simulator::start_vcd(const hal::path& file_path, const std::vector<std::shared_ptr<net>>& nets, const std::string& timescale)
+{
+    stop_vcd();
+
+    auto file = std::make_unique<std::ofstream>(file_path.string(), std::ios::out);
+    if (!file->is_open())
+    {
+        log_error("netlist", "cannot open VCD file '{}'.", file_path.string());
+        return false;
+    }
+    if (!start_vcd(*file, nets, timescale))
+    {
+        return false;
+    }
+    m_vcd_file = std::move(file);
+    return true;
+}
+
+bool event_simulator::start_vcd(std::ostream& stream, const std::vector<std::shared_ptr<net>>& nets, const std::string& timescale)
+{
+    stop_vcd();
+
+    const auto& view = m_model.get_graph_view();
+
+    std::vector<u32> indices;
+    if (nets.empty())
+    {
+        for (u32 i = 0; i < view.get_num_nets(); ++i)
+        {
+            indices.push_back(i);
+        }
+    }
+    for (const auto& n : nets)
+    {
+        u32 index = view.get_net_index(n);
+        if (index == netlist_graph_view::INVALID_INDEX)
+        {
+            log_error("netlist", "cannot record net '{}' since it is not part of the netlist.", (n == nullptr) ? "nullptr" : n->get_name());
+            return false;
+        }
+        indices.push_back(index);
+    }
+
+    auto writer = std::make_unique<vcd_writer>(stream);
+    std::vector<u32> signals(view.get_num_nets(), vcd_writer::INVALID);
+    std::vector<boolean_function::value> initial_values;
+    for (u32 index : indices)
+    {
+        if (signals[index] == vcd_writer::INVALID)
+        {
+            auto n         = view.get_net(index);
+            signals[index] = writer->add_signal(n->get_name() + "_" + std::to_string(n->get_id()));
+            initial_values.push_back(m_values[index]);
+        }
+    }
+
+    auto nl = view.get_netlist();
+    if (!writer->write_header((nl == nullptr) ? "" : nl->get_design_name(), timescale, m_time, initial_values))
+    {
+        return false;
+    }
+
+    m_vcd         = std::move(writer);
+    m_vcd_signals = std::move(signals);
+    return true;
+}
+
+void event_simulator::stop_vcd()
+{
+    if (m_vcd != nullptr)
+    {
+        m_vcd->flush();
+    }
+    m_vcd.reset();
+    m_vcd_file.reset();
+    m_vcd_signals.clear();
+}
+
+void event_simulator::process_next_time_step()
+{
+    auto it     = m_queue.begin();
+    m_time      = it->first;
+    auto events = std::move(it->second);
+    m_queue.erase(it);
+
+    m_step++;
+    m_affected_nodes.clear();
+    m_affected_elements.clear();
+
+    for (const auto& e : events)
+    {
+        // clocks keep toggling regardless of the value they had
+        if (m_clock_half_periods[e.net] != 0)
+        {
+            schedule(e.net, simulation_model::invert(e.value), m_time + m_clock_half_periods[e.net]);
+        }
+
+        if (m_values[e.net] == e.value)
+        {
+            continue;
+        }
+        m_values[e.net] = e.value;
+        m_num_changes++;
+        if (m_vcd != nullptr && m_vcd_signals[e.net] != vcd_writer::INVALID)
+        {
+            m_vcd->write_change(m_time, m_vcd_signals[e.net], e.value);
+        }
+
+        for (u32 node : m_model.get_node_readers(e.net))
+        {
+            if (m_node_marks[node] != m_step)
+            {
+                m_node_marks[node] = m_step;
+                m_affected_nodes.push_back(node);
+            }
+        }
+        for (u32 element : m_model.get_element_readers(e.net))
+        {
+            if (m_element_marks[element] != m_step)
+            {
+                m_element_marks[element] = m_step;
+                m_affected_elements.push_back(element);
+            }
+        }
+    }
+
+    if (m_evaluate_all)
+    {
+        m_evaluate_all = false;
+        m_affected_nodes.resize(m_model.get_combinational_nodes().size());
+        m_affected_elements.resize(m_model.get_sequential_elements().size());
+        for (u32 i = 0; i < m_affected_nodes.size(); ++i)
+        {
+            m_affected_nodes[i] = i;
+        }
+        for (u32 i = 0; i < m_affected_elements.size(); ++i)
+        {
+            m_affected_elements[i] = i;
+        }
+    }
+
+    // all evaluations see the values of this time step, their results appear after the gate delays
+    for (u32 node : m_affected_nodes)
+    {
+        evaluate_node(node);
+    }
+    for (u32 element : m_affected_elements)
+    {
+        evaluate_element(element);
+    }
+}
+
+void event_simulator::evaluate_node(u32 node)
+{
+    const auto& n = m_model.get_combinational_nodes()[node];
+    auto result   = evaluate(n.function, n.first_input);
+    if (result != m_projected_values[n.output])
+    {
+        m_projected_values[n.output] = result;
+        schedule(n.output, result, m_time + m_gate_delays[n.gate]);
+    }
+}
+
+void event_simulator::evaluate_element(u32 element)
+{
+    const auto& e = m_model.get_sequential_elements()[element];
+    auto state    = m_states[element];
+    auto inverted = m_inverted_states[element];
+
+    if (e.clock != simulation_model::INVALID)
+    {
+        auto clock = evaluate(e.clock, e.first_input);
+        if (e.is_latch)
+        {
+            if (clock != boolean_function::ZERO && !m_set_reset_active[element])
+            {
+                auto data = (e.next_state != simulation_model::INVALID) ? evaluate(e.next_state, e.first_input) : boolean_function::X;
+                state     = (clock == boolean_function::X) ? simulation_model::merge(data, state) : data;
+                inverted  = simulation_model::invert(state);
+            }
+        }
+        else
+        {
+            auto previous           = m_clock_values[element];
+            m_clock_values[element] = clock;
+            if (previous != boolean_function::ONE && clock != boolean_function::ZERO && previous != clock && !m_set_reset_active[element])
+            {
+                auto next = (e.next_state != simulation_model::INVALID) ? evaluate(e.next_state, e.first_input) : boolean_function::X;
+                if (previous == boolean_function::X || clock == boolean_function::X)
+                {
+                    // the edge is uncertain, so the state is kept only if it would not change anyway
+                    next = simulation_model::merge(next, state);
+                }
+                state    = next;
+                inverted = simulation_model::invert(next);
+            }
+        }
+    }
+
+    auto set                    = (e.set != simulation_model::INVALID) ? evaluate(e.set, e.first_input) : boolean_function::ZERO;
+    auto reset                  = (e.reset != simulation_model::INVALID) ? evaluate(e.reset, e.first_input) : boolean_function::ZERO;
+    std::tie(state, inverted)   = simulation_model::apply_set_reset(e, set, reset, state, inverted, m_set_reset_active[element]);
+    m_set_reset_active[element] = (set == boolean_function::ONE && reset == boolean_function::ONE);
+
+    if (state == m_states[element] && inverted == m_inverted_states[element])
+    {
+        return;
+    }
+    m_states[element]          = state;
+    m_inverted_states[element] = inverted;
+
+    u64 time = m_time + m_gate_delays[e.gate];
+    for (u32 index : e.state_outputs)
+    {
+        m_projected_values[index] = state;
+        schedule(index, state, time);
+    }
+    for (u32 index : e.inverted_state_outputs)
+    {
+        m_projected_values[index] = inverted;
+        schedule(index, inverted, time);
+    }
+}
+
+void event_simulator::schedule(u32 net_index, boolean_function::value value, u64 time)
+{
+    m_queue[time].push_back({net_index, value});
+}
+
+boolean_function::value event_simulator::evaluate(u32 function, u32 first_input)
+{
+    const auto& f       = m_model.get_function(function);
+    const auto& indices = m_model.get_input_indices();
+    for (u32 i = 0; i < f.get_num_slots(); ++i)
+    {
+        m_inputs[i] = m_values[indices[first_input + i]];
+    }
+    return f.evaluate(m_inputs.data());
+}
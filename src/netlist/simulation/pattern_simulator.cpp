@@ -0,0 +1,316 @@
+#include "netlist/simulation/pattern_simulator.h"
+
+#include "core/log.h"
+#include "netlist/net.h"
+
+#include <algorithm>
+#include <map>
+
+pattern_simulator::pattern_simulator(const std::shared_ptr<netlist>& nl, u32 num_words) : m_model(nl), m_num_words(std::max<u32>(num_words, 1))
+{
+    m_values.assign((u64)m_model.get_num_values() * m_num_words, {0, 0});
+    m_inputs.resize(m_model.get_max_num_inputs());
+
+    u32 num_nets = m_model.get_graph_view().get_num_nets();
+    m_element_of_net.assign(num_nets, simulation_model::INVALID);
+    m_is_inverted_output.assign(num_nets, false);
+    const auto& elements = m_model.get_sequential_elements();
+    for (u32 i = 0; i < elements.size(); ++i)
+    {
+        for (u32 index : elements[i].state_outputs)
+        {
+            m_element_of_net[index] = i;
+        }
+        for (u32 index : elements[i].inverted_state_outputs)
+        {
+            m_element_of_net[index]     = i;
+            m_is_inverted_output[index] = true;
+        }
+    }
+}
+
+const simulation_model& pattern_simulator::get_model() const
+{
+    return m_model;
+}
+
+u32 pattern_simulator::get_num_words() const
+{
+    return m_num_words;
+}
+
+u32 pattern_simulator::get_num_patterns() const
+{
+    return m_num_words * 64;
+}
+
+std::vector<std::shared_ptr<net>> pattern_simulator::get_input_nets() const
+{
+    const auto& view = m_model.get_graph_view();
+
+    std::vector<std::shared_ptr<net>> result;
+    for (u32 index : m_model.get_input_nets())
+    {
+        result.push_back(view.get_net(index));
+    }
+    for (const auto& e : m_model.get_sequential_elements())
+    {
+        if (!e.state_outputs.empty())
+        {
+            result.push_back(view.get_net(e.state_outputs[0]));
+        }
+        else if (!e.inverted_state_outputs.empty())
+        {
+            result.push_back(view.get_net(e.inverted_state_outputs[0]));
+        }
+    }
+    return result;
+}
+
+bool pattern_simulator::set_input(const std::shared_ptr<net>& n, boolean_function::value value)
+{
+    u32 index = get_input_index(n);
+    if (index == simulation_model::INVALID)
+    {
+        return false;
+    }
+
+    value_slice slice = {(value == boolean_function::ONE) ? ~0ull : 0, (value == boolean_function::ZERO) ? ~0ull : 0};
+    for (u32 w = 0; w < m_num_words; ++w)
+    {
+        write_input(index, w, slice);
+    }
+    return true;
+}
+
+bool pattern_simulator::set_input(const std::shared_ptr<net>& n, const std::vector<u64>& ones, const std::vector<u64>& zeros)
+{
+    u32 index = get_input_index(n);
+    if (index == simulation_model::INVALID)
+    {
+        return false;
+    }
+    if (ones.size() != m_num_words || zeros.size() != m_num_words)
+    {
+        log_error("netlist", "expected {} words of patterns for net '{}' but got {} and {}.", m_num_words, n->get_name(), ones.size(), zeros.size());
+        return false;
+    }
+
+    for (u32 w = 0; w < m_num_words; ++w)
+    {
+        write_input(index, w, {ones[w] & ~zeros[w], zeros[w] & ~ones[w]});
+    }
+    return true;
+}
+
+void pattern_simulator::randomize_inputs(u64 seed)
+{
+    u64 state = (seed == 0) ? 1 : seed;
+    for (const auto& n : get_input_nets())
+    {
+        u32 index = m_model.get_graph_view().get_net_index(n);
+        for (u32 w = 0; w < m_num_words; ++w)
+        {
+            u64 bits = simulation_model::next_random(state);
+            write_input(index, w, {bits, ~bits});
+        }
+    }
+}
+
+bool pattern_simulator::set_exhaustive_inputs(const std::vector<std::shared_ptr<net>>& nets, u64 first_assignment)
+{
+    std::vector<u32> indices;
+    for (const auto& n : nets)
+    {
+        u32 index = get_input_index(n);
+        if (index == simulation_model::INVALID)
+        {
+            return false;
+        }
+        indices.push_back(index);
+    }
+
+    for (u32 j = 0; j < indices.size(); ++j)
+    {
+        for (u32 w = 0; w < m_num_words; ++w)
+        {
+            u64 bits = 0;
+            for (u32 bit = 0; bit < 64 && j < 64; ++bit)
+            {
+                u64 assignment = first_assignment + (u64)w * 64 + bit;
+                bits |= ((assignment >> j) & 1) << bit;
+            }
+            write_input(indices[j], w, {bits, ~bits});
+        }
+    }
+    return true;
+}
+
+void pattern_simulator::simulate()
+{
+    const auto& nodes = m_model.get_combinational_nodes();
+    for (const auto& node : nodes)
+    {
+        evaluate_node(node, false);
+    }
+
+    // nodes on or behind combinational loops are the last ones, iterate them until they are stable
+    u32 num_unordered = m_model.get_num_unordered_nodes();
+    for (u32 i = 0; i < num_unordered + 1 && num_unordered != 0; ++i)
+    {
+        bool changed = false;
+        for (u32 node = nodes.size() - num_unordered; node < nodes.size(); ++node)
+        {
+            changed |= evaluate_node(nodes[node], i == num_unordered);
+        }
+        if (!changed)
+        {
+            break;
+        }
+    }
+}
+
+boolean_function::value pattern_simulator::get_value(const std::shared_ptr<net>& n, u32 pattern) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (index == netlist_graph_view::INVALID_INDEX || pattern >= get_num_patterns())
+    {
+        return boolean_function::X;
+    }
+
+    const auto& slice = m_values[(u64)index * m_num_words + pattern / 64];
+    u64 mask          = 1ull << (pattern % 64);
+    if (slice.ones & mask)
+    {
+        return boolean_function::ONE;
+    }
+    return (slice.zeros & mask) ? boolean_function::ZERO : boolean_function::X;
+}
+
+std::vector<u64> pattern_simulator::get_signature(const std::shared_ptr<net>& n) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (index == netlist_graph_view::INVALID_INDEX)
+    {
+        return {};
+    }
+
+    std::vector<u64> result(m_num_words);
+    for (u32 w = 0; w < m_num_words; ++w)
+    {
+        result[w] = m_values[(u64)index * m_num_words + w].ones;
+    }
+    return result;
+}
+
+std::vector<u64> pattern_simulator::get_x_mask(const std::shared_ptr<net>& n) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (index == netlist_graph_view::INVALID_INDEX)
+    {
+        return {};
+    }
+
+    std::vector<u64> result(m_num_words);
+    for (u32 w = 0; w < m_num_words; ++w)
+    {
+        const auto& slice = m_values[(u64)index * m_num_words + w];
+        result[w]         = ~(slice.ones | slice.zeros);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::shared_ptr<net>>> pattern_simulator::get_signature_classes() const
+{
+    const auto& view = m_model.get_graph_view();
+
+    std::map<std::vector<u64>, std::vector<std::shared_ptr<net>>> classes;
+    for (u32 index = 0; index < view.get_num_nets(); ++index)
+    {
+        std::vector<u64> key(2 * m_num_words);
+        for (u32 w = 0; w < m_num_words; ++w)
+        {
+            key[2 * w]     = m_values[(u64)index * m_num_words + w].ones;
+            key[2 * w + 1] = m_values[(u64)index * m_num_words + w].zeros;
+        }
+        classes[key].push_back(view.get_net(index));
+    }
+
+    auto by_id = [](const auto& a, const auto& b) { return a->get_id() < b->get_id(); };
+
+    std::vector<std::vector<std::shared_ptr<net>>> result;
+    for (auto& [key, nets] : classes)
+    {
+        if (nets.size() > 1)
+        {
+            std::sort(nets.begin(), nets.end(), by_id);
+            result.push_back(std::move(nets));
+        }
+    }
+    std::sort(result.begin(), result.end(), [&by_id](const auto& a, const auto& b) { return by_id(a[0], b[0]); });
+    return result;
+}
+
+u32 pattern_simulator::get_input_index(const std::shared_ptr<net>& n) const
+{
+    u32 index = m_model.get_graph_view().get_net_index(n);
+    if (!m_model.is_input_net(index) && (index == netlist_graph_view::INVALID_INDEX || m_element_of_net[index] == simulation_model::INVALID))
+    {
+        log_error("netlist", "cannot set the value of net '{}' since it is neither an input of the netlist nor the output of a flip-flop or latch.", (n == nullptr) ? "nullptr" : n->get_name());
+        return simulation_model::INVALID;
+    }
+    return index;
+}
+
+void pattern_simulator::write_input(u32 net_index, u32 word, value_slice value)
+{
+    if (m_model.is_input_net(net_index))
+    {
+        m_values[(u64)net_index * m_num_words + word] = value;
+        return;
+    }
+
+    // the state is written to all state outputs and its complement to all inverted state outputs
+    if (m_is_inverted_output[net_index])
+    {
+        value = {value.zeros, value.ones};
+    }
+    const auto& e = m_model.get_sequential_elements()[m_element_of_net[net_index]];
+    for (u32 index : e.state_outputs)
+    {
+        m_values[(u64)index * m_num_words + word] = value;
+    }
+    for (u32 index : e.inverted_state_outputs)
+    {
+        m_values[(u64)index * m_num_words + word] = {value.zeros, value.ones};
+    }
+}
+
+bool pattern_simulator::evaluate_node(const simulation_model::combinational_node& node, bool force_x)
+{
+    const auto& f       = m_model.get_function(node.function);
+    const auto& indices = m_model.get_input_indices();
+    u32 num_slots       = f.get_num_slots();
+
+    bool changed = false;
+    for (u32 w = 0; w < m_num_words; ++w)
+    {
+        for (u32 i = 0; i < num_slots; ++i)
+        {
+            m_inputs[i] = m_values[(u64)indices[node.first_input + i] * m_num_words + w];
+        }
+        auto result = f.evaluate(m_inputs.data());
+        auto& out   = m_values[(u64)node.output * m_num_words + w];
+        if (result.ones != out.ones || result.zeros != out.zeros)
+        {
+            if (force_x)
+            {
+                // patterns that still change become X
+                result = {result.ones & out.ones, result.zeros & out.zeros};
+            }
+            out     = result;
+            changed = true;
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,443 @@
+#include "netlist/simulation/simulation_model.h"
+
+#include "core/log.h"
+#include "core/utils.h"
+#include "netlist/gate.h"
+#include "netlist/gate_library/gate_type/gate_type_lut.h"
+#include "netlist/net.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // the init data of a flip-flop or latch is a (hex) number whose least significant bit is the initial state
+    boolean_function::value parse_initial_value(const std::string& data)
+    {
+        auto s = core_utils::trim(data, " \t\r\n'\"");
+        if (s.empty() || !std::isxdigit((unsigned char)s.back()))
+        {
+            return boolean_function::X;
+        }
+        u32 digit = std::stoul(s.substr(s.size() - 1), nullptr, 16);
+        return (digit & 1) ? boolean_function::ONE : boolean_function::ZERO;
+    }
+
+    // functions of a gate type are identical for all of its gates, only custom functions and LUT configurations differ
+    std::string get_function_key(const std::shared_ptr<gate>& g, const std::string& name, const boolean_function& function, const std::unordered_map<std::string, boolean_function>& custom_functions)
+    {
+        auto type       = g->get_type();
+        std::string key = type->get_name() + '\n' + name + '\n';
+        if (custom_functions.find(name) != custom_functions.end())
+        {
+            key += "custom\n" + function.to_string();
+        }
+        else if (type->get_base_type() == gate_type::base_type::lut)
+        {
+            auto lut = std::static_pointer_cast<const gate_type_lut>(type);
+            key += "lut\n" + std::get<1>(g->get_data_by_key(lut->get_config_data_category(), lut->get_config_data_identifier()));
+        }
+        return key;
+    }
+
+    boolean_function::value apply_behavior(gate_type_sequential::set_reset_behavior behavior, boolean_function::value current, bool hold_toggle)
+    {
+        switch (behavior)
+        {
+            case gate_type_sequential::set_reset_behavior::L:
+                return boolean_function::ZERO;
+            case gate_type_sequential::set_reset_behavior::H:
+                return boolean_function::ONE;
+            case gate_type_sequential::set_reset_behavior::N:
+                return current;
+            case gate_type_sequential::set_reset_behavior::T:
+                return hold_toggle ? current : simulation_model::invert(current);
+            default:
+                return boolean_function::X;
+        }
+    }
+}    // namespace
+
+simulation_model::simulation_model(const std::shared_ptr<netlist>& nl) : m_view(nl)
+{
+    u32 num_nets = m_view.get_num_nets();
+    m_is_input_net.assign(num_nets, false);
+    for (u32 i = 0; i < num_nets; ++i)
+    {
+        if (m_view.get_net(i)->is_global_input_net() || m_view.get_source(i).index == netlist_graph_view::INVALID_INDEX)
+        {
+            m_input_nets.push_back(i);
+            m_is_input_net[i] = true;
+        }
+    }
+
+    std::unordered_map<std::string, u32> function_indices;
+    std::unordered_map<std::string, boolean_function> custom_functions;
+    std::shared_ptr<gate> current_gate;
+    auto get_function_index = [&](const std::string& name) {
+        auto function = current_gate->get_boolean_function(name);
+        if (function.is_empty())
+        {
+            return INVALID;
+        }
+        auto [it, inserted] = function_indices.emplace(get_function_key(current_gate, name, function, custom_functions), (u32)m_functions.size());
+        if (inserted)
+        {
+            m_functions.emplace_back(function, current_gate->get_type()->get_input_pins());
+        }
+        return it->second;
+    };
+
+    for (u32 gate_index = 0; gate_index < m_view.get_num_gates(); ++gate_index)
+    {
+        current_gate     = m_view.get_gate(gate_index);
+        custom_functions = current_gate->get_boolean_functions(true);
+        auto type        = current_gate->get_type();
+
+        // unconnected input pins read the constant X
+        u32 first_input = m_input_indices.size();
+        m_input_indices.resize(first_input + type->get_input_pins().size(), get_constant_x_index());
+        for (const auto& c : m_view.get_fan_in(gate_index))
+        {
+            m_input_indices[first_input + c.pin] = c.index;
+        }
+        m_max_num_inputs = std::max(m_max_num_inputs, (u32)type->get_input_pins().size());
+
+        auto sequential_type = std::dynamic_pointer_cast<const gate_type_sequential>(type);
+        bool is_sequential   = sequential_type != nullptr && (type->get_base_type() == gate_type::base_type::ff || type->get_base_type() == gate_type::base_type::latch);
+
+        sequential_element element;
+        std::unordered_set<std::string> state_pins, inverted_state_pins;
+        if (is_sequential)
+        {
+            element.gate        = gate_index;
+            element.is_latch    = type->get_base_type() == gate_type::base_type::latch;
+            element.next_state  = get_function_index(element.is_latch ? "data_in" : "next_state");
+            element.clock       = get_function_index(element.is_latch ? "enable" : "clock");
+            element.set         = get_function_index("set");
+            element.reset       = get_function_index("reset");
+            element.first_input = first_input;
+
+            std::tie(element.state_behavior, element.inverted_state_behavior) = sequential_type->get_set_reset_behavior();
+
+            element.initial_value = boolean_function::X;
+            if (!sequential_type->get_init_data_category().empty() && !sequential_type->get_init_data_identifier().empty())
+            {
+                element.initial_value = parse_initial_value(std::get<1>(current_gate->get_data_by_key(sequential_type->get_init_data_category(), sequential_type->get_init_data_identifier())));
+            }
+
+            state_pins          = sequential_type->get_state_output_pins();
+            inverted_state_pins = sequential_type->get_inverted_state_output_pins();
+        }
+
+        for (const auto& c : m_view.get_fan_out(gate_index))
+        {
+            if (m_is_input_net[c.index])
+            {
+                continue;
+            }
+
+            const auto& pin = type->get_output_pins()[c.pin];
+            if (state_pins.find(pin) != state_pins.end())
+            {
+                element.state_outputs.push_back(c.index);
+            }
+            else if (inverted_state_pins.find(pin) != inverted_state_pins.end())
+            {
+                element.inverted_state_outputs.push_back(c.index);
+            }
+            else if (u32 function = get_function_index(pin); function != INVALID)
+            {
+                m_nodes.push_back({function, first_input, c.index, gate_index});
+            }
+        }
+
+        if (is_sequential)
+        {
+            m_elements.push_back(std::move(element));
+        }
+    }
+
+    levelize();
+    collect_readers();
+}
+
+void simulation_model::levelize()
+{
+    u32 num_nets = m_view.get_num_nets();
+    std::vector<u32> drivers(num_nets, INVALID);
+    for (u32 i = 0; i < m_nodes.size(); ++i)
+    {
+        drivers[m_nodes[i].output] = i;
+    }
+
+    // successors of every node in CSR form and the number of unprocessed predecessors
+    std::vector<u32> pending(m_nodes.size(), 0);
+    std::vector<u32> offsets(m_nodes.size() + 1, 0);
+    auto for_each_predecessor = [&](u32 node, auto callback) {
+        const auto& n = m_nodes[node];
+        for (u32 i = 0; i < m_functions[n.function].get_num_slots(); ++i)
+        {
+            u32 input = m_input_indices[n.first_input + i];
+            if (input < num_nets && drivers[input] != INVALID)
+            {
+                callback(drivers[input]);
+            }
+        }
+    };
+    for (u32 i = 0; i < m_nodes.size(); ++i)
+    {
+        for_each_predecessor(i, [&](u32 predecessor) {
+            offsets[predecessor + 1]++;
+            pending[i]++;
+        });
+    }
+    for (u32 i = 0; i < m_nodes.size(); ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<u32> successors(offsets.back());
+    std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+    for (u32 i = 0; i < m_nodes.size(); ++i)
+    {
+        for_each_predecessor(i, [&](u32 predecessor) { successors[fill[predecessor]++] = i; });
+    }
+
+    // Kahn's algorithm level by level
+    std::vector<u32> order;
+    order.reserve(m_nodes.size());
+    for (u32 i = 0; i < m_nodes.size(); ++i)
+    {
+        if (pending[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+    for (u32 next = 0; next < order.size(); ++next)
+    {
+        u32 node = order[next];
+        for (u32 i = offsets[node]; i < offsets[node + 1]; ++i)
+        {
+            if (--pending[successors[i]] == 0)
+            {
+                order.push_back(successors[i]);
+            }
+        }
+    }
+
+    m_num_unordered_nodes = m_nodes.size() - order.size();
+    if (m_num_unordered_nodes != 0)
+    {
+        log_warning("netlist", "{} combinational gate outputs are part of or depend on combinational loops and cannot be levelized.", m_num_unordered_nodes);
+        for (u32 i = 0; i < m_nodes.size(); ++i)
+        {
+            if (pending[i] != 0)
+            {
+                order.push_back(i);
+            }
+        }
+    }
+
+    std::vector<combinational_node> ordered_nodes;
+    ordered_nodes.reserve(m_nodes.size());
+    for (u32 node : order)
+    {
+        ordered_nodes.push_back(m_nodes[node]);
+    }
+    m_nodes = std::move(ordered_nodes);
+}
+
+void simulation_model::collect_readers()
+{
+    u32 num_nets = m_view.get_num_nets();
+
+    // every reader is listed once per net, even if it reads the net on several pins
+    auto build = [&](u32 num_readers, auto get_inputs, std::vector<u32>& offsets, std::vector<u32>& readers) {
+        std::vector<u32> last_reader(num_nets, INVALID);
+        offsets.assign(num_nets + 1, 0);
+        for (u32 i = 0; i < num_readers; ++i)
+        {
+            auto [first, count] = get_inputs(i);
+            for (u32 j = first; j < first + count; ++j)
+            {
+                u32 input = m_input_indices[j];
+                if (input < num_nets && last_reader[input] != i)
+                {
+                    last_reader[input] = i;
+                    offsets[input + 1]++;
+                }
+            }
+        }
+        for (u32 i = 0; i < num_nets; ++i)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+
+        readers.resize(offsets.back());
+        std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+        last_reader.assign(num_nets, INVALID);
+        for (u32 i = 0; i < num_readers; ++i)
+        {
+            auto [first, count] = get_inputs(i);
+            for (u32 j = first; j < first + count; ++j)
+            {
+                u32 input = m_input_indices[j];
+                if (input < num_nets && last_reader[input] != i)
+                {
+                    last_reader[input]     = i;
+                    readers[fill[input]++] = i;
+                }
+            }
+        }
+    };
+
+    auto node_inputs    = [this](u32 i) { return std::make_pair(m_nodes[i].first_input, m_functions[m_nodes[i].function].get_num_slots()); };
+    auto element_inputs = [this](u32 i) { return std::make_pair(m_elements[i].first_input, (u32)m_view.get_gate(m_elements[i].gate)->get_type()->get_input_pins().size()); };
+    build(m_nodes.size(), node_inputs, m_node_reader_offsets, m_node_readers);
+    build(m_elements.size(), element_inputs, m_element_reader_offsets, m_element_readers);
+}
+
+const netlist_graph_view& simulation_model::get_graph_view() const
+{
+    return m_view;
+}
+
+u32 simulation_model::get_num_values() const
+{
+    return m_view.get_num_nets() + 1;
+}
+
+u32 simulation_model::get_constant_x_index() const
+{
+    return m_view.get_num_nets();
+}
+
+const std::vector<u32>& simulation_model::get_input_nets() const
+{
+    return m_input_nets;
+}
+
+bool simulation_model::is_input_net(u32 net_index) const
+{
+    return net_index < m_is_input_net.size() && m_is_input_net[net_index];
+}
+
+const std::vector<simulation_model::combinational_node>& simulation_model::get_combinational_nodes() const
+{
+    return m_nodes;
+}
+
+u32 simulation_model::get_num_unordered_nodes() const
+{
+    return m_num_unordered_nodes;
+}
+
+const std::vector<simulation_model::sequential_element>& simulation_model::get_sequential_elements() const
+{
+    return m_elements;
+}
+
+const std::vector<u32>& simulation_model::get_input_indices() const
+{
+    return m_input_indices;
+}
+
+const compiled_boolean_function& simulation_model::get_function(u32 index) const
+{
+    return m_functions[index];
+}
+
+u32 simulation_model::get_num_functions() const
+{
+    return m_functions.size();
+}
+
+u32 simulation_model::get_max_num_inputs() const
+{
+    return m_max_num_inputs;
+}
+
+netlist_graph_view::range<u32> simulation_model::get_node_readers(u32 net_index) const
+{
+    if (net_index >= m_view.get_num_nets())
+    {
+        return {nullptr, nullptr};
+    }
+    return {m_node_readers.data() + m_node_reader_offsets[net_index], m_node_readers.data() + m_node_reader_offsets[net_index + 1]};
+}
+
+netlist_graph_view::range<u32> simulation_model::get_element_readers(u32 net_index) const
+{
+    if (net_index >= m_view.get_num_nets())
+    {
+        return {nullptr, nullptr};
+    }
+    return {m_element_readers.data() + m_element_reader_offsets[net_index], m_element_readers.data() + m_element_reader_offsets[net_index + 1]};
+}
+
+std::pair<boolean_function::value, boolean_function::value> simulation_model::apply_set_reset(
+    const sequential_element& element, boolean_function::value set, boolean_function::value reset, boolean_function::value state, boolean_function::value inverted_state, bool both_were_active)
+{
+    if (set == boolean_function::ZERO && reset == boolean_function::ZERO)
+    {
+        return {state, inverted_state};
+    }
+
+    // an X on set or reset yields the common result of both possible values
+    bool first        = true;
+    auto new_state    = boolean_function::X;
+    auto new_inverted = boolean_function::X;
+    for (auto s : {boolean_function::ZERO, boolean_function::ONE})
+    {
+        for (auto r : {boolean_function::ZERO, boolean_function::ONE})
+        {
+            if ((set != boolean_function::X && s != set) || (reset != boolean_function::X && r != reset))
+            {
+                continue;
+            }
+
+            boolean_function::value state_result, inverted_result;
+            if (s == boolean_function::ONE && r == boolean_function::ONE)
+            {
+                state_result    = apply_behavior(element.state_behavior, state, both_were_active);
+                inverted_result = apply_behavior(element.inverted_state_behavior, inverted_state, both_were_active);
+            }
+            else if (s == boolean_function::ONE || r == boolean_function::ONE)
+            {
+                state_result    = (s == boolean_function::ONE) ? boolean_function::ONE : boolean_function::ZERO;
+                inverted_result = (s == boolean_function::ONE) ? boolean_function::ZERO : boolean_function::ONE;
+            }
+            else
+            {
+                state_result    = state;
+                inverted_result = inverted_state;
+            }
+
+            new_state    = first ? state_result : merge(new_state, state_result);
+            new_inverted = first ? inverted_result : merge(new_inverted, inverted_result);
+            first        = false;
+        }
+    }
+    return {new_state, new_inverted};
+}
+
+boolean_function::value simulation_model::invert(boolean_function::value v)
+{
+    return (v == boolean_function::X) ? boolean_function::X : ((v == boolean_function::ONE) ? boolean_function::ZERO : boolean_function::ONE);
+}
+
+boolean_function::value simulation_model::merge(boolean_function::value a, boolean_function::value b)
+{
+    return (a == b) ? a : boolean_function::X;
+}
+
+u64 simulation_model::next_random(u64& state)
+{
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
@@ -0,0 +1,105 @@
+#include "netlist/simulation/vcd_writer.h"
+
+#include "core/log.h"
+
+#include <cctype>
+
+namespace
+{
+    char to_vcd_char(boolean_function::value value)
+    {
+        return (value == boolean_function::ONE) ? '1' : ((value == boolean_function::ZERO) ? '0' : 'x');
+    }
+}    // namespace
+
+vcd_writer::vcd_writer(std::ostream& stream) : m_stream(stream)
+{
+}
+
+u32 vcd_writer::add_signal(const std::string& reference)
+{
+    if (m_header_written)
+    {
+        log_error("netlist", "cannot declare signal '{}' after the VCD header was written.", reference);
+        return INVALID;
+    }
+
+    std::string sanitized = reference;
+    for (auto& c : sanitized)
+    {
+        if (std::isspace((unsigned char)c))
+        {
+            c = '_';
+        }
+    }
+    m_references.push_back(sanitized);
+    m_identifiers.push_back(get_identifier(m_references.size() - 1));
+    return m_references.size() - 1;
+}
+
+u32 vcd_writer::get_num_signals() const
+{
+    return m_references.size();
+}
+
+bool vcd_writer::write_header(const std::string& scope, const std::string& timescale, u64 time, const std::vector<boolean_function::value>& initial_values)
+{
+    if (m_header_written)
+    {
+        log_error("netlist", "the VCD header was already written.");
+        return false;
+    }
+    if (initial_values.size() != m_references.size())
+    {
+        log_error("netlist", "expected {} initial values for the VCD header but got {}.", m_references.size(), initial_values.size());
+        return false;
+    }
+
+    m_stream << "$timescale " << timescale << " $end\n";
+    m_stream << "$scope module " << (scope.empty() ? "top" : scope) << " $end\n";
+    for (u32 i = 0; i < m_references.size(); ++i)
+    {
+        m_stream << "$var wire 1 " << m_identifiers[i] << " " << m_references[i] << " $end\n";
+    }
+    m_stream << "$upscope $end\n";
+    m_stream << "$enddefinitions $end\n";
+
+    m_stream << "#" << time << "\n";
+    m_stream << "$dumpvars\n";
+    for (u32 i = 0; i < m_references.size(); ++i)
+    {
+        m_stream << to_vcd_char(initial_values[i]) << m_identifiers[i] << "\n";
+    }
+    m_stream << "$end\n";
+
+    m_header_written = true;
+    m_time           = time;
+    return true;
+}
+
+void vcd_writer::write_change(u64 time, u32 signal, boolean_function::value value)
+{
+    if (time != m_time)
+    {
+        m_stream << "#" << time << "\n";
+        m_time = time;
+    }
+    m_stream << to_vcd_char(value) << m_identifiers[signal] << "\n";
+}
+
+void vcd_writer::flush()
+{
+    m_stream.flush();
+}
+
+std::string vcd_writer::get_identifier(u32 signal)
+{
+    // identifier codes are numbers in base 94 using the printable characters '!' to '~'
+    std::string result;
+    do
+    {
+        result += (char)('!' + signal % 94);
+        signal /= 94;
+    } while (signal != 0);
+    return result;
+}
@@ -9,7 +9,11 @@
 
 #include "netlist/hdl_writer/hdl_writer_dispatcher.h"
 
+#include "netlist/and_inverter_graph.h"
+#include "netlist/bdd_manager.h"
 #include "netlist/boolean_function.h"
+#include "netlist/compiled_boolean_function.h"
+#include "netlist/equivalence_checker.h"
 #include "netlist/gate.h"
 #include "netlist/gate_library/gate_library.h"
 #include "netlist/gate_library/gate_type/gate_type.h"
@@ -19,7 +23,12 @@
 #include "netlist/net.h"
 #include "netlist/netlist.h"
 #include "netlist/netlist_factory.h"
+#include "netlist/netlist_journal.h"
 #include "netlist/persistent/netlist_serializer.h"
+#include "netlist/sat_solver.h"
+#include "netlist/simulation/cycle_simulator.h"
+#include "netlist/simulation/event_simulator.h"
+#include "netlist/simulation/pattern_simulator.h"
 #include "gui/gui_api/gui_api.h"
 
 #pragma GCC diagnostic push
@@ -314,6 +323,16 @@ py_gate_type.def("get_input_pins", &gate_type::get_input_pins, R"(
         :rtype: list[str]
 )");
 
+py_gate_type.def_readonly_static("INVALID_PIN_ID", &gate_type::INVALID_PIN_ID, R"(The pin id returned for pins that do not exist.)");
+
+py_gate_type.def("get_input_pin_id", &gate_type::get_input_pin_id, py::arg("input_pin"), R"(
+        Get the id of an input pin, i.e., its position within the input pins of the gate type.
+
+        :param str input_pin: The name of the input pin.
+        :returns: The input pin id or INVALID_PIN_ID if there is no such input pin.
+        :rtype: int
+)");
+
 py_gate_type.def("add_output_pin", &gate_type::add_output_pin, py::arg("output_pin"), R"(
         Add an output pin to the gate type.
 
@@ -339,6 +358,14 @@ py_gate_type.def("get_output_pins", &gate_type::get_output_pins, R"(
         :rtype: list[str]
 )");
 
+py_gate_type.def("get_output_pin_id", &gate_type::get_output_pin_id, py::arg("output_pin"), R"(
+        Get the id of an output pin, i.e., its position within the output pins of the gate type.
+
+        :param str output_pin: The name of the output pin.
+        :returns: The output pin id or INVALID_PIN_ID if there is no such output pin.
+        :rtype: int
+)");
+
 py_gate_type.def("add_boolean_function", &gate_type::add_boolean_function, py::arg("pin_name"), py::arg("bf"), R"(
         Add a boolean function with the specified name to the gate type.
 
@@ -370,12 +397,29 @@ py_gate_type_lut.def(py::init<const std::string&>(), py::arg("name"), R"(
         :param str name: The name of the LUT gate type.
 )");
 
-py_gate_type_lut.def("add_output_from_init_string_pin", &gate_type_lut::add_output_from_init_string_pin, py::arg("output_pin"), R"(
+py_gate_type_lut.def("add_output_from_init_string_pin", py::overload_cast<const std::string&>(&gate_type_lut::add_output_from_init_string_pin), py::arg("output_pin"), R"(
         Adds an output pin to the collection of output pins that generate their output not from a boolean function but an initialization string.
 
         :param str output_pin: The name of the output string.
 )");
 
+py_gate_type_lut.def("add_output_from_init_string_pin", py::overload_cast<const std::string&, u32, u32>(&gate_type_lut::add_output_from_init_string_pin), py::arg("output_pin"), py::arg("num_inputs"), py::arg("first_row"), R"(
+        Adds an output pin of a fracturable LUT that generates its output from a part of the initialization string.
+        The output is a function of the first num_inputs input pins, and its row i is row (first_row + i) of the full LUT.
+
+        :param str output_pin: The name of the output pin.
+        :param int num_inputs: The number of leading input pins the output depends on.
+        :param int first_row: The row of the full LUT at which the output's truth table starts.
+)");
+
+py_gate_type_lut.def("get_output_from_init_string_slice", &gate_type_lut::get_output_from_init_string_slice, py::arg("output_pin"), R"(
+        Get the part of the initialization string that generates the output of an output pin.
+
+        :param str output_pin: The name of the output pin.
+        :returns: A tuple of the number of leading input pins the output depends on and the first row of the full LUT.
+        :rtype: tuple(int,int)
+)");
+
 py_gate_type_lut.def_property_readonly("output_from_init_string_pins", &gate_type_lut::get_output_from_init_string_pins, R"(
         The set of output pins that generate their output not from a boolean function but an initialization string.
 
@@ -1204,6 +1248,17 @@ py_netlist.def("get_global_output_nets", &netlist::get_global_output_nets, R"(
         :rtype: set[hal_py.net]
 )");
 
+py_netlist.def("begin_batch", &netlist::begin_batch, R"(
+        Starts a batch of modifications. Until the batch is committed, events are recorded instead of being dispatched.
+)");
+
+py_netlist.def("commit_batch", &netlist::commit_batch, R"(
+        Commits a batch of modifications. The recorded events are coalesced and dispatched, followed by a single summary of all changes.
+
+        :returns: False if no batch was active.
+        :rtype: bool
+)");
+
 py::class_<gate, data_container, std::shared_ptr<gate>> py_gate(m, "gate", R"(Gate class containing information about a gate including its location, functions, and module.)");
 
 py_gate.def_property_readonly("id", &gate::get_id, R"(
@@ -1461,6 +1516,14 @@ py_gate.def("get_fan_in_net", &gate::get_fan_in_net, py::arg("pin_type"), R"(
         :rtype: hal_py.net
 )");
 
+py_gate.def("get_fan_in_net_by_pin_id", &gate::get_fan_in_net_by_pin_id, py::arg("pin_id"), R"(
+        Get the fan-in net which is connected to a specific input pin.
+
+        :param int pin_id: The input pin id as given by gate_type.get_input_pin_id.
+        :returns: The connected input net.
+        :rtype: hal_py.net
+)");
+
 py_gate.def_property_readonly("fan_out_nets", &gate::get_fan_out_nets, R"(
         A set of all fan-out nets of the gate, i.e. all nets that are connected to one of the output pins.
 
@@ -1483,6 +1546,14 @@ py_gate.def("get_fan_out_net", &gate::get_fan_out_net, py::arg("pin_type"), R"(
         :rtype: hal_py.net
 )");
 
+py_gate.def("get_fan_out_net_by_pin_id", &gate::get_fan_out_net_by_pin_id, py::arg("pin_id"), R"(
+        Get the fan-out net which is connected to a specific output pin.
+
+        :param int pin_id: The output pin id as given by gate_type.get_output_pin_id.
+        :returns: The connected output net.
+        :rtype: hal_py.net
+)");
+
 py_gate.def_property_readonly("unique_predecessors", [](const std::shared_ptr<gate>& g){ return g->get_unique_predecessors();}, R"(
         A set of all unique predecessor endpoints of the gate.
 
@@ -1989,6 +2060,59 @@ Writes the netlist into a file with a defined format.
 )");
 
 
+py::class_<netlist_journal> py_netlist_journal(m, "netlist_journal", R"(Journal of the modifications of a netlist that allows to undo and redo them.)");
+
+py_netlist_journal.def(py::init<const std::shared_ptr<netlist>&, u64>(), py::arg("netlist"), py::arg("max_size") = 64 * 1024 * 1024, py::keep_alive<1, 2>(), R"(
+        Attaches a new journal to a netlist. Only one journal can be attached to a netlist at a time.
+
+        :param netlist: The netlist.
+        :type netlist: hal_py.netlist
+        :param int max_size: The maximum number of bytes of all recorded groups.
+)");
+
+py_netlist_journal.def("checkpoint", &netlist_journal::checkpoint, R"(
+        Closes the current group of modifications.
+)");
+
+py_netlist_journal.def("undo", &netlist_journal::undo, R"(
+        Reverts all modifications of the last group.
+
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_netlist_journal.def("redo", &netlist_journal::redo, R"(
+        Reapplies the modifications of the last undone group.
+
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_netlist_journal.def("get_num_undo_steps", &netlist_journal::get_num_undo_steps, R"(
+        Get the number of groups that can be undone, including the open group.
+
+        :returns: The number of undo steps.
+        :rtype: int
+)");
+
+py_netlist_journal.def("get_num_redo_steps", &netlist_journal::get_num_redo_steps, R"(
+        Get the number of groups that can be redone.
+
+        :returns: The number of redo steps.
+        :rtype: int
+)");
+
+py_netlist_journal.def("get_size", &netlist_journal::get_size, R"(
+        Get the number of bytes occupied by all recorded groups.
+
+        :returns: The size of the journal.
+        :rtype: int
+)");
+
+py_netlist_journal.def("clear", &netlist_journal::clear, R"(
+        Discards all recorded modifications.
+)");
+
 auto py_plugin_manager =  m.def_submodule("plugin_manager");
 
 py_plugin_manager.def("get_plugin_names", &plugin_manager::get_plugin_names, R"(
@@ -2279,6 +2403,770 @@ py_boolean_function.def("get_truth_table", &boolean_function::get_truth_table, p
         :rtype: list[value]
 )");
 
+py_boolean_function.def_static("from_truth_table", &boolean_function::from_truth_table, py::arg("table"), py::arg("variables"), R"(
+        Builds the minimized sum of products of a two-valued function from its truth table.
+        Row i, i.e., the assignment in which the j-th variable takes bit j of i, is bit i % 64 of word i / 64.
+
+        :param list[int] table: The packed truth table of 2^n rows.
+        :param list[str] variables: The n variables of the table, at most 32.
+        :returns: The boolean function, or an empty function if the table does not match the variables.
+        :rtype: hal_py.boolean_function
+)");
+
+py::class_<packed_truth_table> py_packed_truth_table(m, "packed_truth_table", R"(Truth table of a boolean function packed into bitvectors using a two-rail encoding.)");
+
+py_packed_truth_table.def_readonly("num_variables", &packed_truth_table::num_variables, R"(
+        The number of variables of the table.
+
+        :type: int
+)");
+
+py_packed_truth_table.def_readonly("ones", &packed_truth_table::ones, R"(
+        Bitvector of the rows that are ONE, 64 rows per word.
+
+        :type: list[int]
+)");
+
+py_packed_truth_table.def_readonly("zeros", &packed_truth_table::zeros, R"(
+        Bitvector of the rows that are ZERO, 64 rows per word.
+
+        :type: list[int]
+)");
+
+py_packed_truth_table.def("get", &packed_truth_table::get, py::arg("row"), R"(
+        Get the value of a row.
+
+        :param int row: The row index.
+        :returns: The value of the row.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_packed_truth_table.def("unpack", &packed_truth_table::unpack, R"(
+        Unpacks the table into one value per row.
+
+        :returns: The vector of output values.
+        :rtype: list[hal_py.boolean_function.value]
+)");
+
+py_packed_truth_table.def(py::self == py::self);
+py_packed_truth_table.def(py::self != py::self);
+
+py::class_<compiled_boolean_function> py_compiled_boolean_function(m, "compiled_boolean_function", R"(A boolean function lowered into a flat instruction array over dense variable slots.)");
+
+py_compiled_boolean_function.def(py::init<const boolean_function&>(), py::arg("function"), R"(
+        Compiles a boolean function. All variables of the function are assigned a slot in alphabetical order.
+
+        :param function: The boolean function to compile.
+        :type function: hal_py.boolean_function
+)");
+
+py_compiled_boolean_function.def(py::init<const boolean_function&, const std::vector<std::string>&>(), py::arg("function"), py::arg("variables"), R"(
+        Compiles a boolean function. The slots are assigned in the order of the given variables.
+
+        :param function: The boolean function to compile.
+        :type function: hal_py.boolean_function
+        :param list[str] variables: The variables in slot order.
+)");
+
+py_compiled_boolean_function.def_property_readonly("variables", &compiled_boolean_function::get_variables, R"(
+        The variables in slot order.
+
+        :type: list[str]
+)");
+
+py_compiled_boolean_function.def("get_variables", &compiled_boolean_function::get_variables, R"(
+        Get the variables in slot order.
+
+        :returns: The variable names.
+        :rtype: list[str]
+)");
+
+py_compiled_boolean_function.def("get_slot", &compiled_boolean_function::get_slot, py::arg("variable"), R"(
+        Get the slot of a variable.
+
+        :param str variable: The variable name.
+        :returns: The slot index or -1 if the variable has no slot.
+        :rtype: int
+)");
+
+py_compiled_boolean_function.def("evaluate", py::overload_cast<const std::vector<boolean_function::value>&>(&compiled_boolean_function::evaluate, py::const_), py::arg("inputs"), R"(
+        Evaluates the function on the given inputs.
+
+        :param list[hal_py.boolean_function.value] inputs: The values indexed by slot.
+        :returns: The value that the function evaluates to.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_compiled_boolean_function.def("get_packed_truth_table", &compiled_boolean_function::get_packed_truth_table, R"(
+        Get the truth table of the function packed into bitvectors, evaluated on 64 rows at once.
+
+        :returns: The packed truth table.
+        :rtype: hal_py.packed_truth_table
+)");
+
+py_compiled_boolean_function.def("get_truth_table", &compiled_boolean_function::get_truth_table, R"(
+        Get the truth table outputs of the function, the variable in slot 0 changes fastest.
+
+        :returns: The vector of output values.
+        :rtype: list[hal_py.boolean_function.value]
+)");
+
+py::class_<bdd_manager> py_bdd_manager(m, "bdd_manager", R"(Manager of reduced ordered binary decision diagrams, referenced by node ids.)");
+
+py_bdd_manager.def(py::init<const std::vector<std::string>&, u32>(), py::arg("variable_order") = std::vector<std::string>(), py::arg("cache_size_log2") = 16, R"(
+        Constructs a manager. Variables that are not part of the given order are appended when they are first used.
+
+        :param list[str] variable_order: The variables from top to bottom.
+        :param int cache_size_log2: Logarithm of the number of entries of the computed cache.
+)");
+
+py_bdd_manager.def_property_readonly("variable_order", &bdd_manager::get_variable_order, R"(
+        The variables from top to bottom.
+
+        :type: list[str]
+)");
+
+py_bdd_manager.def("get_variable", &bdd_manager::get_variable, py::arg("name"), R"(
+        Get the BDD of a single variable.
+
+        :param str name: The variable name.
+        :returns: The node of the variable.
+        :rtype: int
+)");
+
+py_bdd_manager.def("from_boolean_function", py::overload_cast<const boolean_function&>(&bdd_manager::from_boolean_function), py::arg("function"), R"(
+        Converts a boolean function into a BDD.
+
+        :param function: The boolean function.
+        :type function: hal_py.boolean_function
+        :returns: The resulting node or 0xFFFFFFFF if the function is empty or contains X.
+        :rtype: int
+)");
+
+py_bdd_manager.def("to_boolean_function", &bdd_manager::to_boolean_function, py::arg("node"), R"(
+        Converts a BDD into a boolean function in canonical form.
+
+        :param int node: The node.
+        :returns: The boolean function.
+        :rtype: hal_py.boolean_function
+)");
+
+py_bdd_manager.def("get_canonical_form", &bdd_manager::get_canonical_form, py::arg("function"), R"(
+        Computes a canonical form of a boolean function with respect to the variable order of the manager.
+
+        :param function: The boolean function.
+        :type function: hal_py.boolean_function
+        :returns: The canonical form or an empty function if the function cannot be converted.
+        :rtype: hal_py.boolean_function
+)");
+
+py_bdd_manager.def("are_equivalent", &bdd_manager::are_equivalent, py::arg("a"), py::arg("b"), R"(
+        Decides whether two boolean functions are equivalent.
+
+        :param a: The first boolean function.
+        :type a: hal_py.boolean_function
+        :param b: The second boolean function.
+        :type b: hal_py.boolean_function
+        :returns: True if both functions are equivalent.
+        :rtype: bool
+)");
+
+py_bdd_manager.def("get_isop", py::overload_cast<u32>(&bdd_manager::get_isop), py::arg("node"), R"(
+        Computes an irredundant sum-of-products cover of a function using the Minato-Morreale algorithm.
+
+        :param int node: The node.
+        :returns: The cubes of the cover, each a list of pairs (variable name, boolean value).
+        :rtype: list[list[tuple(str,bool)]]
+)");
+
+py_bdd_manager.def("count_satisfying_assignments", &bdd_manager::count_satisfying_assignments, py::arg("node"), R"(
+        Counts the assignments of all variables of the manager for which a function evaluates to ONE.
+
+        :param int node: The node.
+        :returns: The number of satisfying assignments.
+        :rtype: float
+)");
+
+py::class_<and_inverter_graph> py_and_inverter_graph(m, "and_inverter_graph", R"(And-Inverter-Graph for the combined representation of combinational logic, referenced by literals.)");
+
+py_and_inverter_graph.def_readonly_static("ZERO", &and_inverter_graph::ZERO, R"(The literal of the constant ZERO.)");
+py_and_inverter_graph.def_readonly_static("ONE", &and_inverter_graph::ONE, R"(The literal of the constant ONE.)");
+py_and_inverter_graph.def_readonly_static("INVALID", &and_inverter_graph::INVALID, R"(Returned by operations that failed.)");
+
+py_and_inverter_graph.def(py::init<>(), R"(
+        Constructs an empty graph that only contains the constant node.
+)");
+
+py_and_inverter_graph.def_property_readonly("num_nodes", &and_inverter_graph::get_num_nodes, R"(
+        The number of nodes including the constant node.
+
+        :type: int
+)");
+
+py_and_inverter_graph.def_property_readonly("num_ands", &and_inverter_graph::get_num_ands, R"(
+        The number of AND nodes.
+
+        :type: int
+)");
+
+py_and_inverter_graph.def("create_input", &and_inverter_graph::create_input, py::arg("name"), R"(
+        Creates a new input.
+
+        :param str name: The name of the input.
+        :returns: The literal of the input.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def_property_readonly("inputs", &and_inverter_graph::get_inputs, R"(
+        The literals of all inputs in order of creation.
+
+        :type: list[int]
+)");
+
+py_and_inverter_graph.def_property_readonly("outputs", &and_inverter_graph::get_outputs, R"(
+        The literals of all outputs in order of creation.
+
+        :type: list[int]
+)");
+
+py_and_inverter_graph.def("get_input_name", &and_inverter_graph::get_input_name, py::arg("literal"), R"(
+        Get the name of an input.
+
+        :param int literal: The literal of the input.
+        :returns: The name or an empty string if the literal is no input.
+        :rtype: str
+)");
+
+py_and_inverter_graph.def("get_fan_in", &and_inverter_graph::get_fan_in, py::arg("literal"), R"(
+        Get the fan-in literals of the AND node of a literal.
+
+        :param int literal: The literal of an AND node.
+        :returns: The pair of fan-in literals or (INVALID, INVALID) if the literal is no AND node.
+        :rtype: tuple(int,int)
+)");
+
+py_and_inverter_graph.def_static("create_not", &and_inverter_graph::create_not, py::arg("a"), R"(
+        Creates the complement of a function.
+
+        :param int a: The literal of the function.
+        :returns: The resulting literal.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def("create_and", &and_inverter_graph::create_and, py::arg("a"), py::arg("b"), R"(
+        Creates the conjunction of two functions.
+
+        :param int a: The literal of the first function.
+        :param int b: The literal of the second function.
+        :returns: The resulting literal.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def("create_or", &and_inverter_graph::create_or, py::arg("a"), py::arg("b"), R"(
+        Creates the disjunction of two functions.
+
+        :param int a: The literal of the first function.
+        :param int b: The literal of the second function.
+        :returns: The resulting literal.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def("create_xor", &and_inverter_graph::create_xor, py::arg("a"), py::arg("b"), R"(
+        Creates the exclusive disjunction of two functions.
+
+        :param int a: The literal of the first function.
+        :param int b: The literal of the second function.
+        :returns: The resulting literal.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def("from_boolean_function", py::overload_cast<const boolean_function&, const std::unordered_map<std::string, u32>&>(&and_inverter_graph::from_boolean_function), py::arg("function"), py::arg("variable_literals"), R"(
+        Converts a boolean function into the graph.
+
+        :param hal_py.boolean_function function: The boolean function.
+        :param dict[str,int] variable_literals: The literals to use for the variables of the function.
+        :returns: The resulting literal or INVALID if the function cannot be converted.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def("to_boolean_function", &and_inverter_graph::to_boolean_function, py::arg("literal"), R"(
+        Converts the function of a literal back into a boolean function over the input names.
+
+        :param int literal: The literal.
+        :returns: The boolean function or an empty function if the literal is invalid.
+        :rtype: hal_py.boolean_function
+)");
+
+py_and_inverter_graph.def("get_fanout_free_cone", &and_inverter_graph::get_fanout_free_cone, py::arg("literal"), R"(
+        Computes the maximum fanout-free cone of the node of a literal.
+
+        :param int literal: The literal of an AND node.
+        :returns: The non-complemented literals of the cone in topological order, the node itself last.
+        :rtype: list[int]
+)");
+
+py_and_inverter_graph.def("add_netlist", &and_inverter_graph::add_netlist, py::arg("netlist"), R"(
+        Adds the combinational gates of a netlist to the graph, cutting at sequential gates and global inputs.
+
+        :param hal_py.netlist netlist: The netlist.
+        :returns: True on success, false otherwise.
+        :rtype: bool
+)");
+
+py_and_inverter_graph.def("add_gates", &and_inverter_graph::add_gates, py::arg("gates"), R"(
+        Adds the given gates to the graph, assigning a literal to each of their output nets.
+        Nets driven by gates that are not given or cannot be translated become inputs of the graph.
+
+        :param list[hal_py.gate] gates: The gates.
+        :returns: True on success, false otherwise.
+        :rtype: bool
+)");
+
+py_and_inverter_graph.def("get_net_literal", &and_inverter_graph::get_net_literal, py::arg("net"), R"(
+        Get the literal of a net that was added with add_gates or add_netlist.
+
+        :param hal_py.net net: The net.
+        :returns: The literal of the net or INVALID if the net is unknown.
+        :rtype: int
+)");
+
+py_and_inverter_graph.def_property_readonly("input_nets", &and_inverter_graph::get_input_nets, R"(
+        The nets that became inputs of the graph in order of creation.
+
+        :type: list[hal_py.net]
+)");
+
+py::class_<sat_solver> py_sat_solver(m, "sat_solver", R"(Incremental CDCL SAT solver for formulas in conjunctive normal form. Literals encode a variable v as 2*v and its negation as 2*v+1.)");
+
+py::enum_<sat_solver::result>(py_sat_solver, "result", R"(
+        Result of a call to the solver.
+        )")
+        .value("SATISFIABLE", sat_solver::result::SATISFIABLE)
+        .value("UNSATISFIABLE", sat_solver::result::UNSATISFIABLE)
+        .value("UNKNOWN", sat_solver::result::UNKNOWN)
+        .export_values();
+
+py_sat_solver.def(py::init<>(), R"(
+        Constructs a solver for the empty formula.
+)");
+
+py_sat_solver.def("create_variable", &sat_solver::create_variable, R"(
+        Creates a new variable.
+
+        :returns: The index of the variable.
+        :rtype: int
+)");
+
+py_sat_solver.def_property_readonly("num_variables", &sat_solver::get_num_variables, R"(
+        The number of variables.
+
+        :type: int
+)");
+
+py_sat_solver.def_property_readonly("num_clauses", &sat_solver::get_num_clauses, R"(
+        The number of clauses that were added and not found to be trivially satisfied.
+
+        :type: int
+)");
+
+py_sat_solver.def_property_readonly("num_conflicts", &sat_solver::get_num_conflicts, R"(
+        The total number of conflicts encountered in all calls to solve.
+
+        :type: int
+)");
+
+py_sat_solver.def_static("get_literal", &sat_solver::get_literal, py::arg("variable"), py::arg("negated") = false, R"(
+        Get the literal of a variable.
+
+        :param int variable: The variable.
+        :param bool negated: True for the negative literal.
+        :returns: The literal.
+        :rtype: int
+)");
+
+py_sat_solver.def("add_clause", &sat_solver::add_clause, py::arg("literals"), R"(
+        Adds a clause, i.e., a disjunction of literals, to the formula.
+
+        :param list[int] literals: The literals of the clause.
+        :returns: False if the formula became unsatisfiable or a literal refers to an unknown variable, true otherwise.
+        :rtype: bool
+)");
+
+py_sat_solver.def("solve", &sat_solver::solve, py::arg("assumptions") = std::vector<u32>(), py::arg("conflict_limit") = 0, R"(
+        Decides whether the formula is satisfiable when all assumptions hold. Assumptions only apply to this call.
+
+        :param list[int] assumptions: Literals that are assumed to be true.
+        :param int conflict_limit: The number of conflicts after which the solver gives up, 0 for no limit.
+        :returns: The result.
+        :rtype: hal_py.sat_solver.result
+)");
+
+py_sat_solver.def("get_model_value", &sat_solver::get_model_value, py::arg("variable"), R"(
+        Get the value of a variable in the model found by the last satisfiable call to solve.
+
+        :param int variable: The variable.
+        :returns: The value of the variable.
+        :rtype: bool
+)");
+
+py::class_<equivalence_checker> py_equivalence_checker(m, "equivalence_checker", R"(Functional equivalence checking and constant detection for the nets of a netlist, using random simulation and SAT.)");
+
+py_equivalence_checker.def(py::init<const std::shared_ptr<netlist>&, u32, u64>(), py::arg("netlist"), py::arg("num_simulation_words") = 4, py::arg("seed") = 0x5eed, R"(
+        Constructs a checker for the nets of a netlist. The netlist must not be modified while the checker is in use.
+
+        :param hal_py.netlist netlist: The netlist.
+        :param int num_simulation_words: The number of 64-bit words of random patterns that are simulated initially.
+        :param int seed: The seed of the random patterns.
+)");
+
+py_equivalence_checker.def("are_equivalent", &equivalence_checker::are_equivalent, py::arg("a"), py::arg("b"), R"(
+        Checks whether two nets are functionally equivalent.
+
+        :param hal_py.net a: The first net.
+        :param hal_py.net b: The second net.
+        :returns: True if both nets always carry the same value, false otherwise.
+        :rtype: bool
+)");
+
+py_equivalence_checker.def("get_constant_value", &equivalence_checker::get_constant_value, py::arg("net"), R"(
+        Checks whether a net is stuck at a constant value.
+
+        :param hal_py.net net: The net.
+        :returns: ZERO or ONE if the net is constant, X otherwise.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_equivalence_checker.def("find_constant_nets", &equivalence_checker::find_constant_nets, R"(
+        Finds all nets of the netlist that are stuck at a constant value.
+
+        :returns: A dict from each constant net to its value.
+        :rtype: dict[hal_py.net,hal_py.boolean_function.value]
+)");
+
+py_equivalence_checker.def_property_readonly("and_inverter_graph", &equivalence_checker::get_and_inverter_graph, py::return_value_policy::reference_internal, R"(
+        The graph the checks are performed on.
+
+        :type: hal_py.and_inverter_graph
+)");
+
+py_equivalence_checker.def_property_readonly("num_sat_calls", &equivalence_checker::get_num_sat_calls, R"(
+        The number of queries that could not be decided by simulation and were passed to the SAT solver.
+
+        :type: int
+)");
+
+py::class_<cycle_simulator> py_cycle_simulator(m, "cycle_simulator", R"(Cycle-based simulator for gate-level netlists with three-valued logic.)");
+
+py_cycle_simulator.def(py::init<const std::shared_ptr<netlist>&>(), py::arg("netlist"), R"(
+        Constructs a simulator for a netlist and resets it. The netlist must not be modified while the simulator is in use.
+
+        :param hal_py.netlist netlist: The netlist.
+)");
+
+py_cycle_simulator.def("add_clock_net", &cycle_simulator::add_clock_net, py::arg("net"), R"(
+        Registers an input net as a clock which is toggled in every cycle. The clock is driven ZERO until the next cycle starts.
+
+        :param hal_py.net net: The clock net.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_cycle_simulator.def_property_readonly("clock_nets", &cycle_simulator::get_clock_nets, R"(
+        The registered clock nets.
+
+        :type: list[hal_py.net]
+)");
+
+py_cycle_simulator.def("get_clock_nets", &cycle_simulator::get_clock_nets, R"(
+        Get the registered clock nets.
+
+        :returns: The clock nets.
+        :rtype: list[hal_py.net]
+)");
+
+py_cycle_simulator.def("set_input", &cycle_simulator::set_input, py::arg("net"), py::arg("value"), R"(
+        Sets the value of an input net, i.e., a global input net or a net without a source.
+        The value is applied from the next cycle on and kept until it is set again.
+
+        :param hal_py.net net: The input net.
+        :param hal_py.boolean_function.value value: The new value.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_cycle_simulator.def("get_value", &cycle_simulator::get_value, py::arg("net"), R"(
+        Get the current value of a net.
+
+        :param hal_py.net net: The net.
+        :returns: The value of the net or X if the net is not part of the netlist.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_cycle_simulator.def("reset", &cycle_simulator::reset, R"(
+        Resets the simulator. All flip-flops and latches are set to their initial values, all inputs except for the clocks are set to X and the cycle counter is set to 0.
+)");
+
+py_cycle_simulator.def("simulate", &cycle_simulator::simulate, py::arg("num_cycles") = 1, R"(
+        Simulates a number of cycles with the current input values.
+
+        :param int num_cycles: The number of cycles.
+)");
+
+py_cycle_simulator.def("run", &cycle_simulator::run, py::arg("input_nets"), py::arg("stimulus"), py::arg("observed_nets"), R"(
+        Simulates one cycle per stimulus vector.
+        Before every cycle, each input net is set to the value at its position in the stimulus vector of the cycle.
+        After every cycle, the values of the observed nets are recorded.
+
+        :param list[hal_py.net] input_nets: The input nets to drive.
+        :param list[list[hal_py.boolean_function.value]] stimulus: One list of values per cycle, ordered like the input nets.
+        :param list[hal_py.net] observed_nets: The nets to record.
+        :returns: One list of values per simulated cycle, ordered like the observed nets. Empty on error.
+        :rtype: list[list[hal_py.boolean_function.value]]
+)");
+
+py_cycle_simulator.def_property_readonly("cycle", &cycle_simulator::get_cycle, R"(
+        The number of cycles simulated since the last reset.
+
+        :type: int
+)");
+
+py_cycle_simulator.def("get_cycle", &cycle_simulator::get_cycle, R"(
+        Get the number of cycles simulated since the last reset.
+
+        :returns: The cycle count.
+        :rtype: int
+)");
+
+py::class_<pattern_simulator> py_pattern_simulator(m, "pattern_simulator", R"(Bit-parallel simulator evaluating 64 input patterns per word of the combinational logic at once, treating flip-flop and latch states as free inputs.)");
+
+py_pattern_simulator.def(py::init<const std::shared_ptr<netlist>&, u32>(), py::arg("netlist"), py::arg("num_words") = 1, R"(
+        Constructs a simulator for a netlist with all inputs set to X. The netlist must not be modified while the simulator is in use.
+
+        :param hal_py.netlist netlist: The netlist.
+        :param int num_words: The number of 64-bit words per net, at least 1.
+)");
+
+py_pattern_simulator.def_property_readonly("num_words", &pattern_simulator::get_num_words, R"(
+        The number of 64-bit words per net.
+
+        :type: int
+)");
+
+py_pattern_simulator.def("get_num_words", &pattern_simulator::get_num_words, R"(
+        Get the number of 64-bit words per net.
+
+        :returns: The number of words.
+        :rtype: int
+)");
+
+py_pattern_simulator.def_property_readonly("num_patterns", &pattern_simulator::get_num_patterns, R"(
+        The number of patterns simulated per pass, i.e., 64 times the number of words.
+
+        :type: int
+)");
+
+py_pattern_simulator.def("get_num_patterns", &pattern_simulator::get_num_patterns, R"(
+        Get the number of patterns simulated per pass, i.e., 64 times the number of words.
+
+        :returns: The number of patterns.
+        :rtype: int
+)");
+
+py_pattern_simulator.def_property_readonly("input_nets", &pattern_simulator::get_input_nets, R"(
+        The nets whose values are inputs of the simulation, i.e., all input nets followed by one output net per flip-flop or latch that has one.
+
+        :type: list[hal_py.net]
+)");
+
+py_pattern_simulator.def("get_input_nets", &pattern_simulator::get_input_nets, R"(
+        Get the nets whose values are inputs of the simulation, i.e., all input nets followed by one output net per flip-flop or latch that has one.
+
+        :returns: The input nets.
+        :rtype: list[hal_py.net]
+)");
+
+py_pattern_simulator.def("set_input", py::overload_cast<const std::shared_ptr<net>&, boolean_function::value>(&pattern_simulator::set_input), py::arg("net"), py::arg("value"), R"(
+        Sets an input to the same value in all patterns.
+        Setting a state or inverted state output net of a sequential element sets the state of the element.
+
+        :param hal_py.net net: The input net.
+        :param hal_py.boolean_function.value value: The value.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_pattern_simulator.def("set_input", py::overload_cast<const std::shared_ptr<net>&, const std::vector<u64>&, const std::vector<u64>&>(&pattern_simulator::set_input), py::arg("net"), py::arg("ones"), py::arg("zeros"), R"(
+        Sets an input to individual values per pattern in two-rail encoding.
+        Pattern i is ONE if bit (i % 64) of word (i / 64) is set in ones only, ZERO if it is set in zeros only and X otherwise.
+
+        :param hal_py.net net: The input net.
+        :param list[int] ones: One word per num_words marking the ONE patterns.
+        :param list[int] zeros: One word per num_words marking the ZERO patterns.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_pattern_simulator.def("randomize_inputs", &pattern_simulator::randomize_inputs, py::arg("seed"), R"(
+        Sets all inputs to uniformly random ZERO or ONE values in every pattern.
+
+        :param int seed: The seed of the random patterns.
+)");
+
+py_pattern_simulator.def("set_exhaustive_inputs", &pattern_simulator::set_exhaustive_inputs, py::arg("nets"), py::arg("first_assignment") = 0, R"(
+        Enumerates assignments of the given inputs. In pattern i, the j-th input is set to bit j of (first_assignment + i). All other inputs are kept.
+
+        :param list[hal_py.net] nets: The input nets to enumerate.
+        :param int first_assignment: The assignment of the first pattern.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_pattern_simulator.def("simulate", &pattern_simulator::simulate, R"(
+        Propagates the current inputs through the combinational logic. Patterns that do not stabilize on combinational loops are set to X.
+)");
+
+py_pattern_simulator.def("get_value", &pattern_simulator::get_value, py::arg("net"), py::arg("pattern"), R"(
+        Get the value of a net in a single pattern.
+
+        :param hal_py.net net: The net.
+        :param int pattern: The pattern index.
+        :returns: The value or X if the net is not part of the netlist or the pattern index is out of range.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_pattern_simulator.def("get_signature", &pattern_simulator::get_signature, py::arg("net"), R"(
+        Get the signature of a net, i.e., the patterns in which it is ONE.
+
+        :param hal_py.net net: The net.
+        :returns: One word per num_words or an empty list if the net is not part of the netlist.
+        :rtype: list[int]
+)");
+
+py_pattern_simulator.def("get_x_mask", &pattern_simulator::get_x_mask, py::arg("net"), R"(
+        Get the patterns in which a net is X.
+
+        :param hal_py.net net: The net.
+        :returns: One word per num_words or an empty list if the net is not part of the netlist.
+        :rtype: list[int]
+)");
+
+py_pattern_simulator.def("get_signature_classes", &pattern_simulator::get_signature_classes, R"(
+        Groups nets that carry identical values in all patterns, including X. Only groups of at least two nets are returned.
+
+        :returns: The groups of nets, ordered by net id.
+        :rtype: list[list[hal_py.net]]
+)");
+
+py::class_<event_simulator> py_event_simulator(m, "event_simulator", R"(Event-driven simulator for gate-level netlists with per-gate-type delays and VCD output.)");
+
+py_event_simulator.def(py::init<const std::shared_ptr<netlist>&>(), py::arg("netlist"), R"(
+        Constructs a simulator for a netlist at time 0. All inputs are X, flip-flops and latches hold their initial values and all combinational nodes are scheduled to be evaluated once.
+        The netlist must not be modified while the simulator is in use.
+
+        :param hal_py.netlist netlist: The netlist.
+)");
+
+py_event_simulator.def("set_gate_type_delay", &event_simulator::set_gate_type_delay, py::arg("type_name"), py::arg("delay"), R"(
+        Sets the delay of all gates of a gate type. The default delay is 1.
+
+        :param str type_name: The name of the gate type.
+        :param int delay: The delay, at least 1.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_event_simulator.def("get_gate_type_delay", &event_simulator::get_gate_type_delay, py::arg("type_name"), R"(
+        Get the delay of a gate type.
+
+        :param str type_name: The name of the gate type.
+        :returns: The delay.
+        :rtype: int
+)");
+
+py_event_simulator.def("add_clock", &event_simulator::add_clock, py::arg("net"), py::arg("half_period"), R"(
+        Drives an input net with a clock that is ZERO at the current time and toggles every half period.
+
+        :param hal_py.net net: The clock net.
+        :param int half_period: The time between two edges, at least 1.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_event_simulator.def("set_input", &event_simulator::set_input, py::arg("net"), py::arg("value"), py::arg("time"), R"(
+        Schedules a value change of an input net, i.e., a global input net or a net without a source.
+
+        :param hal_py.net net: The input net.
+        :param hal_py.boolean_function.value value: The new value.
+        :param int time: The time of the change, not earlier than the current time.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_event_simulator.def("run_until", &event_simulator::run_until, py::arg("time"), R"(
+        Processes all events up to and including the given time.
+
+        :param int time: The time to simulate to.
+)");
+
+py_event_simulator.def("run_for", &event_simulator::run_for, py::arg("duration"), R"(
+        Processes all events within the given duration from the current time.
+
+        :param int duration: The duration.
+)");
+
+py_event_simulator.def_property_readonly("time", &event_simulator::get_time, R"(
+        The current simulation time.
+
+        :type: int
+)");
+
+py_event_simulator.def("get_time", &event_simulator::get_time, R"(
+        Get the current simulation time.
+
+        :returns: The time.
+        :rtype: int
+)");
+
+py_event_simulator.def("get_value", &event_simulator::get_value, py::arg("net"), R"(
+        Get the current value of a net.
+
+        :param hal_py.net net: The net.
+        :returns: The value of the net or X if the net is not part of the netlist.
+        :rtype: hal_py.boolean_function.value
+)");
+
+py_event_simulator.def_property_readonly("num_changes", &event_simulator::get_num_changes, R"(
+        The number of net value changes processed so far.
+
+        :type: int
+)");
+
+py_event_simulator.def("get_num_changes", &event_simulator::get_num_changes, R"(
+        Get the number of net value changes processed so far.
+
+        :returns: The number of changes.
+        :rtype: int
+)");
+
+py_event_simulator.def("start_vcd",
+                       py::overload_cast<const hal::path&, const std::vector<std::shared_ptr<net>>&, const std::string&>(&event_simulator::start_vcd),
+                       py::arg("file_path"),
+                       py::arg("nets")      = std::vector<std::shared_ptr<net>>(),
+                       py::arg("timescale") = "1ns",
+                       R"(
+        Starts streaming value changes to a VCD file. Nets are named by their name followed by their id. The current values are written as initial values.
+
+        :param hal_py.hal_path file_path: The output file.
+        :param list[hal_py.net] nets: The nets to record, all nets if empty.
+        :param str timescale: The time unit of one simulation time step.
+        :returns: True on success.
+        :rtype: bool
+)");
+
+py_event_simulator.def("stop_vcd", &event_simulator::stop_vcd, R"(
+        Stops streaming value changes and closes the VCD file.
+)");
+
 #ifndef PYBIND11_MODULE
     return m.ptr();
 #endif    // PYBIND11_MODULE
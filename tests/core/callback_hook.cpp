@@ -2,7 +2,9 @@
 #include "gtest/gtest.h"
 #include <core/callback_hook.h>
 #include <core/log.h>
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 typedef callback_hook<std::string(std::string)> test_hook;
 typedef std::function<std::string(std::string)> test_function;
@@ -272,3 +274,83 @@ TEST_F(callback_hook_test, check_bracket_operator)
     }
     TEST_END
 }
+
+/**
+ * Tests that callbacks can add and remove callbacks while the hook is executed. Changes only take effect for the
+ * next execution.
+ *
+ * Functions: operator(), empty, remove_callback, add_callback
+ */
+TEST_F(callback_hook_test, check_modification_during_execution)
+{
+    TEST_START
+    // ########################
+    // POSITIVE TESTS
+    // ########################
+
+    {
+        // A callback removes itself and registers another one
+        sum_up_hook sum_hook;
+        EXPECT_TRUE(sum_hook.empty());
+        sum_hook.add_callback("self_removing", [&sum_hook, this](int& i) {
+            i = i + 1;
+            sum_hook.remove_callback("self_removing");
+            sum_hook.add_callback("id_5", add_5_func);
+        });
+        sum_hook.add_callback("id_2", add_2_func);
+        EXPECT_FALSE(sum_hook.empty());
+
+        int res = 0;
+        sum_hook(res);
+        EXPECT_EQ(res, 3);
+
+        res = 0;
+        sum_hook(res);
+        EXPECT_EQ(res, 7);
+        EXPECT_EQ(sum_hook.size(), (size_t)2);
+        EXPECT_EQ(sum_hook.get_name(CALLBACK_HOOK_MIN_IDX+2), "id_5");
+
+        sum_hook.remove_callback("id_2");
+        sum_hook.remove_callback("id_5");
+        EXPECT_TRUE(sum_hook.empty());
+    }
+    TEST_END
+}
+
+/**
+ * Tests that the hook can be executed on one thread while callbacks are registered and removed on another.
+ *
+ * Functions: operator(), add_callback, remove_callback
+ */
+TEST_F(callback_hook_test, check_concurrent_execution)
+{
+    TEST_START
+    // ########################
+    // POSITIVE TESTS
+    // ########################
+
+    {
+        // Every execution sees either the old or the new subscriber array
+        sum_up_hook sum_hook;
+        sum_hook.add_callback("id_2", add_2_func);
+
+        std::atomic<bool> done(false);
+        std::thread executor([&sum_hook, &done]() {
+            while (!done)
+            {
+                int res = 0;
+                sum_hook(res);
+                EXPECT_TRUE(res == 2 || res == 7);
+            }
+        });
+        for (int i = 0; i < 10000; ++i)
+        {
+            sum_hook.add_callback("id_5", add_5_func);
+            sum_hook.remove_callback("id_5");
+        }
+        done = true;
+        executor.join();
+        EXPECT_EQ(sum_hook.size(), (size_t)1);
+    }
+    TEST_END
+}
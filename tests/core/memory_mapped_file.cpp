@@ -0,0 +1,93 @@
+#include "test_def.h"
+#include "gtest/gtest.h"
+#include <core/log.h>
+#include <core/memory_mapped_file.h>
+#include <core/utils.h>
+#include <fstream>
+
+class memory_mapped_file_test : public ::testing::Test
+{
+protected:
+    hal::path m_tmp_dir;
+
+    virtual void SetUp()
+    {
+        m_tmp_dir = core_utils::get_binary_directory() / "tmp_memory_mapped_file";
+        hal::fs::create_directory(m_tmp_dir);
+    }
+
+    virtual void TearDown()
+    {
+        hal::fs::remove_all(m_tmp_dir);
+    }
+
+    hal::path create_file(const std::string& name, const std::string& content)
+    {
+        hal::path file = m_tmp_dir / name;
+        std::ofstream ofs(file.string(), std::ios::out | std::ios::binary);
+        ofs << content;
+        return file;
+    }
+};
+
+/**
+ * Testing the mapping of a file and access to its contents.
+ *
+ * Functions: open, close, is_open, data, size, view
+ */
+TEST_F(memory_mapped_file_test, check_open){TEST_START
+    {
+        // map a file with windows line endings, the contents are untouched
+        std::string content = "module top;\r\nendmodule\n";
+        hal::path file      = create_file("test.v", content);
+
+        memory_mapped_file mapped;
+        EXPECT_FALSE(mapped.is_open());
+        ASSERT_TRUE(mapped.open(file));
+        EXPECT_TRUE(mapped.is_open());
+        EXPECT_EQ(mapped.size(), content.size());
+        EXPECT_NE(mapped.data(), nullptr);
+        EXPECT_EQ(mapped.view(), content);
+
+        mapped.close();
+        EXPECT_FALSE(mapped.is_open());
+        EXPECT_EQ(mapped.size(), 0);
+        EXPECT_TRUE(mapped.view().empty());
+    }
+    {
+        // reopening replaces the previous mapping
+        hal::path first  = create_file("first.v", "first");
+        hal::path second = create_file("second.v", "second file");
+
+        memory_mapped_file mapped;
+        ASSERT_TRUE(mapped.open(first));
+        ASSERT_TRUE(mapped.open(second));
+        EXPECT_EQ(mapped.view(), "second file");
+    }
+    {
+        // an empty file is mapped to an empty view
+        hal::path file = create_file("empty.v", "");
+
+        memory_mapped_file mapped;
+        ASSERT_TRUE(mapped.open(file));
+        EXPECT_TRUE(mapped.is_open());
+        EXPECT_EQ(mapped.size(), 0);
+        EXPECT_TRUE(mapped.view().empty());
+    }
+    // NEGATIVE
+    {
+        // the file does not exist
+        NO_COUT_TEST_BLOCK;
+        memory_mapped_file mapped;
+        EXPECT_FALSE(mapped.open(m_tmp_dir / "does_not_exist.v"));
+        EXPECT_FALSE(mapped.is_open());
+    }
+    {
+        // a directory cannot be mapped
+        NO_COUT_TEST_BLOCK;
+        memory_mapped_file mapped;
+        EXPECT_FALSE(mapped.open(m_tmp_dir));
+        EXPECT_FALSE(mapped.is_open());
+    }
+    TEST_END
+}
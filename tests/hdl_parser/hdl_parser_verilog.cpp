@@ -1363,6 +1363,123 @@ TEST_F(hdl_parser_verilog_test, check_one_line_multiple_nets)
     TEST_END
 }
 
+/**
+ * Testing the statement-wise parsing with instances of entities that are defined later, wires that are declared after
+ * their use, several statements in one line and statements spanning several lines.
+ *
+ * Functions: parse
+ */
+TEST_F(hdl_parser_verilog_test, check_statement_order)
+{
+    TEST_START
+        {
+            std::stringstream input("module MID ( mid_in, mid_out ) ;\n"
+                                    "  input mid_in ;\n"
+                                    "  output mid_out ;\n"
+                                    "INNER inner_inst (\n"
+                                    "  .inner_in (mid_in ),\n"
+                                    "  .inner_out (mid_net )\n"
+                                    " ) ;\n"
+                                    "INV #\n"
+                                    "( .delay(3) ) mid_gate ( .\\I (mid_net ), .\\O (mid_out ) ) ;\n"
+                                    "  wire mid_net ;\n"
+                                    "endmodule\n"
+                                    "module INNER ( inner_in, inner_out ) ; input inner_in ; output inner_out ;\n"
+                                    "INV inner_gate ( .\\I (inner_in ), .\\O (inner_out ) ) ; endmodule\n"
+                                    "module top ( global_in, global_out ) ;\n"
+                                    "  input global_in ;\n"
+                                    "  output global_out ;\n"
+                                    "MID mid_inst ( .mid_in (global_in ), .mid_out (global_out ) ) ;\n"
+                                    "endmodule");
+            hdl_parser_verilog verilog_parser(input);
+            std::shared_ptr<netlist> nl = verilog_parser.parse(g_lib_name);
+
+            ASSERT_NE(nl, nullptr);
+            EXPECT_EQ(nl->get_modules().size(), 3);
+            ASSERT_EQ(nl->get_gates(gate_filter("INV", "inner_gate")).size(), 1);
+            ASSERT_EQ(nl->get_gates(gate_filter("INV", "mid_gate")).size(), 1);
+            std::shared_ptr<gate> inner_gate = *nl->get_gates(gate_filter("INV", "inner_gate")).begin();
+            std::shared_ptr<gate> mid_gate   = *nl->get_gates(gate_filter("INV", "mid_gate")).begin();
+
+            EXPECT_EQ(mid_gate->get_data_by_key("generic", "delay"), std::make_tuple("integer", "3"));
+
+            ASSERT_EQ(nl->get_nets(net_name_filter("mid_net")).size(), 1);
+            std::shared_ptr<net> mid_net = *nl->get_nets(net_name_filter("mid_net")).begin();
+            EXPECT_EQ(mid_net->get_src(), get_endpoint(inner_gate, "O"));
+            EXPECT_TRUE(vectors_have_same_content(mid_net->get_dsts(), std::vector<endpoint>({get_endpoint(mid_gate, "I")})));
+
+            ASSERT_EQ(nl->get_nets(net_name_filter("global_in")).size(), 1);
+            ASSERT_EQ(nl->get_nets(net_name_filter("global_out")).size(), 1);
+            std::shared_ptr<net> global_in  = *nl->get_nets(net_name_filter("global_in")).begin();
+            std::shared_ptr<net> global_out = *nl->get_nets(net_name_filter("global_out")).begin();
+            EXPECT_TRUE(vectors_have_same_content(global_in->get_dsts(), std::vector<endpoint>({get_endpoint(inner_gate, "I")})));
+            EXPECT_EQ(global_out->get_src(), get_endpoint(mid_gate, "O"));
+        }
+        {
+            // a module that is not terminated by 'endmodule'
+            NO_COUT_TEST_BLOCK;
+            std::stringstream input("module top ( global_in ) ;\n"
+                                    "  input global_in ;\n"
+                                    "INV gate_0 ( .\\I (global_in ) ) ;\n");
+            hdl_parser_verilog verilog_parser(input);
+            std::shared_ptr<netlist> nl = verilog_parser.parse(g_lib_name);
+
+            EXPECT_EQ(nl, nullptr);
+        }
+    TEST_END
+}
+
+/**
+ * Testing that parsing from a view of the hdl code (as done for memory-mapped files) behaves like parsing from a stream.
+ * The input uses windows line endings, comments spanning several lines and no trailing newline.
+ *
+ * Functions: parse
+ */
+TEST_F(hdl_parser_verilog_test, check_view_input)
+{
+    TEST_START
+        {
+            std::string code = "module top (\r\n"
+                               "  global_in,\r\n"
+                               "  global_out\r\n"
+                               " ) ;\r\n"
+                               "  input global_in ;\r\n"
+                               "  output global_out ;\r\n"
+                               "  wire net_0 ; /* first\r\n"
+                               "  wire comment_net ;\r\n"
+                               "  end of comment */\r\n"
+                               "INV gate_0 (\r\n"
+                               "  .\\I (global_in ),\r\n"
+                               "  .\\O (net_0 )\r\n"
+                               " ) ;\r\n"
+                               "INV gate_1 ( // trailing comment\r\n"
+                               "  .\\I (net_0 ),\r\n"
+                               "  .\\O (global_out )\r\n"
+                               " ) ;\r\n"
+                               "endmodule";
+
+            hdl_parser_verilog view_parser{std::string_view(code)};
+            std::shared_ptr<netlist> nl = view_parser.parse(g_lib_name);
+            ASSERT_NE(nl, nullptr);
+
+            std::stringstream input(code);
+            hdl_parser_verilog stream_parser(input);
+            std::shared_ptr<netlist> nl_stream = stream_parser.parse(g_lib_name);
+            ASSERT_NE(nl_stream, nullptr);
+
+            EXPECT_EQ(nl->get_gates().size(), 2);
+            EXPECT_EQ(nl->get_nets().size(), nl_stream->get_nets().size());
+            EXPECT_TRUE(nl->get_nets(net_name_filter("comment_net")).empty());
+            ASSERT_EQ(nl->get_nets(net_name_filter("net_0")).size(), 1);
+            auto net_0 = *nl->get_nets(net_name_filter("net_0")).begin();
+            ASSERT_NE(net_0->get_src().get_gate(), nullptr);
+            EXPECT_EQ(net_0->get_src().get_gate()->get_name(), "gate_0");
+            ASSERT_EQ(net_0->get_dsts().size(), 1);
+            EXPECT_EQ(net_0->get_dsts()[0].get_gate()->get_name(), "gate_1");
+        }
+    TEST_END
+}
+
 /**
  * Testing the correct handling of invalid input
  *
@@ -1687,6 +1687,64 @@ TEST_F(hdl_parser_vhdl_test, check_component)
     TEST_END
 }
 
+/**
+ * Testing that parsing from a view of the hdl code (as done for memory-mapped files) behaves like parsing from a stream.
+ * The input uses windows line endings, indented comments and no trailing newline.
+ *
+ * Functions: parse
+ */
+TEST_F(hdl_parser_vhdl_test, check_view_input)
+{
+    TEST_START
+        {
+            std::string code = "library IEEE;\r\n"
+                               "use IEEE.STD_LOGIC_1164.ALL;\r\n"
+                               "\r\n"
+                               "entity TEST_Comp is\r\n"
+                               "  port (\r\n"
+                               "    net_global_in : in STD_LOGIC := 'X';  -- the input\r\n"
+                               "    net_global_out : out STD_LOGIC := 'X';\r\n"
+                               "  );\r\n"
+                               "end TEST_Comp;\r\n"
+                               "\t-- signal comment_net : STD_LOGIC;\r\n"
+                               "architecture STRUCTURE of TEST_Comp is\r\n"
+                               "  signal net_0 : STD_LOGIC;\r\n"
+                               "begin\r\n"
+                               "  gate_0 : INV\r\n"
+                               "    port map (\r\n"
+                               "      I => net_global_in,\r\n"
+                               "      O => net_0\r\n"
+                               "    );\r\n"
+                               "  gate_1 : INV\r\n"
+                               "    port map (\r\n"
+                               "      I => net_0,\r\n"
+                               "      O => net_global_out\r\n"
+                               "    );\r\n"
+                               "end STRUCTURE;";
+
+            hdl_parser_vhdl view_parser{std::string_view(code)};
+            std::shared_ptr<netlist> nl = view_parser.parse(g_lib_name);
+            ASSERT_NE(nl, nullptr);
+
+            std::stringstream input(code);
+            hdl_parser_vhdl stream_parser(input);
+            std::shared_ptr<netlist> nl_stream = stream_parser.parse(g_lib_name);
+            ASSERT_NE(nl_stream, nullptr);
+
+            EXPECT_EQ(nl->get_design_name(), "TEST_Comp");
+            EXPECT_EQ(nl->get_gates().size(), 2);
+            EXPECT_EQ(nl->get_nets().size(), nl_stream->get_nets().size());
+            EXPECT_TRUE(nl->get_nets(net_name_filter("comment_net")).empty());
+            ASSERT_EQ(nl->get_nets(net_name_filter("net_0")).size(), 1);
+            auto net_0 = *nl->get_nets(net_name_filter("net_0")).begin();
+            ASSERT_NE(net_0->get_src().get_gate(), nullptr);
+            EXPECT_EQ(net_0->get_src().get_gate()->get_name(), "gate_0");
+            ASSERT_EQ(net_0->get_dsts().size(), 1);
+            EXPECT_EQ(net_0->get_dsts()[0].get_gate()->get_name(), "gate_1");
+        }
+    TEST_END
+}
+
 /**
  * Testing the correct handling of invalid input
  *
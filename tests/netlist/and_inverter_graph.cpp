@@ -0,0 +1,264 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/and_inverter_graph.h>
+#include <netlist/bdd_manager.h>
+#include <netlist/boolean_function.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class and_inverter_graph_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("AIG_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "OR2", {"A", "B"}, "A | B");
+        add_combinational_type(m_gl, "XOR2", {"A", "B"}, "A ^ B");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+        add_combinational_type(m_gl, "BUF", {"A"}, "A");
+        add_combinational_type(m_gl, "GND", {}, "0");
+        add_combinational_type(m_gl, "VCC", {}, "1");
+        add_combinational_type(m_gl, "XBUF", {"A"}, "X");
+
+        add_flip_flop_type(m_gl, "DFF");
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing structural hashing and constant propagation on creation
+ *
+ * Functions: create_input, create_and, create_or, create_xor, create_mux, create_not, get_num_ands
+ */
+TEST_F(and_inverter_graph_test, check_structural_hashing){
+    TEST_START
+        {
+            // Trivial cases do not create nodes
+            and_inverter_graph aig;
+            u32 a = aig.create_input("A");
+            EXPECT_EQ(aig.create_and(a, and_inverter_graph::ZERO), and_inverter_graph::ZERO);
+            EXPECT_EQ(aig.create_and(and_inverter_graph::ONE, a), a);
+            EXPECT_EQ(aig.create_and(a, a), a);
+            EXPECT_EQ(aig.create_and(a, and_inverter_graph::create_not(a)), and_inverter_graph::ZERO);
+            EXPECT_EQ(aig.create_or(a, and_inverter_graph::create_not(a)), and_inverter_graph::ONE);
+            EXPECT_EQ(and_inverter_graph::create_not(and_inverter_graph::create_not(a)), a);
+            EXPECT_EQ(aig.get_num_ands(), 0);
+        }
+        {
+            // Equal structures are created only once, regardless of the operand order
+            and_inverter_graph aig;
+            u32 a = aig.create_input("A");
+            u32 b = aig.create_input("B");
+            u32 c = aig.create_input("C");
+            u32 ab = aig.create_and(a, b);
+            EXPECT_EQ(aig.create_and(b, a), ab);
+            EXPECT_EQ(aig.create_xor(a, b), aig.create_xor(a, b));
+            EXPECT_EQ(aig.create_mux(c, a, b), aig.create_mux(c, a, b));
+            EXPECT_EQ(aig.get_num_ands(), 1 + 3 + 3);
+            EXPECT_TRUE(aig.is_and(ab));
+            EXPECT_TRUE(aig.is_input(a));
+            EXPECT_EQ(aig.get_input_name(c), "C");
+            EXPECT_EQ(aig.get_fan_in(ab), std::make_pair(a, b));
+            EXPECT_EQ(aig.get_fan_in(a), std::make_pair(and_inverter_graph::INVALID, and_inverter_graph::INVALID));
+        }
+    TEST_END
+}
+
+/**
+ * Testing the conversion from and to boolean functions
+ *
+ * Functions: from_boolean_function, to_boolean_function
+ */
+TEST_F(and_inverter_graph_test, check_boolean_function){
+    TEST_START
+        {
+            and_inverter_graph aig;
+            std::unordered_map<std::string, u32> literals = {{"A", aig.create_input("A")}, {"B", aig.create_input("B")}, {"C", aig.create_input("C")}};
+
+            bdd_manager mgr;
+            for (const auto& str : {"A & B | !C", "A ^ B ^ C", "!(A | B) & (C ^ A)", "A & !A", "1"})
+            {
+                auto function = boolean_function::from_string(str);
+                u32 literal   = aig.from_boolean_function(function, literals);
+                ASSERT_NE(literal, and_inverter_graph::INVALID);
+                EXPECT_TRUE(mgr.are_equivalent(aig.to_boolean_function(literal), function));
+            }
+
+            // equivalent functions with the same structure share their literal
+            EXPECT_EQ(aig.from_boolean_function(boolean_function::from_string("A & B"), literals), aig.from_boolean_function(boolean_function::from_string("B & A"), literals));
+        }
+        // NEGATIVE
+        {
+            // X and unmapped variables cannot be converted
+            and_inverter_graph aig;
+            std::unordered_map<std::string, u32> literals = {{"A", aig.create_input("A")}};
+            EXPECT_EQ(aig.from_boolean_function(boolean_function::from_string("A & X"), literals), and_inverter_graph::INVALID);
+            EXPECT_EQ(aig.from_boolean_function(boolean_function::from_string("A & B"), literals), and_inverter_graph::INVALID);
+            EXPECT_EQ(aig.from_boolean_function(boolean_function(), literals), and_inverter_graph::INVALID);
+            EXPECT_EQ(aig.to_boolean_function(and_inverter_graph::INVALID), boolean_function());
+        }
+    TEST_END
+}
+
+/**
+ * Testing the ingestion of a netlist
+ *
+ * Functions: add_netlist, add_gates, get_net_literal, get_input_nets, get_outputs
+ */
+TEST_F(and_inverter_graph_test, check_netlist){
+    TEST_START
+        {
+            // Combinational logic between inputs and a flip-flop, including redundant gates and constants
+            auto nl  = std::make_shared<netlist>(m_gl);
+            auto a   = add_input(nl, "a");
+            auto b   = add_input(nl, "b");
+            auto gnd = add_gate(nl, "GND", {})[0];
+            auto vcc = add_gate(nl, "VCC", {})[0];
+
+            auto and_0 = add_gate(nl, "AND2", {a, b})[0];
+            auto and_1 = add_gate(nl, "AND2", {b, a})[0];
+            auto buf   = add_gate(nl, "BUF", {and_1})[0];
+            auto or_0  = add_gate(nl, "OR2", {and_0, gnd})[0];
+            auto xor_0 = add_gate(nl, "XOR2", {or_0, buf})[0];
+            auto and_2 = add_gate(nl, "AND2", {xor_0, vcc})[0];
+
+            auto ff_gate = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff");
+            and_2->add_dst(ff_gate, "D");
+            auto q = nl->create_net("q");
+            q->set_src(ff_gate, "Q");
+            auto out = add_gate(nl, "INV", {q})[0];
+            out->mark_global_output_net();
+
+            and_inverter_graph aig;
+            ASSERT_TRUE(aig.add_netlist(nl));
+
+            // both ANDs and the buffer are merged, constants are propagated and a ^ a vanishes
+            EXPECT_EQ(aig.get_net_literal(and_0), aig.get_net_literal(and_1));
+            EXPECT_EQ(aig.get_net_literal(buf), aig.get_net_literal(and_0));
+            EXPECT_EQ(aig.get_net_literal(or_0), aig.get_net_literal(and_0));
+            EXPECT_EQ(aig.get_net_literal(and_2), and_inverter_graph::ZERO);
+            EXPECT_EQ(aig.get_net_literal(gnd), and_inverter_graph::ZERO);
+            EXPECT_EQ(aig.get_net_literal(vcc), and_inverter_graph::ONE);
+            EXPECT_EQ(aig.get_num_ands(), 1);
+
+            // the flip-flop output is an input, its output and the global output are outputs
+            EXPECT_EQ(aig.get_net_literal(out), and_inverter_graph::create_not(aig.get_net_literal(q)));
+            EXPECT_TRUE(aig.is_input(aig.get_net_literal(q)));
+            std::set<std::shared_ptr<net>> input_nets(aig.get_input_nets().begin(), aig.get_input_nets().end());
+            EXPECT_EQ(input_nets, std::set<std::shared_ptr<net>>({a, b, q}));
+            std::set<u32> outputs(aig.get_outputs().begin(), aig.get_outputs().end());
+            EXPECT_EQ(outputs, std::set<u32>({and_inverter_graph::ZERO, aig.get_net_literal(out)}));
+            EXPECT_EQ(aig.get_net_literal(nl->create_net("unknown")), and_inverter_graph::INVALID);
+        }
+        {
+            // Only the given gates are translated, the fan-in of the others is cut
+            auto nl    = std::make_shared<netlist>(m_gl);
+            auto a     = add_input(nl, "a");
+            auto b     = add_input(nl, "b");
+            auto and_0 = add_gate(nl, "AND2", {a, b})[0];
+            auto inv   = add_gate(nl, "INV", {and_0})[0];
+
+            and_inverter_graph aig;
+            ASSERT_TRUE(aig.add_gates({inv->get_src().get_gate()}));
+            EXPECT_EQ(aig.get_input_nets(), std::vector<std::shared_ptr<net>>({and_0}));
+            EXPECT_EQ(aig.get_net_literal(inv), and_inverter_graph::create_not(aig.get_net_literal(and_0)));
+        }
+        {
+            // Combinational loops and undefined functions are cut
+            auto nl    = std::make_shared<netlist>(m_gl);
+            auto a     = add_input(nl, "a");
+            auto x     = add_gate(nl, "XBUF", {a})[0];
+            auto and_0 = nl->create_net("loop");
+            auto and_1 = add_gate(nl, "AND2", {a, and_0})[0];
+            auto and_0_gate = nl->create_gate(m_gl->get_gate_types().at("AND2"), "loop_gate");
+            and_0->set_src(and_0_gate, "O");
+            and_1->add_dst(and_0_gate, "A");
+            x->add_dst(and_0_gate, "B");
+
+            and_inverter_graph aig;
+            NO_COUT_BLOCK;
+            ASSERT_TRUE(aig.add_netlist(nl));
+            EXPECT_TRUE(aig.is_input(aig.get_net_literal(x)));
+            EXPECT_NE(aig.get_net_literal(and_0), and_inverter_graph::INVALID);
+            EXPECT_NE(aig.get_net_literal(and_1), and_inverter_graph::INVALID);
+            EXPECT_EQ(aig.get_input_nets().size(), 3);
+        }
+        {
+            // A long chain is translated without recursion
+            auto nl    = std::make_shared<netlist>(m_gl);
+            auto a     = add_input(nl, "a");
+            auto chain = a;
+            for (u32 i = 0; i < 20000; ++i)
+            {
+                chain = add_gate(nl, "INV", {chain})[0];
+            }
+
+            and_inverter_graph aig;
+            ASSERT_TRUE(aig.add_netlist(nl));
+            EXPECT_EQ(aig.get_net_literal(chain), aig.get_net_literal(a));
+        }
+        // NEGATIVE
+        {
+            and_inverter_graph aig;
+            NO_COUT_BLOCK;
+            EXPECT_FALSE(aig.add_netlist(nullptr));
+            EXPECT_FALSE(aig.add_gates({nullptr}));
+        }
+    TEST_END
+}
+
+/**
+ * Testing the extraction of maximum fanout-free cones
+ *
+ * Functions: get_fanout_free_cone, get_fan_out_count, add_output
+ */
+TEST_F(and_inverter_graph_test, check_fanout_free_cone){
+    TEST_START
+        {
+            and_inverter_graph aig;
+            u32 a = aig.create_input("A");
+            u32 b = aig.create_input("B");
+            u32 c = aig.create_input("C");
+            u32 d = aig.create_input("D");
+
+            u32 ab   = aig.create_and(a, b);
+            u32 cd   = aig.create_and(c, d);
+            u32 abcd = aig.create_and(ab, cd);
+            u32 top  = aig.create_and(abcd, and_inverter_graph::create_not(ab));
+            aig.add_output(top);
+
+            // ab has two references, one from within the cone of abcd and one from outside
+            EXPECT_EQ(aig.get_fan_out_count(ab), 2);
+            EXPECT_EQ(aig.get_fanout_free_cone(abcd), std::vector<u32>({cd, abcd}));
+            EXPECT_EQ(aig.get_fanout_free_cone(top), std::vector<u32>({ab, cd, abcd, top}));
+
+            // an output references ab from outside, so it is no longer part of the cone of top
+            aig.add_output(and_inverter_graph::create_not(ab));
+            EXPECT_EQ(aig.get_fanout_free_cone(top), std::vector<u32>({cd, abcd, top}));
+        }
+        // NEGATIVE
+        {
+            and_inverter_graph aig;
+            u32 a = aig.create_input("A");
+            NO_COUT_BLOCK;
+            EXPECT_TRUE(aig.get_fanout_free_cone(a).empty());
+            EXPECT_TRUE(aig.get_fanout_free_cone(and_inverter_graph::INVALID).empty());
+        }
+    TEST_END
+}
@@ -0,0 +1,122 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/bdd_manager.h>
+#include <netlist/boolean_function.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class bdd_manager_test : public ::testing::Test
+{
+protected:
+
+    const boolean_function::value X = boolean_function::value::X;
+    const boolean_function::value ZERO = boolean_function::value::ZERO;
+    const boolean_function::value ONE = boolean_function::value::ONE;
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the basic operations and that equivalent functions are represented by the same node
+ *
+ * Functions: get_variable, ite, apply_not, apply_and, apply_or, apply_xor, from_boolean_function, are_equivalent
+ */
+TEST_F(bdd_manager_test, check_equivalence){
+    TEST_START
+        {
+            // Operations on variables
+            bdd_manager mgr({"A", "B"});
+            u32 a = mgr.get_variable("A");
+            u32 b = mgr.get_variable("B");
+            EXPECT_EQ(mgr.apply_and(a, mgr.apply_not(a)), bdd_manager::ZERO);
+            EXPECT_EQ(mgr.apply_or(a, mgr.apply_not(a)), bdd_manager::ONE);
+            EXPECT_EQ(mgr.apply_xor(a, b), mgr.apply_xor(b, a));
+            EXPECT_EQ(mgr.ite(a, b, bdd_manager::ZERO), mgr.apply_and(b, a));
+            EXPECT_EQ(mgr.apply_not(mgr.apply_not(b)), b);
+        }
+        {
+            // Equivalence of structurally different functions
+            bdd_manager mgr;
+            EXPECT_TRUE(mgr.are_equivalent(boolean_function::from_string("!(A & B)"), boolean_function::from_string("!A | !B")));
+            EXPECT_TRUE(mgr.are_equivalent(boolean_function::from_string("A ^ B ^ C"), boolean_function::from_string("(A & !B | !A & B) ^ C")));
+            EXPECT_TRUE(mgr.are_equivalent(boolean_function::from_string("A & (B | C)"), boolean_function::from_string("A & B | A & C")));
+            EXPECT_FALSE(mgr.are_equivalent(boolean_function::from_string("A & (B | C)"), boolean_function::from_string("A & B | C")));
+        }
+        {
+            // Equivalence of functions with many inputs, far beyond what a DNF can handle
+            bdd_manager mgr;
+            boolean_function parity_a(ZERO);
+            boolean_function parity_b(ZERO);
+            for (u32 i = 0; i < 48; ++i)
+            {
+                boolean_function v("V" + std::to_string(i));
+                parity_a = parity_a ^ v;
+                parity_b = (parity_b & !v) | ((!parity_b) & v);
+            }
+            EXPECT_TRUE(mgr.are_equivalent(parity_a, parity_b));
+            EXPECT_FALSE(mgr.are_equivalent(parity_a, !parity_b));
+            EXPECT_EQ(mgr.count_satisfying_assignments(mgr.from_boolean_function(parity_a)), std::ldexp(1.0, 47));
+        }
+        // NEGATIVE
+        {
+            // Functions with X or empty functions cannot be converted
+            NO_COUT_TEST_BLOCK;
+            bdd_manager mgr;
+            EXPECT_EQ(mgr.from_boolean_function(boolean_function::from_string("A & X")), bdd_manager::INVALID);
+            EXPECT_EQ(mgr.from_boolean_function(boolean_function()), bdd_manager::INVALID);
+            EXPECT_FALSE(mgr.are_equivalent(boolean_function(), boolean_function()));
+        }
+    TEST_END
+}
+
+/**
+ * Testing the canonical form, the variable order and counting of satisfying assignments
+ *
+ * Functions: get_canonical_form, to_boolean_function, get_variable_order, count_satisfying_assignments, get_isop
+ */
+TEST_F(bdd_manager_test, check_canonical_form){
+    TEST_START
+        {
+            // Canonical forms of equivalent functions are equal and equivalent to the input
+            bdd_manager mgr({"C", "B", "A"});
+            boolean_function f = boolean_function::from_string("(A | B) & !(A & B) & C");
+            boolean_function g = boolean_function::from_string("(A ^ B) & C | (A & B & C & 0)");
+            boolean_function cf = mgr.get_canonical_form(f);
+
+            EXPECT_EQ(cf, mgr.get_canonical_form(g));
+            EXPECT_EQ(cf.get_truth_table({"A", "B", "C"}), f.get_truth_table({"A", "B", "C"}));
+            EXPECT_EQ(mgr.get_variable_order(), std::vector<std::string>({"C", "B", "A"}));
+            EXPECT_EQ(mgr.get_canonical_form(boolean_function::from_string("A & !A")), boolean_function(ZERO));
+        }
+        {
+            // Counting satisfying assignments over all variables of the manager
+            bdd_manager mgr({"A", "B", "C", "D"});
+            EXPECT_EQ(mgr.count_satisfying_assignments(bdd_manager::ONE), 16.0);
+            EXPECT_EQ(mgr.count_satisfying_assignments(bdd_manager::ZERO), 0.0);
+            EXPECT_EQ(mgr.count_satisfying_assignments(mgr.from_boolean_function(boolean_function::from_string("A & D"))), 4.0);
+            EXPECT_EQ(mgr.count_satisfying_assignments(mgr.from_boolean_function(boolean_function::from_string("A | B | C | D"))), 15.0);
+            EXPECT_EQ(mgr.count_satisfying_assignments(mgr.from_boolean_function(boolean_function::from_string("B ^ C"))), 8.0);
+        }
+        {
+            // Irredundant sum of products
+            bdd_manager mgr({"A", "B", "C"});
+            auto cover = mgr.get_isop(mgr.from_boolean_function(boolean_function::from_string("A & B | A & !B & C | A & B & C")));
+            std::sort(cover.begin(), cover.end());
+            std::vector<std::vector<std::pair<std::string, bool>>> expected = {{{"A", true}, {"B", true}}, {{"A", true}, {"C", true}}};
+            EXPECT_EQ(cover, expected);
+            EXPECT_EQ(mgr.get_isop(bdd_manager::ONE).size(), (size_t)1);
+            EXPECT_TRUE(mgr.get_isop(bdd_manager::ZERO).empty());
+        }
+    TEST_END
+}
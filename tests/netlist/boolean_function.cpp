@@ -324,6 +324,25 @@ TEST_F(boolean_function_test, check_optimize){
             boolean_function bf = (a & !a) | (b & !b);
             EXPECT_EQ(bf.get_truth_table(std::vector<std::string>({"A","B"})), bf.optimize().get_truth_table(std::vector<std::string>({"A","B"})));
         }
+        {
+            // The result is an irredundant sum of products
+            boolean_function bf = (a & b) | (a & !b & c) | (a & b & c);
+            EXPECT_EQ(bf.optimize().get_dnf_clauses().size(), (size_t)2);
+            EXPECT_TRUE(((a & b) | (!a & b)).optimize() == b);
+            EXPECT_TRUE(((a & b) | (!a & !b) | (a & !b) | (!a & b)).optimize().is_constant_one());
+        }
+        {
+            // Functions with many variables are minimized as well
+            boolean_function bf(ZERO);
+            std::vector<std::string> vars;
+            for (u32 i = 0; i < 20; ++i)
+            {
+                vars.push_back("V" + std::to_string(i));
+                bf = bf | (boolean_function(vars.back()) & boolean_function("V0"));
+            }
+            bf = bf | (boolean_function("V0") & !boolean_function("V19"));
+            EXPECT_TRUE(bf.optimize() == boolean_function("V0"));
+        }
     TEST_END
 }
 
@@ -366,6 +385,45 @@ TEST_F(boolean_function_test, check_from_string){
             auto bf = boolean_function::from_string(f_str, {"X"});
             EXPECT_EQ(bf.get_variables(), std::set<std::string>({"A", "B", "C", "D"}));
         }
+        {
+            // Declared variables are matched at every occurrence, but not inside longer names
+            auto bf = boolean_function::from_string("D(1) & A1 | !D(1) & A", {"D(1)", "A"});
+            EXPECT_EQ(bf.get_variables(), std::set<std::string>({"A", "A1", "D(1)"}));
+            EXPECT_EQ(bf, (boolean_function("D(1)") & boolean_function("A1")) | (!boolean_function("D(1)") & boolean_function("A")));
+        }
+        {
+            // Operator precedence, implicit AND and negation
+            boolean_function a("A"), b("B"), c("C");
+            EXPECT_EQ(boolean_function::from_string("A | B ^ C & A"), a | (b ^ (c & a)));
+            EXPECT_EQ(boolean_function::from_string("A + B * C"), a | (b & c));
+            EXPECT_EQ(boolean_function::from_string("A B | C"), (a & b) | c);
+            EXPECT_EQ(boolean_function::from_string("(A | B)' C"), !(a | b) & c);
+            EXPECT_EQ(boolean_function::from_string("!A'"), a);
+            EXPECT_EQ(boolean_function::from_string("A & 1 & X"), a & boolean_function(ONE) & boolean_function(X));
+            EXPECT_EQ(boolean_function::from_string("  "), boolean_function());
+        }
+        {
+            // Printing and parsing are inverse
+            for (const auto& str : {"A & B", "!(A | B) ^ C", "(A & !B) | (!A & B) | 1", "A_1 & B(0) & X"})
+            {
+                auto bf = boolean_function::from_string(str);
+                EXPECT_EQ(boolean_function::from_string(bf.to_string()), bf);
+            }
+            EXPECT_EQ(boolean_function::from_string("A | (B & !C)").to_string(), "A | (B & !C)");
+            EXPECT_EQ(boolean_function::from_string("!(A & B)").to_string(), "!(A & B)");
+            EXPECT_EQ(boolean_function().to_string(), "<empty>");
+
+            // the buffer overload appends
+            std::string buffer = "f = ";
+            boolean_function::from_string("!(A & B)").to_string(buffer);
+            EXPECT_EQ(buffer, "f = !(A & B)");
+        }
+        // NEGATIVE
+        {
+            // Unbalanced brackets result in X
+            EXPECT_EQ(boolean_function::from_string("(A & B"), boolean_function(X));
+            EXPECT_EQ(boolean_function::from_string("A) & (B"), boolean_function(X));
+        }
 
     TEST_END
 }
@@ -536,3 +594,37 @@ TEST_F(boolean_function_test, check_get_dnf_clauses){
         }
     TEST_END
 }
+
+/**
+ * Testing that identical subfunctions are shared, so that repeated substitution stays linear in size.
+ *
+ * Functions: substitute, get_variables, operator==
+ */
+TEST_F(boolean_function_test, check_shared_subfunctions){
+    TEST_START
+        {
+            // Identical functions built independently are equal
+            EXPECT_EQ(boolean_function::from_string("A & (B | !C)"), boolean_function("A") & (boolean_function("B") | !boolean_function("C")));
+            EXPECT_NE(boolean_function::from_string("A & (B | !C)"), boolean_function::from_string("A & (B | C)"));
+            EXPECT_EQ(!!boolean_function::from_string("A ^ B"), boolean_function::from_string("A ^ B"));
+        }
+        {
+            // Every step references the previous function twice, a tree representation would double in size
+            auto compose = [](u32 steps) {
+                boolean_function f = boolean_function::from_string("V & !W");
+                for (u32 i = 0; i < steps; ++i)
+                {
+                    std::string w = "W" + std::to_string(i);
+                    f             = boolean_function::from_string("(V & " + w + ") | (V ^ " + w + ")").substitute("V", f);
+                }
+                return f;
+            };
+            boolean_function f = compose(64);
+
+            EXPECT_EQ(f.get_variables().size(), (size_t)66);
+            EXPECT_EQ(f, compose(64));
+            EXPECT_NE(f, compose(63));
+            EXPECT_EQ(f.substitute("V", "V"), f);
+        }
+    TEST_END
+}
@@ -0,0 +1,205 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/compiled_boolean_function.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class compiled_boolean_function_test : public ::testing::Test
+{
+protected:
+
+    const boolean_function::value X = boolean_function::value::X;
+    const boolean_function::value ZERO = boolean_function::value::ZERO;
+    const boolean_function::value ONE = boolean_function::value::ONE;
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // compares the compiled function against boolean_function::evaluate on all three-valued inputs
+    void expect_equal_evaluation(const boolean_function& bf, const std::vector<std::string>& vars)
+    {
+        compiled_boolean_function cbf(bf, vars);
+        std::vector<boolean_function::value> inputs(vars.size(), X);
+        u32 combinations = 1;
+        for (u32 i = 0; i < vars.size(); ++i)
+        {
+            combinations *= 3;
+        }
+        for (u32 c = 0; c < combinations; ++c)
+        {
+            std::map<std::string, boolean_function::value> input_map;
+            u32 tmp = c;
+            for (u32 i = 0; i < vars.size(); ++i)
+            {
+                inputs[i] = (boolean_function::value)((i32)(tmp % 3) - 1);
+                input_map[vars[i]] = inputs[i];
+                tmp /= 3;
+            }
+            EXPECT_EQ(cbf.evaluate(inputs), bf.evaluate(input_map)) << bf << " at input combination " << c;
+        }
+    }
+};
+
+/**
+ * Testing that the compiled function evaluates exactly like the boolean function, including X propagation
+ *
+ * Functions: constructor, evaluate
+ */
+TEST_F(compiled_boolean_function_test, check_evaluate){
+    TEST_START
+        {
+            // Some functions combining all operations and inversions
+            std::vector<std::string> vars = {"A", "B", "C", "D"};
+            expect_equal_evaluation(boolean_function::from_string("A & B | C ^ D"), vars);
+            expect_equal_evaluation(boolean_function::from_string("!(A & !B) | !(C ^ D)"), vars);
+            expect_equal_evaluation(boolean_function::from_string("(A | B | C) & !(B & C & D) ^ 1"), vars);
+            expect_equal_evaluation(boolean_function::from_string("A ^ B ^ X"), vars);
+            expect_equal_evaluation(!boolean_function(ZERO) & boolean_function("A"), vars);
+        }
+        {
+            // Variables without a slot evaluate to X
+            boolean_function bf = boolean_function::from_string("A & B");
+            compiled_boolean_function cbf(bf, {"A"});
+            EXPECT_EQ(cbf.get_num_slots(), (u32)1);
+            EXPECT_EQ(cbf.get_slot("A"), 0);
+            EXPECT_EQ(cbf.get_slot("B"), -1);
+            EXPECT_EQ(cbf.evaluate({ONE}), X);
+            EXPECT_EQ(cbf.evaluate({ZERO}), ZERO);
+        }
+        {
+            // Slots are ordered alphabetically by default
+            compiled_boolean_function cbf(boolean_function::from_string("C & !A"));
+            EXPECT_EQ(cbf.get_variables(), std::vector<std::string>({"A", "C"}));
+            boolean_function::value inputs[] = {ZERO, ONE};
+            EXPECT_EQ(cbf(inputs), ONE);
+        }
+        {
+            // Empty functions evaluate to X
+            EXPECT_EQ(compiled_boolean_function().evaluate(std::vector<boolean_function::value>()), X);
+            EXPECT_EQ(compiled_boolean_function(boolean_function()).evaluate(std::vector<boolean_function::value>()), X);
+        }
+        {
+            // Deep functions exceed the inline stack
+            boolean_function bf("V0");
+            std::vector<std::string> vars = {"V0"};
+            for (u32 i = 1; i < 100; ++i)
+            {
+                vars.push_back("V" + std::to_string(i));
+                bf = boolean_function(vars.back()) ^ bf;
+            }
+            compiled_boolean_function cbf(bf, vars);
+            std::vector<boolean_function::value> inputs(vars.size(), ZERO);
+            EXPECT_EQ(cbf.evaluate(inputs), ZERO);
+            inputs[42] = ONE;
+            EXPECT_EQ(cbf.evaluate(inputs), ONE);
+        }
+    TEST_END
+}
+
+/**
+ * Testing the truth table of the compiled function
+ *
+ * Functions: get_truth_table
+ */
+TEST_F(compiled_boolean_function_test, check_get_truth_table){
+    TEST_START
+        boolean_function r = ((boolean_function("A") & boolean_function("B")) | boolean_function("C")) ^ boolean_function(ONE);
+        compiled_boolean_function cbf(r, {"C", "B", "A"});
+        EXPECT_EQ(cbf.get_truth_table(), std::vector<boolean_function::value>({ONE, ZERO, ONE, ZERO, ONE, ZERO, ZERO, ZERO}));
+        EXPECT_EQ(cbf.get_truth_table(), r.get_truth_table({"C", "B", "A"}));
+
+        // unknown variables that are removed do not show up in the table
+        EXPECT_EQ(boolean_function("A").get_truth_table({"B"}, true), std::vector<boolean_function::value>({X}));
+    TEST_END
+}
+
+/**
+ * Testing the bit-sliced evaluation against the scalar evaluation, including X propagation
+ *
+ * Functions: evaluate, get_packed_truth_table
+ */
+TEST_F(compiled_boolean_function_test, check_bit_sliced_evaluation){
+    TEST_START
+        {
+            // All 81 three-valued input combinations of four variables in two slices
+            boolean_function bf = boolean_function::from_string("!(A & !B) | (C ^ D) & A");
+            compiled_boolean_function cbf(bf, {"A", "B", "C", "D"});
+            std::vector<compiled_boolean_function::value_slice> slices(2 * 4, {0, 0});
+            std::vector<std::vector<boolean_function::value>> patterns;
+            for (u32 c = 0; c < 81; ++c)
+            {
+                std::vector<boolean_function::value> inputs;
+                u32 tmp = c;
+                for (u32 i = 0; i < 4; ++i)
+                {
+                    auto v = (boolean_function::value)((i32)(tmp % 3) - 1);
+                    inputs.push_back(v);
+                    tmp /= 3;
+                    u64 bit = (u64)1 << (c % 64);
+                    if (v == ONE)
+                    {
+                        slices[(c / 64) * 4 + i].ones |= bit;
+                    }
+                    else if (v == ZERO)
+                    {
+                        slices[(c / 64) * 4 + i].zeros |= bit;
+                    }
+                }
+                patterns.push_back(inputs);
+            }
+            for (u32 s = 0; s < 2; ++s)
+            {
+                auto result = cbf.evaluate(&slices[s * 4]);
+                EXPECT_EQ(result.ones & result.zeros, (u64)0);
+                for (u32 c = s * 64; c < std::min(81u, (s + 1) * 64); ++c)
+                {
+                    u64 bit                    = (u64)1 << (c % 64);
+                    boolean_function::value v = (result.ones & bit) ? ONE : ((result.zeros & bit) ? ZERO : X);
+                    EXPECT_EQ(v, cbf.evaluate(patterns[c])) << "pattern " << c;
+                }
+            }
+        }
+        {
+            // Packed truth tables of small and large functions match the scalar evaluation
+            for (u32 num_vars : {0, 3, 6, 9})
+            {
+                boolean_function bf(ONE);
+                std::vector<std::string> vars;
+                for (u32 i = 0; i < num_vars; ++i)
+                {
+                    vars.push_back("V" + std::to_string(i));
+                    bf = (i % 2 == 0) ? (bf ^ boolean_function(vars.back())) : (bf | !boolean_function(vars.back()));
+                }
+                bf = bf & boolean_function("UNKNOWN");
+                compiled_boolean_function cbf(bf, vars);
+                packed_truth_table table = cbf.get_packed_truth_table();
+
+                EXPECT_EQ(table.num_variables, num_vars);
+                EXPECT_EQ(table.size(), (u64)1 << num_vars);
+                EXPECT_EQ(table.ones.size(), std::max((size_t)1, (size_t)(table.size() / 64)));
+                for (u64 row = 0; row < table.size(); ++row)
+                {
+                    std::vector<boolean_function::value> inputs;
+                    for (u32 i = 0; i < num_vars; ++i)
+                    {
+                        inputs.push_back((row >> i) & 1 ? ONE : ZERO);
+                    }
+                    EXPECT_EQ(table.get(row), cbf.evaluate(inputs));
+                }
+                if (num_vars > 0)
+                {
+                    EXPECT_EQ(table.unpack(), bf.get_truth_table(vars));
+                }
+            }
+        }
+    TEST_END
+}
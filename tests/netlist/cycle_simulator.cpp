@@ -0,0 +1,355 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <netlist/simulation/cycle_simulator.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class cycle_simulator_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    const boolean_function::value X    = boolean_function::X;
+    const boolean_function::value ZERO = boolean_function::ZERO;
+    const boolean_function::value ONE  = boolean_function::ONE;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("CYCLE_SIMULATOR_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "OR2", {"A", "B"}, "A | B");
+        add_combinational_type(m_gl, "XOR2", {"A", "B"}, "A ^ B");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+
+        auto dff = add_flip_flop_type(m_gl, "DFF");
+        dff->set_init_data_category("generic");
+        dff->set_init_data_identifier("INIT");
+
+        auto dffsr = add_flip_flop_type(m_gl, "DFFSR", true, true);
+        dffsr->set_set_reset_behavior(gate_type_sequential::set_reset_behavior::L, gate_type_sequential::set_reset_behavior::H);
+
+        auto dffsr_t = add_flip_flop_type(m_gl, "DFFSR_T", true, true);
+        dffsr_t->set_set_reset_behavior(gate_type_sequential::set_reset_behavior::T, gate_type_sequential::set_reset_behavior::T);
+
+        add_latch_type(m_gl, "LATCH");
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the evaluation of combinational logic with three-valued inputs
+ *
+ * Functions: set_input, get_value, simulate
+ */
+TEST_F(cycle_simulator_test, check_combinational_logic)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto b   = add_input(nl, "b");
+        auto c   = add_input(nl, "c");
+        auto ab  = add_gate(nl, "AND2", {a, b})[0];
+        auto out = add_gate(nl, "XOR2", {ab, c})[0];
+
+        cycle_simulator sim(nl);
+        EXPECT_EQ(sim.get_value(out), X);
+
+        EXPECT_TRUE(sim.set_input(a, ZERO));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(ab), ZERO);
+        EXPECT_EQ(sim.get_value(out), X);
+
+        EXPECT_TRUE(sim.set_input(c, ONE));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(out), ONE);
+
+        EXPECT_TRUE(sim.set_input(a, ONE));
+        EXPECT_TRUE(sim.set_input(b, ONE));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(out), ZERO);
+        EXPECT_EQ(sim.get_cycle(), 3);
+
+        // only inputs can be set
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(sim.set_input(out, ONE));
+        EXPECT_FALSE(sim.set_input(nullptr, ONE));
+        EXPECT_EQ(sim.get_value(nullptr), X);
+    }
+    TEST_END
+}
+
+/**
+ * Testing flip-flops capturing on rising clock edges
+ *
+ * Functions: add_clock_net, simulate, run, reset
+ */
+TEST_F(cycle_simulator_test, check_flip_flops)
+{
+    TEST_START
+    {
+        // shift register of three flip-flops
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto d   = add_input(nl, "d");
+        auto q0  = add_gate(nl, "DFF", {d, clk});
+        auto q1  = add_gate(nl, "DFF", {q0[0], clk});
+        auto q2  = add_gate(nl, "DFF", {q1[0], clk});
+
+        cycle_simulator sim(nl);
+        EXPECT_TRUE(sim.add_clock_net(clk));
+        EXPECT_EQ(sim.get_clock_nets(), std::vector<std::shared_ptr<net>>({clk}));
+        EXPECT_EQ(sim.get_value(clk), ZERO);
+        EXPECT_EQ(sim.get_value(q0[0]), X);
+
+        auto trace = sim.run({d}, {{ONE}, {ZERO}, {ONE}, {ONE}}, {q0[0], q1[0], q2[0], q2[1]});
+        ASSERT_EQ(trace.size(), 4);
+        EXPECT_EQ(trace[0], std::vector<boolean_function::value>({ONE, X, X, X}));
+        EXPECT_EQ(trace[1], std::vector<boolean_function::value>({ZERO, ONE, X, X}));
+        EXPECT_EQ(trace[2], std::vector<boolean_function::value>({ONE, ZERO, ONE, ZERO}));
+        EXPECT_EQ(trace[3], std::vector<boolean_function::value>({ONE, ONE, ZERO, ONE}));
+        EXPECT_EQ(sim.get_cycle(), 4);
+
+        sim.reset();
+        EXPECT_EQ(sim.get_cycle(), 0);
+        EXPECT_EQ(sim.get_value(q0[0]), X);
+        EXPECT_EQ(sim.get_value(d), X);
+        EXPECT_EQ(sim.get_value(clk), ZERO);
+    }
+    {
+        // an uncertain clock edge makes states X unless they do not change
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto d   = add_input(nl, "d");
+        auto q0  = add_gate(nl, "DFF", {d, clk})[0];
+        auto q1  = add_gate(nl, "DFF", {q0, clk})[0];
+
+        // without registered clocks the clock is an ordinary input
+        cycle_simulator sim(nl);
+        sim.set_input(d, ONE);
+        for (auto v : {ZERO, ONE, ZERO, ONE})
+        {
+            sim.set_input(clk, v);
+            sim.simulate();
+        }
+        EXPECT_EQ(sim.get_value(q0), ONE);
+        EXPECT_EQ(sim.get_value(q1), ONE);
+
+        sim.set_input(d, ZERO);
+        sim.set_input(clk, ZERO);
+        sim.simulate();
+        sim.set_input(clk, X);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q0), X);
+        EXPECT_EQ(sim.get_value(q1), ONE);
+    }
+    {
+        // two bit counter starting from its init values, the second bit is clocked by the first one
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto ff0 = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff0");
+        auto ff1 = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff1");
+        auto q0  = nl->create_net("q0");
+        auto qn0 = nl->create_net("qn0");
+        auto q1  = nl->create_net("q1");
+        auto qn1 = nl->create_net("qn1");
+        q0->set_src(ff0, "Q");
+        qn0->set_src(ff0, "QN");
+        q1->set_src(ff1, "Q");
+        qn1->set_src(ff1, "QN");
+        clk->add_dst(ff0, "CLK");
+        qn0->add_dst(ff0, "D");
+        qn0->add_dst(ff1, "CLK");
+        qn1->add_dst(ff1, "D");
+        ff0->set_data("generic", "INIT", "bit_vector", "0");
+        ff1->set_data("generic", "INIT", "bit_vector", "0");
+
+        cycle_simulator sim(nl);
+        EXPECT_EQ(sim.get_value(q0), ZERO);
+        EXPECT_EQ(sim.get_value(qn0), ONE);
+        sim.add_clock_net(clk);
+
+        std::vector<std::pair<boolean_function::value, boolean_function::value>> expected = {{ONE, ZERO}, {ZERO, ONE}, {ONE, ONE}, {ZERO, ZERO}, {ONE, ZERO}};
+        for (const auto& [v0, v1] : expected)
+        {
+            sim.simulate();
+            EXPECT_EQ(sim.get_value(q0), v0);
+            EXPECT_EQ(sim.get_value(q1), v1);
+        }
+
+        sim.simulate(1000);
+        EXPECT_EQ(sim.get_value(q0), ONE);
+        EXPECT_EQ(sim.get_value(q1), ZERO);
+        EXPECT_EQ(sim.get_cycle(), 1005);
+    }
+    {
+        // invalid arguments
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto q   = add_gate(nl, "DFF", {clk, clk});
+
+        cycle_simulator sim(nl);
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(sim.add_clock_net(q[0]));
+        EXPECT_TRUE(sim.run({q[0]}, {{ONE}}, {}).empty());
+        EXPECT_TRUE(sim.run({clk}, {{ONE, ONE}}, {q[0]}).empty());
+        EXPECT_EQ(sim.get_cycle(), 0);
+    }
+    TEST_END
+}
+
+/**
+ * Testing asynchronous set and reset
+ *
+ * Functions: simulate
+ */
+TEST_F(cycle_simulator_test, check_set_reset)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto d   = add_input(nl, "d");
+        auto s   = add_input(nl, "s");
+        auto r   = add_input(nl, "r");
+        auto q   = add_gate(nl, "DFFSR", {d, clk, s, r})[0];
+
+        cycle_simulator sim(nl);
+        sim.add_clock_net(clk);
+        auto trace = sim.run({d, s, r},
+                             {
+                                 {ZERO, ZERO, ONE},    // reset
+                                 {ONE, ZERO, ZERO},    // capture
+                                 {ZERO, ONE, ZERO},    // set overrides the clock
+                                 {ZERO, ONE, ONE},     // both active, behavior L
+                                 {ONE, ZERO, X},       // uncertain reset
+                                 {ONE, ZERO, ZERO},    // capture
+                                 {ONE, X, ZERO},       // uncertain set that does not change the state
+                             },
+                             {q});
+        ASSERT_EQ(trace.size(), 7);
+        std::vector<boolean_function::value> expected = {ZERO, ONE, ONE, ZERO, X, ONE, ONE};
+        for (u32 i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_EQ(trace[i][0], expected[i]) << "cycle " << i;
+        }
+    }
+    {
+        // set and reset active together toggle the state once, it is kept while both stay active
+        auto nl      = std::make_shared<netlist>(m_gl);
+        auto clk     = add_input(nl, "clk");
+        auto d       = add_input(nl, "d");
+        auto s       = add_input(nl, "s");
+        auto r       = add_input(nl, "r");
+        auto outputs = add_gate(nl, "DFFSR_T", {d, clk, s, r});
+
+        cycle_simulator sim(nl);
+        sim.add_clock_net(clk);
+        auto trace = sim.run({d, s, r},
+                             {
+                                 {ZERO, ONE, ONE},      // toggling the uninitialized state
+                                 {ZERO, ZERO, ONE},     // reset
+                                 {ONE, ZERO, ZERO},     // capture
+                                 {ONE, ONE, ONE},       // toggle, the clock is ignored
+                                 {ONE, ONE, ONE},       // still active
+                                 {ZERO, ZERO, ZERO},    // capture
+                                 {ZERO, ONE, ONE},      // toggle
+                             },
+                             outputs);
+        ASSERT_EQ(trace.size(), 7);
+        std::vector<boolean_function::value> expected = {X, ZERO, ONE, ZERO, ZERO, ZERO, ONE};
+        for (u32 i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_EQ(trace[i][0], expected[i]) << "cycle " << i;
+            EXPECT_EQ(trace[i][1], simulation_model::invert(expected[i])) << "cycle " << i;
+        }
+    }
+    TEST_END
+}
+
+/**
+ * Testing transparent latches
+ *
+ * Functions: set_input, simulate
+ */
+TEST_F(cycle_simulator_test, check_latches)
+{
+    TEST_START
+    {
+        // latch enabled by the inverted clock followed by a flip-flop forms a master-slave flip-flop
+        auto nl    = std::make_shared<netlist>(m_gl);
+        auto clk   = add_input(nl, "clk");
+        auto en    = add_input(nl, "en");
+        auto d     = add_input(nl, "d");
+        auto q     = add_gate(nl, "LATCH", {d, en})[0];
+        auto clk_n = add_gate(nl, "INV", {clk})[0];
+        auto m     = add_gate(nl, "LATCH", {d, clk_n})[0];
+        auto s     = add_gate(nl, "DFF", {m, clk})[0];
+
+        cycle_simulator sim(nl);
+        sim.add_clock_net(clk);
+
+        sim.set_input(en, ONE);
+        sim.set_input(d, ONE);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), ONE);
+        EXPECT_EQ(sim.get_value(m), ONE);
+        EXPECT_EQ(sim.get_value(s), ONE);
+
+        sim.set_input(en, ZERO);
+        sim.set_input(d, ZERO);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), ONE);
+        EXPECT_EQ(sim.get_value(s), ZERO);
+
+        // an X enable only keeps states that would not change
+        sim.set_input(en, X);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), X);
+        sim.set_input(en, ONE);
+        sim.simulate();
+        sim.set_input(en, X);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), ZERO);
+    }
+    {
+        // an oscillating loop through an enabled latch settles to X
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto en  = add_input(nl, "en");
+        auto a   = add_input(nl, "a");
+        auto g   = nl->create_gate(m_gl->get_gate_types().at("LATCH"), "latch");
+        auto q   = nl->create_net("q");
+        q->set_src(g, "Q");
+        en->add_dst(g, "EN");
+        auto q_n = add_gate(nl, "INV", {q})[0];
+        auto d   = add_gate(nl, "AND2", {q_n, a})[0];
+        d->add_dst(g, "D");
+
+        cycle_simulator sim(nl);
+        sim.set_input(en, ONE);
+        sim.set_input(a, ZERO);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), ZERO);
+        EXPECT_EQ(sim.get_value(q_n), ONE);
+
+        sim.set_input(a, ONE);
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(q), X);
+        EXPECT_EQ(sim.get_value(q_n), X);
+    }
+    TEST_END
+}
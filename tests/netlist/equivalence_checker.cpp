@@ -0,0 +1,189 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/equivalence_checker.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class equivalence_checker_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("EQUIVALENCE_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "OR2", {"A", "B"}, "A | B");
+        add_combinational_type(m_gl, "XOR2", {"A", "B"}, "A ^ B");
+        add_combinational_type(m_gl, "XNOR2", {"A", "B"}, "!(A ^ B)");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+        add_combinational_type(m_gl, "MUX", {"S", "A", "B"}, "(S & B) | (!S & A)");
+
+        add_flip_flop_type(m_gl, "DFF");
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the equivalence of nets
+ *
+ * Functions: are_equivalent, get_num_sat_calls
+ */
+TEST_F(equivalence_checker_test, check_are_equivalent){
+    TEST_START
+        {
+            // Parity trees of different shape and a MUX against its AND/OR implementation
+            auto nl = std::make_shared<netlist>(m_gl);
+            std::vector<std::shared_ptr<net>> inputs;
+            for (u32 i = 0; i < 8; ++i)
+            {
+                inputs.push_back(add_input(nl, "in_" + std::to_string(i)));
+            }
+
+            auto chain = inputs[0];
+            for (u32 i = 1; i < inputs.size(); ++i)
+            {
+                chain = add_gate(nl, "XOR2", {chain, inputs[i]})[0];
+            }
+            std::vector<std::shared_ptr<net>> level = inputs;
+            while (level.size() > 1)
+            {
+                std::vector<std::shared_ptr<net>> next_level;
+                for (u32 i = 0; i < level.size(); i += 2)
+                {
+                    next_level.push_back(add_gate(nl, "XOR2", {level[i], level[i + 1]})[0]);
+                }
+                level = next_level;
+            }
+            auto tree = level[0];
+
+            // XNOR of the inverted chain is the same parity again
+            auto inverted = add_gate(nl, "XNOR2", {add_gate(nl, "INV", {chain})[0], inputs[0]})[0];
+            auto almost   = add_gate(nl, "XOR2", {tree, inputs[0]})[0];
+
+            auto mux     = add_gate(nl, "MUX", {inputs[0], inputs[1], inputs[2]})[0];
+            auto and_or  = add_gate(nl, "OR2", {add_gate(nl, "AND2", {inputs[0], inputs[2]})[0], add_gate(nl, "AND2", {add_gate(nl, "INV", {inputs[0]})[0], inputs[1]})[0]})[0];
+            auto and_or2 = add_gate(nl, "OR2", {add_gate(nl, "AND2", {inputs[0], inputs[1]})[0], add_gate(nl, "AND2", {add_gate(nl, "INV", {inputs[0]})[0], inputs[2]})[0]})[0];
+
+            equivalence_checker checker(nl);
+            EXPECT_TRUE(checker.are_equivalent(chain, chain));
+            EXPECT_TRUE(checker.are_equivalent(chain, tree));
+            EXPECT_TRUE(checker.are_equivalent(tree, chain));
+            EXPECT_TRUE(checker.are_equivalent(mux, and_or));
+            EXPECT_FALSE(checker.are_equivalent(mux, and_or2));
+            EXPECT_FALSE(checker.are_equivalent(chain, inverted));
+            EXPECT_TRUE(checker.are_equivalent(inverted, almost));
+            EXPECT_FALSE(checker.are_equivalent(almost, tree));
+            EXPECT_GT(checker.get_num_sat_calls(), 0);
+        }
+        {
+            // Nets behind flip-flops are compared as functions of the flip-flop outputs
+            auto nl = std::make_shared<netlist>(m_gl);
+            auto a  = add_input(nl, "a");
+            auto ff = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff");
+            a->add_dst(ff, "D");
+            auto q = nl->create_net("q");
+            q->set_src(ff, "Q");
+
+            auto inv_q      = add_gate(nl, "INV", {q})[0];
+            auto inv_a      = add_gate(nl, "INV", {a})[0];
+            auto double_inv = add_gate(nl, "INV", {inv_q})[0];
+
+            equivalence_checker checker(nl);
+            EXPECT_TRUE(checker.are_equivalent(double_inv, q));
+            EXPECT_FALSE(checker.are_equivalent(inv_q, inv_a));
+        }
+        // NEGATIVE
+        {
+            // Nets of other netlists cannot be compared
+            auto nl    = std::make_shared<netlist>(m_gl);
+            auto a     = add_input(nl, "a");
+            auto other = std::make_shared<netlist>(m_gl);
+            auto b     = add_input(other, "b");
+
+            equivalence_checker checker(nl);
+            EXPECT_FALSE(checker.are_equivalent(a, b));
+            EXPECT_FALSE(checker.are_equivalent(a, nullptr));
+        }
+    TEST_END
+}
+
+/**
+ * Testing the detection of constant nets
+ *
+ * Functions: get_constant_value, find_constant_nets
+ */
+TEST_F(equivalence_checker_test, check_constant_nets){
+    TEST_START
+        {
+            auto nl = std::make_shared<netlist>(m_gl);
+            auto a  = add_input(nl, "a");
+            auto b  = add_input(nl, "b");
+            auto c  = add_input(nl, "c");
+
+            // (a & b) & !(a | b) is always zero, its inversion always one
+            auto zero = add_gate(nl, "AND2", {add_gate(nl, "AND2", {a, b})[0], add_gate(nl, "INV", {add_gate(nl, "OR2", {a, b})[0]})[0]})[0];
+            auto one  = add_gate(nl, "INV", {zero})[0];
+
+            // (a ^ b) ^ (b ^ a) is always zero
+            auto xor_zero = add_gate(nl, "XOR2", {add_gate(nl, "XOR2", {a, b})[0], add_gate(nl, "XOR2", {b, a})[0]})[0];
+
+            // a & b & c is one for a single input pattern only
+            auto rare = add_gate(nl, "AND2", {add_gate(nl, "AND2", {a, b})[0], c})[0];
+
+            equivalence_checker checker(nl);
+            EXPECT_EQ(checker.get_constant_value(zero), boolean_function::ZERO);
+            EXPECT_EQ(checker.get_constant_value(one), boolean_function::ONE);
+            EXPECT_EQ(checker.get_constant_value(xor_zero), boolean_function::ZERO);
+            EXPECT_EQ(checker.get_constant_value(rare), boolean_function::X);
+            EXPECT_EQ(checker.get_constant_value(a), boolean_function::X);
+
+            std::map<std::shared_ptr<net>, boolean_function::value> expected = {{zero, boolean_function::ZERO}, {one, boolean_function::ONE}, {xor_zero, boolean_function::ZERO}};
+            EXPECT_EQ(checker.find_constant_nets(), expected);
+        }
+        {
+            // With a single random pattern, counterexamples of the solver refine the simulation
+            auto nl = std::make_shared<netlist>(m_gl);
+            std::vector<std::shared_ptr<net>> inputs;
+            for (u32 i = 0; i < 12; ++i)
+            {
+                inputs.push_back(add_input(nl, "in_" + std::to_string(i)));
+            }
+            auto conjunction = inputs[0];
+            for (u32 i = 1; i < inputs.size(); ++i)
+            {
+                conjunction = add_gate(nl, "AND2", {conjunction, inputs[i]})[0];
+            }
+
+            equivalence_checker checker(nl, 1);
+            EXPECT_EQ(checker.get_constant_value(conjunction), boolean_function::X);
+            u32 num_sat_calls = checker.get_num_sat_calls();
+            EXPECT_EQ(checker.get_constant_value(conjunction), boolean_function::X);
+            EXPECT_EQ(checker.get_num_sat_calls(), num_sat_calls);
+        }
+        // NEGATIVE
+        {
+            auto nl    = std::make_shared<netlist>(m_gl);
+            auto other = std::make_shared<netlist>(m_gl);
+            auto b     = add_input(other, "b");
+
+            equivalence_checker checker(nl);
+            EXPECT_EQ(checker.get_constant_value(b), boolean_function::X);
+            EXPECT_TRUE(checker.find_constant_nets().empty());
+        }
+    TEST_END
+}
@@ -0,0 +1,260 @@
+#include "netlist/event_system/event_controls.h"
+#include "netlist/gate_library/gate_library_manager.h"
+#include "netlist/netlist.h"
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <core/log.h>
+#include <netlist/gate.h>
+#include <netlist/module.h>
+#include <netlist/net.h>
+#include <stdexcept>
+
+using namespace test_utils;
+
+class event_controls_test : public ::testing::Test
+{
+protected:
+    std::vector<std::tuple<gate_event_handler::event, std::shared_ptr<gate>, u32>> m_gate_events;
+    std::vector<std::tuple<net_event_handler::event, std::shared_ptr<net>, u32>> m_net_events;
+    std::vector<std::tuple<module_event_handler::event, std::shared_ptr<module>, u32>> m_module_events;
+    std::vector<event_controls::change_set> m_change_sets;
+
+    virtual void SetUp()
+    {
+        NO_COUT_BLOCK;
+        gate_library_manager::load_all();
+
+        gate_event_handler::register_callback("event_controls_test",
+                                              [this](gate_event_handler::event e, std::shared_ptr<gate> g, u32 data) { m_gate_events.emplace_back(e, g, data); });
+        net_event_handler::register_callback("event_controls_test", [this](net_event_handler::event e, std::shared_ptr<net> n, u32 data) { m_net_events.emplace_back(e, n, data); });
+        module_event_handler::register_callback("event_controls_test",
+                                                [this](module_event_handler::event e, std::shared_ptr<module> m, u32 data) { m_module_events.emplace_back(e, m, data); });
+        event_controls::register_batch_callback("event_controls_test", [this](const event_controls::change_set& changes) { m_change_sets.push_back(changes); });
+    }
+
+    virtual void TearDown()
+    {
+        gate_event_handler::unregister_callback("event_controls_test");
+        net_event_handler::unregister_callback("event_controls_test");
+        module_event_handler::unregister_callback("event_controls_test");
+        event_controls::unregister_batch_callback("event_controls_test");
+    }
+
+    void clear_events()
+    {
+        m_gate_events.clear();
+        m_net_events.clear();
+        m_module_events.clear();
+        m_change_sets.clear();
+    }
+};
+
+/**
+ * Testing that events are recorded during a batch and dispatched on commit, followed by a single change set
+ *
+ * Functions: begin_batch, commit_batch, is_batch_active, register_batch_callback
+ */
+TEST_F(event_controls_test, check_batch_dispatch){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        clear_events();
+
+        nl->begin_batch();
+        EXPECT_TRUE(event_controls::is_batch_active(nl));
+        std::shared_ptr<module> m = nl->create_module(MIN_MODULE_ID+0, "m", nl->get_top_module());
+        for (u32 i = 0; i < 5; ++i)
+        {
+            m->assign_gate(nl->get_gate_by_id(MIN_GATE_ID+i));
+        }
+        EXPECT_TRUE(m_module_events.empty());
+        EXPECT_TRUE(m_change_sets.empty());
+
+        EXPECT_TRUE(nl->commit_batch());
+        EXPECT_FALSE(event_controls::is_batch_active(nl));
+
+        // created + submodule_added + 5 * (gate_removed + gate_assigned)
+        EXPECT_EQ(m_module_events.size(), (size_t)12);
+        EXPECT_EQ(std::get<0>(m_module_events[0]), module_event_handler::event::created);
+        EXPECT_EQ(std::get<1>(m_module_events[0]), m);
+
+        ASSERT_EQ(m_change_sets.size(), (size_t)1);
+        EXPECT_EQ(m_change_sets[0].created_modules, std::set<std::shared_ptr<module>>({m}));
+        EXPECT_EQ(m_change_sets[0].modified_modules, std::set<std::shared_ptr<module>>({nl->get_top_module()}));
+        EXPECT_TRUE(m_change_sets[0].created_gates.empty());
+
+        // events are dispatched immediately again
+        clear_events();
+        m->set_name("m_new");
+        EXPECT_EQ(m_module_events.size(), (size_t)1);
+        EXPECT_TRUE(m_change_sets.empty());
+
+        // committing without a batch fails
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(nl->commit_batch());
+    TEST_END
+}
+
+/**
+ * Testing that nested batches are only dispatched when the outermost batch is committed
+ *
+ * Functions: begin_batch, commit_batch
+ */
+TEST_F(event_controls_test, check_nested_batches){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        clear_events();
+
+        nl->begin_batch();
+        nl->begin_batch();
+        nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("new_name");
+        EXPECT_TRUE(nl->commit_batch());
+        EXPECT_TRUE(m_gate_events.empty());
+        EXPECT_TRUE(m_change_sets.empty());
+        EXPECT_TRUE(nl->commit_batch());
+        EXPECT_EQ(m_gate_events.size(), (size_t)1);
+        EXPECT_EQ(m_change_sets.size(), (size_t)1);
+    TEST_END
+}
+
+/**
+ * Testing the coalescing of recorded events
+ *
+ * Functions: commit_batch
+ */
+TEST_F(event_controls_test, check_coalescing){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<gate> gate_0 = nl->get_gate_by_id(MIN_GATE_ID+0);
+        std::shared_ptr<gate> gate_5 = nl->get_gate_by_id(MIN_GATE_ID+5);
+        std::shared_ptr<net> net_0_4_5 = nl->get_net_by_id(MIN_NET_ID+045);
+        std::shared_ptr<net> net_7_8 = nl->get_net_by_id(MIN_NET_ID+78);
+        {
+            // objects created and removed within the batch vanish completely
+            clear_events();
+            nl->begin_batch();
+            auto tmp_gate = nl->create_gate(MIN_GATE_ID+100, get_gate_type_by_name("INV"), "tmp");
+            auto tmp_net = nl->create_net(MIN_NET_ID+100, "tmp");
+            tmp_net->add_dst(tmp_gate, "I");
+            tmp_gate->set_name("tmp_new");
+            nl->delete_net(tmp_net);
+            nl->delete_gate(tmp_gate);
+            nl->commit_batch();
+
+            EXPECT_TRUE(m_gate_events.empty());
+            EXPECT_TRUE(m_net_events.empty());
+            EXPECT_TRUE(m_module_events.empty());
+            ASSERT_EQ(m_change_sets.size(), (size_t)1);
+            EXPECT_TRUE(m_change_sets[0].created_gates.empty());
+            EXPECT_TRUE(m_change_sets[0].removed_gates.empty());
+        }
+        {
+            // only the last of repeated state changes is dispatched
+            clear_events();
+            nl->begin_batch();
+            gate_0->set_name("name_a");
+            gate_0->set_name("name_b");
+            gate_0->set_name("name_c");
+            nl->commit_batch();
+
+            ASSERT_EQ(m_gate_events.size(), (size_t)1);
+            EXPECT_EQ(std::get<0>(m_gate_events[0]), gate_event_handler::event::name_changed);
+            EXPECT_EQ(m_change_sets[0].modified_gates, std::set<std::shared_ptr<gate>>({gate_0}));
+        }
+        {
+            // an addition that is removed again cancels out
+            clear_events();
+            nl->begin_batch();
+            net_7_8->add_dst(gate_5, "I1");
+            net_7_8->remove_dst(gate_5, "I1");
+            nl->commit_batch();
+
+            EXPECT_TRUE(m_net_events.empty());
+            EXPECT_TRUE(m_change_sets[0].modified_nets.empty());
+        }
+        {
+            // a removal followed by an addition is kept, the destination may have changed its pin
+            clear_events();
+            nl->begin_batch();
+            net_0_4_5->remove_dst(gate_5, "I0");
+            net_0_4_5->add_dst(gate_5, "I1");
+            nl->commit_batch();
+
+            ASSERT_EQ(m_net_events.size(), (size_t)2);
+            EXPECT_EQ(std::get<0>(m_net_events[0]), net_event_handler::event::dst_removed);
+            EXPECT_EQ(std::get<0>(m_net_events[1]), net_event_handler::event::dst_added);
+        }
+        {
+            // connecting a net to two pins of the same gate yields two additions, a removal only cancels one of them
+            auto and_gate = nl->create_gate(MIN_GATE_ID+101, get_gate_type_by_name("AND2"), "and");
+            auto and_net  = nl->create_net(MIN_NET_ID+101, "and_in");
+            clear_events();
+            nl->begin_batch();
+            and_net->add_dst(and_gate, "I0");
+            and_net->add_dst(and_gate, "I1");
+            and_net->remove_dst(and_gate, "I0");
+            and_net->add_dst(and_gate, "I0");
+            nl->commit_batch();
+
+            ASSERT_EQ(m_net_events.size(), (size_t)2);
+            EXPECT_EQ(std::get<0>(m_net_events[0]), net_event_handler::event::dst_added);
+            EXPECT_EQ(std::get<0>(m_net_events[1]), net_event_handler::event::dst_added);
+        }
+        {
+            // only the removal of a removed object is dispatched
+            clear_events();
+            nl->begin_batch();
+            net_7_8->set_name("new_name");
+            nl->delete_net(net_7_8);
+            nl->commit_batch();
+
+            ASSERT_EQ(m_net_events.size(), (size_t)1);
+            EXPECT_EQ(std::get<0>(m_net_events[0]), net_event_handler::event::removed);
+            EXPECT_EQ(m_change_sets[0].removed_nets, std::set<std::shared_ptr<net>>({net_7_8}));
+            EXPECT_TRUE(m_change_sets[0].modified_nets.empty());
+        }
+    TEST_END
+}
+
+/**
+ * Testing that batches only record the events of their own netlist and that scoped batches are committed when left through an exception
+ *
+ * Functions: scoped_batch, is_batch_active
+ */
+TEST_F(event_controls_test, check_scoped_batch){
+    TEST_START
+        std::shared_ptr<netlist> nl       = create_example_netlist();
+        std::shared_ptr<netlist> other_nl = create_example_netlist();
+        clear_events();
+        {
+            event_controls::scoped_batch batch(nl);
+            EXPECT_TRUE(event_controls::is_batch_active(nl));
+            EXPECT_FALSE(event_controls::is_batch_active(other_nl));
+
+            // events of other netlists are dispatched immediately
+            other_nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("other");
+            EXPECT_EQ(m_gate_events.size(), (size_t)1);
+            nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("batched");
+            EXPECT_EQ(m_gate_events.size(), (size_t)1);
+        }
+        EXPECT_FALSE(event_controls::is_batch_active(nl));
+        EXPECT_EQ(m_gate_events.size(), (size_t)2);
+        ASSERT_EQ(m_change_sets.size(), (size_t)1);
+        EXPECT_EQ(m_change_sets[0].batch_netlist, nl);
+
+        // an exception does not leave the batch open
+        clear_events();
+        try
+        {
+            event_controls::scoped_batch batch(nl);
+            nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("aborted");
+            throw std::runtime_error("abort");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        EXPECT_FALSE(event_controls::is_batch_active(nl));
+        EXPECT_EQ(m_gate_events.size(), (size_t)1);
+        nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("after");
+        EXPECT_EQ(m_gate_events.size(), (size_t)2);
+    TEST_END
+}
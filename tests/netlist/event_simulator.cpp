@@ -0,0 +1,278 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <netlist/simulation/event_simulator.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+using namespace test_utils;
+
+
+class event_simulator_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    const boolean_function::value X    = boolean_function::X;
+    const boolean_function::value ZERO = boolean_function::ZERO;
+    const boolean_function::value ONE  = boolean_function::ONE;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("EVENT_SIMULATOR_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+
+        add_flip_flop_type(m_gl, "DFF");
+        add_flip_flop_type(m_gl, "DFFR", false, true);
+        add_latch_type(m_gl, "LATCH");
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the propagation of events through combinational logic with delays
+ *
+ * Functions: set_input, run_until, run_for, get_value, get_time, set_gate_type_delay
+ */
+TEST_F(event_simulator_test, check_delays)
+{
+    TEST_START
+    {
+        // a & !a glitches when a rises since the inverter is slower than the AND gate
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto a_n = add_gate(nl, "INV", {a})[0];
+        auto out = add_gate(nl, "AND2", {a, a_n})[0];
+
+        event_simulator sim(nl);
+        EXPECT_TRUE(sim.set_gate_type_delay("INV", 2));
+        EXPECT_EQ(sim.get_gate_type_delay("INV"), 2);
+        EXPECT_EQ(sim.get_gate_type_delay("AND2"), 1);
+
+        EXPECT_TRUE(sim.set_input(a, ZERO, 0));
+        EXPECT_TRUE(sim.set_input(a, ONE, 10));
+        sim.run_until(0);
+        EXPECT_EQ(sim.get_value(a), ZERO);
+        EXPECT_EQ(sim.get_value(out), X);
+        sim.run_until(1);
+        EXPECT_EQ(sim.get_value(out), ZERO);
+        EXPECT_EQ(sim.get_value(a_n), X);
+        sim.run_until(2);
+        EXPECT_EQ(sim.get_value(a_n), ONE);
+
+        std::vector<boolean_function::value> expected = {ZERO, ONE, ONE, ZERO};
+        for (u32 t = 10; t < 14; ++t)
+        {
+            sim.run_until(t);
+            EXPECT_EQ(sim.get_value(out), expected[t - 10]) << "time " << t;
+        }
+        EXPECT_EQ(sim.get_time(), 13);
+        sim.run_for(7);
+        EXPECT_EQ(sim.get_time(), 20);
+
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(sim.set_gate_type_delay("INV", 0));
+        EXPECT_FALSE(sim.set_input(a, ONE, 5));
+        EXPECT_FALSE(sim.set_input(out, ONE, 30));
+        EXPECT_EQ(sim.get_value(nullptr), X);
+    }
+    TEST_END
+}
+
+/**
+ * Testing that only affected gates are evaluated
+ *
+ * Functions: get_num_changes
+ */
+TEST_F(event_simulator_test, check_activity)
+{
+    TEST_START
+    {
+        // a chain of inverters and an idle second chain
+        auto nl     = std::make_shared<netlist>(m_gl);
+        auto a      = add_input(nl, "a");
+        auto b      = add_input(nl, "b");
+        auto last_a = a;
+        auto last_b = b;
+        for (u32 i = 0; i < 100; ++i)
+        {
+            last_a = add_gate(nl, "INV", {last_a})[0];
+            last_b = add_gate(nl, "INV", {last_b})[0];
+        }
+
+        event_simulator sim(nl);
+        sim.set_input(a, ZERO, 0);
+        sim.set_input(b, ZERO, 0);
+        sim.run_until(200);
+        EXPECT_EQ(sim.get_value(last_a), ZERO);
+        EXPECT_EQ(sim.get_num_changes(), 202);
+
+        // every toggle changes the input and each inverter exactly once
+        for (u32 i = 0; i < 10; ++i)
+        {
+            sim.set_input(a, (i % 2 == 0) ? ONE : ZERO, sim.get_time() + 1);
+            sim.run_for(200);
+        }
+        EXPECT_EQ(sim.get_value(last_a), ZERO);
+        EXPECT_EQ(sim.get_value(last_b), ZERO);
+        EXPECT_EQ(sim.get_num_changes(), 202 + 10 * 101);
+    }
+    TEST_END
+}
+
+/**
+ * Testing flip-flops and latches driven by a clock
+ *
+ * Functions: add_clock, run_until
+ */
+TEST_F(event_simulator_test, check_sequential_elements)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto d   = add_input(nl, "d");
+        auto r   = add_input(nl, "r");
+        auto q0  = add_gate(nl, "DFF", {d, clk});
+        auto q1  = add_gate(nl, "DFFR", {q0[0], clk, r})[0];
+        auto l   = add_gate(nl, "LATCH", {d, clk})[0];
+
+        event_simulator sim(nl);
+        EXPECT_TRUE(sim.set_gate_type_delay("DFF", 3));
+        EXPECT_TRUE(sim.add_clock(clk, 5));
+        sim.set_input(d, ONE, 0);
+        sim.set_input(r, ZERO, 0);
+
+        // the clock rises at 5, 15, 25 and falls at 10, 20, 30
+        sim.run_until(7);
+        EXPECT_EQ(sim.get_value(clk), ONE);
+        EXPECT_EQ(sim.get_value(q0[0]), X);
+        EXPECT_EQ(sim.get_value(l), ONE);
+        sim.run_until(8);
+        EXPECT_EQ(sim.get_value(q0[0]), ONE);
+        EXPECT_EQ(sim.get_value(q0[1]), ZERO);
+        EXPECT_EQ(sim.get_value(q1), X);
+
+        // the latch holds while the clock is ZERO
+        sim.set_input(d, ZERO, 12);
+        sim.run_until(14);
+        EXPECT_EQ(sim.get_value(clk), ZERO);
+        EXPECT_EQ(sim.get_value(l), ONE);
+        sim.run_until(16);
+        EXPECT_EQ(sim.get_value(q1), ONE);
+        EXPECT_EQ(sim.get_value(l), ZERO);
+        EXPECT_EQ(sim.get_value(q0[0]), ONE);
+        sim.run_until(18);
+        EXPECT_EQ(sim.get_value(q0[0]), ZERO);
+
+        // asynchronous reset
+        sim.set_input(d, ONE, 20);
+        sim.set_input(r, ONE, 21);
+        sim.run_until(21);
+        EXPECT_EQ(sim.get_value(q1), ONE);
+        sim.run_until(22);
+        EXPECT_EQ(sim.get_value(q1), ZERO);
+        sim.run_until(40);
+        EXPECT_EQ(sim.get_value(q0[0]), ONE);
+        EXPECT_EQ(sim.get_value(q1), ZERO);
+
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(sim.add_clock(clk, 5));
+        EXPECT_FALSE(sim.add_clock(d, 0));
+        EXPECT_FALSE(sim.add_clock(q1, 5));
+        EXPECT_FALSE(sim.set_input(clk, ONE, 50));
+    }
+    TEST_END
+}
+
+/**
+ * Testing the streaming of value changes
+ *
+ * Functions: start_vcd, stop_vcd
+ */
+TEST_F(event_simulator_test, check_vcd)
+{
+    TEST_START
+    {
+        auto nl = std::make_shared<netlist>(m_gl);
+        nl->set_design_name("top_design");
+        auto a   = add_input(nl, "a");
+        auto a_n = add_gate(nl, "INV", {a})[0];
+
+        std::stringstream stream;
+        event_simulator sim(nl);
+        EXPECT_TRUE(sim.start_vcd(stream, {a_n, a}, "10ps"));
+        sim.set_input(a, ZERO, 0);
+        sim.set_input(a, ONE, 4);
+        sim.run_until(10);
+        sim.stop_vcd();
+        sim.set_input(a, ZERO, 12);
+        sim.run_until(20);
+
+        std::string expected = "$timescale 10ps $end\n"
+                               "$scope module top_design $end\n"
+                               "$var wire 1 ! "
+                               + a_n->get_name() + "_" + std::to_string(a_n->get_id())
+                               + " $end\n"
+                                 "$var wire 1 \" a_"
+                               + std::to_string(a->get_id())
+                               + " $end\n"
+                                 "$upscope $end\n"
+                                 "$enddefinitions $end\n"
+                                 "#0\n"
+                                 "$dumpvars\n"
+                                 "x!\n"
+                                 "x\"\n"
+                                 "$end\n"
+                                 "0\"\n"
+                                 "#1\n"
+                                 "1!\n"
+                                 "#4\n"
+                                 "1\"\n"
+                                 "#5\n"
+                                 "0!\n";
+        EXPECT_EQ(stream.str(), expected);
+    }
+    {
+        // all nets are recorded into a file
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        add_gate(nl, "INV", {a});
+        auto path = hal::fs::temp_directory_path() / "event_simulator_test.vcd";
+
+        {
+            event_simulator sim(nl);
+            EXPECT_TRUE(sim.start_vcd(path));
+            sim.set_input(a, ONE, 0);
+            sim.run_until(5);
+        }
+
+        std::ifstream file(path.string());
+        std::stringstream content;
+        content << file.rdbuf();
+        EXPECT_NE(content.str().find("$var wire 1 ! a_"), std::string::npos);
+        EXPECT_NE(content.str().find("$var wire 1 \" "), std::string::npos);
+        EXPECT_NE(content.str().find("#1\n0\"\n"), std::string::npos);
+        hal::fs::remove(path);
+
+        NO_COUT_TEST_BLOCK;
+        event_simulator sim(nl);
+        EXPECT_FALSE(sim.start_vcd(hal::path("/nonexistent_directory/test.vcd")));
+        std::stringstream stream;
+        EXPECT_FALSE(sim.start_vcd(stream, {nullptr}));
+    }
+    TEST_END
+}
@@ -297,7 +297,7 @@ TEST_F(gate_test, check_get_fan_out_nets)
  * Testing functions which returns the fan-in net, connected to a specific pin-type,
  * by using the example netlist (see above)
  *
- * Functions: get_fan_in_net
+ * Functions: get_fan_in_net, get_fan_in_net_by_pin_id
  */
 TEST_F(gate_test, check_get_fan_in_net)
 {
@@ -314,6 +314,7 @@ TEST_F(gate_test, check_get_fan_in_net)
         std::shared_ptr<gate> gate_0 = nl->get_gate_by_id(MIN_GATE_ID+0);
         EXPECT_EQ(gate_0->get_fan_in_net("I0"), nl->get_net_by_id(MIN_NET_ID+30));
         EXPECT_EQ(gate_0->get_fan_in_net("I1"), nl->get_net_by_id(MIN_NET_ID+20));
+        EXPECT_EQ(gate_0->get_fan_in_net_by_pin_id(gate_0->get_type()->get_input_pin_id("I1")), nl->get_net_by_id(MIN_NET_ID+20));
     }
     {
         // Get the net of a pin where no net is connected
@@ -335,6 +336,11 @@ TEST_F(gate_test, check_get_fan_in_net)
         std::shared_ptr<gate> gate_0 = nl->get_gate_by_id(MIN_GATE_ID+0);
         EXPECT_EQ(gate_0->get_fan_in_net(""), nullptr);
     }
+    {
+        // Pass an invalid pin id
+        std::shared_ptr<gate> gate_0 = nl->get_gate_by_id(MIN_GATE_ID+0);
+        EXPECT_EQ(gate_0->get_fan_in_net_by_pin_id(gate_type::INVALID_PIN_ID), nullptr);
+    }
     TEST_END
 }
 
@@ -342,7 +348,7 @@ TEST_F(gate_test, check_get_fan_in_net)
  * Testing functions which returns the fan-out net, connected to a specific pin-type,
  * by using the example netlist (see above)
  *
- * Functions: get_fan_out_net
+ * Functions: get_fan_out_net, get_fan_out_net_by_pin_id
  */
 TEST_F(gate_test, check_get_fan_out_net)
 {
@@ -358,6 +364,7 @@ TEST_F(gate_test, check_get_fan_out_net)
         // Get an existing net at an existing pin-type
         std::shared_ptr<gate> gate_0 = nl->get_gate_by_id(MIN_GATE_ID+0);
         EXPECT_EQ(gate_0->get_fan_out_net("O"), nl->get_net_by_id(MIN_NET_ID+045));
+        EXPECT_EQ(gate_0->get_fan_out_net_by_pin_id(0), nl->get_net_by_id(MIN_NET_ID+045));
     }
     {
         // Get the net of a pin where no net is connected
@@ -887,6 +894,32 @@ TEST_F(gate_test, check_lut_function)
             lut_gate->add_boolean_function("O_LUT", lut_bf);
             get_truth_table_from_hex_string("EF", 8);
         }
+        {
+            // Gates of the same type and INIT string share their decoded function, changing the INIT string is respected
+            std::shared_ptr<netlist> nl     = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate_0 = nl->create_gate(MIN_GATE_ID+0, lut, "lut_0");
+            std::shared_ptr<gate> lut_gate_1 = nl->create_gate(MIN_GATE_ID+1, lut, "lut_1");
+            lut_gate_0->set_data(lut->get_config_data_category(), lut->get_config_data_identifier(), "bit_vector", "E8");
+            lut_gate_1->set_data(lut->get_config_data_category(), lut->get_config_data_identifier(), "bit_vector", "E8");
+            EXPECT_EQ(lut_gate_0->get_boolean_function("O_LUT"), lut_gate_1->get_boolean_function("O_LUT"));
+            EXPECT_EQ(lut_gate_0->get_boolean_function("O_LUT"), lut_gate_0->get_boolean_function("O_LUT_other"));
+
+            lut_gate_1->add_boolean_function("O_LUT", boolean_function::from_string("I0 & I1 & I2", input_pins));
+            EXPECT_NE(lut_gate_0->get_boolean_function("O_LUT"), lut_gate_1->get_boolean_function("O_LUT"));
+        }
+        {
+            // Writing a function to a lut pin and reading it back yields the same function
+            std::shared_ptr<netlist> nl   = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, lut, "lut");
+            for (bool ascending : {true, false})
+            {
+                lut->set_config_data_ascending_order(ascending);
+                boolean_function lut_bf = boolean_function::from_string("(I0 & !I1) | I2", input_pins);
+                lut_gate->add_boolean_function("O_LUT", lut_bf);
+                EXPECT_EQ(lut_gate->get_boolean_function("O_LUT").get_truth_table(input_pins), lut_bf.get_truth_table(input_pins));
+            }
+            lut->set_config_data_ascending_order(true);
+        }
         // NEGATIVE
         {
             // There is no hex string at the config data path
@@ -919,7 +952,7 @@ TEST_F(gate_test, check_lut_function)
             EXPECT_EQ(lut_gate->get_boolean_function("O_LUT"), boolean_function());
         }
         {
-            // Test a lut with more than 6 inputs
+            // Test a lut with more than 6 inputs, i.e., more than 64 configuration bits
             std::vector<std::string> new_input_pins({"I3", "I4", "I5", "I6"});
             lut->add_input_pins(new_input_pins);
             input_pins.insert(input_pins.begin(), new_input_pins.begin(), new_input_pins.end());
@@ -930,8 +963,183 @@ TEST_F(gate_test, check_lut_function)
             std::string long_hex = "DEADBEEFC001D00DDEADC0DEDEADDA7A";
             lut_gate->set_data(lut->get_config_data_category(), lut->get_config_data_identifier(), "bit_vector", long_hex);
 
+            EXPECT_EQ(lut_gate->get_boolean_function("O_LUT").get_truth_table(lut->get_input_pins()), get_truth_table_from_hex_string(long_hex, 128));
+        }
+    TEST_END
+}
+
+/**
+ * Testing LUTs with more than 64 configuration bits and fracturable LUT outputs
+ *
+ * Functions: get_boolean_function, add_boolean_function
+ */
+TEST_F(gate_test, check_wide_lut_function)
+{
+    TEST_START
+        std::shared_ptr<gate_library> gl(new gate_library("TEST_LIB"));
+        std::shared_ptr<gate_type_lut> lut(new gate_type_lut("LUT8_2"));
+
+        std::vector<std::string> input_pins({"I0", "I1", "I2", "I3", "I4", "I5", "I6", "I7"});
+        std::vector<std::string> lower_input_pins(input_pins.begin(), input_pins.begin() + 7);
+
+        lut->add_input_pins(input_pins);
+        lut->add_output_pins({"O8", "O7_low", "O7_high"});
+        lut->add_output_from_init_string_pin("O8");
+        lut->add_output_from_init_string_pin("O7_low", 7, 0);
+        lut->add_output_from_init_string_pin("O7_high", 7, 128);
+        lut->set_config_data_ascending_order(false);
+        lut->set_config_data_identifier("data_identifier");
+        lut->set_config_data_category("data_category");
+        gl->add_gate_type(lut);
+        {
+            // The upper 128 rows are the AND of the lower seven inputs, the lower 128 rows are their XOR
+            std::shared_ptr<netlist> nl    = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, lut, "lut");
+
+            boolean_function and_bf = boolean_function::from_string("I0 & I1 & I2 & I3 & I4 & I5 & I6", input_pins);
+            boolean_function xor_bf = boolean_function::from_string("I0 ^ I1 ^ I2 ^ I3 ^ I4 ^ I5 ^ I6", input_pins);
+            boolean_function full_bf = (boolean_function("I7") & and_bf) | ((!boolean_function("I7")) & xor_bf);
+
+            lut_gate->add_boolean_function("O8", full_bf);
+            EXPECT_EQ(std::get<1>(lut_gate->get_data_by_key("data_category", "data_identifier")).size(), 64);
+            EXPECT_EQ(lut_gate->get_boolean_function("O8").get_truth_table(input_pins), full_bf.get_truth_table(input_pins));
+            EXPECT_EQ(lut_gate->get_boolean_function("O7_low").get_truth_table(lower_input_pins), xor_bf.get_truth_table(lower_input_pins));
+            EXPECT_EQ(lut_gate->get_boolean_function("O7_high").get_truth_table(lower_input_pins), and_bf.get_truth_table(lower_input_pins));
+            EXPECT_EQ(lut_gate->get_boolean_function("O7_high").get_variables(), std::set<std::string>(lower_input_pins.begin(), lower_input_pins.end()));
+
+            // a function written to a partial output is stored as custom function and does not change the configuration
+            lut_gate->add_boolean_function("O7_low", and_bf);
+            EXPECT_EQ(lut_gate->get_boolean_function("O8").get_truth_table(input_pins), full_bf.get_truth_table(input_pins));
+        }
+        {
+            // Short configuration strings are padded with zeros, a "0x" prefix is accepted
+            std::shared_ptr<netlist> nl    = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, lut, "lut");
+
+            lut_gate->set_data("data_category", "data_identifier", "bit_vector", "0x10000000000000001");
+            EXPECT_EQ(lut_gate->get_boolean_function("O8"), boolean_function::from_string("(!I0 & !I1 & !I2 & !I3 & !I4 & !I5 & !I6 & !I7) | (!I0 & !I1 & !I2 & !I3 & !I4 & !I5 & I6 & !I7)", input_pins).optimize());
+            EXPECT_TRUE(lut_gate->get_boolean_function("O7_high").is_constant_zero());
+        }
+        {
+            // Decoding more distinct configuration strings than the shared cache holds keeps the functions correct
+            std::shared_ptr<netlist> nl    = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, lut, "lut");
+
+            for (u32 i = 0; i < 5000; i++)
+            {
+                lut_gate->set_data("data_category", "data_identifier", "bit_vector", i_to_hex_string(i));
+                std::vector<boolean_function::value> expected;
+                for (u32 row = 0; row < 128; row++)
+                {
+                    expected.push_back((row < 32 && ((i >> row) & 1)) ? boolean_function::value::ONE : boolean_function::value::ZERO);
+                }
+                EXPECT_EQ(lut_gate->get_boolean_function("O7_low").get_truth_table(lower_input_pins), expected);
+            }
+        }
+        {
+            // Configuration strings of LUTs with more than 16 inputs only cover their lowest rows, the other rows are ZERO
+            for (u32 num_inputs : {20, 32})
+            {
+                std::shared_ptr<gate_type_lut> wide_lut(new gate_type_lut("LUT" + std::to_string(num_inputs)));
+                std::vector<std::string> wide_input_pins;
+                for (u32 i = 0; i < num_inputs; i++)
+                {
+                    wide_input_pins.push_back("I" + std::to_string(i));
+                }
+                wide_lut->add_input_pins(wide_input_pins);
+                wide_lut->add_output_pins({"O"});
+                wide_lut->add_output_from_init_string_pin("O");
+                wide_lut->set_config_data_identifier("data_identifier");
+                wide_lut->set_config_data_category("data_category");
+                gl->add_gate_type(wide_lut);
+
+                std::shared_ptr<netlist> nl    = std::make_shared<netlist>(gl);
+                std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, wide_lut, "lut");
+
+                std::map<std::string, boolean_function::value> all_zero, all_one;
+                for (const auto& pin : wide_input_pins)
+                {
+                    all_zero[pin] = boolean_function::value::ZERO;
+                    all_one[pin]  = boolean_function::value::ONE;
+                }
+                auto only_i0 = all_zero;
+                only_i0["I0"] = boolean_function::value::ONE;
+                auto only_i1 = all_zero;
+                only_i1["I1"] = boolean_function::value::ONE;
+
+                for (bool ascending : {false, true})
+                {
+                    wide_lut->set_config_data_ascending_order(ascending);
+
+                    lut_gate->set_data("data_category", "data_identifier", "bit_vector", "0");
+                    EXPECT_TRUE(lut_gate->get_boolean_function("O").is_constant_zero());
+                }
+
+                // rows 0 and 1 in descending order
+                wide_lut->set_config_data_ascending_order(false);
+                lut_gate->set_data("data_category", "data_identifier", "bit_vector", "3");
+                boolean_function bf = lut_gate->get_boolean_function("O");
+                EXPECT_EQ(bf.get_variables(), std::set<std::string>(wide_input_pins.begin() + 1, wide_input_pins.end()));
+                EXPECT_EQ(bf.evaluate(all_zero), boolean_function::value::ONE);
+                EXPECT_EQ(bf.evaluate(only_i0), boolean_function::value::ONE);
+                EXPECT_EQ(bf.evaluate(only_i1), boolean_function::value::ZERO);
+
+                // the last row in ascending order
+                wide_lut->set_config_data_ascending_order(true);
+                lut_gate->set_data("data_category", "data_identifier", "bit_vector", "1");
+                bf = lut_gate->get_boolean_function("O");
+                EXPECT_EQ(bf.get_variables(), std::set<std::string>(wide_input_pins.begin(), wide_input_pins.end()));
+                EXPECT_EQ(bf.evaluate(all_one), boolean_function::value::ONE);
+                EXPECT_EQ(bf.evaluate(all_zero), boolean_function::value::ZERO);
+                EXPECT_EQ(bf.evaluate(only_i0), boolean_function::value::ZERO);
+            }
+        }
+        // NEGATIVE
+        {
+            // A configuration string that is too long or not a hex value
+            std::shared_ptr<netlist> nl    = std::make_shared<netlist>(gl);
+            std::shared_ptr<gate> lut_gate = nl->create_gate(MIN_GATE_ID+0, lut, "lut");
+
             NO_COUT_BLOCK;
-            EXPECT_EQ(lut_gate->get_boolean_function("O_LUT"), boolean_function());
+            lut_gate->set_data("data_category", "data_identifier", "bit_vector", std::string(65, 'F'));
+            EXPECT_EQ(lut_gate->get_boolean_function("O8"), boolean_function());
+            lut_gate->set_data("data_category", "data_identifier", "bit_vector", std::string(63, 'F') + "G");
+            EXPECT_EQ(lut_gate->get_boolean_function("O8"), boolean_function());
         }
     TEST_END
 }
+
+/**
+ * Testing the visitor functions over the fan-in and fan-out nets of a gate
+ *
+ * Functions: for_each_fan_in_net, for_each_fan_out_net
+ */
+TEST_F(gate_test, check_for_each_fan_net)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<gate> g     = nl->get_gate_by_id(MIN_GATE_ID + 0);
+
+        std::vector<std::string> pins;
+        std::set<std::shared_ptr<net>> nets;
+        g->for_each_fan_in_net([&](const std::string& pin, const std::shared_ptr<net>& n) {
+            pins.push_back(pin);
+            nets.insert(n);
+            EXPECT_EQ(g->get_fan_in_net(pin), n);
+        });
+        EXPECT_EQ(pins, std::vector<std::string>({"I0", "I1"}));
+        EXPECT_EQ(nets, g->get_fan_in_nets());
+
+        nets.clear();
+        g->for_each_fan_out_net([&](const std::string& pin, const std::shared_ptr<net>& n) {
+            EXPECT_EQ(pin, "O");
+            nets.insert(n);
+        });
+        EXPECT_EQ(nets, g->get_fan_out_nets());
+
+        // unconnected pins are skipped
+        u32 count = 0;
+        nl->get_gate_by_id(MIN_GATE_ID + 4)->for_each_fan_out_net([&count](const std::string&, const std::shared_ptr<net>&) { count++; });
+        EXPECT_EQ(count, 0u);
+    TEST_END
+}
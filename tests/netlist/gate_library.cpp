@@ -49,7 +49,8 @@ TEST_F(gate_library_test, check_constructor)
 /**
  * Testing the addition of input and output pins and the access to them
  *
- * Functions: add_input_pin, add_input_pins, get_input_pins, add_output_pin, add_output_pins, get_output_pins
+ * Functions: add_input_pin, add_input_pins, get_input_pins, get_input_pin_id, add_output_pin, add_output_pins, get_output_pins,
+ *            get_output_pin_id
  */
 TEST_F(gate_library_test, check_pin_management)
 {
@@ -60,6 +61,9 @@ TEST_F(gate_library_test, check_pin_management)
             gt.add_input_pin("IN_0"); // Single
             gt.add_input_pins(std::vector<std::string>({"IN_1", "IN_2"})); // Multiple
             EXPECT_EQ(gt.get_input_pins(), std::vector<std::string>({"IN_0", "IN_1", "IN_2"}));
+            EXPECT_EQ(gt.get_input_pin_id("IN_0"), 0u);
+            EXPECT_EQ(gt.get_input_pin_id("IN_2"), 2u);
+            EXPECT_EQ(gt.get_input_pin_id("OUT_0"), gate_type::INVALID_PIN_ID);
         }
         {
             // Add some output nets
@@ -67,6 +71,8 @@ TEST_F(gate_library_test, check_pin_management)
             gt.add_output_pin("OUT_0"); // Single
             gt.add_output_pins(std::vector<std::string>({"OUT_1", "OUT_2"})); // Multiple
             EXPECT_EQ(gt.get_output_pins(), std::vector<std::string>({"OUT_0", "OUT_1", "OUT_2"}));
+            EXPECT_EQ(gt.get_output_pin_id("OUT_1"), 1u);
+            EXPECT_EQ(gt.get_output_pin_id("IN_0"), gate_type::INVALID_PIN_ID);
         }
         // NEGATIVE TESTS
         {
@@ -150,6 +150,53 @@ TEST_F(gate_library_parser_liberty_test, check_lut)
             EXPECT_EQ(gt_lut->is_config_data_ascending_order(), true);
 
         }
+        {
+            // Create a fracturable LUT gate type, O5 uses the lower half of the configuration
+            std::stringstream input("library (TEST_GATE_LIBRARY) {\n"
+                                    "    define(cell);\n"
+                                    "    cell(TEST_LUT) {\n"
+                                    "        lut (\"lut_out\") {\n"
+                                    "            data_category     : \"test_category\";\n"
+                                    "            data_identifier   : \"test_identifier\";\n"
+                                    "            direction         : \"descending\";\n"
+                                    "        }\n"
+                                    "        lut (\"lut_out5\") {\n"
+                                    "            data_category     : \"test_category\";\n"
+                                    "            data_identifier   : \"test_identifier\";\n"
+                                    "            direction         : \"descending\";\n"
+                                    "            input_count       : 5;\n"
+                                    "            first_row         : 0;\n"
+                                    "        }\n"
+                                    "        pin(I0) { direction: input; }\n"
+                                    "        pin(I1) { direction: input; }\n"
+                                    "        pin(I2) { direction: input; }\n"
+                                    "        pin(I3) { direction: input; }\n"
+                                    "        pin(I4) { direction: input; }\n"
+                                    "        pin(I5) { direction: input; }\n"
+                                    "        pin(O5) {\n"
+                                    "            direction: output;\n"
+                                    "            function: \"lut_out5\";\n"
+                                    "        }\n"
+                                    "        pin(O6) {\n"
+                                    "            direction: output;\n"
+                                    "            function: \"lut_out\";\n"
+                                    "        }\n"
+                                    "    }"
+                                    "}");
+            gate_library_parser_liberty liberty_parser(input);
+            std::shared_ptr<gate_library> gl = liberty_parser.parse();
+
+            ASSERT_NE(gl, nullptr);
+
+            auto gt_it = gl->get_gate_types().find("TEST_LUT");
+            ASSERT_TRUE(gt_it != gl->get_gate_types().end());
+            std::shared_ptr<const gate_type_lut> gt_lut = std::dynamic_pointer_cast<const gate_type_lut>(gt_it->second);
+            ASSERT_NE(gt_lut, nullptr);
+
+            EXPECT_EQ(gt_lut->get_output_from_init_string_pins(), std::unordered_set<std::string>({"O5", "O6"}));
+            EXPECT_EQ(gt_lut->get_output_from_init_string_slice("O5"), std::make_pair(5u, 0u));
+            EXPECT_EQ(gt_lut->get_output_from_init_string_slice("O6"), std::make_pair(6u, 0u));
+        }
         {
             // Create a simple LUT gate type with an descending bit order
             std::stringstream input("library (TEST_GATE_LIBRARY) {\n"
@@ -0,0 +1,180 @@
+#include "netlist/id_slot_map.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+class id_slot_map_test : public ::testing::Test
+{
+protected:
+    // minimal object with an id
+    struct object
+    {
+        u32 id;
+
+        u32 get_id() const
+        {
+            return id;
+        }
+    };
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::shared_ptr<object> make(u32 id)
+    {
+        return std::make_shared<object>(object{id});
+    }
+};
+
+/**
+ * Testing insertion, lookup and removal of objects
+ *
+ * Functions: insert, erase, contains, get, get_objects, size
+ */
+TEST_F(id_slot_map_test, check_insert_and_erase)
+{
+    id_slot_map<object> map;
+    auto a = make(1);
+    auto b = make(2);
+    auto c = make(7);
+
+    EXPECT_TRUE(map.insert(a));
+    EXPECT_TRUE(map.insert(b));
+    EXPECT_TRUE(map.insert(c));
+    EXPECT_EQ(map.size(), 3u);
+
+    // ids are unique
+    EXPECT_FALSE(map.insert(make(2)));
+    EXPECT_EQ(map.get(2), b);
+
+    EXPECT_TRUE(map.contains(7));
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(map.get(3), nullptr);
+
+    // removing an object keeps the others accessible
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.get(2), b);
+    EXPECT_EQ(map.get(7), c);
+    EXPECT_EQ(map.size(), 2u);
+
+    auto objects = map.get_objects();
+    EXPECT_EQ(objects.size(), 2u);
+    EXPECT_NE(std::find(objects.begin(), objects.end(), b), objects.end());
+    EXPECT_NE(std::find(objects.begin(), objects.end(), c), objects.end());
+}
+
+/**
+ * Testing objects with far outlying ids
+ *
+ * Functions: insert, erase, get
+ */
+TEST_F(id_slot_map_test, check_sparse_ids)
+{
+    id_slot_map<object> map;
+    auto a = make(5);
+    auto b = make(0xFFFFFFF0);
+    auto c = make(0x80000000);
+
+    EXPECT_TRUE(map.insert(a));
+    EXPECT_TRUE(map.insert(b));
+    EXPECT_TRUE(map.insert(c));
+    EXPECT_EQ(map.get(0xFFFFFFF0), b);
+    EXPECT_EQ(map.get(0x80000000), c);
+    EXPECT_EQ(map.get(0x80000001), nullptr);
+
+    EXPECT_TRUE(map.erase(0xFFFFFFF0));
+    EXPECT_EQ(map.get(0xFFFFFFF0), nullptr);
+    EXPECT_EQ(map.get(0x80000000), c);
+    EXPECT_EQ(map.get(5), a);
+
+    // growing the dense range keeps existing entries
+    for (u32 id = 100; id < 5000; ++id)
+    {
+        ASSERT_TRUE(map.insert(make(id)));
+    }
+    EXPECT_EQ(map.get(5), a);
+    EXPECT_EQ(map.get(4999)->get_id(), 4999u);
+    EXPECT_EQ(map.get(0x80000000), c);
+}
+
+/**
+ * Testing the allocation of unique ids
+ *
+ * Functions: get_unique_id
+ */
+TEST_F(id_slot_map_test, check_unique_id)
+{
+    id_slot_map<object> map;
+
+    // 0 is never handed out
+    EXPECT_EQ(map.get_unique_id(), 1u);
+
+    map.insert(make(1));
+    map.insert(make(2));
+    map.insert(make(4));
+    EXPECT_EQ(map.get_unique_id(), 3u);
+    map.insert(make(3));
+    EXPECT_EQ(map.get_unique_id(), 5u);
+
+    // ids of removed objects are reused
+    map.erase(2);
+    EXPECT_EQ(map.get_unique_id(), 2u);
+
+    // unless they were taken explicitly in the meantime
+    map.insert(make(2));
+    EXPECT_EQ(map.get_unique_id(), 5u);
+
+    // the smallest free id is reused first
+    map.erase(4);
+    map.erase(1);
+    map.erase(3);
+    EXPECT_EQ(map.get_unique_id(), 1u);
+    map.insert(make(map.get_unique_id()));
+    EXPECT_EQ(map.get_unique_id(), 3u);
+
+    // repeatedly removing and recreating an object with the same id does not pile up free ids
+    for (u32 i = 0; i < 100; ++i)
+    {
+        map.erase(2);
+        map.insert(make(2));
+    }
+    map.insert(make(3));
+    EXPECT_EQ(map.get_unique_id(), 4u);
+    map.insert(make(4));
+    EXPECT_EQ(map.get_unique_id(), 5u);
+
+    // free ids that are taken out of order are skipped
+    for (u32 id = 5; id < 1000; ++id)
+    {
+        map.insert(make(id));
+    }
+    for (u32 round = 0; round < 10; ++round)
+    {
+        for (u32 id = 10; id < 1000; ++id)
+        {
+            map.erase(id);
+        }
+        for (u32 id = 999; id > 10; --id)
+        {
+            map.insert(make(id));
+        }
+        EXPECT_EQ(map.get_unique_id(), 10u);
+        map.insert(make(10));
+    }
+    EXPECT_EQ(map.get_unique_id(), 1000u);
+
+    // far outlying ids are reused as well
+    map.insert(make(0x80000000));
+    map.insert(make(1000));
+    map.erase(0x80000000);
+    EXPECT_FALSE(map.contains(0x80000000));
+    EXPECT_EQ(map.get_unique_id(), 0x80000000u);
+    map.erase(1000);
+    EXPECT_EQ(map.get_unique_id(), 1000u);
+}
@@ -592,3 +592,247 @@ TEST_F(module_test, check_get_input_nets){
 }
 
 
+
+/**
+ * Testing the visitor functions over the gates and submodules of a module
+ *
+ * Functions: for_each_gate, for_each_submodule
+ */
+TEST_F(module_test, check_for_each){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<module> tm  = nl->get_top_module();
+        std::shared_ptr<module> m_0 = nl->create_module(MIN_MODULE_ID+0, "m_0", tm, {nl->get_gate_by_id(MIN_GATE_ID+0), nl->get_gate_by_id(MIN_GATE_ID+1)});
+        std::shared_ptr<module> m_1 = nl->create_module(MIN_MODULE_ID+1, "m_1", m_0, {nl->get_gate_by_id(MIN_GATE_ID+2)});
+
+        for (bool recursive : {false, true})
+        {
+            std::set<std::shared_ptr<gate>> gates;
+            m_0->for_each_gate([&gates](const std::shared_ptr<gate>& g) { gates.insert(g); }, recursive);
+            EXPECT_EQ(gates, m_0->get_gates(nullptr, recursive));
+
+            std::set<std::shared_ptr<module>> submodules;
+            tm->for_each_submodule([&submodules](const std::shared_ptr<module>& m) { submodules.insert(m); }, recursive);
+            EXPECT_EQ(submodules, tm->get_submodules(nullptr, recursive));
+        }
+    TEST_END
+}
+
+/**
+ * Testing that the cached input, output and internal nets of modules stay consistent with the netlist after
+ * connections, gate assignments, global net markings and the module hierarchy are modified
+ *
+ * Functions: get_input_nets, get_output_nets, get_internal_nets
+ */
+TEST_F(module_test, check_module_nets_cache){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<module> tm  = nl->get_top_module();
+        std::shared_ptr<module> m_0 = nl->create_module(MIN_MODULE_ID+0, "m_0", tm, {nl->get_gate_by_id(MIN_GATE_ID+0), nl->get_gate_by_id(MIN_GATE_ID+3)});
+        std::shared_ptr<module> m_1 = nl->create_module(MIN_MODULE_ID+1, "m_1", m_0, {nl->get_gate_by_id(MIN_GATE_ID+4)});
+        std::shared_ptr<module> m_2 = nl->create_module(MIN_MODULE_ID+2, "m_2", tm, {nl->get_gate_by_id(MIN_GATE_ID+7)});
+
+        // computes the expected nets of a module from scratch
+        auto check_module = [&nl](const std::shared_ptr<module>& m) {
+            auto gates = m->get_gates(nullptr, true);
+            std::set<std::shared_ptr<net>> inputs, outputs, internals;
+            for (const auto& n : nl->get_nets())
+            {
+                bool src_inside = gates.find(n->get_src().gate) != gates.end();
+                bool dst_inside = false, dst_outside = false;
+                for (const auto& dst : n->get_dsts())
+                {
+                    (gates.find(dst.gate) != gates.end() ? dst_inside : dst_outside) = true;
+                }
+                if (dst_inside && (!src_inside || nl->is_global_input_net(n)))
+                {
+                    inputs.insert(n);
+                }
+                if (src_inside && (dst_outside || nl->is_global_output_net(n)))
+                {
+                    outputs.insert(n);
+                }
+                if (src_inside && dst_inside)
+                {
+                    internals.insert(n);
+                }
+            }
+            EXPECT_EQ(m->get_input_nets(), inputs);
+            EXPECT_EQ(m->get_output_nets(), outputs);
+            EXPECT_EQ(m->get_internal_nets(), internals);
+        };
+        auto check_all = [&]() {
+            for (const auto& m : nl->get_modules())
+            {
+                check_module(m);
+            }
+        };
+
+        // build the caches
+        check_all();
+
+        // modify connections
+        auto net_0_4_5 = nl->get_net_by_id(MIN_NET_ID+045);
+        net_0_4_5->remove_dst(nl->get_gate_by_id(MIN_GATE_ID+5), "I0");
+        check_all();
+        net_0_4_5->add_dst(nl->get_gate_by_id(MIN_GATE_ID+8), "I1");
+        check_all();
+        auto net_3_0 = nl->get_net_by_id(MIN_NET_ID+30);
+        net_3_0->remove_src();
+        check_all();
+        net_3_0->set_src(nl->get_gate_by_id(MIN_GATE_ID+6), "O");
+        check_all();
+
+        // create and delete nets
+        auto net_new = nl->create_net(MIN_NET_ID+100, "net_new");
+        net_new->add_dst(nl->get_gate_by_id(MIN_GATE_ID+4), "I");
+        net_new->add_dst(nl->get_gate_by_id(MIN_GATE_ID+6), "I");
+        check_all();
+        nl->mark_global_input_net(net_new);
+        check_all();
+        nl->delete_net(net_new);
+        check_all();
+
+        // mark global outputs
+        nl->mark_global_output_net(net_0_4_5);
+        check_all();
+        nl->unmark_global_output_net(net_0_4_5);
+        check_all();
+
+        // move gates
+        m_1->assign_gate(nl->get_gate_by_id(MIN_GATE_ID+0));
+        check_all();
+        m_2->assign_gate(nl->get_gate_by_id(MIN_GATE_ID+8));
+        check_all();
+        m_1->remove_gate(nl->get_gate_by_id(MIN_GATE_ID+4));
+        check_all();
+
+        // modify the hierarchy
+        m_1->set_parent_module(m_2);
+        check_all();
+        m_0->set_parent_module(m_1);
+        check_all();
+        nl->delete_module(m_1);
+        check_all();
+
+        // delete gates
+        nl->delete_gate(nl->get_gate_by_id(MIN_GATE_ID+0));
+        check_all();
+    TEST_END
+}
+
+/**
+ * Testing the recursive membership queries of modules while the module hierarchy and the gate assignments change
+ *
+ * Functions: contains_gate, contains_module, get_gate_by_id, get_gates, get_submodules
+ */
+TEST_F(module_test, check_recursive_queries){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<module> tm  = nl->get_top_module();
+        std::shared_ptr<module> m_0 = nl->create_module(MIN_MODULE_ID+0, "m_0", tm, {nl->get_gate_by_id(MIN_GATE_ID+0), nl->get_gate_by_id(MIN_GATE_ID+1)});
+        std::shared_ptr<module> m_1 = nl->create_module(MIN_MODULE_ID+1, "m_1", m_0, {nl->get_gate_by_id(MIN_GATE_ID+2)});
+        std::shared_ptr<module> m_2 = nl->create_module(MIN_MODULE_ID+2, "m_2", m_1, {nl->get_gate_by_id(MIN_GATE_ID+3)});
+        std::shared_ptr<module> m_3 = nl->create_module(MIN_MODULE_ID+3, "m_3", tm, {nl->get_gate_by_id(MIN_GATE_ID+4)});
+
+        // compares the recursive queries against walking up the parents
+        auto is_ancestor = [](const std::shared_ptr<module>& anc, std::shared_ptr<module> m) {
+            for (; m != nullptr; m = m->get_parent_module())
+            {
+                if (m == anc)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto check_all = [&]() {
+            for (const auto& m : nl->get_modules())
+            {
+                std::set<std::shared_ptr<gate>> exp_gates;
+                for (const auto& g : nl->get_gates())
+                {
+                    bool inside = is_ancestor(m, g->get_module());
+                    EXPECT_EQ(m->contains_gate(g, true), inside);
+                    EXPECT_EQ(m->get_gate_by_id(g->get_id(), true), inside ? g : nullptr);
+                    if (inside)
+                    {
+                        exp_gates.insert(g);
+                    }
+                }
+                EXPECT_EQ(m->get_gates(nullptr, true), exp_gates);
+
+                std::set<std::shared_ptr<module>> exp_submodules;
+                for (const auto& other : nl->get_modules())
+                {
+                    bool inside = (other != m) && is_ancestor(m, other);
+                    EXPECT_EQ(m->contains_module(other, true), inside);
+                    if (inside)
+                    {
+                        exp_submodules.insert(other);
+                    }
+                }
+                EXPECT_EQ(m->get_submodules(nullptr, true), exp_submodules);
+            }
+        };
+
+        check_all();
+
+        // filters are applied to all levels
+        EXPECT_EQ(tm->get_gates([](const std::shared_ptr<gate>& g) { return g->get_type()->get_name() == "INV"; }, true),
+                  std::set<std::shared_ptr<gate>>({nl->get_gate_by_id(MIN_GATE_ID+3), nl->get_gate_by_id(MIN_GATE_ID+4)}));
+        EXPECT_EQ(tm->get_submodules([](const std::shared_ptr<module>& m) { return m->get_name() != "m_1"; }, true), std::set<std::shared_ptr<module>>({m_0, m_2, m_3}));
+
+        // gates from other netlists are never contained
+        std::shared_ptr<netlist> other_nl = create_example_netlist();
+        EXPECT_FALSE(tm->contains_gate(other_nl->get_gate_by_id(MIN_GATE_ID+0), true));
+        EXPECT_FALSE(tm->contains_module(other_nl->get_top_module(), true));
+
+        // modify gate assignments
+        m_2->assign_gate(nl->get_gate_by_id(MIN_GATE_ID+5));
+        check_all();
+        m_0->remove_gate(nl->get_gate_by_id(MIN_GATE_ID+0));
+        check_all();
+        nl->delete_gate(nl->get_gate_by_id(MIN_GATE_ID+3));
+        check_all();
+        nl->create_gate(MIN_GATE_ID+9, get_gate_type_by_name("INV"), "gate_9");
+        check_all();
+
+        // modify the hierarchy
+        m_1->set_parent_module(m_3);
+        check_all();
+        m_3->set_parent_module(m_2);
+        check_all();
+        std::shared_ptr<module> m_4 = nl->create_module(MIN_MODULE_ID+4, "m_4", m_2, {nl->get_gate_by_id(MIN_GATE_ID+6)});
+        check_all();
+        nl->delete_module(m_2);
+        check_all();
+
+        // alternating edits and single queries (answered by walking the hierarchy instead of rebuilding the gate order)
+        for (u32 i = 0; i < 10; ++i)
+        {
+            auto g = nl->create_gate(MIN_GATE_ID+10+i, get_gate_type_by_name("INV"), "gate_" + std::to_string(10+i));
+            EXPECT_TRUE(m_0->assign_gate(g));
+            EXPECT_TRUE(m_0->contains_gate(g, true));
+            EXPECT_EQ(tm->get_gates(nullptr, true), nl->get_gates());
+        }
+        check_all();
+
+        // deleted gates and modules are not contained in their former parents anymore
+        {
+            auto g = nl->create_gate(MIN_GATE_ID+30, get_gate_type_by_name("INV"), "gate_30");
+            EXPECT_TRUE(m_0->assign_gate(g));
+            EXPECT_TRUE(tm->contains_gate(g, true));
+            nl->delete_gate(g);
+            EXPECT_FALSE(m_0->contains_gate(g, true));
+            EXPECT_FALSE(tm->contains_gate(g, true));
+            EXPECT_EQ(tm->get_gate_by_id(MIN_GATE_ID+30, true), nullptr);
+
+            auto m_5 = nl->create_module(MIN_MODULE_ID+5, "m_5", m_0);
+            EXPECT_TRUE(tm->contains_module(m_5, true));
+            nl->delete_module(m_5);
+            EXPECT_FALSE(m_0->contains_module(m_5, true));
+            EXPECT_FALSE(tm->contains_module(m_5, true));
+        }
+    TEST_END
+}
@@ -292,6 +292,27 @@ TEST_F(net_test, check_add_dst){
             EXPECT_EQ(test_net->get_num_of_dsts(), (size_t)1);
             EXPECT_FALSE(suc);
         }
+        {
+            // Connect pins that were added to the gate type after the gate was created
+            std::shared_ptr<gate_library> gl = std::make_shared<gate_library>("TEST_LIB");
+            std::shared_ptr<gate_type> gt    = std::make_shared<gate_type>("TEST_TYPE");
+            gt->add_input_pins({"I0"});
+            gt->add_output_pins({"O0"});
+            gl->add_gate_type(gt);
+
+            std::shared_ptr<netlist> nl = std::make_shared<netlist>(gl);
+            auto t_gate                 = nl->create_gate(MIN_GATE_ID+1, gt, "gate");
+            gt->add_input_pins({"I1", "I2"});
+            gt->add_output_pins({"O1"});
+
+            std::shared_ptr<net> in_net  = nl->create_net(MIN_NET_ID+1, "in_net");
+            std::shared_ptr<net> out_net = nl->create_net(MIN_NET_ID+2, "out_net");
+            EXPECT_TRUE(in_net->add_dst(t_gate, "I2"));
+            EXPECT_TRUE(out_net->set_src(t_gate, "O1"));
+            EXPECT_EQ(t_gate->get_fan_in_net("I2"), in_net);
+            EXPECT_EQ(t_gate->get_fan_out_net("O1"), out_net);
+            EXPECT_EQ(t_gate->get_fan_in_net("I1"), nullptr);
+        }
 
         // NEGATIVE
         {
@@ -523,3 +544,25 @@ TEST_F(net_test, check_global_nets)
 
     TEST_END
 }
+
+/**
+ * Testing the visitor function over the destinations of a net
+ *
+ * Functions: for_each_dst
+ */
+TEST_F(net_test, check_for_each_dst)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<net> n      = nl->get_net_by_id(MIN_NET_ID + 045);
+
+        std::vector<endpoint> dsts;
+        n->for_each_dst([&dsts](const std::shared_ptr<gate>& g, const std::string& pin) { dsts.push_back({g, pin}); });
+        EXPECT_EQ(dsts, n->get_dsts());
+
+        // a net without destinations
+        u32 count = 0;
+        nl->create_net(MIN_NET_ID + 100, "empty_net")->for_each_dst([&count](const std::shared_ptr<gate>&, const std::string&) { count++; });
+        EXPECT_EQ(count, 0u);
+    TEST_END
+}
@@ -1325,3 +1325,28 @@ TEST_F(netlist_test, check_get_unique_module_id) {
     TEST_END
 }
 
+
+/**
+ * Testing the visitor functions that iterate over all gates, nets and modules of the netlist
+ *
+ * Functions: for_each_gate, for_each_net, for_each_module
+ */
+TEST_F(netlist_test, check_for_each)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        nl->create_module(MIN_MODULE_ID + 0, "mod", nl->get_top_module(), {nl->get_gate_by_id(MIN_GATE_ID + 0)});
+
+        std::set<std::shared_ptr<gate>> gates;
+        nl->for_each_gate([&gates](const std::shared_ptr<gate>& g) { gates.insert(g); });
+        EXPECT_EQ(gates, nl->get_gates());
+
+        std::unordered_set<std::shared_ptr<net>> nets;
+        nl->for_each_net([&nets](const std::shared_ptr<net>& n) { nets.insert(n); });
+        EXPECT_EQ(nets, nl->get_nets());
+
+        std::set<std::shared_ptr<module>> modules;
+        nl->for_each_module([&modules](const std::shared_ptr<module>& m) { modules.insert(m); });
+        EXPECT_EQ(modules, nl->get_modules());
+    TEST_END
+}
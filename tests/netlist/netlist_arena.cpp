@@ -0,0 +1,138 @@
+#include "netlist/gate_library/gate_library_manager.h"
+#include "netlist/netlist.h"
+#include "netlist/netlist_arena.h"
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <core/log.h>
+#include <netlist/gate.h>
+#include <netlist/module.h>
+#include <netlist/net.h>
+#include <thread>
+
+using namespace test_utils;
+
+class netlist_arena_test : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        NO_COUT_BLOCK;
+        gate_library_manager::load_all();
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the allocation of memory in the arena and the reuse of freed slots
+ *
+ * Functions: allocate, deallocate, get_reserved_bytes, get_used_bytes
+ */
+TEST_F(netlist_arena_test, check_allocation)
+{
+    TEST_START
+        netlist_arena arena;
+        EXPECT_EQ(arena.get_reserved_bytes(), 0u);
+
+        void* a = arena.allocate(40);
+        void* b = arena.allocate(40);
+        ASSERT_NE(a, nullptr);
+        ASSERT_NE(b, nullptr);
+        EXPECT_NE(a, b);
+        EXPECT_EQ((uintptr_t)a % 16, 0u);
+        EXPECT_EQ((uintptr_t)b % 16, 0u);
+        EXPECT_EQ(arena.get_used_bytes(), 96u);
+        u64 reserved = arena.get_reserved_bytes();
+        EXPECT_GT(reserved, 0u);
+
+        // a freed slot is reused by the next object of the same size class
+        arena.deallocate(a, 40);
+        EXPECT_EQ(arena.get_used_bytes(), 48u);
+        EXPECT_EQ(arena.allocate(33), a);
+
+        // many small objects share chunks
+        for (u32 i = 0; i < 100; ++i)
+        {
+            arena.allocate(40);
+        }
+        EXPECT_EQ(arena.get_reserved_bytes(), reserved);
+
+        // large objects are not taken from the chunks
+        void* large = arena.allocate(4096);
+        ASSERT_NE(large, nullptr);
+        EXPECT_EQ(arena.get_reserved_bytes(), reserved);
+        arena.deallocate(large, 4096);
+    TEST_END
+}
+
+/**
+ * Testing that memory can be returned from another thread while the owning thread keeps allocating
+ *
+ * Functions: allocate, deallocate
+ */
+TEST_F(netlist_arena_test, check_concurrent_deallocation)
+{
+    TEST_START
+        netlist_arena arena;
+        const u32 num_objects = 20000;
+
+        std::vector<void*> released;
+        for (u32 i = 0; i < num_objects; ++i)
+        {
+            released.push_back(arena.allocate(64));
+        }
+
+        std::thread releaser([&arena, &released]() {
+            for (void* p : released)
+            {
+                arena.deallocate(p, 64);
+            }
+        });
+
+        std::vector<void*> kept;
+        for (u32 i = 0; i < num_objects; ++i)
+        {
+            kept.push_back(arena.allocate(64));
+        }
+        releaser.join();
+
+        EXPECT_EQ(arena.get_used_bytes(), (u64)num_objects * 64);
+        std::sort(kept.begin(), kept.end());
+        EXPECT_EQ(std::unique(kept.begin(), kept.end()), kept.end());
+    TEST_END
+}
+
+/**
+ * Testing that gates, nets and modules are placed in the arena and released together with the netlist
+ *
+ * Functions: create, netlist destructor
+ */
+TEST_F(netlist_arena_test, check_netlist_objects)
+{
+    TEST_START
+        std::weak_ptr<gate> weak_gate;
+        std::weak_ptr<net> weak_net;
+        std::weak_ptr<module> weak_module;
+        std::shared_ptr<gate> kept_gate;
+        {
+            std::shared_ptr<netlist> nl = create_example_netlist();
+            weak_gate                   = nl->get_gate_by_id(MIN_GATE_ID + 0);
+            weak_net                    = nl->get_net_by_id(MIN_NET_ID + 13);
+            weak_module                 = nl->create_module(MIN_MODULE_ID + 1, "mod", nl->get_top_module(), {nl->get_gate_by_id(MIN_GATE_ID + 0)});
+            kept_gate                   = nl->get_gate_by_id(MIN_GATE_ID + 3);
+            EXPECT_FALSE(weak_gate.expired());
+            EXPECT_FALSE(weak_module.expired());
+        }
+
+        // all objects are released with the netlist, objects that are still referenced stay valid
+        EXPECT_TRUE(weak_gate.expired());
+        EXPECT_TRUE(weak_net.expired());
+        EXPECT_TRUE(weak_module.expired());
+        ASSERT_NE(kept_gate, nullptr);
+        EXPECT_EQ(kept_gate->get_name(), "gate_3");
+        EXPECT_TRUE(kept_gate->get_fan_in_nets().empty());
+        EXPECT_EQ(kept_gate->get_module(), nullptr);
+    TEST_END
+}
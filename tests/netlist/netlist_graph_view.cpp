@@ -0,0 +1,195 @@
+#include "netlist/gate_library/gate_library_manager.h"
+#include "netlist/netlist.h"
+#include "netlist/netlist_graph_view.h"
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <core/log.h>
+#include <netlist/gate.h>
+#include <netlist/net.h>
+#include <algorithm>
+
+using namespace test_utils;
+
+class netlist_graph_view_test : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        NO_COUT_BLOCK;
+        gate_library_manager::load_all();
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // maps a range of gate indices back to gate ids (sorted)
+    std::vector<u32> to_ids(const netlist_graph_view& view, netlist_graph_view::range<u32> r)
+    {
+        std::vector<u32> res;
+        for (u32 i : r)
+        {
+            res.push_back(view.get_gate(i)->get_id());
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    std::vector<u32> to_ids(const std::vector<endpoint>& endpoints)
+    {
+        std::vector<u32> res;
+        for (const auto& ep : endpoints)
+        {
+            res.push_back(ep.gate->get_id());
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+};
+
+/**
+ * Testing the index mapping of gates and nets
+ *
+ * Functions: constructor, get_num_gates, get_num_nets, get_gate_index, get_net_index, get_gate, get_net
+ */
+TEST_F(netlist_graph_view_test, check_index_mapping)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        netlist_graph_view view(nl);
+
+        EXPECT_TRUE(view.is_valid());
+        EXPECT_EQ(view.get_netlist(), nl);
+        EXPECT_EQ(view.get_num_gates(), nl->get_gates().size());
+        EXPECT_EQ(view.get_num_nets(), nl->get_nets().size());
+
+        for (const auto& g : nl->get_gates())
+        {
+            u32 idx = view.get_gate_index(g);
+            ASSERT_NE(idx, netlist_graph_view::INVALID_INDEX);
+            EXPECT_EQ(view.get_gate(idx), g);
+        }
+        for (const auto& n : nl->get_nets())
+        {
+            u32 idx = view.get_net_index(n);
+            ASSERT_NE(idx, netlist_graph_view::INVALID_INDEX);
+            EXPECT_EQ(view.get_net(idx), n);
+        }
+
+        // indices are ordered by id
+        for (u32 i = 1; i < view.get_num_gates(); ++i)
+        {
+            EXPECT_LT(view.get_gate(i - 1)->get_id(), view.get_gate(i)->get_id());
+        }
+
+        // gates of other netlists are unknown
+        std::shared_ptr<netlist> other = create_example_netlist();
+        EXPECT_EQ(view.get_gate_index(other->get_gate_by_id(MIN_GATE_ID + 0)), netlist_graph_view::INVALID_INDEX);
+        EXPECT_EQ(view.get_gate_index(nullptr), netlist_graph_view::INVALID_INDEX);
+        EXPECT_EQ(view.get_net_index(nullptr), netlist_graph_view::INVALID_INDEX);
+    TEST_END
+}
+
+/**
+ * Testing that the CSR connectivity matches the gate and net accessors
+ *
+ * Functions: get_fan_in, get_fan_out, get_source, get_destinations, get_successors, get_predecessors
+ */
+TEST_F(netlist_graph_view_test, check_connectivity)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        netlist_graph_view view(nl);
+
+        for (const auto& g : nl->get_gates())
+        {
+            u32 idx = view.get_gate_index(g);
+
+            auto fan_in = view.get_fan_in(idx);
+            EXPECT_EQ(fan_in.size(), g->get_fan_in_nets().size());
+            for (u32 i = 0; i < fan_in.size(); ++i)
+            {
+                ASSERT_LT(fan_in[i].pin, g->get_input_pins().size());
+                std::string pin = g->get_input_pins()[fan_in[i].pin];
+                EXPECT_EQ(g->get_fan_in_net(pin), view.get_net(fan_in[i].index));
+                if (i > 0)
+                {
+                    EXPECT_LT(fan_in[i - 1].pin, fan_in[i].pin);
+                }
+            }
+
+            auto fan_out = view.get_fan_out(idx);
+            EXPECT_EQ(fan_out.size(), g->get_fan_out_nets().size());
+            for (const auto& c : fan_out)
+            {
+                ASSERT_LT(c.pin, g->get_output_pins().size());
+                EXPECT_EQ(g->get_fan_out_net(g->get_output_pins()[c.pin]), view.get_net(c.index));
+            }
+
+            EXPECT_EQ(to_ids(view, view.get_successors(idx)), to_ids(g->get_successors()));
+            EXPECT_EQ(to_ids(view, view.get_predecessors(idx)), to_ids(g->get_predecessors()));
+        }
+
+        for (const auto& n : nl->get_nets())
+        {
+            u32 idx  = view.get_net_index(n);
+            auto src = view.get_source(idx);
+            if (n->get_src().gate == nullptr)
+            {
+                EXPECT_EQ(src.index, netlist_graph_view::INVALID_INDEX);
+            }
+            else
+            {
+                EXPECT_EQ(view.get_gate(src.index), n->get_src().gate);
+                EXPECT_EQ(n->get_src().gate->get_output_pins()[src.pin], n->get_src().pin_type);
+            }
+
+            auto dsts = view.get_destinations(idx);
+            ASSERT_EQ(dsts.size(), n->get_num_of_dsts());
+            for (u32 i = 0; i < dsts.size(); ++i)
+            {
+                endpoint dst = n->get_dsts()[i];
+                EXPECT_EQ(view.get_gate(dsts[i].index), dst.gate);
+                EXPECT_EQ(dst.gate->get_input_pins()[dsts[i].pin], dst.pin_type);
+            }
+        }
+    TEST_END
+}
+
+/**
+ * Testing the invalidation of the view on netlist changes and the rebuild
+ *
+ * Functions: is_valid, rebuild
+ */
+TEST_F(netlist_graph_view_test, check_invalidation)
+{
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        netlist_graph_view view(nl);
+        EXPECT_TRUE(view.is_valid());
+
+        // renaming does not change the connectivity
+        nl->get_net_by_id(MIN_NET_ID + 13)->set_name("renamed");
+        EXPECT_TRUE(view.is_valid());
+
+        // changes in other netlists are ignored
+        std::shared_ptr<netlist> other = create_example_netlist();
+        other->create_gate(MIN_GATE_ID + 100, get_gate_type_by_name("INV"), "other_gate");
+        EXPECT_TRUE(view.is_valid());
+
+        // adding a destination invalidates the view
+        std::shared_ptr<gate> inv = nl->create_gate(MIN_GATE_ID + 100, get_gate_type_by_name("INV"), "new_gate");
+        EXPECT_FALSE(view.is_valid());
+        view.rebuild();
+        EXPECT_TRUE(view.is_valid());
+        EXPECT_EQ(view.get_num_gates(), nl->get_gates().size());
+
+        std::shared_ptr<net> n = nl->get_net_by_id(MIN_NET_ID + 13);
+        u32 num_dsts           = view.get_destinations(view.get_net_index(n)).size();
+        n->add_dst(inv, "I");
+        EXPECT_FALSE(view.is_valid());
+        view.rebuild();
+        EXPECT_EQ(view.get_destinations(view.get_net_index(n)).size(), num_dsts + 1);
+        EXPECT_EQ(view.get_predecessors(view.get_gate_index(inv)).size(), 1u);
+    TEST_END
+}
@@ -0,0 +1,209 @@
+#include "netlist/gate_library/gate_library_manager.h"
+#include "netlist/netlist.h"
+#include "netlist/netlist_journal.h"
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <core/log.h>
+#include <netlist/gate.h>
+#include <netlist/module.h>
+#include <netlist/net.h>
+#include <set>
+#include <sstream>
+
+using namespace test_utils;
+
+class netlist_journal_test : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        NO_COUT_BLOCK;
+        gate_library_manager::load_all();
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // textual description of everything the journal is able to restore
+    std::string snapshot(const std::shared_ptr<netlist>& nl)
+    {
+        std::stringstream ss;
+        for (const auto& g : nl->get_gates())
+        {
+            ss << "gate " << g->get_id() << " " << g->get_name() << " " << g->get_type()->get_name() << " " << g->get_module()->get_id() << " " << g->get_location_x() << " "
+               << g->get_location_y() << " " << nl->is_vcc_gate(g) << nl->is_gnd_gate(g);
+            for (const auto& [key, value] : g->get_data())
+            {
+                ss << " " << std::get<0>(key) << ":" << std::get<1>(key) << "=" << std::get<1>(value);
+            }
+            for (const auto& [name, function] : g->get_boolean_functions(true))
+            {
+                ss << " " << name << "=" << function;
+            }
+            ss << "\n";
+        }
+        for (const auto& n : nl->get_nets())
+        {
+            ss << "net " << n->get_id() << " " << n->get_name() << " " << nl->is_global_input_net(n) << nl->is_global_output_net(n);
+            if (auto src = n->get_src(); src.gate != nullptr)
+            {
+                ss << " src " << src.gate->get_id() << ":" << src.pin_type;
+            }
+            std::set<std::pair<u32, std::string>> dsts;
+            for (const auto& dst : n->get_dsts())
+            {
+                dsts.insert({dst.gate->get_id(), dst.pin_type});
+            }
+            for (const auto& dst : dsts)
+            {
+                ss << " dst " << dst.first << ":" << dst.second;
+            }
+            for (const auto& [key, value] : n->get_data())
+            {
+                ss << " " << std::get<0>(key) << ":" << std::get<1>(key) << "=" << std::get<1>(value);
+            }
+            ss << "\n";
+        }
+        for (const auto& m : nl->get_modules())
+        {
+            ss << "module " << m->get_id() << " " << m->get_name() << " " << (m->get_parent_module() ? m->get_parent_module()->get_id() : 0) << "\n";
+        }
+
+        // sets of objects are ordered by address, so sort the lines for a stable comparison
+        std::multiset<std::string> lines;
+        for (std::string line; std::getline(ss, line);)
+        {
+            lines.insert(line);
+        }
+        std::string res;
+        for (const auto& line : lines)
+        {
+            res += line + "\n";
+        }
+        return res;
+    }
+};
+
+/**
+ * Testing that undo restores the netlist exactly and redo reapplies all modifications
+ *
+ * Functions: checkpoint, undo, redo, get_num_undo_steps, get_num_redo_steps
+ */
+TEST_F(netlist_journal_test, check_undo_redo){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        std::shared_ptr<module> m_0 = nl->create_module(MIN_MODULE_ID+0, "m_0", nl->get_top_module(), {nl->get_gate_by_id(MIN_GATE_ID+0)});
+        std::shared_ptr<module> m_1 = nl->create_module(MIN_MODULE_ID+1, "m_1", m_0, {nl->get_gate_by_id(MIN_GATE_ID+3)});
+        nl->get_gate_by_id(MIN_GATE_ID+0)->set_data("category", "key", "string", "value");
+        nl->get_gate_by_id(MIN_GATE_ID+0)->add_boolean_function("custom", boolean_function::from_string("I0 & I1"));
+        nl->get_net_by_id(MIN_NET_ID+045)->set_data("category", "key", "string", "value");
+        std::string initial = snapshot(nl);
+
+        netlist_journal journal(nl);
+        EXPECT_TRUE(journal.is_attached());
+        EXPECT_EQ(nl->get_journal(), &journal);
+
+        // a group of structural modifications
+        auto new_gate = nl->create_gate(MIN_GATE_ID+100, get_gate_type_by_name("AND2"), "new_gate");
+        auto new_net  = nl->create_net(MIN_NET_ID+100, "new_net");
+        new_net->set_src(new_gate, "O");
+        new_net->add_dst(nl->get_gate_by_id(MIN_GATE_ID+4), "I");
+        nl->get_net_by_id(MIN_NET_ID+045)->remove_dst(nl->get_gate_by_id(MIN_GATE_ID+4), "I");
+        nl->mark_global_output_net(new_net);
+        nl->mark_vcc_gate(nl->get_gate_by_id(MIN_GATE_ID+2));
+        m_1->assign_gate(new_gate);
+        journal.checkpoint();
+        std::string after_first = snapshot(nl);
+
+        // a group of deletions and renames
+        nl->delete_gate(nl->get_gate_by_id(MIN_GATE_ID+0));
+        nl->delete_net(nl->get_net_by_id(MIN_NET_ID+045));
+        nl->delete_module(m_0);
+        m_1->set_name("renamed");
+        new_gate->set_name("renamed");
+        new_net->set_name("renamed");
+        new_gate->set_location({1.0f, 2.0f});
+        nl->unmark_global_output_net(new_net);
+        std::string after_second = snapshot(nl);
+
+        EXPECT_EQ(journal.get_num_undo_steps(), (u32)2);
+        EXPECT_GT(journal.get_size(), (u64)0);
+
+        EXPECT_TRUE(journal.undo());
+        EXPECT_EQ(snapshot(nl), after_first);
+        EXPECT_TRUE(journal.undo());
+        EXPECT_EQ(snapshot(nl), initial);
+        EXPECT_FALSE(journal.undo());
+        EXPECT_EQ(journal.get_num_redo_steps(), (u32)2);
+
+        EXPECT_TRUE(journal.redo());
+        EXPECT_EQ(snapshot(nl), after_first);
+        EXPECT_TRUE(journal.redo());
+        EXPECT_EQ(snapshot(nl), after_second);
+        EXPECT_FALSE(journal.redo());
+
+        // undo and redo are not recorded themselves
+        EXPECT_EQ(journal.get_num_undo_steps(), (u32)2);
+        EXPECT_EQ(journal.get_num_redo_steps(), (u32)0);
+    TEST_END
+}
+
+/**
+ * Testing that new modifications discard undone groups and that the size of the journal is bounded
+ *
+ * Functions: undo, redo, get_size, clear
+ */
+TEST_F(netlist_journal_test, check_limits){
+    TEST_START
+        std::shared_ptr<netlist> nl = create_example_netlist();
+        {
+            netlist_journal journal(nl);
+            nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("a");
+            journal.checkpoint();
+            nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("b");
+            journal.undo();
+            EXPECT_EQ(journal.get_num_redo_steps(), (u32)1);
+
+            // a new modification discards the redo steps
+            nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("c");
+            EXPECT_EQ(journal.get_num_redo_steps(), (u32)0);
+            EXPECT_FALSE(journal.redo());
+
+            journal.clear();
+            EXPECT_EQ(journal.get_num_undo_steps(), (u32)0);
+            EXPECT_EQ(journal.get_size(), (u64)0);
+
+            // only one journal per netlist
+            NO_COUT_TEST_BLOCK;
+            netlist_journal second(nl);
+            EXPECT_FALSE(second.is_attached());
+        }
+        EXPECT_EQ(nl->get_journal(), nullptr);
+        {
+            netlist_journal journal(nl, 256);
+            for (u32 i = 0; i < 100; ++i)
+            {
+                nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("name_" + std::to_string(i));
+                journal.checkpoint();
+            }
+            EXPECT_LE(journal.get_size(), (u64)256);
+            EXPECT_GT(journal.get_num_undo_steps(), (u32)0);
+            EXPECT_LT(journal.get_num_undo_steps(), (u32)100);
+
+            while (journal.undo())
+            {
+            }
+            EXPECT_NE(nl->get_gate_by_id(MIN_GATE_ID+0)->get_name(), "gate_0");
+        }
+        {
+            // a group that is never closed is bounded as well
+            netlist_journal journal(nl, 256);
+            for (u32 i = 0; i < 100; ++i)
+            {
+                nl->get_gate_by_id(MIN_GATE_ID+0)->set_name("open_" + std::to_string(i));
+                EXPECT_LE(journal.get_size(), (u64)256);
+            }
+        }
+    TEST_END
+}
@@ -0,0 +1,257 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <netlist/simulation/pattern_simulator.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class pattern_simulator_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    const boolean_function::value X    = boolean_function::X;
+    const boolean_function::value ZERO = boolean_function::ZERO;
+    const boolean_function::value ONE  = boolean_function::ONE;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("PATTERN_SIMULATOR_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "OR2", {"A", "B"}, "A | B");
+        add_combinational_type(m_gl, "XOR2", {"A", "B"}, "A ^ B");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+        add_combinational_type(m_gl, "MUX", {"S", "A", "B"}, "(S & B) | (!S & A)");
+
+        add_flip_flop_type(m_gl, "DFF");
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing random patterns against the evaluation of the equivalent boolean function
+ *
+ * Functions: constructor, randomize_inputs, simulate, get_value, get_num_patterns
+ */
+TEST_F(pattern_simulator_test, check_random_patterns)
+{
+    TEST_START
+    {
+        // out = MUX(a ^ b, c, a & !c)
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto b   = add_input(nl, "b");
+        auto c   = add_input(nl, "c");
+        auto ab  = add_gate(nl, "XOR2", {a, b})[0];
+        auto c_n = add_gate(nl, "INV", {c})[0];
+        auto ac  = add_gate(nl, "AND2", {a, c_n})[0];
+        auto out = add_gate(nl, "MUX", {ab, c, ac})[0];
+
+        auto expected = boolean_function::from_string("((a ^ b) & a & !c) | (!(a ^ b) & c)", {"a", "b", "c"});
+        for (u32 num_words : {1, 4, 8})
+        {
+            pattern_simulator sim(nl, num_words);
+            EXPECT_EQ(sim.get_num_words(), num_words);
+            EXPECT_EQ(sim.get_num_patterns(), 64 * num_words);
+            EXPECT_EQ(sim.get_input_nets(), std::vector<std::shared_ptr<net>>({a, b, c}));
+
+            sim.randomize_inputs(42);
+            sim.simulate();
+            for (u32 p = 0; p < sim.get_num_patterns(); ++p)
+            {
+                std::map<std::string, boolean_function::value> inputs = {{"a", sim.get_value(a, p)}, {"b", sim.get_value(b, p)}, {"c", sim.get_value(c, p)}};
+                ASSERT_NE(inputs["a"], X);
+                ASSERT_EQ(sim.get_value(out, p), expected.evaluate(inputs)) << "pattern " << p;
+            }
+        }
+
+        // the seed determines the patterns
+        pattern_simulator sim_a(nl), sim_b(nl), sim_c(nl);
+        sim_a.randomize_inputs(1);
+        sim_b.randomize_inputs(1);
+        sim_c.randomize_inputs(2);
+        EXPECT_EQ(sim_a.get_signature(a), sim_b.get_signature(a));
+        EXPECT_NE(sim_a.get_signature(a), sim_c.get_signature(a));
+    }
+    TEST_END
+}
+
+/**
+ * Testing exhaustive enumeration of input assignments
+ *
+ * Functions: set_exhaustive_inputs, get_signature
+ */
+TEST_F(pattern_simulator_test, check_exhaustive_patterns)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto b   = add_input(nl, "b");
+        auto out = add_gate(nl, "AND2", {a, b})[0];
+
+        pattern_simulator sim(nl);
+        EXPECT_TRUE(sim.set_exhaustive_inputs({a, b}));
+        sim.simulate();
+        EXPECT_EQ(sim.get_signature(a)[0] & 0xF, 0xA);
+        EXPECT_EQ(sim.get_signature(b)[0] & 0xF, 0xC);
+        EXPECT_EQ(sim.get_signature(out)[0] & 0xF, 0x8);
+        EXPECT_EQ(sim.get_signature(out)[0], 0x8888888888888888ull);
+    }
+    {
+        // 8 inputs need 256 patterns, i.e., four words or four passes of one word
+        auto nl = std::make_shared<netlist>(m_gl);
+        std::vector<std::shared_ptr<net>> inputs;
+        for (u32 i = 0; i < 8; ++i)
+        {
+            inputs.push_back(add_input(nl, "in_" + std::to_string(i)));
+        }
+        auto parity = inputs[0];
+        for (u32 i = 1; i < 8; ++i)
+        {
+            parity = add_gate(nl, "XOR2", {parity, inputs[i]})[0];
+        }
+
+        pattern_simulator wide(nl, 4);
+        pattern_simulator narrow(nl, 1);
+        EXPECT_TRUE(wide.set_exhaustive_inputs(inputs));
+        wide.simulate();
+        for (u32 pass = 0; pass < 4; ++pass)
+        {
+            EXPECT_TRUE(narrow.set_exhaustive_inputs(inputs, 64 * pass));
+            narrow.simulate();
+            EXPECT_EQ(narrow.get_signature(parity)[0], wide.get_signature(parity)[pass]);
+            for (u32 p = 0; p < 64; ++p)
+            {
+                u32 assignment = 64 * pass + p;
+                EXPECT_EQ(narrow.get_value(parity, p), (__builtin_popcount(assignment) & 1) ? ONE : ZERO);
+            }
+        }
+    }
+    TEST_END
+}
+
+/**
+ * Testing the propagation of X
+ *
+ * Functions: set_input, get_x_mask
+ */
+TEST_F(pattern_simulator_test, check_x_propagation)
+{
+    TEST_START
+    {
+        auto nl      = std::make_shared<netlist>(m_gl);
+        auto a       = add_input(nl, "a");
+        auto b       = add_input(nl, "b");
+        auto and_out = add_gate(nl, "AND2", {a, b})[0];
+        auto or_out  = add_gate(nl, "OR2", {a, b})[0];
+
+        pattern_simulator sim(nl);
+        sim.simulate();
+        EXPECT_EQ(sim.get_x_mask(and_out), std::vector<u64>({~0ull}));
+
+        // a is X, ONE and ZERO in the patterns 0, 1 and 2, b is ZERO
+        EXPECT_TRUE(sim.set_input(a, {0x2}, {0x4}));
+        EXPECT_TRUE(sim.set_input(b, ZERO));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(and_out, 0), ZERO);
+        EXPECT_EQ(sim.get_value(or_out, 0), X);
+        EXPECT_EQ(sim.get_value(or_out, 1), ONE);
+        EXPECT_EQ(sim.get_value(or_out, 2), ZERO);
+        EXPECT_EQ(sim.get_x_mask(or_out)[0], ~0x6ull);
+        EXPECT_EQ(sim.get_signature(or_out)[0], 0x2ull);
+
+        // bits set in both rails are X
+        EXPECT_TRUE(sim.set_input(a, {0x3}, {0x1}));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(a, 0), X);
+        EXPECT_EQ(sim.get_value(a, 1), ONE);
+
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(sim.set_input(and_out, ONE));
+        EXPECT_FALSE(sim.set_input(a, {0, 0}, {0}));
+        EXPECT_FALSE(sim.set_exhaustive_inputs({a, or_out}));
+        EXPECT_EQ(sim.get_value(a, 64), X);
+        EXPECT_EQ(sim.get_value(nullptr, 0), X);
+        EXPECT_TRUE(sim.get_signature(nullptr).empty());
+    }
+    TEST_END
+}
+
+/**
+ * Testing flip-flop states as free inputs
+ *
+ * Functions: get_input_nets, set_input
+ */
+TEST_F(pattern_simulator_test, check_sequential_inputs)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto clk = add_input(nl, "clk");
+        auto a   = add_input(nl, "a");
+        auto ff  = add_gate(nl, "DFF", {a, clk});
+        auto out = add_gate(nl, "AND2", {ff[1], a})[0];
+
+        pattern_simulator sim(nl);
+        EXPECT_EQ(sim.get_input_nets(), std::vector<std::shared_ptr<net>>({clk, a, ff[0]}));
+
+        // setting the inverted state output sets the complement of the state
+        EXPECT_TRUE(sim.set_input(ff[1], ONE));
+        EXPECT_TRUE(sim.set_input(a, ONE));
+        sim.simulate();
+        EXPECT_EQ(sim.get_value(ff[0], 5), ZERO);
+        EXPECT_EQ(sim.get_value(out, 5), ONE);
+
+        sim.randomize_inputs(7);
+        sim.simulate();
+        for (u32 p = 0; p < 64; ++p)
+        {
+            EXPECT_NE(sim.get_value(ff[0], p), sim.get_value(ff[1], p));
+        }
+    }
+    TEST_END
+}
+
+/**
+ * Testing the grouping of nets by signature
+ *
+ * Functions: get_signature_classes
+ */
+TEST_F(pattern_simulator_test, check_signature_classes)
+{
+    TEST_START
+    {
+        // a & b and !(!a | !b) are equivalent, a ^ b is not
+        auto nl     = std::make_shared<netlist>(m_gl);
+        auto a      = add_input(nl, "a");
+        auto b      = add_input(nl, "b");
+        auto and_ab = add_gate(nl, "AND2", {a, b})[0];
+        auto a_n    = add_gate(nl, "INV", {a})[0];
+        auto b_n    = add_gate(nl, "INV", {b})[0];
+        auto or_n   = add_gate(nl, "OR2", {a_n, b_n})[0];
+        auto nand   = add_gate(nl, "INV", {or_n})[0];
+        add_gate(nl, "XOR2", {a, b});
+
+        pattern_simulator sim(nl, 2);
+        sim.randomize_inputs(3);
+        sim.simulate();
+        auto classes = sim.get_signature_classes();
+        ASSERT_EQ(classes.size(), 1);
+        EXPECT_EQ(classes[0], std::vector<std::shared_ptr<net>>({and_ab, nand}));
+    }
+    TEST_END
+}
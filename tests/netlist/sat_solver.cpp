@@ -0,0 +1,207 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/sat_solver.h>
+#include <iostream>
+
+
+using namespace test_utils;
+
+
+class sat_solver_test : public ::testing::Test
+{
+protected:
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // checks whether the model of the solver satisfies all given clauses
+    bool satisfies(const sat_solver& solver, const std::vector<std::vector<u32>>& clauses)
+    {
+        for (const auto& clause : clauses)
+        {
+            bool satisfied = false;
+            for (u32 literal : clause)
+            {
+                satisfied |= (solver.get_model_value(literal >> 1) != (bool)(literal & 1));
+            }
+            if (!satisfied)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * Testing satisfiable and unsatisfiable formulas
+ *
+ * Functions: create_variable, add_clause, solve, get_model_value
+ */
+TEST_F(sat_solver_test, check_solve){
+    TEST_START
+        {
+            // The empty formula is satisfiable
+            sat_solver solver;
+            EXPECT_EQ(solver.solve(), sat_solver::result::SATISFIABLE);
+        }
+        {
+            // Unit clauses determine the model
+            sat_solver solver;
+            u32 a = solver.create_variable();
+            u32 b = solver.create_variable();
+            EXPECT_TRUE(solver.add_clause({sat_solver::get_literal(a)}));
+            EXPECT_TRUE(solver.add_clause({sat_solver::get_literal(a, true), sat_solver::get_literal(b, true)}));
+            ASSERT_EQ(solver.solve(), sat_solver::result::SATISFIABLE);
+            EXPECT_TRUE(solver.get_model_value(a));
+            EXPECT_FALSE(solver.get_model_value(b));
+            EXPECT_EQ(solver.get_num_variables(), 2);
+        }
+        {
+            // Pigeonhole principle: 6 pigeons do not fit into 5 holes
+            const u32 pigeons = 6;
+            const u32 holes   = 5;
+            sat_solver solver;
+            std::vector<std::vector<u32>> in_hole(pigeons, std::vector<u32>(holes));
+            for (u32 p = 0; p < pigeons; ++p)
+            {
+                std::vector<u32> clause;
+                for (u32 h = 0; h < holes; ++h)
+                {
+                    in_hole[p][h] = solver.create_variable();
+                    clause.push_back(sat_solver::get_literal(in_hole[p][h]));
+                }
+                solver.add_clause(clause);
+            }
+            for (u32 h = 0; h < holes; ++h)
+            {
+                for (u32 p = 0; p < pigeons; ++p)
+                {
+                    for (u32 q = p + 1; q < pigeons; ++q)
+                    {
+                        solver.add_clause({sat_solver::get_literal(in_hole[p][h], true), sat_solver::get_literal(in_hole[q][h], true)});
+                    }
+                }
+            }
+            EXPECT_EQ(solver.solve(), sat_solver::result::UNSATISFIABLE);
+            EXPECT_GT(solver.get_num_conflicts(), 0);
+        }
+        {
+            // Random 3-SAT below the phase transition, every model must satisfy all clauses
+            u64 state = 42;
+            auto next = [&state]() {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                return state;
+            };
+            const u32 num_variables = 100;
+            for (u32 round = 0; round < 5; ++round)
+            {
+                sat_solver solver;
+                for (u32 i = 0; i < num_variables; ++i)
+                {
+                    solver.create_variable();
+                }
+                std::vector<std::vector<u32>> clauses;
+                for (u32 i = 0; i < 350; ++i)
+                {
+                    std::vector<u32> clause;
+                    for (u32 j = 0; j < 3; ++j)
+                    {
+                        clause.push_back(sat_solver::get_literal(next() % num_variables, next() & 1));
+                    }
+                    clauses.push_back(clause);
+                    solver.add_clause(clause);
+                }
+                auto res = solver.solve();
+                ASSERT_NE(res, sat_solver::result::UNKNOWN);
+                if (res == sat_solver::result::SATISFIABLE)
+                {
+                    EXPECT_TRUE(satisfies(solver, clauses));
+                }
+            }
+        }
+        // NEGATIVE
+        {
+            // Clauses over unknown variables are rejected
+            sat_solver solver;
+            solver.create_variable();
+            EXPECT_FALSE(solver.add_clause({sat_solver::get_literal(1)}));
+        }
+        {
+            // Contradicting units make the formula unsatisfiable at once
+            sat_solver solver;
+            u32 a = solver.create_variable();
+            EXPECT_TRUE(solver.add_clause({sat_solver::get_literal(a)}));
+            EXPECT_FALSE(solver.add_clause({sat_solver::get_literal(a, true)}));
+            EXPECT_EQ(solver.solve(), sat_solver::result::UNSATISFIABLE);
+        }
+    TEST_END
+}
+
+/**
+ * Testing incremental solving under assumptions
+ *
+ * Functions: solve, add_clause
+ */
+TEST_F(sat_solver_test, check_assumptions){
+    TEST_START
+        {
+            // a -> b, b -> c
+            sat_solver solver;
+            u32 a = solver.create_variable();
+            u32 b = solver.create_variable();
+            u32 c = solver.create_variable();
+            solver.add_clause({sat_solver::get_literal(a, true), sat_solver::get_literal(b)});
+            solver.add_clause({sat_solver::get_literal(b, true), sat_solver::get_literal(c)});
+
+            ASSERT_EQ(solver.solve({sat_solver::get_literal(a)}), sat_solver::result::SATISFIABLE);
+            EXPECT_TRUE(solver.get_model_value(c));
+            EXPECT_EQ(solver.solve({sat_solver::get_literal(a), sat_solver::get_literal(c, true)}), sat_solver::result::UNSATISFIABLE);
+
+            // assumptions do not persist
+            ASSERT_EQ(solver.solve({sat_solver::get_literal(c, true)}), sat_solver::result::SATISFIABLE);
+            EXPECT_FALSE(solver.get_model_value(a));
+
+            // clauses added later are taken into account
+            solver.add_clause({sat_solver::get_literal(a)});
+            EXPECT_EQ(solver.solve({sat_solver::get_literal(c, true)}), sat_solver::result::UNSATISFIABLE);
+            ASSERT_EQ(solver.solve(), sat_solver::result::SATISFIABLE);
+            EXPECT_TRUE(solver.get_model_value(b));
+        }
+        {
+            // A hard instance is given up once the conflict limit is reached
+            const u32 pigeons = 9;
+            const u32 holes   = 8;
+            sat_solver solver;
+            std::vector<std::vector<u32>> in_hole(pigeons, std::vector<u32>(holes));
+            for (u32 p = 0; p < pigeons; ++p)
+            {
+                std::vector<u32> clause;
+                for (u32 h = 0; h < holes; ++h)
+                {
+                    in_hole[p][h] = solver.create_variable();
+                    clause.push_back(sat_solver::get_literal(in_hole[p][h]));
+                }
+                solver.add_clause(clause);
+            }
+            for (u32 h = 0; h < holes; ++h)
+            {
+                for (u32 p = 0; p < pigeons; ++p)
+                {
+                    for (u32 q = p + 1; q < pigeons; ++q)
+                    {
+                        solver.add_clause({sat_solver::get_literal(in_hole[p][h], true), sat_solver::get_literal(in_hole[q][h], true)});
+                    }
+                }
+            }
+            EXPECT_EQ(solver.solve({}, 10), sat_solver::result::UNKNOWN);
+        }
+    TEST_END
+}
@@ -0,0 +1,326 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/boolean_function.h>
+#include <netlist/gate.h>
+#include <netlist/gate_library/gate_library.h>
+#include <netlist/gate_library/gate_type/gate_type.h>
+#include <netlist/gate_library/gate_type/gate_type_sequential.h>
+#include <netlist/net.h>
+#include <netlist/netlist.h>
+#include <netlist/simulation/simulation_model.h>
+#include <iostream>
+#include <set>
+
+
+using namespace test_utils;
+
+
+class simulation_model_test : public ::testing::Test
+{
+protected:
+
+    std::shared_ptr<gate_library> m_gl;
+
+    virtual void SetUp()
+    {
+        m_gl = std::make_shared<gate_library>("SIMULATION_MODEL_TEST_LIB");
+        add_combinational_type(m_gl, "AND2", {"A", "B"}, "A & B");
+        add_combinational_type(m_gl, "INV", {"A"}, "!A");
+
+        auto dff = add_flip_flop_type(m_gl, "DFF", false, true);
+        dff->set_set_reset_behavior(gate_type_sequential::set_reset_behavior::L, gate_type_sequential::set_reset_behavior::H);
+        dff->set_init_data_category("generic");
+        dff->set_init_data_identifier("INIT");
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // position of the node driving a net in the combinational order
+    u32 get_position(const simulation_model& model, const std::shared_ptr<net>& n)
+    {
+        u32 index         = model.get_graph_view().get_net_index(n);
+        const auto& nodes = model.get_combinational_nodes();
+        for (u32 i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i].output == index)
+            {
+                return i;
+            }
+        }
+        return simulation_model::INVALID;
+    }
+};
+
+/**
+ * Testing the compilation of combinational logic
+ *
+ * Functions: constructor, get_combinational_nodes, get_input_nets, get_function, get_num_functions
+ */
+TEST_F(simulation_model_test, check_combinational_nodes)
+{
+    TEST_START
+    {
+        // the gates are created in reverse topological order
+        auto nl = std::make_shared<netlist>(m_gl);
+        auto a  = add_input(nl, "a");
+        auto b  = add_input(nl, "b");
+        auto c  = nl->create_net("c");
+        auto d  = nl->create_net("d");
+
+        auto inv = nl->create_gate(m_gl->get_gate_types().at("INV"), "inv");
+        d->add_dst(inv, "A");
+        auto e = nl->create_net("e");
+        e->set_src(inv, "O");
+
+        auto and_1 = nl->create_gate(m_gl->get_gate_types().at("AND2"), "and_1");
+        c->add_dst(and_1, "A");
+        b->add_dst(and_1, "B");
+        d->set_src(and_1, "O");
+
+        auto and_0 = nl->create_gate(m_gl->get_gate_types().at("AND2"), "and_0");
+        a->add_dst(and_0, "A");
+        b->add_dst(and_0, "B");
+        c->set_src(and_0, "O");
+
+        simulation_model model(nl);
+        EXPECT_EQ(model.get_combinational_nodes().size(), 3);
+        EXPECT_EQ(model.get_num_unordered_nodes(), 0);
+        EXPECT_LT(get_position(model, c), get_position(model, d));
+        EXPECT_LT(get_position(model, d), get_position(model, e));
+
+        // both AND gates share their compiled function
+        EXPECT_EQ(model.get_num_functions(), 2);
+        EXPECT_EQ(model.get_combinational_nodes()[get_position(model, c)].function, model.get_combinational_nodes()[get_position(model, d)].function);
+
+        const auto& view = model.get_graph_view();
+        EXPECT_EQ(model.get_input_nets(), std::vector<u32>({view.get_net_index(a), view.get_net_index(b)}));
+        EXPECT_TRUE(model.is_input_net(view.get_net_index(a)));
+        EXPECT_FALSE(model.is_input_net(view.get_net_index(c)));
+        EXPECT_FALSE(model.is_input_net(netlist_graph_view::INVALID_INDEX));
+        EXPECT_EQ(model.get_num_values(), 6);
+        EXPECT_EQ(model.get_max_num_inputs(), 2);
+
+        // inputs are listed in slot order
+        const auto& node = model.get_combinational_nodes()[get_position(model, d)];
+        EXPECT_EQ(model.get_input_indices()[node.first_input], view.get_net_index(c));
+        EXPECT_EQ(model.get_input_indices()[node.first_input + 1], view.get_net_index(b));
+        EXPECT_EQ(model.get_function(node.function).get_variables(), std::vector<std::string>({"A", "B"}));
+    }
+    {
+        // unconnected input pins read the constant X
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto out = add_gate(nl, "AND2", {a, nullptr})[0];
+
+        simulation_model model(nl);
+        ASSERT_EQ(model.get_combinational_nodes().size(), 1);
+        const auto& node = model.get_combinational_nodes()[0];
+        EXPECT_EQ(model.get_input_indices()[node.first_input + 1], model.get_constant_x_index());
+        EXPECT_EQ(model.get_constant_x_index(), model.get_graph_view().get_num_nets());
+        EXPECT_EQ(node.output, model.get_graph_view().get_net_index(out));
+    }
+    {
+        // nets without a source are inputs as well
+        auto nl       = std::make_shared<netlist>(m_gl);
+        auto floating = nl->create_net("floating");
+        add_gate(nl, "INV", {floating});
+
+        simulation_model model(nl);
+        EXPECT_TRUE(model.is_input_net(model.get_graph_view().get_net_index(floating)));
+    }
+    TEST_END
+}
+
+/**
+ * Testing combinational loops
+ *
+ * Functions: get_num_unordered_nodes
+ */
+TEST_F(simulation_model_test, check_combinational_loops)
+{
+    TEST_START
+    {
+        auto nl = std::make_shared<netlist>(m_gl);
+        auto a  = add_input(nl, "a");
+        auto g  = nl->create_gate(m_gl->get_gate_types().at("AND2"), "loop");
+        auto l  = nl->create_net("l");
+        a->add_dst(g, "A");
+        l->add_dst(g, "B");
+        l->set_src(g, "O");
+        auto out = add_gate(nl, "INV", {l})[0];
+        add_gate(nl, "INV", {a});
+
+        simulation_model model(nl);
+        EXPECT_EQ(model.get_combinational_nodes().size(), 3);
+        EXPECT_EQ(model.get_num_unordered_nodes(), 2);
+        EXPECT_LT(get_position(model, l), get_position(model, out));
+    }
+    TEST_END
+}
+
+/**
+ * Testing the compilation of flip-flops
+ *
+ * Functions: get_sequential_elements
+ */
+TEST_F(simulation_model_test, check_sequential_elements)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto d   = add_input(nl, "d");
+        auto clk = add_input(nl, "clk");
+        auto r   = add_input(nl, "r");
+
+        auto ff = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff");
+        d->add_dst(ff, "D");
+        clk->add_dst(ff, "CLK");
+        r->add_dst(ff, "R");
+        auto q  = nl->create_net("q");
+        auto qn = nl->create_net("qn");
+        q->set_src(ff, "Q");
+        qn->set_src(ff, "QN");
+        add_gate(nl, "INV", {q});
+
+        ff->set_data("generic", "INIT", "bit_vector", "1");
+
+        simulation_model model(nl);
+        EXPECT_EQ(model.get_combinational_nodes().size(), 1);
+        ASSERT_EQ(model.get_sequential_elements().size(), 1);
+
+        const auto& view = model.get_graph_view();
+        const auto& e    = model.get_sequential_elements()[0];
+        EXPECT_EQ(view.get_gate(e.gate), ff);
+        EXPECT_FALSE(e.is_latch);
+        EXPECT_NE(e.next_state, simulation_model::INVALID);
+        EXPECT_NE(e.clock, simulation_model::INVALID);
+        EXPECT_EQ(e.set, simulation_model::INVALID);
+        EXPECT_NE(e.reset, simulation_model::INVALID);
+        EXPECT_EQ(e.state_behavior, gate_type_sequential::set_reset_behavior::L);
+        EXPECT_EQ(e.inverted_state_behavior, gate_type_sequential::set_reset_behavior::H);
+        EXPECT_EQ(e.initial_value, boolean_function::ONE);
+        EXPECT_EQ(e.state_outputs, std::vector<u32>({view.get_net_index(q)}));
+        EXPECT_EQ(e.inverted_state_outputs, std::vector<u32>({view.get_net_index(qn)}));
+        EXPECT_EQ(model.get_input_indices()[e.first_input + 1], view.get_net_index(clk));
+
+        // the next state function is evaluated on the input pins of the gate
+        const auto& next_state = model.get_function(e.next_state);
+        std::vector<boolean_function::value> inputs = {boolean_function::ONE, boolean_function::ZERO, boolean_function::ZERO};
+        EXPECT_EQ(next_state.evaluate(inputs), boolean_function::ONE);
+    }
+    {
+        // init values are given as hex numbers, anything else is X
+        for (const auto& [init, expected] : std::vector<std::pair<std::string, boolean_function::value>>{
+                 {"0", boolean_function::ZERO}, {"1'b1", boolean_function::ONE}, {"\"A\"", boolean_function::ZERO}, {"F", boolean_function::ONE}, {"", boolean_function::X}, {"x", boolean_function::X}})
+        {
+            auto nl = std::make_shared<netlist>(m_gl);
+            auto ff = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff");
+            if (!init.empty())
+            {
+                ff->set_data("generic", "INIT", "bit_vector", init);
+            }
+
+            simulation_model model(nl);
+            ASSERT_EQ(model.get_sequential_elements().size(), 1);
+            EXPECT_EQ(model.get_sequential_elements()[0].initial_value, expected) << init;
+        }
+    }
+    TEST_END
+}
+
+/**
+ * Testing the readers of nets and the resolution of set and reset
+ *
+ * Functions: get_node_readers, get_element_readers, apply_set_reset
+ */
+TEST_F(simulation_model_test, check_readers)
+{
+    TEST_START
+    {
+        auto nl  = std::make_shared<netlist>(m_gl);
+        auto a   = add_input(nl, "a");
+        auto b   = add_input(nl, "b");
+        auto ab  = add_gate(nl, "AND2", {a, b})[0];
+        auto aa  = add_gate(nl, "AND2", {a, a})[0];
+        auto inv = add_gate(nl, "INV", {ab})[0];
+        auto ff  = nl->create_gate(m_gl->get_gate_types().at("DFF"), "ff");
+        inv->add_dst(ff, "D");
+        a->add_dst(ff, "CLK");
+
+        simulation_model model(nl);
+        const auto& view  = model.get_graph_view();
+        const auto& nodes = model.get_combinational_nodes();
+        auto readers      = [&](const std::shared_ptr<net>& n) {
+            std::set<u32> result;
+            for (u32 node : model.get_node_readers(view.get_net_index(n)))
+            {
+                result.insert(nodes[node].output);
+            }
+            return result;
+        };
+
+        // every reader is listed once, even if it reads the net on several pins
+        EXPECT_EQ(model.get_node_readers(view.get_net_index(a)).size(), 2);
+        EXPECT_EQ(readers(a), std::set<u32>({view.get_net_index(ab), view.get_net_index(aa)}));
+        EXPECT_EQ(readers(ab), std::set<u32>({view.get_net_index(inv)}));
+        EXPECT_TRUE(model.get_node_readers(view.get_net_index(inv)).empty());
+        EXPECT_EQ(model.get_element_readers(view.get_net_index(a)).size(), 1);
+        EXPECT_EQ(model.get_element_readers(view.get_net_index(inv)).size(), 1);
+        EXPECT_TRUE(model.get_element_readers(view.get_net_index(b)).empty());
+        EXPECT_TRUE(model.get_node_readers(netlist_graph_view::INVALID_INDEX).empty());
+    }
+    {
+        simulation_model::sequential_element e;
+        e.state_behavior          = gate_type_sequential::set_reset_behavior::H;
+        e.inverted_state_behavior = gate_type_sequential::set_reset_behavior::N;
+
+        using value     = boolean_function::value;
+        using result    = std::pair<value, value>;
+        const value X    = boolean_function::X;
+        const value ZERO = boolean_function::ZERO;
+        const value ONE  = boolean_function::ONE;
+
+        EXPECT_EQ(simulation_model::apply_set_reset(e, ZERO, ZERO, ONE, ZERO), result(ONE, ZERO));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, ONE, ZERO, ZERO, ONE), result(ONE, ZERO));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, ZERO, ONE, ONE, ZERO), result(ZERO, ONE));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, ONE, ONE, ZERO, ONE), result(ONE, ONE));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, X, ZERO, ONE, ZERO), result(ONE, ZERO));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, X, ZERO, ZERO, ONE), result(X, X));
+        EXPECT_EQ(simulation_model::apply_set_reset(e, ONE, X, ZERO, ONE), result(ONE, X));
+    }
+    TEST_END
+}
+
+/**
+ * Testing the value helpers shared by the simulators
+ *
+ * Functions: invert, merge, next_random
+ */
+TEST_F(simulation_model_test, check_value_helpers)
+{
+    TEST_START
+    {
+        EXPECT_EQ(simulation_model::invert(boolean_function::ZERO), boolean_function::ONE);
+        EXPECT_EQ(simulation_model::invert(boolean_function::ONE), boolean_function::ZERO);
+        EXPECT_EQ(simulation_model::invert(boolean_function::X), boolean_function::X);
+
+        EXPECT_EQ(simulation_model::merge(boolean_function::ONE, boolean_function::ONE), boolean_function::ONE);
+        EXPECT_EQ(simulation_model::merge(boolean_function::ZERO, boolean_function::ONE), boolean_function::X);
+        EXPECT_EQ(simulation_model::merge(boolean_function::X, boolean_function::X), boolean_function::X);
+    }
+    {
+        // the generator is reproducible and does not get stuck
+        u64 state_0 = 1, state_1 = 1;
+        std::set<u64> words;
+        for (u32 i = 0; i < 100; i++)
+        {
+            u64 word = simulation_model::next_random(state_0);
+            EXPECT_EQ(simulation_model::next_random(state_1), word);
+            words.insert(word);
+        }
+        EXPECT_EQ(words.size(), 100u);
+    }
+    TEST_END
+}
@@ -0,0 +1,106 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include <netlist/simulation/vcd_writer.h>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+
+using namespace test_utils;
+
+
+class vcd_writer_test : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+/**
+ * Testing the identifier codes of signals
+ *
+ * Functions: get_identifier
+ */
+TEST_F(vcd_writer_test, check_identifiers)
+{
+    TEST_START
+    {
+        EXPECT_EQ(vcd_writer::get_identifier(0), "!");
+        EXPECT_EQ(vcd_writer::get_identifier(93), "~");
+        EXPECT_EQ(vcd_writer::get_identifier(94), "!\"");
+
+        std::set<std::string> identifiers;
+        for (u32 i = 0; i < 20000; ++i)
+        {
+            auto id = vcd_writer::get_identifier(i);
+            for (char c : id)
+            {
+                ASSERT_TRUE(c >= '!' && c <= '~');
+            }
+            identifiers.insert(id);
+        }
+        EXPECT_EQ(identifiers.size(), 20000);
+    }
+    TEST_END
+}
+
+/**
+ * Testing the header and value changes
+ *
+ * Functions: add_signal, write_header, write_change
+ */
+TEST_F(vcd_writer_test, check_output)
+{
+    TEST_START
+    {
+        std::stringstream stream;
+        vcd_writer writer(stream);
+        EXPECT_EQ(writer.add_signal("clk"), 0);
+        EXPECT_EQ(writer.add_signal("data out"), 1);
+        EXPECT_EQ(writer.get_num_signals(), 2);
+
+        EXPECT_TRUE(writer.write_header("dut", "1ns", 0, {boolean_function::ZERO, boolean_function::X}));
+        writer.write_change(0, 1, boolean_function::ONE);
+        writer.write_change(5, 0, boolean_function::ONE);
+        writer.write_change(5, 1, boolean_function::X);
+        writer.write_change(10, 0, boolean_function::ZERO);
+
+        EXPECT_EQ(stream.str(),
+                  "$timescale 1ns $end\n"
+                  "$scope module dut $end\n"
+                  "$var wire 1 ! clk $end\n"
+                  "$var wire 1 \" data_out $end\n"
+                  "$upscope $end\n"
+                  "$enddefinitions $end\n"
+                  "#0\n"
+                  "$dumpvars\n"
+                  "0!\n"
+                  "x\"\n"
+                  "$end\n"
+                  "1\"\n"
+                  "#5\n"
+                  "1!\n"
+                  "x\"\n"
+                  "#10\n"
+                  "0!\n");
+
+        NO_COUT_TEST_BLOCK;
+        EXPECT_EQ(writer.add_signal("late"), vcd_writer::INVALID);
+        EXPECT_FALSE(writer.write_header("dut", "1ns", 0, {boolean_function::ZERO, boolean_function::X}));
+    }
+    {
+        std::stringstream stream;
+        vcd_writer writer(stream);
+        writer.add_signal("a");
+
+        NO_COUT_TEST_BLOCK;
+        EXPECT_FALSE(writer.write_header("", "1ns", 0, {}));
+        EXPECT_TRUE(stream.str().empty());
+    }
+    TEST_END
+}
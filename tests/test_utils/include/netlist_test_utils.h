@@ -8,6 +8,7 @@
 #include "netlist/netlist.h"
 #include "netlist/gate_library/gate_library.h"
 #include "netlist/gate_library/gate_library_manager.h"
+#include "netlist/gate_library/gate_type/gate_type_sequential.h"
 #include "netlist/gate.h"
 #include "netlist/net.h"
 #include "netlist/module.h"
@@ -107,6 +108,57 @@ namespace test_utils
      * @returns an already created AND3 gate
      */
     std::shared_ptr<gate> create_test_gate(std::shared_ptr<netlist> nl, const u32 id);
+
+    /**
+     * Adds a combinational gate type with a single output pin "O" to a gate library.
+     *
+     * @param[in] gl - the gate library
+     * @param[in] name - the name of the gate type
+     * @param[in] inputs - the input pins
+     * @param[in] function - the function of the output pin over the input pins
+     */
+    void add_combinational_type(const std::shared_ptr<gate_library>& gl, const std::string& name, const std::vector<std::string>& inputs, const std::string& function);
+
+    /**
+     * Adds a flip-flop type to a gate library. It has the data input "D", the clock input "CLK", optionally the
+     * asynchronous set input "S" and reset input "R" in this order, the state output "Q" and the inverted state output "QN".
+     *
+     * @param[in] gl - the gate library
+     * @param[in] name - the name of the gate type
+     * @param[in] has_set - true to add the set input
+     * @param[in] has_reset - true to add the reset input
+     * @returns the gate type for further configuration
+     */
+    std::shared_ptr<gate_type_sequential> add_flip_flop_type(const std::shared_ptr<gate_library>& gl, const std::string& name, bool has_set = false, bool has_reset = false);
+
+    /**
+     * Adds a latch type to a gate library. It has the data input "D", the enable input "EN" and the state output "Q".
+     *
+     * @param[in] gl - the gate library
+     * @param[in] name - the name of the gate type
+     * @returns the gate type for further configuration
+     */
+    std::shared_ptr<gate_type_sequential> add_latch_type(const std::shared_ptr<gate_library>& gl, const std::string& name);
+
+    /**
+     * Creates a gate of the given type whose input pins are driven by the given nets (nullptr leaves a pin unconnected)
+     * and creates one net per output pin driven by the gate.
+     *
+     * @param[in] nl - the netlist
+     * @param[in] type - the name of the gate type within the gate library of the netlist
+     * @param[in] inputs - the nets driving the input pins in order of the pins
+     * @returns the output nets in order of the output pins
+     */
+    std::vector<std::shared_ptr<net>> add_gate(const std::shared_ptr<netlist>& nl, const std::string& type, const std::vector<std::shared_ptr<net>>& inputs);
+
+    /**
+     * Creates a global input net.
+     *
+     * @param[in] nl - the netlist
+     * @param[in] name - the name of the net
+     * @returns the net
+     */
+    std::shared_ptr<net> add_input(const std::shared_ptr<netlist>& nl, const std::string& name);
     /**
      * Checks if two vectors have the same content regardless of their order. Shouldn't be used for
      * large vectors, since it isn't really efficient.
@@ -477,6 +477,79 @@ std::shared_ptr<gate> test_utils::create_test_gate(std::shared_ptr<netlist> nl,
     return res_gate;
 }
 
+void test_utils::add_combinational_type(const std::shared_ptr<gate_library>& gl, const std::string& name, const std::vector<std::string>& inputs, const std::string& function)
+{
+    auto gt = std::make_shared<gate_type>(name);
+    gt->add_input_pins(inputs);
+    gt->add_output_pins({"O"});
+    gt->add_boolean_function("O", boolean_function::from_string(function, inputs));
+    gl->add_gate_type(gt);
+}
+
+std::shared_ptr<gate_type_sequential> test_utils::add_flip_flop_type(const std::shared_ptr<gate_library>& gl, const std::string& name, bool has_set, bool has_reset)
+{
+    auto ff = std::make_shared<gate_type_sequential>(name, gate_type::base_type::ff);
+    ff->add_input_pins({"D", "CLK"});
+    ff->add_output_pins({"Q", "QN"});
+    ff->add_state_output_pin("Q");
+    ff->add_inverted_state_output_pin("QN");
+    ff->add_boolean_function("next_state", boolean_function::from_string("D", {"D"}));
+    ff->add_boolean_function("clock", boolean_function::from_string("CLK", {"CLK"}));
+    if (has_set)
+    {
+        ff->add_input_pin("S");
+        ff->add_boolean_function("set", boolean_function::from_string("S", {"S"}));
+    }
+    if (has_reset)
+    {
+        ff->add_input_pin("R");
+        ff->add_boolean_function("reset", boolean_function::from_string("R", {"R"}));
+    }
+    gl->add_gate_type(ff);
+    return ff;
+}
+
+std::shared_ptr<gate_type_sequential> test_utils::add_latch_type(const std::shared_ptr<gate_library>& gl, const std::string& name)
+{
+    auto latch = std::make_shared<gate_type_sequential>(name, gate_type::base_type::latch);
+    latch->add_input_pins({"D", "EN"});
+    latch->add_output_pins({"Q"});
+    latch->add_state_output_pin("Q");
+    latch->add_boolean_function("data_in", boolean_function::from_string("D", {"D"}));
+    latch->add_boolean_function("enable", boolean_function::from_string("EN", {"EN"}));
+    gl->add_gate_type(latch);
+    return latch;
+}
+
+std::vector<std::shared_ptr<net>> test_utils::add_gate(const std::shared_ptr<netlist>& nl, const std::string& type, const std::vector<std::shared_ptr<net>>& inputs)
+{
+    auto gt = nl->get_gate_library()->get_gate_types().at(type);
+    u32 id  = nl->get_unique_gate_id();
+    auto g  = nl->create_gate(id, gt, type + "_" + std::to_string(id));
+    for (u32 i = 0; i < inputs.size(); ++i)
+    {
+        if (inputs[i] != nullptr)
+        {
+            inputs[i]->add_dst(g, gt->get_input_pins()[i]);
+        }
+    }
+    std::vector<std::shared_ptr<net>> outputs;
+    for (const auto& pin : gt->get_output_pins())
+    {
+        auto out = nl->create_net("n_" + g->get_name() + "_" + pin);
+        out->set_src(g, pin);
+        outputs.push_back(out);
+    }
+    return outputs;
+}
+
+std::shared_ptr<net> test_utils::add_input(const std::shared_ptr<netlist>& nl, const std::string& name)
+{
+    auto n = nl->create_net(name);
+    n->mark_global_input_net();
+    return n;
+}
+
 
 endpoint test_utils::get_dst_by_pin_type(const std::vector<endpoint> dsts, const std::string pin_type)
 {